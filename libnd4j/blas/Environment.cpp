@@ -49,6 +49,32 @@ namespace nd4j {
                 // still do nothing
             }
         }
+
+        const char* hugePages = std::getenv("ND4J_HUGE_PAGES");
+        if (hugePages != nullptr) {
+            try {
+                int val = std::stoi(std::string(hugePages));
+                if (val >= nd4j::memory::HUGE_PAGES_NONE && val <= nd4j::memory::HUGE_PAGES_EXPLICIT)
+                    _hugePages.store((nd4j::memory::HugePagesMode) val);
+            } catch (std::invalid_argument &e) {
+                // just do nothing
+            } catch (std::out_of_range &e) {
+                // still do nothing
+            }
+        }
+
+        const char* numaPolicy = std::getenv("ND4J_NUMA_POLICY");
+        if (numaPolicy != nullptr) {
+            try {
+                int val = std::stoi(std::string(numaPolicy));
+                if (val >= nd4j::memory::NUMA_DEFAULT && val <= nd4j::memory::NUMA_INTERLEAVE)
+                    _numaPolicy.store((nd4j::memory::NumaPolicy) val);
+            } catch (std::invalid_argument &e) {
+                // just do nothing
+            } catch (std::out_of_range &e) {
+                // still do nothing
+            }
+        }
 #endif
     }
 
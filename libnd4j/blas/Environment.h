@@ -25,6 +25,7 @@
 #include <dll.h>
 #include <stdexcept>
 #include <array/DataType.h>
+#include <memory/HostAllocator.h>
 
 namespace nd4j{
     class ND4J_EXPORT Environment {
@@ -38,6 +39,11 @@ namespace nd4j{
         std::atomic<nd4j::DataType> _dataType;
         std::atomic<bool> _precBoost;
         std::atomic<bool> _useMKLDNN{true};
+        std::atomic<bool> _useShapeCache{true};
+        std::atomic<bool> _useMemoryPlanner{false};
+        std::atomic<nd4j::memory::HugePagesMode> _hugePages{nd4j::memory::HUGE_PAGES_NONE};
+        std::atomic<nd4j::memory::NumaPolicy> _numaPolicy{nd4j::memory::NUMA_DEFAULT};
+        std::atomic<Nd4jLong> _largeAllocationThreshold{2 * 1024 * 1024};
 
 #ifdef __ND4J_EXPERIMENTAL__
         const bool _experimental = true;
@@ -72,6 +78,28 @@ namespace nd4j{
         bool isUseMKLDNN() { return _useMKLDNN.load(); }
         void setUseMKLDNN(bool useMKLDNN) { _useMKLDNN.store(useMKLDNN); }
 
+        bool isUseShapeCache() { return _useShapeCache.load(); }
+        void setUseShapeCache(bool useShapeCache) { _useShapeCache.store(useShapeCache); }
+
+        /**
+         * Static memory plans for graph outputs, see MemoryPlanner.h. Disabled by default
+         */
+        bool isUseMemoryPlanner() { return _useMemoryPlanner.load(); }
+        void setUseMemoryPlanner(bool useMemoryPlanner) { _useMemoryPlanner.store(useMemoryPlanner); }
+
+        /**
+         * Huge pages and NUMA placement for host buffers of at least largeAllocationThreshold() bytes.
+         * Defaults can be set via ND4J_HUGE_PAGES and ND4J_NUMA_POLICY environment variables, see HostAllocator.h for values
+         */
+        nd4j::memory::HugePagesMode hugePagesMode() { return _hugePages.load(); }
+        void setHugePagesMode(nd4j::memory::HugePagesMode mode) { _hugePages.store(mode); }
+
+        nd4j::memory::NumaPolicy numaPolicy() { return _numaPolicy.load(); }
+        void setNumaPolicy(nd4j::memory::NumaPolicy policy) { _numaPolicy.store(policy); }
+
+        Nd4jLong largeAllocationThreshold() { return _largeAllocationThreshold.load(); }
+        void setLargeAllocationThreshold(Nd4jLong bytes) { _largeAllocationThreshold.store(bytes); }
+
         nd4j::DataType defaultFloatDataType();
         void setDefaultFloatDataType(nd4j::DataType dtype);
 
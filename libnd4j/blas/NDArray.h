@@ -62,6 +62,37 @@ namespace nd4j {
 
     ND4J_EXPORT NDArray mmul(const NDArray&, const NDArray&);
 
+    // overloads for temporary operands: if temporary array is suitable, result is written into its buffer, so chains like a + b * c don't allocate intermediate arrays (ops aren't fused though, each one is a separate pass)
+    ND4J_EXPORT NDArray operator+(NDArray&&, const NDArray&);
+    ND4J_EXPORT NDArray operator+(const NDArray&, NDArray&&);
+    ND4J_EXPORT NDArray operator+(NDArray&&, NDArray&&);
+
+    ND4J_EXPORT NDArray operator-(NDArray&&, const NDArray&);
+    ND4J_EXPORT NDArray operator-(const NDArray&, NDArray&&);
+    ND4J_EXPORT NDArray operator-(NDArray&&, NDArray&&);
+
+    ND4J_EXPORT NDArray operator*(NDArray&&, const NDArray&);
+    ND4J_EXPORT NDArray operator*(const NDArray&, NDArray&&);
+    ND4J_EXPORT NDArray operator*(NDArray&&, NDArray&&);
+
+    ND4J_EXPORT NDArray operator/(NDArray&&, const NDArray&);
+    ND4J_EXPORT NDArray operator/(const NDArray&, NDArray&&);
+    ND4J_EXPORT NDArray operator/(NDArray&&, NDArray&&);
+
+    ND4J_EXPORT NDArray operator-(NDArray&&);
+
+    template <typename T, typename = typename std::enable_if<!std::is_same<T, NDArray>::value>::type>
+    ND4J_EXPORT NDArray operator+(NDArray&&, const T&);
+
+    template <typename T, typename = typename std::enable_if<!std::is_same<T, NDArray>::value>::type>
+    ND4J_EXPORT NDArray operator-(NDArray&&, const T&);
+
+    template <typename T, typename = typename std::enable_if<!std::is_same<T, NDArray>::value>::type>
+    ND4J_EXPORT NDArray operator*(NDArray&&, const T&);
+
+    template <typename T, typename = typename std::enable_if<!std::is_same<T, NDArray>::value>::type>
+    ND4J_EXPORT NDArray operator/(NDArray&&, const T&);
+
     class ND4J_EXPORT NDArray {
     private:
         /**
@@ -1203,6 +1234,12 @@ namespace nd4j {
         */
         FORCEINLINE bool isSameShapeStrict(const NDArray *other) const;
 
+        /**
+        *  returns true if this array may hold result of elementwise op applied to this and other arrays:
+        *  it owns its buffer, has ews == 1 and the same shape, order and data type as other array
+        */
+        FORCEINLINE bool isReusableFor(const NDArray &other) const;
+
         /**
         *  returns true if buffer && shapeInfo were defined (non nullptr)
         */
@@ -1867,6 +1904,14 @@ bool NDArray::isSameShapeStrict(const NDArray *other) const {
     return shape::equalsStrict(_shapeInfo, other->_shapeInfo);
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool NDArray::isReusableFor(const NDArray &other) const {
+    if (!_isBuffAlloc || _isView || _buffer == nullptr || isS() || isEmpty() || other.isEmpty())
+        return false;
+
+    return _dataType == other._dataType && ews() == 1 && ordering() == other.ordering() && shape::equalsSoft(_shapeInfo, other._shapeInfo);
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool NDArray::isEmpty() const {
     if (this->_shapeInfo == nullptr)
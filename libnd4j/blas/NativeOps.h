@@ -1383,7 +1383,7 @@ public:
  * @return
  */
     Nd4jPointer numpyFromFile(std::string path) {
-        char *numpyBuffer = cnpy::loadFile(path.data());
+        char *numpyBuffer = cnpy::mapFile(path.data());
         return reinterpret_cast<Nd4jPointer >(numpyBuffer);
     }
 
@@ -1505,7 +1505,7 @@ public:
 
 
     void releaseNumpy(Nd4jPointer npyArray) {
-        free(reinterpret_cast<void *>(npyArray));
+        cnpy::releaseFile(reinterpret_cast<char *>(npyArray));
     }
 
 
@@ -50,10 +50,16 @@
 #include <helpers/ShapeUtils.h>
 #include <Status.h>
 #include <deque>
+#include <exception>
+#include <openmp_pragmas.h>
 #include <graph/ResultWrapper.h>
 #include <graph/ExecutionResult.h>
+#include <graph/VariableProxy.h>
+#include <graph/MemoryPlanner.h>
+#include <graph/execution/FrameSchedule.h>
 #include <graph/exceptions/graph_execution_exception.h>
 #include <graph/exceptions/no_results_exception.h>
+#include <graph/MappedFile.h>
 
 namespace nd4j{
 namespace graph {
@@ -198,6 +204,187 @@ namespace graph {
 }
 
 
+/**
+ * This method checks if given Node has to be skipped, because one of its inputs is disabled or belongs to inactive branch.
+ * Node is marked as inactive in FlowPath in this case.
+ */
+static bool hasInactiveInputs(Graph *graph, Node *node, FlowPath *flowPath) {
+    for (size_t e = 0; e < node->input()->size(); e++) {
+        auto inputId = node->input()->at(e);
+
+        // not a node. skipping checks
+        if (graph->getMapped()->count(inputId.first) == 0)
+            continue;
+
+        /**
+         * We can skip current node, in two cases:
+         * 1) If previous node was disabled
+         * 2) If previous node was divergent node (i.e. IF op) and code went other way
+         */
+        Node *prevNode = graph->getMapped()->at(inputId.first);
+        if (!flowPath->isNodeActive(inputId.first)) {
+            flowPath->markNodeActive(node->id(), false);
+
+            nd4j_debug("Skipping Node_%i due to inactive input [%i]\n", node->id(), inputId.first);
+            return true;
+
+        } else if (prevNode->isDivergencePoint()) { // literally checking for switch here
+            if (flowPath->branch(inputId.first) != inputId.second) {
+                flowPath->markNodeActive(node->id(), false);
+                nd4j_debug("Skipping Node_%i due to divergent branch [%i]\n", node->id(), inputId.first);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * This method checks if nodes of the given layer can be executed concurrently:
+ * layer should have more then 1 node, and only "plain" ops, so no control flow or embedded graphs are involved
+ */
+static bool isConcurrentLayer(std::vector<Node*> *layer) {
+    if (layer->size() < 2)
+        return false;
+
+    for (auto node: *layer)
+        if (node->opType() == OpType_LOGIC || node->hasGraphEmbedded() || !node->hasCustomOp())
+            return false;
+
+    return true;
+}
+
+/**
+ * This method returns total length of node inputs, which is used as estimate of node cost.
+ * As side effect, proxied inputs get replicated into local VariableSpace here, before any concurrent access.
+ */
+static Nd4jLong estimateNodeCost(Node *node, VariableSpace *variableSpace) {
+    Nd4jLong cost = 0;
+    for (auto &in: *node->input()) {
+        if (!variableSpace->hasVariable(in))
+            continue;
+
+        auto var = variableSpace->getVariable(in);
+        if (var->hasNDArray())
+            cost += var->getNDArray()->lengthOf();
+    }
+
+    return cost;
+}
+
+/**
+ * This method executes nodes of the given layer. Nodes within the same layer never depend on each other,
+ * so the only shared state here is VariableSpace (which is synchronized) and Workspace (which is synchronized as well).
+ *
+ * Nested OpenMP regions run single-threaded, so only cheap nodes, i.e. ones whose inputs are below elementwise threshold
+ * and which wouldn't go parallel internally anyway, are executed concurrently, one thread per node.
+ * Heavy nodes are executed one by one, each of them with all threads available.
+ * FlowPath bookkeeping is done sequentially, before and after parallel region.
+ */
+static Nd4jStatus executeConcurrentLayer(Graph *graph, std::vector<Node*> *layer, VariableSpace *variableSpace) {
+    auto flowPath = variableSpace->flowPath();
+    auto threshold = Environment::getInstance()->elementwiseThreshold();
+
+    std::vector<Node*> cheap;
+    std::vector<Node*> heavy;
+    for (auto node: *layer) {
+        if (hasInactiveInputs(graph, node, flowPath))
+            continue;
+
+        flowPath->markNodeActive(node->id(), true);
+
+        if (estimateNodeCost(node, variableSpace) < threshold)
+            cheap.emplace_back(node);
+        else
+            heavy.emplace_back(node);
+    }
+
+    std::vector<Node*> nodes(heavy);
+    nodes.insert(nodes.end(), cheap.begin(), cheap.end());
+
+    auto numNodes = static_cast<int>(nodes.size());
+    auto numHeavy = static_cast<int>(heavy.size());
+    std::vector<Nd4jStatus> statuses(numNodes, Status::OK());
+    std::vector<Nd4jLong> timings(numNodes, 0L);
+    std::vector<std::exception_ptr> exceptions(numNodes);
+
+    auto executeNode = [&](int e) {
+        try {
+            auto timeStart = std::chrono::system_clock::now();
+
+            statuses[e] = GraphExecutioner::executeFlatNode(graph, nodes[e], variableSpace);
+
+            auto timeEnd = std::chrono::system_clock::now();
+            timings[e] = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
+        } catch (...) {
+            // exceptions can't leave parallel region, so we'll rethrow them afterwards
+            exceptions[e] = std::current_exception();
+        }
+    };
+
+    bool failed = false;
+    for (int e = 0; e < numHeavy && !failed; e++) {
+        executeNode(e);
+        failed = exceptions[e] || statuses[e] != ND4J_STATUS_OK;
+    }
+
+    // layer result is reported as failure anyway, so there's no point in running cheap nodes
+    if (!failed) {
+        auto numThreads = nd4j::math::nd4j_min<int>(numNodes - numHeavy, omp_get_max_threads());
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(num_threads(numThreads) if(numThreads > 1) schedule(dynamic, 1))
+        for (int e = numHeavy; e < numNodes; e++)
+            executeNode(e);
+    }
+
+    for (int e = 0; e < numNodes; e++) {
+        if (exceptions[e])
+            std::rethrow_exception(exceptions[e]);
+
+        if (statuses[e] != ND4J_STATUS_OK)
+            return statuses[e];
+
+        flowPath->setOuterTime(nodes[e]->id(), timings[e]);
+        flowPath->markExecuted(nodes[e]->id(), true);
+    }
+
+    return Status::OK();
+}
+
+/**
+ * This class keeps MemoryArena attached to the FlowPath for the duration of single graph run, no matter how this run ends
+ */
+class MemoryArenaHolder {
+private:
+    FlowPath* _flowPath;
+    MemoryArena* _arena;
+public:
+    MemoryArenaHolder(FlowPath* flowPath, MemoryArena* arena) {
+        _flowPath = flowPath;
+        _arena = arena;
+
+        if (_arena != nullptr)
+            _flowPath->setMemoryArena(_arena);
+    }
+
+    ~MemoryArenaHolder() {
+        release();
+    }
+
+    void release() {
+        if (_arena != nullptr) {
+            _flowPath->setMemoryArena(nullptr);
+            delete _arena;
+            _arena = nullptr;
+        }
+    }
+
+    MemoryArena* arena() {
+        return _arena;
+    }
+};
+
 /**
  * This method executes given Graph instance, and returns error code.
  *
@@ -217,43 +404,103 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     Nd4jLong tb0 = Environment::getInstance()->isProfiling() ? GraphProfile::currentTime() : 0L;
     graph->buildGraph();
 
-    auto footprintForward = nd4j::memory::MemoryRegistrator::getInstance()->getGraphMemoryFootprint(graph->hashCode());
+    auto graphHash = graph->hashCode();
+    auto workspace = __variableSpace->workspace();
+
+    // if enabled, static memory plan is used if it's available for this graph and these input shapes, otherwise current run gets recorded to build one
+    auto planner = MemoryPlanner::getInstance();
+    MemoryPlan* plan = nullptr;
+    Nd4jLong signature = 0L;
+    Nd4jLong memoryBefore = 0L;
+    bool planning = workspace != nullptr && Environment::getInstance()->isUseMemoryPlanner() && MemoryPlanner::isPlannable(graph);
+    if (planning) {
+        signature = MemoryPlanner::signature(graph, __variableSpace);
+        plan = planner->getPlan(graphHash, signature);
+    }
+
+    auto footprintForward = plan != nullptr ? plan->footprint() : nd4j::memory::MemoryRegistrator::getInstance()->getGraphMemoryFootprint(graphHash);
     if (footprintForward > 0) {
-        if (__variableSpace->workspace() != nullptr) {
+        if (workspace != nullptr) {
             // this method will work only if current workspace size is smaller then proposed value
             nd4j_debug("Setting workspace to %lld bytes\n", footprintForward);
-            __variableSpace->workspace()->expandTo(footprintForward);
+            workspace->expandTo(footprintForward);
         }
     }
 
+    if (planning)
+        memoryBefore = workspace->getUsedSize() + workspace->getSpilledSize();
+
+    MemoryArenaHolder arenaHolder(flowPath, !planning ? nullptr : plan != nullptr ? new MemoryArena(plan, workspace) : new MemoryArena());
+
     // optionally saving graph build time
     if (Environment::getInstance()->isProfiling())
         flowPath->profile()->setBuildTime(GraphProfile::relativeTime(tb0));
 
     Nd4jLong timeStart = Environment::getInstance()->isProfiling() ? GraphProfile::currentTime() : 0L;
 
-    bool pe = graph->getExecutorConfiguration()->_executionMode == ExecutionMode_AUTO;
+    // in AUTO mode independent nodes of the same layer are executed concurrently, as long as there's no control flow involved
+    bool pe = graph->getExecutorConfiguration()->_executionMode == ExecutionMode_AUTO && !Environment::getInstance()->isProfiling() && !Environment::getInstance()->isDebugAndVerbose();
 
 
     // basically if at some point code diverges, code branch might be _DISABLED_, and all nodes within that branch will be disabled as well
 
     std::deque<Nd4jLong> frames;
-    bool inFrame =  false;
-    bool leftFrame = false;
 
     auto nodeTime = GraphProfile::currentTime();
     int lastId = -10000000;
     Nd4jLong exec_counter = 0;
+    auto maxSteps = graph->getExecutorConfiguration()->_maxSteps;
+    auto maxIterations = graph->getExecutorConfiguration()->_maxIterations;
+
+    // once loop frame was rewound, only nodes of its body are visited. innermost rewound frame wins
+    auto activeSchedule = [&] () -> FrameSchedule* {
+        for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+            if (flowPath->getNumberOfCycles(*it) > 0)
+                return flowPath->frameSchedule(*it);
+        }
+
+        return nullptr;
+    };
+
     // we loop through op layers here
     for (int l = 0; l < (int) graph->getOnion()->size(); l++) {
         int layerSize = graph->getOnion()->count(l) == 1 ? graph->getOnion()->at(l)->size() : 0;
 
+        if (!frames.empty()) {
+            auto schedule = activeSchedule();
+            if (schedule != nullptr && schedule->isEmptyLayer(l))
+                continue;
+        }
+
+        if (pe && frames.empty() && layerSize > 1 && isConcurrentLayer(graph->getOnion()->at(l))) {
+            // whole layer is checked against the limit before any of its nodes is started
+            exec_counter += layerSize;
+            if (exec_counter > maxSteps && maxSteps > 0) {
+                throw std::runtime_error("Graph execution exceeded limit of " + std::to_string(maxSteps) + " steps");
+            }
+
+            nd4j_debug("Step: %lld; Layer: %i; executing %i nodes concurrently\n", exec_counter, l, layerSize);
+
+            auto status = executeConcurrentLayer(graph, graph->getOnion()->at(l), __variableSpace);
+            if (status != Status::OK())
+                return status;
+
+            continue;
+        }
+
         int n = 0;
-// this omp block will probably never be the case
         for (; n < layerSize; n++) {
-            if (++exec_counter > 10000) {
-                l = graph->getOnion()->size();
-                return Status::THROW("Early termination hit");
+            if (!frames.empty()) {
+                auto schedule = activeSchedule();
+                if (schedule != nullptr) {
+                    n = schedule->nextNode(l, n);
+                    if (n >= layerSize)
+                        break;
+                }
+            }
+
+            if (++exec_counter > maxSteps && maxSteps > 0) {
+                throw std::runtime_error("Graph execution exceeded limit of " + std::to_string(maxSteps) + " steps");
             }
 
             Node* node = graph->getOnion()->at(l)->at(n);
@@ -271,71 +518,27 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
             nd4j_debug("Step: %lld; Node: %i <%s>\n", exec_counter, node->id(), node->name()->c_str());
 
-            // on first non-Exit node after loop we can rewind (if planned)
-            if (!(node->opType() == OpType_LOGIC && node->opNum() == nd4j::logic::Exit)) {
-                // VALIDATED
-
-                // if we're out of frame - let's remove it from queue
-                if (leftFrame) {
-                    auto frame_id = frames.back();
-                    frames.pop_back();
-                    flowPath->markFrameActive(frame_id, false);
-                    flowPath->forgetFrame(frame_id);
+            // TODO: move inactivity check right here
+            bool shouldSkip = false;
+            if (node->opType() == OpType_LOGIC && node->opNum() == nd4j::logic::Merge) {
+                // Merge node has own checkout logic
 
-                    leftFrame = false;
-                }
+                auto inputId0 = node->input()->at(0);
+                auto inputId1 = node->input()->at(1);
 
+                // Merge node can be skipped only both inputs are inactive
+                if (!flowPath->isNodeActive(inputId0.first) && !flowPath->isNodeActive(inputId1.first))
+                    shouldSkip = true;
 
-                // TODO: move inactivity check right here
-                bool shouldSkip = false;
-                if (node->opType() == OpType_LOGIC && node->opNum() == nd4j::logic::Merge) {
-                    // Merge node has own checkout logic
-
-                    auto inputId0 = node->input()->at(0);
-                    auto inputId1 = node->input()->at(1);
-
-                    // Merge node can be skipped only both inputs are inactive
-                    if (!flowPath->isNodeActive(inputId0.first) && !flowPath->isNodeActive(inputId1.first))
-                        shouldSkip = true;
-
-                } else {
-                    // let's check for input nodes, if they are disabled or contain divergents
-                    for (int e = 0; e < node->input()->size(); e++) {
-                        auto inputId = node->input()->at(e);
-
-                        // not a node. skipping checks
-                        if (graph->getMapped()->count(inputId.first) == 0)
-                            continue;
-
-                        /**
-                         * We can skip current node, in two cases:
-                         * 1) If previous node was disabled
-                         * 2) If previous node was divergent node (i.e. IF op) and code went other way
-                         */
-                        Node *prevNode = graph->getMapped()->at(inputId.first);
-                        if (!flowPath->isNodeActive(inputId.first)) {
-                            shouldSkip = true;
-                            flowPath->markNodeActive(node->id(), false);
-
-                            nd4j_debug("Skipping Node_%i due to inactive input [%i]\n", node->id(), inputId.first);
-                            break;
-
-                        } else if (prevNode->isDivergencePoint()) { // literally checking for switch here
-                            if (flowPath->branch(inputId.first) != inputId.second) {
-                                shouldSkip = true;
-                                flowPath->markNodeActive(node->id(), false);
-                                nd4j_debug("Skipping Node_%i due to divergent branch [%i]\n", node->id(),
-                                           inputId.first);
-                                break;
-                            }
-                        }
-                    }
-                }
-
-                if (shouldSkip)
-                    continue;
+            } else {
+                // let's check for input nodes, if they are disabled or contain divergents
+                // that's also how Exit nodes are skipped while loop goes on
+                shouldSkip = hasInactiveInputs(graph, node, flowPath);
             }
 
+            if (shouldSkip)
+                continue;
+
             // we're propagating frameId here (but only if wasn't set earlier)
             if (frames.size() > 0 && node->getFrameId() < 0)
                 node->setFrameId(frames.back());
@@ -354,79 +557,35 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
                 if (frames.size() == 0 || (frames.size() > 0 && frames.back() != frame_id)) {
                     flowPath->registerFrame(frame_id);
                     frames.emplace_back(frame_id);
-                    inFrame = true;
+
+                    // loop body is static, so it's resolved once per graph run
+                    if (flowPath->frameSchedule(frame_id) == nullptr)
+                        flowPath->setFrameSchedule(frame_id, FrameSchedule(graph, frame_id));
                 }
 
 
-                auto status = LogicExecutor::processNode(graph, node);
+                auto status = LogicExecutor::processNode(graph, node, __variableSpace);
                 if (status != Status::OK())
                     return status;
 
             } else if (node->opType() == OpType_LOGIC && node->opNum() == nd4j::logic::NextIteration) {
                 /**
-                 * NextIteration is special case: after successful execution of this op - we're changing execution position
+                 * NextIteration is special case: after successful execution of this op - loop body will be rewound
+                 * once the last layer of the body is done
                  */
-                // VALIDATED
-                auto inputId = node->input()->at(0);
-
-                auto status = LogicExecutor::processNode(graph, node);
+                auto status = LogicExecutor::processNode(graph, node, __variableSpace);
                 if (status != Status::OK())
                     return status;
 
-                auto frame_id = frames.back();
-
-                flowPath->markNodeActive(node->id(), true);
-                flowPath->markExecuted(node->id(), true);
-
-                if (!flowPath->isRewindPlanned(frame_id)) {
-                    auto nextLayer = node->getRewindLayer();
-
-                    nd4j_debug("Node_%i planned rewind to Node_%i at [%i:%i]\n", node->id(), node->getRewindNode(), nextLayer.first, nextLayer.second);
-
-                    flowPath->planRewind(frame_id, true);
-                    flowPath->setRewindPositionOnce(frame_id, nextLayer.first - 1);
-
-                    continue;
+                if (!frames.empty() && !flowPath->isRewindPlanned(frames.back())) {
+                    nd4j_debug("Node_%i planned rewind of frame [%lld]\n", node->id(), frames.back());
+                    flowPath->planRewind(frames.back(), true);
                 }
-
-
-            } else if (node->opType() == OpType_LOGIC && node->opNum() == nd4j::logic::Exit) {
-                // Exit node is another special case: it can rewind executioner to specific point in graph
-                // VALIDATED
-
-                auto frame_id = frames.back();
-
-                // if this loop frame wasn't activated - just skip it
-                if (!flowPath->isFrameActive(frame_id)) {
-                    flowPath->markNodeActive(node->id(), false);
-
-                    leftFrame = true;
-                    continue;
-                }
-
-                if (flowPath->isRewindPlanned(frame_id)) {
-                    // just break loop here
-                    l = flowPath->getRewindPosition(frame_id);
-                    flowPath->setRewindPosition(frame_id, -1);
-                    flowPath->planRewind(frame_id, false);
-
-                    break;
-                } else {
-                    // execute Exit node otherwise
-
-                    auto status = LogicExecutor::processNode(graph, node);
-                    if (status != Status::OK())
-                        return status;
-
-                    leftFrame = true;
-                }
-
-
             } else if (node->opType() == OpType_LOGIC) {
                 /**
                  * If this LOGIC op, we'll use another execution model here
                  */
-                auto status = LogicExecutor::processNode(graph, node);
+                auto status = LogicExecutor::processNode(graph, node, __variableSpace);
 
                 if (status != Status::OK())
                     return status;
@@ -477,6 +636,30 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
             // if node was executed - tag it as active
             flowPath->markExecuted(node->id(), true);
         }
+
+        // last layer of the loop body: we either rewind to the first layer of the body, or leave the frame. nested frames might end at the same layer
+        while (!frames.empty()) {
+            auto frame_id = frames.back();
+            auto schedule = flowPath->frameSchedule(frame_id);
+            if (schedule == nullptr || l < schedule->lastLayer())
+                break;
+
+            if (flowPath->isRewindPlanned(frame_id)) {
+                flowPath->planRewind(frame_id, false);
+                flowPath->incrementNumberOfCycles(frame_id);
+
+                if (maxIterations > 0 && flowPath->getNumberOfCycles(frame_id) > maxIterations) {
+                    throw std::runtime_error("Frame [" + std::to_string(frame_id) + "] exceeded limit of " + std::to_string(maxIterations) + " iterations");
+                }
+
+                l = schedule->firstLayer() - 1;
+                break;
+            }
+
+            frames.pop_back();
+            flowPath->markFrameActive(frame_id, false);
+            flowPath->forgetFrame(frame_id);
+        }
     }
 
     // optionally saving execution time
@@ -487,12 +670,23 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     }
 
     // saving memory footprint for current run
-    if (__variableSpace->workspace() != nullptr) {
-        auto m = __variableSpace->workspace()->getAllocatedSize();
-        auto h = graph->hashCode();
-        nd4j::memory::MemoryRegistrator::getInstance()->setGraphMemoryFootprintIfGreater(h, m);
+    if (planning) {
+        auto arena = arenaHolder.arena();
+        auto used = workspace->getUsedSize() + workspace->getSpilledSize() - memoryBefore;
+
+        if (arena->isRecording())
+            planner->buildPlan(graph, __variableSpace, arena, used - arena->recordedBytes(), graphHash, signature);
+        else
+            plan->setFootprintIfGreater(used);
     }
 
+    if (workspace != nullptr && plan == nullptr) {
+        auto m = workspace->getAllocatedSize();
+        nd4j::memory::MemoryRegistrator::getInstance()->setGraphMemoryFootprintIfGreater(graphHash, m);
+    }
+
+    arenaHolder.release();
+
     if (tempFlow)
         delete flowPath;
 
@@ -837,39 +1031,42 @@ uint8_t* readFlatBuffers(const char * filename) {
     uint8_t * data = new uint8_t[fileLen];
 
     FILE *in = fopen(filename, "rb");
-    int cnt = 0;
-    int b = 0;
-    while (cnt < fileLen) {
-        b += fread(data + cnt, 1, 1, in);
+    auto cnt = fread(data, 1, fileLen, in);
+    fclose(in);
 
-        cnt++;
+    if ((long) cnt != fileLen) {
+        delete[] data;
+        throw std::runtime_error("Failed to read file");
     }
-    fclose(in);
 
     return data;
 }
 
 flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
     ExecutionResult result;
-    auto varSpace = graph->getVariableSpace();
+
+    // Graph is never modified here: placeholders and intermediate results live in per-request proxy,
+    // while weights are read from the Graph's own VariableSpace. So the same Graph can serve concurrent requests.
+    // Weights are told apart by Graph::markSharedVariables(), which is called when graph gets registered in GraphHolder
+    VariableProxy varSpace(graph->getVariableSpace());
 
     if (request != nullptr && request->variables() != nullptr) {
         auto vars = request->variables();
         for (int e = 0; e < vars->size(); e++) {
             auto fv = vars->Get(e);
             auto v = new Variable(fv);
-            varSpace->replaceVariable(v);
+            varSpace.replaceVariable(v);
         }
     }
 
     if (Environment::getInstance()->isDebugAndVerbose())
         graph->printOut();
 
-    auto status = GraphExecutioner::execute(graph);
+    auto status = GraphExecutioner::execute(graph, &varSpace);
     if (status != nd4j::Status::OK())
         throw graph_execution_exception(request->id());
 
-    auto outputs = graph->fetchOutputs();
+    auto outputs = graph->fetchOutputs(&varSpace);
 
     if (outputs->size() == 0)
         throw no_results_exception(request->id());
@@ -893,10 +1090,11 @@ flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuff
         *   PLEASE NOTE: This method is mostly suited for tests and debugging/profiling
         */
         Graph* GraphExecutioner::importFromFlatBuffers(const char *filename) {
-            auto data = readFlatBuffers(filename);
-            auto restoredGraph = importFromFlatPointer(reinterpret_cast<Nd4jPointer>(data));
-            delete[] data;
-            return restoredGraph;
+            // file is mapped, and weights stored in host byte order are used in place, so Graph keeps the mapping
+            auto storage = std::make_shared<MappedFile>(filename);
+            auto fg = GetFlatGraph(storage->data());
+
+            return new Graph(fg, nullptr, storage);
         }
 
         Graph *GraphExecutioner::importFromFlatPointer(Nd4jPointer ptr) {
@@ -4310,6 +4310,190 @@ ND4J_EXPORT NDArray operator/(const int& scalar, const NDArray & arr) {
     return result;
 }
 
+////////////////////////////////////////////////////////////////////////
+// operators for temporary operands, result is written into buffer of temporary array whenever it's possible.
+// that's not fusion: each operator still makes its own pass over memory, only intermediate allocations are avoided.
+// chains of same-shape ews == 1 operands can be evaluated in one pass with ElementwiseChain
+ND4J_EXPORT NDArray operator+(NDArray&& arr, const NDArray& other) {
+    if (!arr.isReusableFor(other))
+        return static_cast<const NDArray&>(arr) + other;
+
+    NativeOpExcutioner::execPairwiseTransform(nd4j::pairwise::Add, arr.getBuffer(), arr.getShapeInfo(), other.getBuffer(), other.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), nullptr);
+    return std::move(arr);
+}
+
+ND4J_EXPORT NDArray operator+(const NDArray& other, NDArray&& arr) {
+    if (!arr.isReusableFor(other))
+        return other + static_cast<const NDArray&>(arr);
+
+    NativeOpExcutioner::execPairwiseTransform(nd4j::pairwise::Add, other.getBuffer(), other.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), nullptr);
+    return std::move(arr);
+}
+
+ND4J_EXPORT NDArray operator+(NDArray&& arr, NDArray&& other) {
+    if (!arr.isReusableFor(other))
+        return static_cast<const NDArray&>(arr) + std::move(other);
+
+    return std::move(arr) + static_cast<const NDArray&>(other);
+}
+
+ND4J_EXPORT NDArray operator-(NDArray&& arr, const NDArray& other) {
+    if (!arr.isReusableFor(other))
+        return static_cast<const NDArray&>(arr) - other;
+
+    NativeOpExcutioner::execPairwiseTransform(nd4j::pairwise::Subtract, arr.getBuffer(), arr.getShapeInfo(), other.getBuffer(), other.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), nullptr);
+    return std::move(arr);
+}
+
+ND4J_EXPORT NDArray operator-(const NDArray& other, NDArray&& arr) {
+    if (!arr.isReusableFor(other))
+        return other - static_cast<const NDArray&>(arr);
+
+    NativeOpExcutioner::execPairwiseTransform(nd4j::pairwise::Subtract, other.getBuffer(), other.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), nullptr);
+    return std::move(arr);
+}
+
+ND4J_EXPORT NDArray operator-(NDArray&& arr, NDArray&& other) {
+    if (!arr.isReusableFor(other))
+        return static_cast<const NDArray&>(arr) - std::move(other);
+
+    return std::move(arr) - static_cast<const NDArray&>(other);
+}
+
+ND4J_EXPORT NDArray operator*(NDArray&& arr, const NDArray& other) {
+    if (!arr.isReusableFor(other))
+        return static_cast<const NDArray&>(arr) * other;
+
+    NativeOpExcutioner::execPairwiseTransform(nd4j::pairwise::Multiply, arr.getBuffer(), arr.getShapeInfo(), other.getBuffer(), other.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), nullptr);
+    return std::move(arr);
+}
+
+ND4J_EXPORT NDArray operator*(const NDArray& other, NDArray&& arr) {
+    if (!arr.isReusableFor(other))
+        return other * static_cast<const NDArray&>(arr);
+
+    NativeOpExcutioner::execPairwiseTransform(nd4j::pairwise::Multiply, other.getBuffer(), other.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), nullptr);
+    return std::move(arr);
+}
+
+ND4J_EXPORT NDArray operator*(NDArray&& arr, NDArray&& other) {
+    if (!arr.isReusableFor(other))
+        return static_cast<const NDArray&>(arr) * std::move(other);
+
+    return std::move(arr) * static_cast<const NDArray&>(other);
+}
+
+ND4J_EXPORT NDArray operator/(NDArray&& arr, const NDArray& other) {
+    if (!arr.isReusableFor(other) || other.isB())
+        return static_cast<const NDArray&>(arr) / other;
+
+    NativeOpExcutioner::execPairwiseTransform(nd4j::pairwise::Divide, arr.getBuffer(), arr.getShapeInfo(), other.getBuffer(), other.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), nullptr);
+    return std::move(arr);
+}
+
+ND4J_EXPORT NDArray operator/(const NDArray& other, NDArray&& arr) {
+    if (!arr.isReusableFor(other) || arr.isB())
+        return other / static_cast<const NDArray&>(arr);
+
+    NativeOpExcutioner::execPairwiseTransform(nd4j::pairwise::Divide, other.getBuffer(), other.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), nullptr);
+    return std::move(arr);
+}
+
+ND4J_EXPORT NDArray operator/(NDArray&& arr, NDArray&& other) {
+    if (!arr.isReusableFor(other))
+        return static_cast<const NDArray&>(arr) / std::move(other);
+
+    return std::move(arr) / static_cast<const NDArray&>(other);
+}
+
+ND4J_EXPORT NDArray operator-(NDArray&& arr) {
+    if (!arr.isReusableFor(arr))
+        return -static_cast<const NDArray&>(arr);
+
+    NativeOpExcutioner::execTransformSame(nd4j::transform::Neg, arr.getBuffer(), arr.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), nullptr, nullptr, nullptr);
+    return std::move(arr);
+}
+
+template <typename T, typename>
+NDArray operator+(NDArray&& arr, const T& scalar) {
+    if (!(arr.isReusableFor(arr) && DataTypeUtils::pickPairwiseResultType(arr.dataType(), DataTypeUtils::fromT<T>()) == arr.dataType()))
+        return static_cast<const NDArray&>(arr) + scalar;
+
+    auto tmp = NDArrayFactory::create(arr.dataType(), scalar, arr.getWorkspace());
+    NativeOpExcutioner::execScalar(nd4j::scalar::Add, arr.getBuffer(), arr.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), tmp.getBuffer(), tmp.getShapeInfo(), nullptr);
+    return std::move(arr);
+}
+template ND4J_EXPORT NDArray operator+(NDArray&& arr, const double&   scalar);
+template ND4J_EXPORT NDArray operator+(NDArray&& arr, const float&    scalar);
+template ND4J_EXPORT NDArray operator+(NDArray&& arr, const float16&  scalar);
+template ND4J_EXPORT NDArray operator+(NDArray&& arr, const bfloat16& scalar);
+template ND4J_EXPORT NDArray operator+(NDArray&& arr, const Nd4jLong& scalar);
+template ND4J_EXPORT NDArray operator+(NDArray&& arr, const int&      scalar);
+template ND4J_EXPORT NDArray operator+(NDArray&& arr, const int16_t&  scalar);
+template ND4J_EXPORT NDArray operator+(NDArray&& arr, const int8_t&   scalar);
+template ND4J_EXPORT NDArray operator+(NDArray&& arr, const uint8_t&  scalar);
+template ND4J_EXPORT NDArray operator+(NDArray&& arr, const bool&     scalar);
+
+template <typename T, typename>
+NDArray operator-(NDArray&& arr, const T& scalar) {
+    if (!(arr.isReusableFor(arr) && DataTypeUtils::pickPairwiseResultType(arr.dataType(), DataTypeUtils::fromT<T>()) == arr.dataType()))
+        return static_cast<const NDArray&>(arr) - scalar;
+
+    auto tmp = NDArrayFactory::create(arr.dataType(), scalar, arr.getWorkspace());
+    NativeOpExcutioner::execScalar(nd4j::scalar::Subtract, arr.getBuffer(), arr.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), tmp.getBuffer(), tmp.getShapeInfo(), nullptr);
+    return std::move(arr);
+}
+template ND4J_EXPORT NDArray operator-(NDArray&& arr, const double&   scalar);
+template ND4J_EXPORT NDArray operator-(NDArray&& arr, const float&    scalar);
+template ND4J_EXPORT NDArray operator-(NDArray&& arr, const float16&  scalar);
+template ND4J_EXPORT NDArray operator-(NDArray&& arr, const bfloat16& scalar);
+template ND4J_EXPORT NDArray operator-(NDArray&& arr, const Nd4jLong& scalar);
+template ND4J_EXPORT NDArray operator-(NDArray&& arr, const int&      scalar);
+template ND4J_EXPORT NDArray operator-(NDArray&& arr, const int16_t&  scalar);
+template ND4J_EXPORT NDArray operator-(NDArray&& arr, const int8_t&   scalar);
+template ND4J_EXPORT NDArray operator-(NDArray&& arr, const uint8_t&  scalar);
+template ND4J_EXPORT NDArray operator-(NDArray&& arr, const bool&     scalar);
+
+template <typename T, typename>
+NDArray operator*(NDArray&& arr, const T& scalar) {
+    if (!(arr.isReusableFor(arr) && DataTypeUtils::pickPairwiseResultType(arr.dataType(), DataTypeUtils::fromT<T>()) == arr.dataType()))
+        return static_cast<const NDArray&>(arr) * scalar;
+
+    auto tmp = NDArrayFactory::create(arr.dataType(), scalar, arr.getWorkspace());
+    NativeOpExcutioner::execScalar(nd4j::scalar::Multiply, arr.getBuffer(), arr.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), tmp.getBuffer(), tmp.getShapeInfo(), nullptr);
+    return std::move(arr);
+}
+template ND4J_EXPORT NDArray operator*(NDArray&& arr, const double&   scalar);
+template ND4J_EXPORT NDArray operator*(NDArray&& arr, const float&    scalar);
+template ND4J_EXPORT NDArray operator*(NDArray&& arr, const float16&  scalar);
+template ND4J_EXPORT NDArray operator*(NDArray&& arr, const bfloat16& scalar);
+template ND4J_EXPORT NDArray operator*(NDArray&& arr, const Nd4jLong& scalar);
+template ND4J_EXPORT NDArray operator*(NDArray&& arr, const int&      scalar);
+template ND4J_EXPORT NDArray operator*(NDArray&& arr, const int16_t&  scalar);
+template ND4J_EXPORT NDArray operator*(NDArray&& arr, const int8_t&   scalar);
+template ND4J_EXPORT NDArray operator*(NDArray&& arr, const uint8_t&  scalar);
+template ND4J_EXPORT NDArray operator*(NDArray&& arr, const bool&     scalar);
+
+template <typename T, typename>
+NDArray operator/(NDArray&& arr, const T& scalar) {
+    if (!(scalar != (T) 0. && arr.isReusableFor(arr) && DataTypeUtils::pickPairwiseResultType(arr.dataType(), DataTypeUtils::fromT<T>()) == arr.dataType()))
+        return static_cast<const NDArray&>(arr) / scalar;
+
+    auto tmp = NDArrayFactory::create(arr.dataType(), scalar, arr.getWorkspace());
+    NativeOpExcutioner::execScalar(nd4j::scalar::Divide, arr.getBuffer(), arr.getShapeInfo(), arr.getBuffer(), arr.getShapeInfo(), tmp.getBuffer(), tmp.getShapeInfo(), nullptr);
+    return std::move(arr);
+}
+template ND4J_EXPORT NDArray operator/(NDArray&& arr, const double&   scalar);
+template ND4J_EXPORT NDArray operator/(NDArray&& arr, const float&    scalar);
+template ND4J_EXPORT NDArray operator/(NDArray&& arr, const float16&  scalar);
+template ND4J_EXPORT NDArray operator/(NDArray&& arr, const bfloat16& scalar);
+template ND4J_EXPORT NDArray operator/(NDArray&& arr, const Nd4jLong& scalar);
+template ND4J_EXPORT NDArray operator/(NDArray&& arr, const int&      scalar);
+template ND4J_EXPORT NDArray operator/(NDArray&& arr, const int16_t&  scalar);
+template ND4J_EXPORT NDArray operator/(NDArray&& arr, const int8_t&   scalar);
+template ND4J_EXPORT NDArray operator/(NDArray&& arr, const uint8_t&  scalar);
+template ND4J_EXPORT NDArray operator/(NDArray&& arr, const bool&     scalar);
+
 ////////////////////////////////////////////////////////////////////////
 void NDArray::operator+=(const NDArray& other) {
     if (isS())
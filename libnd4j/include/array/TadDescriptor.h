@@ -29,6 +29,11 @@ namespace nd4j {
         ShapeDescriptor _originalShape;
 
         std::vector<int> _axis;
+
+        // hash is computed once, so cache lookups don't have to walk shape & axis
+        Nd4jLong _hash = 0;
+
+        void computeHash();
     public:
         explicit TadDescriptor(const Nd4jLong *originalShape, const int *dimensions, const int length);
         explicit TadDescriptor(const ShapeDescriptor &descriptor, const std::vector<int> &dimensions);
@@ -49,6 +54,8 @@ namespace nd4j {
 
         std::vector<int>& axis();
         ShapeDescriptor& originalShape();
+
+        Nd4jLong hash() const;
     };
 }
 
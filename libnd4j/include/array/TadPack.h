@@ -22,6 +22,7 @@
 #define DEV_TESTS_TADPACK_H
 
 #include "DataBuffer.h"
+#include <memory>
 
 namespace nd4j {
     class ND4J_EXPORT TadPack {
@@ -29,8 +30,12 @@ namespace nd4j {
         DataBuffer _tadShape;
         DataBuffer _tadOffsets;
         Nd4jLong _numTads;
+
+        // optional owner of underlying buffers: they are released once the last copy of this pack is gone
+        std::shared_ptr<void> _owner;
     public:
         explicit TadPack(DataBuffer &shapes, DataBuffer &offets, Nd4jLong numTads);
+        explicit TadPack(DataBuffer &shapes, DataBuffer &offets, Nd4jLong numTads, const std::shared_ptr<void> &owner);
         TadPack() = default;
         ~TadPack() = default;
 
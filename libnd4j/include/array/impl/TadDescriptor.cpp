@@ -26,6 +26,7 @@ namespace nd4j {
     TadDescriptor::TadDescriptor(const TadDescriptor &other) {
         _originalShape = other._originalShape;
         _axis = other._axis;
+        _hash = other._hash;
     }
 
     TadDescriptor::TadDescriptor(const Nd4jLong *originalShape, const int *dimensions, const int length) {
@@ -39,6 +40,8 @@ namespace nd4j {
             std::sort(_axis.begin(), _axis.end());
 
         _originalShape = descriptor;
+
+        computeHash();
     }
 
     TadDescriptor::TadDescriptor(const ShapeDescriptor &descriptor, const std::vector<int> &dimensions) {
@@ -47,9 +50,38 @@ namespace nd4j {
 
         if (_axis.size() > 1)
             std::sort(_axis.begin(), _axis.end());
+
+        computeHash();
+    }
+
+    void TadDescriptor::computeHash() {
+        auto combine = [](uint64_t h, uint64_t v) -> uint64_t {
+            return h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+        };
+
+        uint64_t h = 0;
+        h = combine(h, static_cast<uint64_t>(_originalShape.rank()));
+        h = combine(h, static_cast<uint64_t>(_originalShape.order()));
+        h = combine(h, static_cast<uint64_t>(_originalShape.dataType()));
+        h = combine(h, static_cast<uint64_t>(_originalShape.ews()));
+        h = combine(h, static_cast<uint64_t>(_originalShape.isEmpty()));
+
+        for (auto v: _originalShape.shape())
+            h = combine(h, static_cast<uint64_t>(v));
+
+        for (auto v: _originalShape.strides())
+            h = combine(h, static_cast<uint64_t>(v));
+
+        for (auto v: _axis)
+            h = combine(h, static_cast<uint64_t>(v));
+
+        _hash = static_cast<Nd4jLong>(h);
     }
 
     bool TadDescriptor::operator==(const TadDescriptor &other) const {
+        if (_hash != other._hash)
+            return false;
+
         return std::tie(_originalShape, _axis) == std::tie(other._originalShape, other._axis);
     }
 
@@ -65,4 +97,8 @@ namespace nd4j {
     ShapeDescriptor& TadDescriptor::originalShape() {
         return _originalShape;
     }
+
+    Nd4jLong TadDescriptor::hash() const {
+        return _hash;
+    }
 }
\ No newline at end of file
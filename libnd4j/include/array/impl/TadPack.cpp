@@ -27,6 +27,10 @@ namespace nd4j {
         _numTads = numTads;
     }
 
+    TadPack::TadPack(DataBuffer &shapes, DataBuffer &offets, Nd4jLong numTads, const std::shared_ptr<void> &owner) : TadPack(shapes, offets, numTads) {
+        _owner = owner;
+    }
+
     Nd4jLong* TadPack::primaryShapeInfo() {
         return reinterpret_cast<Nd4jLong *>(_tadShape.primary());
     }
@@ -20,8 +20,309 @@
 
 #include <pointercast.h>
 #include <stdexcept>
+#include <exception>
+#include <cstdint>
+#include <mutex>
+#include <config.h>
 #include"cnpy.h"
 
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+
+namespace cnpy {
+    // zip structures are little endian and not aligned
+    static FORCEINLINE uint16_t readU16(const char *ptr) {
+        uint16_t result;
+        memcpy(&result, ptr, sizeof(result));
+        return result;
+    }
+
+    static FORCEINLINE uint32_t readU32(const char *ptr) {
+        uint32_t result;
+        memcpy(&result, ptr, sizeof(result));
+        return result;
+    }
+
+    static FORCEINLINE uint64_t readU64(const char *ptr) {
+        uint64_t result;
+        memcpy(&result, ptr, sizeof(result));
+        return result;
+    }
+
+    static void seekTo(FILE *fp, Nd4jLong offset, int origin) {
+#if defined(_WIN32) || defined(_WIN64)
+        auto status = _fseeki64(fp, offset, origin);
+#else
+        auto status = fseeko(fp, (off_t) offset, origin);
+#endif
+        if (status != 0)
+            throw std::runtime_error("npz_load: failed fseek");
+    }
+
+    static Nd4jLong sizeOfFile(FILE *fp) {
+        seekTo(fp, 0, SEEK_END);
+#if defined(_WIN32) || defined(_WIN64)
+        return (Nd4jLong) _ftelli64(fp);
+#else
+        return (Nd4jLong) ftello(fp);
+#endif
+    }
+
+    static void readAt(FILE *fp, Nd4jLong offset, char *buffer, Nd4jLong numBytes) {
+        seekTo(fp, offset, SEEK_SET);
+        if (fread(buffer, 1, (size_t) numBytes, fp) != (size_t) numBytes)
+            throw std::runtime_error("npz_load: failed fread");
+    }
+
+    static Nd4jLong dataLength(const NpyArray &arr) {
+        Nd4jLong length = arr.wordSize;
+        for (auto v: arr.shape)
+            length *= v;
+
+        return length;
+    }
+
+    /**
+     * This method reads magic string, version and header dictionary of .npy content. Bytes are fetched via given function,
+     * so the same code serves files, mapped memory and deflated streams.
+     */
+    template <typename F>
+    static void readNpyHeader(F fetch, NpyArray &arr) {
+        char preamble[12];
+        if (fetch(preamble, 10) != 10 || memcmp(preamble, "\x93NUMPY", 6) != 0)
+            throw std::runtime_error("npy: magic string wasn't found");
+
+        // version 1.0 has 2 bytes for header length, 2.0 and 3.0 have 4 bytes
+        Nd4jLong headerLength = readU16(preamble + 8);
+        if (preamble[6] > 1) {
+            if (fetch(preamble + 10, 2) != 2)
+                throw std::runtime_error("npy: header is truncated");
+
+            headerLength = readU32(preamble + 8);
+        }
+
+        std::string header(headerLength, ' ');
+        if (fetch(&header[0], headerLength) != headerLength)
+            throw std::runtime_error("npy: header is truncated");
+
+        unsigned int *shape = nullptr;
+        unsigned int ndims = 0;
+        parseNpyHeaderStr(header, arr.wordSize, shape, ndims, arr.fortranOrder);
+        arr.shape = std::vector<unsigned int>(shape, shape + ndims);
+        delete[] shape;
+    }
+
+    /**
+     * This method returns array stored in given part of mapped file. Data isn't copied unless it's misaligned
+     */
+    static NpyArray mapArray(const std::shared_ptr<nd4j::graph::MappedFile> &file, const char *base, Nd4jLong size) {
+        Nd4jLong cursor = 0;
+        auto fetch = [&](char *buffer, Nd4jLong numBytes) -> Nd4jLong {
+            auto cnt = std::min<Nd4jLong>(numBytes, size - cursor);
+            memcpy(buffer, base + cursor, (size_t) cnt);
+            cursor += cnt;
+            return cnt;
+        };
+
+        NpyArray arr;
+        readNpyHeader(fetch, arr);
+
+        auto length = dataLength(arr);
+        if (cursor + length > size)
+            throw std::runtime_error("npy: array is truncated");
+
+        // .npy files keep data aligned, but stored .npz members can start anywhere
+        auto data = const_cast<char *>(base + cursor);
+        auto alignment = std::min<uintptr_t>(arr.wordSize > 0 ? arr.wordSize : 1, 8);
+        if (reinterpret_cast<uintptr_t>(data) % alignment == 0) {
+            arr.data = data;
+            arr.owner = file;
+        } else {
+            arr.data = new char[length];
+            memcpy(arr.data, data, (size_t) length);
+        }
+
+        return arr;
+    }
+
+    /**
+     * This method parses zip central directory, including zip64 extensions numpy uses for large archives
+     */
+    static void readEntries(FILE *fp, std::vector<NpzEntry> &entries) {
+        const uint32_t END_SIGNATURE = 0x06054b50;
+        const uint32_t END64_SIGNATURE = 0x06064b50;
+        const uint32_t LOCATOR64_SIGNATURE = 0x07064b50;
+        const uint32_t CENTRAL_SIGNATURE = 0x02014b50;
+        const uint32_t LOCAL_SIGNATURE = 0x04034b50;
+
+        auto fileSize = sizeOfFile(fp);
+
+        // end of central directory record is 22 bytes, optionally followed by comment of up to 64K
+        auto tailSize = std::min<Nd4jLong>(fileSize, 22 + 65535);
+        std::vector<char> tail(tailSize);
+        readAt(fp, fileSize - tailSize, tail.data(), tailSize);
+
+        Nd4jLong end = -1;
+        for (Nd4jLong e = tailSize - 22; e >= 0; e--) {
+            if (readU32(&tail[e]) == END_SIGNATURE) {
+                end = e;
+                break;
+            }
+        }
+
+        if (end < 0)
+            throw std::runtime_error("npz_load: end of central directory wasn't found");
+
+        uint64_t numEntries = readU16(&tail[end + 10]);
+        uint64_t directorySize = readU32(&tail[end + 12]);
+        uint64_t directoryOffset = readU32(&tail[end + 16]);
+
+        if (numEntries == 0xFFFF || directorySize == 0xFFFFFFFF || directoryOffset == 0xFFFFFFFF) {
+            if (end < 20 || readU32(&tail[end - 20]) != LOCATOR64_SIGNATURE)
+                throw std::runtime_error("npz_load: zip64 locator wasn't found");
+
+            char record[56];
+            readAt(fp, (Nd4jLong) readU64(&tail[end - 20 + 8]), record, 56);
+            if (readU32(record) != END64_SIGNATURE)
+                throw std::runtime_error("npz_load: zip64 end of central directory wasn't found");
+
+            numEntries = readU64(record + 32);
+            directorySize = readU64(record + 40);
+            directoryOffset = readU64(record + 48);
+        }
+
+        if (directoryOffset + directorySize > (uint64_t) fileSize)
+            throw std::runtime_error("npz_load: central directory is out of file bounds");
+
+        std::vector<char> directory(directorySize);
+        if (directorySize > 0)
+            readAt(fp, (Nd4jLong) directoryOffset, directory.data(), (Nd4jLong) directorySize);
+
+        entries.clear();
+        entries.reserve(numEntries);
+
+        Nd4jLong cursor = 0;
+        for (uint64_t e = 0; e < numEntries; e++) {
+            if (cursor + 46 > (Nd4jLong) directorySize || readU32(&directory[cursor]) != CENTRAL_SIGNATURE)
+                throw std::runtime_error("npz_load: central directory is corrupted");
+
+            auto header = &directory[cursor];
+            auto flags = readU16(header + 8);
+            auto nameLength = readU16(header + 28);
+            auto extraLength = readU16(header + 30);
+            auto commentLength = readU16(header + 32);
+
+            if (cursor + 46 + nameLength + extraLength + commentLength > (Nd4jLong) directorySize)
+                throw std::runtime_error("npz_load: central directory is corrupted");
+
+            if (flags & 0x1)
+                throw std::runtime_error("npz_load: encrypted archives aren't supported");
+
+            NpzEntry entry;
+            entry.method = readU16(header + 10);
+            uint64_t compressedSize = readU32(header + 20);
+            uint64_t uncompressedSize = readU32(header + 24);
+            uint64_t localOffset = readU32(header + 42);
+            entry.name = std::string(header + 46, nameLength);
+
+            // zip64 extra field holds only those values which didn't fit into 32 bits, in fixed order
+            auto extra = header + 46 + nameLength;
+            for (int f = 0; f + 4 <= extraLength; ) {
+                auto id = readU16(extra + f);
+                auto length = readU16(extra + f + 2);
+                if (id == 0x0001) {
+                    auto value = extra + f + 4;
+                    auto last = value + std::min<int>(length, extraLength - f - 4);
+                    if (uncompressedSize == 0xFFFFFFFF && value + 8 <= last) {
+                        uncompressedSize = readU64(value);
+                        value += 8;
+                    }
+
+                    if (compressedSize == 0xFFFFFFFF && value + 8 <= last) {
+                        compressedSize = readU64(value);
+                        value += 8;
+                    }
+
+                    if (localOffset == 0xFFFFFFFF && value + 8 <= last)
+                        localOffset = readU64(value);
+                }
+
+                f += 4 + length;
+            }
+
+            // local header may have its own extra field, so payload offset can only be found there
+            char local[30];
+            readAt(fp, (Nd4jLong) localOffset, local, 30);
+            if (readU32(local) != LOCAL_SIGNATURE)
+                throw std::runtime_error("npz_load: local header is corrupted");
+
+            entry.offset = (Nd4jLong) localOffset + 30 + readU16(local + 26) + readU16(local + 28);
+            entry.compressedSize = (Nd4jLong) compressedSize;
+            entry.uncompressedSize = (Nd4jLong) uncompressedSize;
+
+            if (entry.offset + entry.compressedSize > fileSize)
+                throw std::runtime_error("npz_load: member is out of file bounds");
+
+            //erase the lagging .npy
+            if (entry.name.size() > 4 && entry.name.compare(entry.name.size() - 4, 4, ".npy") == 0)
+                entry.name.erase(entry.name.size() - 4);
+
+            entries.emplace_back(entry);
+            cursor += 46 + nameLength + extraLength + commentLength;
+        }
+    }
+
+#ifdef HAVE_ZLIB
+    static z_stream* createInflater() {
+        auto stream = new z_stream();
+
+        // negative window bits: raw deflate data, zip has its own headers
+        if (inflateInit2(stream, -MAX_WBITS) != Z_OK) {
+            delete stream;
+            throw std::runtime_error("npz_load: inflateInit2 failed");
+        }
+
+        return stream;
+    }
+
+    static void releaseInflater(z_stream *stream) {
+        inflateEnd(stream);
+        delete stream;
+    }
+
+    /**
+     * This method inflates up to numBytes into buffer, and returns number of bytes produced.
+     * refill(stream) provides next chunk of compressed input, and returns false once input is exhausted
+     */
+    template <typename F>
+    static Nd4jLong inflateBytes(z_stream *stream, char *buffer, Nd4jLong numBytes, F refill) {
+        Nd4jLong produced = 0;
+        while (produced < numBytes) {
+            if (stream->avail_in == 0 && !refill(stream))
+                break;
+
+            // avail_out is 32 bit wide
+            auto chunk = std::min<Nd4jLong>(numBytes - produced, 1L << 30);
+            stream->next_out = reinterpret_cast<Bytef *>(buffer + produced);
+            stream->avail_out = (uInt) chunk;
+
+            auto status = inflate(stream, Z_NO_FLUSH);
+            produced += chunk - stream->avail_out;
+
+            if (status == Z_STREAM_END)
+                break;
+
+            if (status != Z_OK)
+                throw std::runtime_error("npz_load: deflate stream is corrupted");
+        }
+
+        return produced;
+    }
+#endif
+}
+
 
 
 /**
@@ -305,12 +606,9 @@ cnpy::NpyArray cnpy::loadNpyFromHeader(char *data) {
     unsigned int *shape;
     unsigned int ndims, wordSize;
     bool fortranOrder;
-    cnpy::parseNpyHeaderStr(std::string(data),
-                            wordSize,
-                            shape,
-                            ndims,
-                            fortranOrder);
+
     //the "real" data starts after the \n
+    char *header = data;
     char currChar = data[0];
     int count = 0;
     while(currChar != '\n') {
@@ -319,6 +617,13 @@ cnpy::NpyArray cnpy::loadNpyFromHeader(char *data) {
         count++;
     }
 
+    //only header is parsed, data may be neither copied nor null terminated
+    cnpy::parseNpyHeaderStr(std::string(header, count),
+                            wordSize,
+                            shape,
+                            ndims,
+                            fortranOrder);
+
     //move pass the \n
     data++;
     count++;
@@ -383,116 +688,355 @@ cnpy::npz_t cnpy::npzLoad(FILE* fp){
  * @return the arrays
  */
 cnpy::npz_t cnpy::npzLoad(std::string fname) {
-    FILE* fp = fopen(fname.c_str(),"rb");
+    return cnpy::NpzIndex(fname).loadAll();
+}
 
-    if(!fp) printf("npz_load: Error! Unable to open file %s!\n",fname.c_str());
-    assert(fp);
-    cnpy::npz_t arrays;
-    while(1) {
-        std::vector<char> local_header(30);
-        size_t headerres = fread(&local_header[0],sizeof(char),30,fp);
-        if(headerres != 30)
-            throw std::runtime_error("npz_load: failed fread");
+/**
+ * Loads a npz (multiple numpy arrays) file
+ * @param fname the file name
+ * @param varname
+ * @return
+ */
+cnpy::NpyArray cnpy::npzLoad(std::string fname, std::string varname) {
+    return cnpy::NpzIndex(fname).load(varname);
+}
 
-        //if we've reached the global header, stop reading
-        if(local_header[2] != 0x03 || local_header[3] != 0x04) break;
 
-        //read in the variable name
-        unsigned short name_len = *(unsigned short*) &local_header[26];
-        std::string varname(name_len,' ');
-        size_t vname_res = fread(&varname[0],sizeof(char),name_len,fp);
-        if(vname_res != name_len)
-            throw std::runtime_error("npz_load: failed fread");
 
-        //erase the lagging .npy
-        varname.erase(varname.end() - 4,varname.end());
 
-        //read in the extra field
-        unsigned short extra_field_len = *(unsigned short*) &local_header[28];
-        if(extra_field_len > 0) {
-            std::vector<char> buff(extra_field_len);
-            size_t efield_res = fread(&buff[0],sizeof(char),extra_field_len,fp);
-            if(efield_res != extra_field_len)
-                throw std::runtime_error("npz_load: failed fread");
+/**
+ * Load a numpy array from the given file
+ * @param fname the fully qualified path for the file
+ * @return the NpArray for this file
+ */
+cnpy::NpyArray cnpy::npyLoad(std::string fname) {
+    auto file = std::make_shared<nd4j::graph::MappedFile>(fname.c_str());
+    return cnpy::mapArray(file, reinterpret_cast<const char *>(file->data()), file->size());
+}
+
+
+/**
+ * Files mapped with mapFile(), by address of the first byte
+ */
+static std::mutex& mappedFilesLock() {
+    static std::mutex lock;
+    return lock;
+}
+
+static std::map<char*, std::shared_ptr<nd4j::graph::MappedFile>>& mappedFiles() {
+    static std::map<char*, std::shared_ptr<nd4j::graph::MappedFile>> files;
+    return files;
+}
+
+char* cnpy::mapFile(const char *path) {
+    auto file = std::make_shared<nd4j::graph::MappedFile>(path);
+    auto data = reinterpret_cast<char *>(file->data());
+
+    std::lock_guard<std::mutex> lock(mappedFilesLock());
+    mappedFiles()[data] = file;
+
+    return data;
+}
+
+void cnpy::releaseFile(char *data) {
+    {
+        std::lock_guard<std::mutex> lock(mappedFilesLock());
+        auto it = mappedFiles().find(data);
+        if (it != mappedFiles().end()) {
+            mappedFiles().erase(it);
+            return;
         }
+    }
 
-        arrays[varname] = loadNpyFromFile(fp);
+    // buffer came from loadFile()
+    free(data);
+}
+
+
+cnpy::NpzIndex::NpzIndex(const std::string &fname) {
+    FILE *fp = fopen(fname.c_str(), "rb");
+    if (fp == nullptr) {
+        printf("npz_load: Error! Unable to open file %s!\n", fname.c_str());
+        throw std::runtime_error("npz_load: unable to open file");
+    }
+
+    try {
+        readEntries(fp, _entries);
+    } catch (...) {
+        fclose(fp);
+        throw;
     }
     fclose(fp);
-    return arrays;
 
+    for (int e = 0; e < (int) _entries.size(); e++)
+        _positions[_entries[e].name] = e;
+
+    _file = std::make_shared<nd4j::graph::MappedFile>(fname.c_str());
 }
 
-/**
- * Loads a npz (multiple numpy arrays) file
- * @param fname the file name
- * @param varname
- * @return
- */
-cnpy::NpyArray cnpy::npzLoad(std::string fname, std::string varname) {
-    FILE *fp = fopen(fname.c_str(),"rb");
+const std::vector<cnpy::NpzEntry>& cnpy::NpzIndex::entries() const {
+    return _entries;
+}
+
+bool cnpy::NpzIndex::hasEntry(const std::string &name) const {
+    return _positions.count(name) > 0;
+}
 
-    if(!fp) {
-        printf("npz_load: Error! Unable to open file %s!\n",fname.c_str());
+const cnpy::NpzEntry& cnpy::NpzIndex::entry(const std::string &name) const {
+    auto it = _positions.find(name);
+    if (it == _positions.end()) {
+        printf("npz_load: Error! Variable name %s not found!\n", name.c_str());
+        throw std::runtime_error("Variable wasn't found in file");
     }
 
-    while(1) {
-        std::vector<char> local_header(30);
-        size_t header_res = fread(&local_header[0],sizeof(char),30,fp);
-        if(header_res != 30)
-            throw std::runtime_error("npz_load: failed fread");
+    return _entries[it->second];
+}
 
-        //if we've reached the global header, stop reading
-        if(local_header[2] != 0x03 || local_header[3] != 0x04) break;
+cnpy::NpyArray cnpy::NpzIndex::loadEntry(const NpzEntry &entry) const {
+    auto base = reinterpret_cast<const char *>(_file->data()) + entry.offset;
+
+    if (entry.method == 0)
+        return mapArray(_file, base, entry.compressedSize);
+
+    if (entry.method != 8)
+        throw std::runtime_error("npz_load: unsupported compression method");
+
+#ifdef HAVE_ZLIB
+    Nd4jLong left = entry.compressedSize;
+    auto refill = [&](z_stream *stream) -> bool {
+        if (left == 0)
+            return false;
+
+        // avail_in is 32 bit wide
+        auto chunk = std::min<Nd4jLong>(left, 1L << 30);
+        stream->next_in = reinterpret_cast<Bytef *>(const_cast<char *>(base));
+        stream->avail_in = (uInt) chunk;
+        base += chunk;
+        left -= chunk;
+        return true;
+    };
+
+    auto stream = createInflater();
+    auto fetch = [&](char *buffer, Nd4jLong numBytes) -> Nd4jLong {
+        return inflateBytes(stream, buffer, numBytes, refill);
+    };
+
+    NpyArray arr;
+    arr.data = nullptr;
+    try {
+        readNpyHeader(fetch, arr);
+
+        // data is inflated straight into its final buffer
+        auto length = dataLength(arr);
+        arr.data = new char[length];
+        if (fetch(arr.data, length) != length)
+            throw std::runtime_error("npz_load: member is truncated");
+    } catch (...) {
+        delete[] arr.data;
+        releaseInflater(stream);
+        throw;
+    }
 
-        //read in the variable name
-        unsigned short name_len = *(unsigned short*) &local_header[26];
-        std::string vname(name_len,' ');
-        size_t vname_res = fread(&vname[0],sizeof(char),name_len,fp);
-        if(vname_res != name_len)
-            throw std::runtime_error("npz_load: failed fread");
-        vname.erase(vname.end()-4,vname.end()); //erase the lagging .npy
+    releaseInflater(stream);
+    return arr;
+#else
+    throw std::runtime_error("npz_load: deflated members require libnd4j built with zlib");
+#endif
+}
 
-        //read in the extra field
-        unsigned short extra_field_len = *(unsigned short*) &local_header[28];
-        fseek(fp,extra_field_len,SEEK_CUR); //skip past the extra field
+cnpy::NpyArray cnpy::NpzIndex::load(const std::string &name) const {
+    return loadEntry(entry(name));
+}
 
-        if(vname == varname) {
-            NpyArray array = cnpy::loadNpyFromFile(fp);
-            fclose(fp);
-            return array;
-        }
-        else {
-            //skip past the data
-            unsigned int size = *(unsigned int*) &local_header[22];
-            fseek(fp,size,SEEK_CUR);
+cnpy::npz_t cnpy::NpzIndex::loadAll() const {
+    const int numEntries = (int) _entries.size();
+    std::vector<NpyArray> arrays(numEntries);
+    std::vector<std::exception_ptr> errors(numEntries);
+
+    // stored members are just mapped, so threads are worth it only for deflated ones
+    int numDeflated = 0;
+    for (const auto &e: _entries)
+        if (e.method != 0)
+            numDeflated++;
+
+    PRAGMA_OMP_PARALLEL_FOR_ARGS(if(numDeflated > 1) schedule(dynamic, 1))
+    for (int e = 0; e < numEntries; e++) {
+        try {
+            arrays[e] = loadEntry(_entries[e]);
+        } catch (...) {
+            errors[e] = std::current_exception();
         }
     }
 
+    for (int e = 0; e < numEntries; e++) {
+        if (errors[e] == nullptr)
+            continue;
+
+        for (int i = 0; i < numEntries; i++)
+            if (errors[i] == nullptr)
+                arrays[i].destruct();
+
+        std::rethrow_exception(errors[e]);
+    }
+
+    npz_t result;
+    for (int e = 0; e < numEntries; e++)
+        result[_entries[e].name] = arrays[e];
+
+    return result;
+}
+
+
+cnpy::NpyStream::NpyStream(const std::string &fname) {
+    open(fname, 0, 0, -1);
+}
+
+cnpy::NpyStream::NpyStream(const std::string &fname, const std::string &varname) {
+    FILE *fp = fopen(fname.c_str(), "rb");
+    if (fp == nullptr) {
+        printf("npz_load: Error! Unable to open file %s!\n", fname.c_str());
+        throw std::runtime_error("npz_load: unable to open file");
+    }
+
+    std::vector<NpzEntry> entries;
+    try {
+        readEntries(fp, entries);
+    } catch (...) {
+        fclose(fp);
+        throw;
+    }
     fclose(fp);
-    printf("npz_load: Error! Variable name %s not found in %s!\n",varname.c_str(),fname.c_str());
+
+    for (const auto &e: entries) {
+        if (e.name == varname) {
+            open(fname, e.method, e.offset, e.compressedSize);
+            return;
+        }
+    }
+
+    printf("npz_load: Error! Variable name %s not found in %s!\n", varname.c_str(), fname.c_str());
     throw std::runtime_error("Variable wasn't found in file");
 }
 
+cnpy::NpyStream::~NpyStream() {
+    close();
+}
 
+void cnpy::NpyStream::open(const std::string &fname, unsigned short method, Nd4jLong offset, Nd4jLong size) {
+    if (method != 0 && method != 8)
+        throw std::runtime_error("npz_load: unsupported compression method");
 
+#ifndef HAVE_ZLIB
+    if (method == 8)
+        throw std::runtime_error("npz_load: deflated members require libnd4j built with zlib");
+#endif
 
-/**
- * Load a numpy array from the given file
- * @param fname the fully qualified path for the file
- * @return the NpArray for this file
- */
-cnpy::NpyArray cnpy::npyLoad(std::string fname) {
-    FILE* fp = fopen(fname.c_str(), "rb");
+    _fp = fopen(fname.c_str(), "rb");
+    if (_fp == nullptr) {
+        printf("npy_load: Error! Unable to open file %s!\n", fname.c_str());
+        throw std::runtime_error("npy_load: unable to open file");
+    }
+
+    try {
+        // negative size means "up to the end of file"
+        _available = size >= 0 ? size : sizeOfFile(_fp) - offset;
+        seekTo(_fp, offset, SEEK_SET);
 
-    if(!fp) {
-        printf("npy_load: Error! Unable to open file %s!\n",fname.c_str());
+        _method = method;
+#ifdef HAVE_ZLIB
+        if (method == 8) {
+            _inflater = createInflater();
+            _input.resize(1024 * 1024);
+        }
+#endif
+
+        NpyArray arr;
+        readNpyHeader([&](char *buffer, Nd4jLong numBytes) -> Nd4jLong { return readBytes(buffer, numBytes); }, arr);
+
+        _shape = arr.shape;
+        _wordSize = arr.wordSize;
+        _fortranOrder = arr.fortranOrder;
+        _length = 1;
+        for (auto v: _shape)
+            _length *= v;
+    } catch (...) {
+        close();
+        throw;
     }
+}
 
-    NpyArray arr = cnpy::loadNpyFromFile(fp);
+void cnpy::NpyStream::close() {
+#ifdef HAVE_ZLIB
+    if (_inflater != nullptr)
+        releaseInflater(reinterpret_cast<z_stream *>(_inflater));
+#endif
+    _inflater = nullptr;
 
-    fclose(fp);
-    return arr;
+    if (_fp != nullptr)
+        fclose(_fp);
+
+    _fp = nullptr;
+}
+
+Nd4jLong cnpy::NpyStream::readBytes(char *buffer, Nd4jLong numBytes) {
+    if (_method == 0) {
+        auto cnt = (Nd4jLong) fread(buffer, 1, (size_t) std::min<Nd4jLong>(numBytes, _available), _fp);
+        _available -= cnt;
+        return cnt;
+    }
+
+#ifdef HAVE_ZLIB
+    auto refill = [&](z_stream *stream) -> bool {
+        if (_available == 0)
+            return false;
+
+        auto cnt = (Nd4jLong) fread(_input.data(), 1, (size_t) std::min<Nd4jLong>(_available, _input.size()), _fp);
+        if (cnt == 0)
+            return false;
+
+        stream->next_in = reinterpret_cast<Bytef *>(_input.data());
+        stream->avail_in = (uInt) cnt;
+        _available -= cnt;
+        return true;
+    };
+
+    return inflateBytes(reinterpret_cast<z_stream *>(_inflater), buffer, numBytes, refill);
+#else
+    return 0;
+#endif
+}
+
+const std::vector<unsigned int>& cnpy::NpyStream::shape() const {
+    return _shape;
+}
+
+unsigned int cnpy::NpyStream::wordSize() const {
+    return _wordSize;
+}
+
+bool cnpy::NpyStream::fortranOrder() const {
+    return _fortranOrder;
+}
+
+Nd4jLong cnpy::NpyStream::lengthOf() const {
+    return _length;
+}
+
+Nd4jLong cnpy::NpyStream::position() const {
+    return _position;
+}
+
+Nd4jLong cnpy::NpyStream::read(void *buffer, Nd4jLong numElements) {
+    auto count = std::min<Nd4jLong>(numElements, _length - _position);
+    if (count <= 0)
+        return 0;
+
+    auto numBytes = count * _wordSize;
+    if (readBytes(reinterpret_cast<char *>(buffer), numBytes) != numBytes)
+        throw std::runtime_error("npy_load: array is truncated");
+
+    _position += count;
+    return count;
 }
 
 
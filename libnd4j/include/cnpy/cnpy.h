@@ -41,8 +41,10 @@
 #include <string>
 #include <fstream>
 #include <streambuf>
+#include <memory>
 #include <op_boilerplate.h>
 #include <dll.h>
+#include <graph/MappedFile.h>
 
 
 
@@ -56,8 +58,15 @@ namespace cnpy {
         std::vector<unsigned int> shape;
         unsigned int wordSize;
         bool fortranOrder;
+
+        // set if data belongs to something else, i.e. memory mapped file. Shared by all arrays pointing into it
+        std::shared_ptr<void> owner;
+
         void destruct() {
-            delete[] data;
+            if (owner == nullptr)
+                delete[] data;
+
+            owner.reset();
         }
     };
 
@@ -227,6 +236,121 @@ namespace cnpy {
 
     ND4J_EXPORT npz_t npzLoad(std::string fname);
 
+    /**
+     * This method maps whole file into memory, as zero copy alternative to loadFile()
+     * Returned pointer must be released with releaseFile()
+     *
+     * @param path
+     * @return
+     */
+    ND4J_EXPORT char* mapFile(const char *path);
+
+    /**
+     * This method releases buffer obtained from mapFile() or loadFile()
+     *
+     * @param data
+     */
+    ND4J_EXPORT void releaseFile(char *data);
+
+    /**
+     * Single member of .npz archive, as described by zip central directory
+     */
+    struct ND4J_EXPORT NpzEntry {
+        // member name without trailing .npy
+        std::string name;
+
+        // 0 for stored members, 8 for deflated ones
+        unsigned short method;
+
+        // offset of member payload within archive, local header excluded
+        Nd4jLong offset;
+
+        Nd4jLong compressedSize;
+        Nd4jLong uncompressedSize;
+    };
+
+    /**
+     * This class maps .npz archive and parses its central directory once, so members can be fetched by name without rescanning.
+     * Stored members are returned without copy, pointing into the mapping. Deflated members are decompressed into heap,
+     * in parallel when several members are requested at once.
+     */
+    class ND4J_EXPORT NpzIndex {
+    protected:
+        std::shared_ptr<nd4j::graph::MappedFile> _file;
+        std::vector<NpzEntry> _entries;
+        std::map<std::string, int> _positions;
+
+        NpyArray loadEntry(const NpzEntry &entry) const;
+
+    public:
+        explicit NpzIndex(const std::string &fname);
+
+        const std::vector<NpzEntry>& entries() const;
+
+        bool hasEntry(const std::string &name) const;
+
+        /**
+         * This method returns entry with given name, or throws if there's no such member in archive
+         */
+        const NpzEntry& entry(const std::string &name) const;
+
+        NpyArray load(const std::string &name) const;
+
+        npz_t loadAll() const;
+    };
+
+    /**
+     * This class reads array from .npy file or .npz member sequentially, chunk by chunk, so arrays larger than RAM can be processed.
+     * Deflated members are decompressed on the fly.
+     */
+    class ND4J_EXPORT NpyStream {
+    protected:
+        FILE *_fp = nullptr;
+        unsigned short _method = 0;
+
+        // payload bytes still in the file, compressed ones for deflated members
+        Nd4jLong _available = 0;
+
+        // z_stream, opaque here so zlib stays out of this header
+        void *_inflater = nullptr;
+        std::vector<char> _input;
+
+        std::vector<unsigned int> _shape;
+        unsigned int _wordSize = 0;
+        bool _fortranOrder = false;
+        Nd4jLong _length = 0;
+        Nd4jLong _position = 0;
+
+        void open(const std::string &fname, unsigned short method, Nd4jLong offset, Nd4jLong size);
+        void close();
+        Nd4jLong readBytes(char *buffer, Nd4jLong numBytes);
+
+    public:
+        explicit NpyStream(const std::string &fname);
+        NpyStream(const std::string &fname, const std::string &varname);
+        ~NpyStream();
+
+        NpyStream(const NpyStream &other) = delete;
+        NpyStream& operator=(const NpyStream &other) = delete;
+
+        const std::vector<unsigned int>& shape() const;
+        unsigned int wordSize() const;
+        bool fortranOrder() const;
+        Nd4jLong lengthOf() const;
+
+        // number of elements read so far
+        Nd4jLong position() const;
+
+        /**
+         * This method reads up to numElements next elements into buffer
+         *
+         * @param buffer
+         * @param numElements
+         * @return number of elements actually read, 0 once whole array was read
+         */
+        Nd4jLong read(void *buffer, Nd4jLong numElements);
+    };
+
 /**
 * Parse the numpy header from
 * the given file
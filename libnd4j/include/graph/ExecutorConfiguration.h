@@ -37,6 +37,12 @@ namespace nd4j {
             Nd4jLong _footprintBackward = 0L;
             Direction _direction = Direction_FORWARD_ONLY;
 
+            // max number of node executions within single graph run, 0 means no limit
+            Nd4jLong _maxSteps = 0L;
+
+            // max number of iterations for any single loop frame, 0 means no limit
+            Nd4jLong _maxIterations = 0L;
+
             explicit ExecutorConfiguration(const nd4j::graph::FlatConfiguration *conf = nullptr);
             ~ExecutorConfiguration() = default;
             
@@ -35,7 +35,14 @@ namespace nd4j {
 
             static std::pair<Nd4jLong, Nd4jLong> fromLongPair(LongPair* pair);
 
-            static NDArray* fromFlatArray(const nd4j::graph::FlatArray* flatArray);
+            /**
+             * This method restores NDArray from FlatArray
+             *
+             * @param flatArray
+             * @param zeroCopy - if TRUE, and stored buffer has host byte order and proper alignment, array will point
+             *                   directly into FlatBuffers storage instead of copy. Storage must outlive such array then
+             */
+            static NDArray* fromFlatArray(const nd4j::graph::FlatArray* flatArray, bool zeroCopy = false);
         };
     }
 }
@@ -25,20 +25,28 @@
 #include <pointercast.h>
 #include <graph/NodeState.h>
 #include <graph/FrameState.h>
+#include <graph/execution/FrameSchedule.h>
 #include <graph/profiling/GraphProfile.h>
 #include <dll.h>
 
 namespace nd4j {
     namespace graph {
+        class MemoryArena;
+
         class ND4J_EXPORT FlowPath {
         private:
             std::map<int, NodeState> _states;
             std::map<Nd4jLong, FrameState> _frames;
 
+            // loop schedules outlive frames: nested frames are registered and forgotten on each iteration of outer loop
+            std::map<Nd4jLong, FrameSchedule> _schedules;
+
             void ensureNode(int nodeId);
             void ensureFrame(int nodeId);
 
             GraphProfile _profile;
+
+            MemoryArena* _arena = nullptr;
         public:
             FlowPath() = default;
             ~FlowPath() = default;
@@ -76,7 +84,19 @@ namespace nd4j {
             void incrementNumberOfCycles(Nd4jLong frameId);
             Nd4jLong getNumberOfCycles(Nd4jLong frameId);
 
+            /**
+             * These methods provide access to loop schedule of the given frame. nullptr is returned if schedule wasn't built yet
+             */
+            FrameSchedule* frameSchedule(Nd4jLong frameId);
+            void setFrameSchedule(Nd4jLong frameId, const FrameSchedule &schedule);
+
             GraphProfile* profile();
+
+            /**
+             * This method attaches MemoryArena, which will be used for node outputs during current run
+             */
+            void setMemoryArena(MemoryArena* arena);
+            MemoryArena* memoryArena();
         };
     }
 }
@@ -34,6 +34,8 @@
 #include <graph/generated/graph_generated.h>
 #include <graph/generated/config_generated.h>
 #include <graph/ExecutorConfiguration.h>
+#include <graph/MappedFile.h>
+#include <memory>
 #include <ops/declarable/OpDescriptor.h>
 
 namespace nd4j {
@@ -45,6 +47,9 @@ namespace nd4j {
             VariableSpace *_variableSpace;
             Stash* _stash;
 
+            // file this graph was imported from, weights may point directly into it
+            std::shared_ptr<MappedFile> _storage;
+
             // this list holds references to Node ptrs, which should be free'd in Graph destructor
             std::vector<Node*> _handles;
 
@@ -80,7 +85,12 @@ namespace nd4j {
             void prepareOutputs();
 
         public:
-            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr);
+            /**
+             * @param flatGraph
+             * @param variableSpace
+             * @param storage - memory holding flatGraph. If provided, weights are restored without copy where it's possible, and storage is kept alive by this Graph
+             */
+            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr, const std::shared_ptr<MappedFile> &storage = nullptr);
 
             ~Graph();
 
@@ -112,6 +122,11 @@ namespace nd4j {
              */
             nd4j::graph::VariableSpace *getVariableSpace();
 
+            /**
+             * This method returns memory this graph was imported from, or nullptr if weights were copied
+             */
+            std::shared_ptr<MappedFile> getStorage();
+
             /**
              * This method adds given node to the graph
              *
@@ -134,9 +149,11 @@ namespace nd4j {
 
             /**
              * This method returns outputs of this graph
+             *
+             * @param variableSpace - optional VariableSpace to fetch outputs from, i.e. per-request VariableProxy. Graph's own VariableSpace is used if nullptr
              * @return
              */
-            std::vector<nd4j::graph::Variable*> *fetchOutputs();
+            std::vector<nd4j::graph::Variable*> *fetchOutputs(VariableSpace *variableSpace = nullptr);
 
             /**
              * This method returns pointer to ExecutorConfiguration
@@ -192,6 +209,12 @@ namespace nd4j {
              */
             Graph* cloneWithProxy();
 
+            /**
+             * This method marks Variables holding weights and constants as shared, so sessions running through VariableProxy read them in place.
+             * Slots of op outputs are never shared, even if graph was executed before, so every session gets its own copy of them
+             */
+            void markSharedVariables();
+
             /**
              * This method removes reference to VariableSpace from this Graph
              */
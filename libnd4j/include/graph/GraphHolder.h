@@ -21,21 +21,64 @@
 #include <helpers/logger.h>
 #include <pointercast.h>
 #include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
 #include <graph/Graph.h>
-#include <helpers/SimpleReadWriteLock.h>
 #include <graph/exceptions/unknown_graph_exception.h>
 
 namespace nd4j {
     namespace graph {
+        /**
+         * This class is registry of graphs served concurrently.
+         *
+         * Every registered graph is kept as the list of published versions. Readers pin version they execute, without
+         * any locking, and version is released once the last reader unpins it. Replacement publishes new version atomically:
+         * new requests pick it up immediately, while in-flight requests drain on the previous one.
+         *
+         * Optionally more than one version can be kept per graph, and requests can be split between newest and previous
+         * version (i.e. for A/B testing or canary rollouts).
+         */
         class ND4J_EXPORT GraphHolder {
+        public:
+            class ND4J_EXPORT GraphVersion {
+            private:
+                Nd4jLong _version;
+                Graph *_graph;
+
+                // graphs detached via forgetGraph() are not released by holder
+                std::atomic<bool> _owned;
+            public:
+                GraphVersion(Nd4jLong version, Graph *graph);
+                ~GraphVersion();
+
+                Nd4jLong version();
+                Graph* graph();
+                void detach();
+            };
         private:
             static GraphHolder *_INSTANCE;
-            std::map<Nd4jLong, Graph *> _graphF;
 
-            std::map<Nd4jLong, SimpleReadWriteLock> _locks;
+            // versions of each graph, newest first. published snapshots are never modified
+            typedef std::map<Nd4jLong, std::vector<std::shared_ptr<GraphVersion>>> Registry;
+            std::shared_ptr<const Registry> _registry;
+
+            // writers are serialized, readers never take this lock
+            std::mutex _mutex;
 
-            GraphHolder() = default;
+            std::atomic<int> _retainedVersions;
+            std::atomic<int> _newestShare;
+            std::atomic<Nd4jLong> _requests;
+
+            GraphHolder();
             ~GraphHolder() = default;
+
+            std::shared_ptr<const Registry> snapshot();
+            void publish(Registry *registry);
+
+            std::vector<std::shared_ptr<GraphVersion>> versionsOf(Nd4jLong graphId);
+            std::shared_ptr<Graph> pin(std::shared_ptr<GraphVersion> version);
         public:
             static GraphHolder* getInstance();
 
@@ -43,8 +86,43 @@ namespace nd4j {
             
             Graph* cloneGraph(Nd4jLong graphId);
 
+            /**
+             * This method returns current version of the graph. Returned pointer isn't pinned, so it might be released
+             * once graph is replaced or dropped. Use pinGraph() if graph is replaced concurrently
+             */
             Graph* pullGraph(Nd4jLong graphId);
 
+            /**
+             * This method returns current version of the graph, which stays alive for as long as returned pointer exists
+             */
+            std::shared_ptr<Graph> pinGraph(Nd4jLong graphId);
+
+            /**
+             * This method returns given version of the graph, if it's still kept
+             */
+            std::shared_ptr<Graph> pinGraph(Nd4jLong graphId, Nd4jLong version);
+
+            /**
+             * This method returns version of the graph for the next request: newest one, or previous one, according to share set via setNewestShare()
+             */
+            std::shared_ptr<Graph> routeGraph(Nd4jLong graphId);
+
+            /**
+             * This method returns numbers of versions kept for given graph, newest first
+             */
+            std::vector<Nd4jLong> versions(Nd4jLong graphId);
+
+            /**
+             * This method sets number of versions kept for each graph. Default value is 1
+             */
+            void setRetainedVersions(int numVersions);
+
+            /**
+             * This method sets share of requests (in percents) routed to the newest version, if there's more than one version kept.
+             * Default value is 100
+             */
+            void setNewestShare(int percent);
+
             void forgetGraph(Nd4jLong graphId);
 
             void dropGraph(Nd4jLong graphId);
@@ -57,37 +135,11 @@ namespace nd4j {
 
             flatbuffers::Offset<FlatResult> execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
 
+            /**
+             * This method publishes new version of the graph. Previous version is released once all requests using it are finished,
+             * unless it's kept due to setRetainedVersions()
+             */
             void replaceGraph(Nd4jLong graphId, Graph *graph);
-
-            /////////////////////////////
-
-            FORCEINLINE void lockWrite(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].lockWrite();
-            }
-
-            FORCEINLINE void unlockWrite(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].unlockWrite();
-            }
-
-            FORCEINLINE void lockRead(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].lockRead();
-            }
-
-            FORCEINLINE void unlockRead(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].unlockRead();
-            }
         };
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_INFERENCEBATCHER_H
+#define LIBND4J_INFERENCEBATCHER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <condition_variable>
+#include <graph/Variable.h>
+#include <graph/generated/graph_generated.h>
+#include <graph/generated/result_generated.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class implements server-side dynamic batching of inference requests for the single graph:
+         * requests arriving within given time window are concatenated along dimension 0, executed at once, and
+         * results are split back to each caller.
+         *
+         * There's no dedicated thread here: first caller that finds no active batch becomes batch leader, waits for
+         * the window to pass (or batch to be filled), and executes whole batch on behalf of other callers.
+         *
+         * If requests can't be merged (i.e. different set of inputs, or different trailing shapes), or graph outputs
+         * can't be split along dimension 0 - requests are executed one by one.
+         *
+         * PLEASE NOTE: graph must process rows along dimension 0 independently. Outputs are split back whenever their
+         * dimension 0 matches total number of merged rows, so ops mixing rows (i.e. softmax or cumsum along dimension 0,
+         * batch statistics, x^T * x) would silently return results depending on other requests.
+         */
+        class ND4J_EXPORT InferenceBatcher {
+        protected:
+            class PendingRequest {
+            public:
+                std::vector<Variable*> inputs;
+                std::vector<Variable*> outputs;
+                Nd4jLong rows = 0;
+
+                std::chrono::time_point<std::chrono::steady_clock> enqueued;
+                std::exception_ptr exception;
+                bool done = false;
+
+                explicit PendingRequest(const FlatInferenceRequest* request);
+                ~PendingRequest();
+            };
+
+            Nd4jLong _graphId;
+            int _maxBatchSize;
+            Nd4jLong _window;
+
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            std::deque<PendingRequest*> _queue;
+            bool _leaderActive = false;
+
+            // batching metrics
+            std::atomic<Nd4jLong> _numRequests;
+            std::atomic<Nd4jLong> _numBatches;
+            std::atomic<Nd4jLong> _waitTime;
+            std::atomic<int> _queueDepth;
+
+            void executeBatch(std::vector<PendingRequest*> &batch);
+
+            bool canMerge(std::vector<PendingRequest*> &batch);
+
+            /**
+             * This method executes graph with given inputs, and returns detached copies of graph outputs
+             */
+            std::vector<Variable*> executeGraph(std::vector<Variable*> &inputs);
+        public:
+            /**
+             * @param graphId - id of the graph registered in GraphHolder
+             * @param maxBatchSize - max number of requests merged together
+             * @param window - max time (in microseconds) batch leader waits for other requests
+             */
+            explicit InferenceBatcher(Nd4jLong graphId, int maxBatchSize = 32, Nd4jLong window = 1000L);
+            ~InferenceBatcher() = default;
+
+            /**
+             * This method blocks until given request is executed as part of some batch, and stores its results into builder
+             */
+            flatbuffers::Offset<FlatResult> execute(flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
+
+            /**
+             * This method returns number of requests waiting for execution at this moment
+             */
+            int queueDepth();
+
+            /**
+             * This method returns total number of requests processed
+             */
+            Nd4jLong numberOfRequests();
+
+            /**
+             * This method returns total number of graph executions (i.e. batches)
+             */
+            Nd4jLong numberOfBatches();
+
+            /**
+             * This method returns average number of requests per graph execution
+             */
+            double averageBatchSize();
+
+            /**
+             * This method returns average time (in microseconds) request spent in queue before execution
+             */
+            double averageWaitTime();
+        };
+    }
+}
+
+#endif //LIBND4J_INFERENCEBATCHER_H
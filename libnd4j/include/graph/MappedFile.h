@@ -0,0 +1,58 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_MAPPEDFILE_H
+#define LIBND4J_MAPPEDFILE_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <cstdint>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class holds content of the file: private copy-on-write memory mapping where it's available, heap copy otherwise.
+         * Arrays restored from FlatBuffers with zero copy point directly into this memory, so it must outlive them.
+         */
+        class ND4J_EXPORT MappedFile {
+        protected:
+            uint8_t *_data = nullptr;
+            Nd4jLong _size = 0;
+            bool _mapped = false;
+
+        public:
+            explicit MappedFile(const char *filename);
+            ~MappedFile();
+
+            MappedFile(const MappedFile &other) = delete;
+            MappedFile& operator=(const MappedFile &other) = delete;
+
+            uint8_t* data() const;
+            Nd4jLong size() const;
+
+            /**
+             * This method returns TRUE if file content is backed by page cache, and FALSE if it was read into heap
+             */
+            bool isMapped() const;
+        };
+    }
+}
+
+#endif //LIBND4J_MAPPEDFILE_H
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_MEMORYARENA_H
+#define LIBND4J_MEMORYARENA_H
+
+#include <vector>
+#include <mutex>
+#include <NDArray.h>
+#include <memory/Workspace.h>
+#include <graph/MemoryPlan.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class serves node outputs during single graph run:
+         * - if MemoryPlan is available, outputs are placed into the arena at planned offsets
+         * - otherwise outputs are allocated as usual, and each allocation is recorded, so plan can be built after the run
+         */
+        class ND4J_EXPORT MemoryArena {
+        public:
+            class Allocation {
+            public:
+                int nodeId = 0;
+                int index = 0;
+                int8_t* buffer = nullptr;
+                Nd4jLong bytes = 0L;
+            };
+        protected:
+            MemoryPlan* _plan = nullptr;
+            nd4j::memory::Workspace* _workspace = nullptr;
+
+            // arena is reserved on first planned allocation, so runs that allocate nothing don't waste workspace
+            int8_t* _base = nullptr;
+            std::once_flag _reserved;
+
+            std::vector<Allocation> _allocations;
+            std::mutex _mutex;
+        public:
+            /**
+             * This constructor creates recording arena
+             */
+            MemoryArena() = default;
+
+            /**
+             * This constructor creates arena for given plan within given workspace
+             */
+            MemoryArena(MemoryPlan* plan, nd4j::memory::Workspace* workspace);
+            ~MemoryArena() = default;
+
+            /**
+             * This method creates output array for given node output, zero-filled, as DeclarableOp::prepareOutputs expects
+             */
+            NDArray* allocate(int nodeId, int index, Nd4jLong* shapeInfo, nd4j::memory::Workspace* workspace);
+
+            bool isRecording();
+            MemoryPlan* plan();
+
+            /**
+             * This method returns allocations recorded so far
+             */
+            std::vector<Allocation>& allocations();
+
+            /**
+             * This method returns total number of bytes recorded so far
+             */
+            Nd4jLong recordedBytes();
+        };
+    }
+}
+
+#endif //LIBND4J_MEMORYARENA_H
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_MEMORYPLAN_H
+#define LIBND4J_MEMORYPLAN_H
+
+#include <map>
+#include <atomic>
+#include <utility>
+#include <pointercast.h>
+#include <dll.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class holds static memory layout for node outputs of the single graph, computed for the specific set of input shapes:
+         * each output gets its own offset within single arena, and outputs with non-overlapping lifetimes share memory.
+         *
+         * Plan is immutable once built, so it can be used by any number of concurrent sessions.
+         */
+        class ND4J_EXPORT MemoryPlan {
+        public:
+            // all offsets within arena are aligned to this number of bytes
+            static const Nd4jLong ALIGNMENT = 64;
+
+            class Slot {
+            public:
+                Nd4jLong offset = 0L;
+                Nd4jLong bytes = 0L;
+            };
+        protected:
+            std::map<std::pair<int, int>, Slot> _slots;
+            Nd4jLong _arenaSize = 0L;
+            Nd4jLong _totalBytes = 0L;
+
+            // expected workspace size for the whole graph run, this value is updated after each planned run
+            std::atomic<Nd4jLong> _footprint;
+        public:
+            MemoryPlan();
+            ~MemoryPlan() = default;
+
+            /**
+             * This method registers slot for given node output
+             */
+            void addSlot(int nodeId, int index, Nd4jLong offset, Nd4jLong bytes);
+
+            bool hasSlot(int nodeId, int index);
+
+            /**
+             * This method returns pointer to the slot for given node output, or nullptr if output wasn't planned
+             */
+            Slot* slot(int nodeId, int index);
+
+            /**
+             * This method returns number of planned node outputs
+             */
+            int numberOfSlots();
+
+            /**
+             * This method returns size of the arena required by this plan, in bytes
+             */
+            Nd4jLong arenaSize();
+
+            /**
+             * This method returns total size of planned outputs, i.e. memory they would take without any reuse
+             */
+            Nd4jLong totalBytes();
+
+            Nd4jLong footprint();
+            void setFootprintIfGreater(Nd4jLong bytes);
+        };
+    }
+}
+
+#endif //LIBND4J_MEMORYPLAN_H
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_MEMORYPLANNER_H
+#define LIBND4J_MEMORYPLANNER_H
+
+#include <map>
+#include <mutex>
+#include <pointercast.h>
+#include <dll.h>
+#include <graph/Graph.h>
+#include <graph/VariableSpace.h>
+#include <graph/MemoryPlan.h>
+#include <graph/MemoryArena.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class builds and keeps static memory plans for graph node outputs.
+         *
+         * First run of the graph for the given set of input shapes records output allocations. After that run, liveness
+         * interval of each output is computed (from the layer where it's produced, to the last layer reading it), and
+         * outputs are assigned offsets within single arena via greedy interval colouring: outputs that are never
+         * alive at the same time share the same memory. All subsequent runs with the same signature use this plan.
+         *
+         * Graphs with control flow (loops, conditionals, embedded graphs) are never planned, since their layers might be executed more than once.
+         *
+         * Planning is opt-in, see Environment::setUseMemoryPlanner()
+         */
+        class ND4J_EXPORT MemoryPlanner {
+        protected:
+            static MemoryPlanner* _INSTANCE;
+
+            std::map<std::pair<Nd4jLong, Nd4jLong>, MemoryPlan*> _plans;
+            std::mutex _mutex;
+
+            MemoryPlanner();
+            ~MemoryPlanner();
+        public:
+            static MemoryPlanner* getInstance();
+
+            /**
+             * This method checks, if static memory plan can be built for given graph
+             */
+            static bool isPlannable(Graph* graph);
+
+            /**
+             * This method returns signature of graph structure and shapes of external inputs within given VariableSpace
+             */
+            static Nd4jLong signature(Graph* graph, VariableSpace* variableSpace);
+
+            bool hasPlan(Nd4jLong hash, Nd4jLong signature);
+
+            /**
+             * This method returns plan for given graph hash and input signature, or nullptr if there's no such plan yet
+             */
+            MemoryPlan* getPlan(Nd4jLong hash, Nd4jLong signature);
+
+            /**
+             * This method builds plan out of allocations recorded during graph run, and stores it for future runs
+             *
+             * @param graph - graph that was executed
+             * @param variableSpace - VariableSpace used during that run
+             * @param arena - recording arena used during that run
+             * @param temporaryBytes - number of workspace bytes used for anything but node outputs
+             * @return plan, or nullptr if there's nothing to plan
+             */
+            MemoryPlan* buildPlan(Graph* graph, VariableSpace* variableSpace, MemoryArena* arena, Nd4jLong temporaryBytes, Nd4jLong hash, Nd4jLong signature);
+
+            int numberOfPlans();
+
+            /**
+             * This method removes all stored plans. It must not be called while graphs are executed
+             */
+            void clear();
+        };
+    }
+}
+
+#endif //LIBND4J_MEMORYPLANNER_H
@@ -26,6 +26,8 @@
 #include <op_boilerplate.h>
 #include <dll.h>
 #include <chrono>
+#include <type_traits>
+#include <templatemath.h>
 #include <array/DataTypeUtils.h>
 #include <helpers/logger.h>
 
@@ -79,6 +81,12 @@ namespace nd4j {
             FORCEINLINE _CUDA_HD uint32_t xoroshiro32(Nd4jLong index);
             FORCEINLINE _CUDA_HD uint64_t xoroshiro64(Nd4jLong index);
 
+            /**
+             * Box-Muller transform: every 2 uniform values produce 2 normal values
+             */
+            template <typename Z>
+            static FORCEINLINE _CUDA_HD void boxMuller(const uint32_t *bits, Z *result, int numPairs);
+
             /**
              * This method returns integer value between 0 and MAX_UINT
              */
@@ -117,6 +125,32 @@ namespace nd4j {
 
             FORCEINLINE _CUDA_HD void rewindH(Nd4jLong steps);
 
+            // number of values produced by single philoxBlock()/normalBlock() call
+            static const int PHILOX_BLOCK = 16;
+
+            /**
+             * Philox4x32-10 counter-based generator: 4 uint32 values for given counter.
+             * Node state forms high half of the counter, root state is the key.
+             */
+            FORCEINLINE _CUDA_HD void philox(Nd4jLong counter, uint32_t *result);
+
+            /**
+             * This method returns PHILOX_BLOCK values, equal to philox() output for counters [4 * block, 4 * block + 4)
+             */
+            FORCEINLINE _CUDA_HD void philoxBlock(Nd4jLong block, uint32_t *result);
+
+            /**
+             * This method returns standard normal value for given index. Values are the same as produced by normalBlock()
+             */
+            template <typename T>
+            FORCEINLINE _CUDA_HD T relativeNormal(Nd4jLong index);
+
+            /**
+             * This method returns PHILOX_BLOCK standard normal values for indices [PHILOX_BLOCK * block, PHILOX_BLOCK * (block + 1))
+             */
+            template <typename T>
+            FORCEINLINE _CUDA_HD void normalBlock(Nd4jLong block, T *result);
+
             /**
              * These methods set up only node states, with non-changed root ones
              */
@@ -272,6 +306,178 @@ namespace nd4j {
 
             _nodeState._long ^= (steps ^ 0xdeadbeef);
         }
+
+        //////
+        static FORCEINLINE _CUDA_HD void philoxRound(uint32_t &c0, uint32_t &c1, uint32_t &c2, uint32_t &c3, uint32_t k0, uint32_t k1) {
+            auto p0 = static_cast<uint64_t>(0xD2511F53U) * c0;
+            auto p1 = static_cast<uint64_t>(0xCD9E8D57U) * c2;
+
+            auto t0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+            auto t2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+
+            c1 = static_cast<uint32_t>(p1);
+            c3 = static_cast<uint32_t>(p0);
+            c0 = t0;
+            c2 = t2;
+        }
+
+        _CUDA_HD FORCEINLINE void RandomGenerator::philox(Nd4jLong counter, uint32_t *result) {
+            uint32_t c0 = static_cast<uint32_t>(counter);
+            uint32_t c1 = static_cast<uint32_t>(static_cast<uint64_t>(counter) >> 32);
+            uint32_t c2 = _nodeState._du32._v0;
+            uint32_t c3 = _nodeState._du32._v1;
+
+            uint32_t k0 = _rootState._du32._v0;
+            uint32_t k1 = _rootState._du32._v1;
+
+            for (int r = 0; r < 10; r++) {
+                philoxRound(c0, c1, c2, c3, k0, k1);
+                k0 += 0x9E3779B9U;
+                k1 += 0xBB67AE85U;
+            }
+
+            result[0] = c0;
+            result[1] = c1;
+            result[2] = c2;
+            result[3] = c3;
+        }
+
+        _CUDA_HD FORCEINLINE void RandomGenerator::philoxBlock(Nd4jLong block, uint32_t *result) {
+            // 4 independent streams in structure-of-arrays layout, so each round is vectorized across them
+            uint32_t c0[4], c1[4], c2[4], c3[4];
+
+            for (int j = 0; j < 4; j++) {
+                auto counter = static_cast<uint64_t>(4 * block + j);
+                c0[j] = static_cast<uint32_t>(counter);
+                c1[j] = static_cast<uint32_t>(counter >> 32);
+                c2[j] = _nodeState._du32._v0;
+                c3[j] = _nodeState._du32._v1;
+            }
+
+            uint32_t k0 = _rootState._du32._v0;
+            uint32_t k1 = _rootState._du32._v1;
+
+            for (int r = 0; r < 10; r++) {
+                PRAGMA_OMP_SIMD
+                for (int j = 0; j < 4; j++)
+                    philoxRound(c0[j], c1[j], c2[j], c3[j], k0, k1);
+
+                k0 += 0x9E3779B9U;
+                k1 += 0xBB67AE85U;
+            }
+
+            for (int j = 0; j < 4; j++) {
+                result[4 * j + 0] = c0[j];
+                result[4 * j + 1] = c1[j];
+                result[4 * j + 2] = c2[j];
+                result[4 * j + 3] = c3[j];
+            }
+        }
+
+        template <typename Z>
+        _CUDA_HD FORCEINLINE void RandomGenerator::boxMuller(const uint32_t *bits, Z *result, int numPairs) {
+            const Z two_pi = static_cast<Z>(2.0f) * static_cast<Z>(3.14159265358979323846);
+
+            // uniform values are within (0, 1], so log is always defined
+            const Z scale = static_cast<Z>(2.3283064365386963e-10);
+
+            PRAGMA_OMP_SIMD
+            for (int p = 0; p < numPairs; p++) {
+                Z u0 = (static_cast<Z>(bits[2 * p]) + static_cast<Z>(0.5f)) * scale;
+                Z u1 = (static_cast<Z>(bits[2 * p + 1]) + static_cast<Z>(0.5f)) * scale;
+
+                Z r = nd4j::math::nd4j_sqrt<Z, Z>(static_cast<Z>(-2.0f) * nd4j::math::nd4j_log<Z, Z>(u0));
+                Z phi = two_pi * u1;
+
+                result[2 * p] = r * nd4j::math::nd4j_cos<Z, Z>(phi);
+                result[2 * p + 1] = r * nd4j::math::nd4j_sin<Z, Z>(phi);
+            }
+        }
+
+        /**
+         * Single precision version avoids libm calls, so main loop is vectorized: log and sincos are evaluated with
+         * minimax polynomials (cephes), accurate within few ulp for uniform arguments within (0, 1).
+         * numPairs can't exceed PHILOX_BLOCK / 2
+         */
+        template <>
+        _CUDA_HD FORCEINLINE void RandomGenerator::boxMuller<float>(const uint32_t *bits, float *result, int numPairs) {
+            // squared radius and unit vector go first, so this loop has no branches
+            float squared[PHILOX_BLOCK / 2], cs[PHILOX_BLOCK / 2], sn[PHILOX_BLOCK / 2];
+
+            PRAGMA_OMP_SIMD
+            for (int p = 0; p < numPairs; p++) {
+                // 23 bits, so (x + 0.5) is exact in float and uniform values never hit 0 or 1
+                float u0 = (static_cast<float>(bits[2 * p] >> 9) + 0.5f) * 1.1920928955078125e-7f;
+                float u1 = (static_cast<float>(bits[2 * p + 1] >> 9) + 0.5f) * 1.1920928955078125e-7f;
+
+                // log(u0): u0 = m * 2^e, with m within [sqrt(0.5), sqrt(2))
+                u64 v;
+                v._float = u0;
+                auto e = static_cast<int>((v._du32._v0 >> 23) & 0xff) - 126;
+                v._du32._v0 = (v._du32._v0 & 0x007fffffU) | 0x3f000000U;
+                float m = v._float;
+
+                int below = m < 0.707106781186547524f ? 1 : 0;
+                e -= below;
+                m += m * static_cast<float>(below);
+
+                float x = m - 1.0f;
+                float z = x * x;
+                float y = ((((((((7.0376836292e-2f * x - 1.1514610310e-1f) * x + 1.1676998740e-1f) * x - 1.2420140846e-1f) * x + 1.4249322787e-1f) * x - 1.6668057665e-1f) * x + 2.0000714765e-1f) * x - 2.4999993993e-1f) * x + 3.3333331174e-1f) * x * z;
+                float fe = static_cast<float>(e);
+                y += -2.12194440e-4f * fe - 0.5f * z;
+                squared[p] = -2.0f * (x + y + 0.693359375f * fe);
+
+                // sincos(2 * pi * u1): quadrant is taken from u1 directly, remainder is within [-pi/4, pi/4]
+                float t = u1 * 4.0f;
+                auto q = static_cast<int>(t + 0.5f);
+                float a = (t - static_cast<float>(q)) * 1.57079632679489661923f;
+                float a2 = a * a;
+
+                float s = ((-1.9515295891e-4f * a2 + 8.3321608736e-3f) * a2 - 1.6666654611e-1f) * a2 * a + a;
+                float c = ((2.443315711809948e-5f * a2 - 1.388731625493765e-3f) * a2 + 4.166664568298827e-2f) * a2 * a2 - 0.5f * a2 + 1.0f;
+
+                // odd quadrants swap sin and cos, quadrants 2 and 3 flip both signs
+                float swap = static_cast<float>(q & 1);
+                float sign = 1.0f - 2.0f * static_cast<float>((q >> 1) & 1);
+                cs[p] = sign * (c - swap * (s + c));
+                sn[p] = sign * (s + swap * (c - s));
+            }
+
+            for (int p = 0; p < numPairs; p++) {
+                float r = nd4j::math::nd4j_sqrt<float, float>(squared[p]);
+                result[2 * p] = r * cs[p];
+                result[2 * p + 1] = r * sn[p];
+            }
+        }
+
+        template <typename T>
+        _CUDA_HD FORCEINLINE T RandomGenerator::relativeNormal(Nd4jLong index) {
+            typedef typename std::conditional<sizeof(T) == 8, double, float>::type Z;
+
+            uint32_t bits[4];
+            Z values[4];
+
+            philox(index / 4, bits);
+            auto pair = (index % 4) / 2;
+            boxMuller<Z>(bits + 2 * pair, values, 1);
+
+            return static_cast<T>(values[index % 2]);
+        }
+
+        template <typename T>
+        _CUDA_HD FORCEINLINE void RandomGenerator::normalBlock(Nd4jLong block, T *result) {
+            typedef typename std::conditional<sizeof(T) == 8, double, float>::type Z;
+
+            uint32_t bits[PHILOX_BLOCK];
+            Z values[PHILOX_BLOCK];
+
+            philoxBlock(block, bits);
+            boxMuller<Z>(bits, values, PHILOX_BLOCK / 2);
+
+            for (int e = 0; e < PHILOX_BLOCK; e++)
+                result[e] = static_cast<T>(values[e]);
+        }
     }
 }
 
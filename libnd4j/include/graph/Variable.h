@@ -45,6 +45,9 @@ namespace nd4j {
             bool _placeholder = false;
             bool _removable = true;
 
+            // shared variables are read in place by every session of registered graph, see VariableProxy
+            bool _shared = false;
+
             // for now we're setting default to numeric
             // in future we'll be fetching it right from the array, 
             //InputType _variableType = InputType_UNDEFINED;
@@ -58,7 +61,7 @@ namespace nd4j {
             Variable(bool placeHolder);
             Variable(nd4j::NDArray *arrayw, const char *name, int id, int idx = 0);
             Variable(nd4j::NDArray *array = nullptr, const char *name = nullptr);
-            Variable(const nd4j::graph::FlatVariable *flatVariable);
+            Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy = false);
             ~Variable();
 
             Variable* clone();
@@ -80,6 +83,7 @@ namespace nd4j {
             bool isRemovable();
 
             bool isPlaceholder();
+            bool isShared();
 
             VariableType variableType();
             void setVariableType(VariableType variableType);
@@ -94,6 +98,7 @@ namespace nd4j {
             void markExternal(bool reallyExternal);
             void markReadOnly(bool reallyReadOnly);
             void markRemovable(bool reallyRemovable);
+            void markShared(bool reallyShared);
 
             int id();
             int index();
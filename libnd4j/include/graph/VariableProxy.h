@@ -18,6 +18,9 @@
 //  @author raver119@gmail.com
 //
 
+#ifndef LIBND4J_VARIABLEPROXY_H
+#define LIBND4J_VARIABLEPROXY_H
+
 #include <graph/VariableSpace.h>
 
 namespace nd4j {
@@ -26,6 +29,12 @@ namespace nd4j {
         protected:
             VariableSpace* _backed = nullptr;
             VariableSpace* _current = nullptr;
+
+            /**
+             * This method returns Variable suitable for writes within current session: shared Variables of backing VariableSpace
+             * (weights and constants) are returned as is, and all others get replicated into local VariableSpace instead
+             */
+            Variable* shadow(Variable *variable);
         public:
             explicit VariableProxy(VariableSpace* reference);
             ~VariableProxy();
@@ -87,4 +96,6 @@ namespace nd4j {
             virtual FlowPath* flowPath();
         };
     }
-}
\ No newline at end of file
+}
+
+#endif //LIBND4J_VARIABLEPROXY_H
@@ -61,7 +61,8 @@ namespace nd4j {
 
             int _auto_counter = -1;
 
-            std::mutex _varmap;
+            // recursive, since public lookup methods are calling each other. Used for concurrent node execution within Graph layer
+            std::recursive_mutex _varmap;
 
             std::map<int, nd4j::graph::Variable*> _temporary;
 
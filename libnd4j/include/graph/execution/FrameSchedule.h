@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_FRAMESCHEDULE_H
+#define LIBND4J_FRAMESCHEDULE_H
+
+#include <vector>
+#include <pointercast.h>
+#include <dll.h>
+
+namespace nd4j {
+    namespace graph {
+        class Graph;
+
+        /**
+         * This class describes body of the single loop frame: the range of layers between loop Merge and Exit nodes,
+         * and positions of nodes within these layers that actually depend on the loop.
+         *
+         * First iteration of the loop walks all layers within the range as usual, and every subsequent iteration visits
+         * loop body nodes only: nodes that don't depend on the loop were already executed, and their results can't change.
+         */
+        class ND4J_EXPORT FrameSchedule {
+        protected:
+            int _firstLayer = 0;
+            int _lastLayer = -1;
+
+            // for each layer within range: position of next body node for each position within layer
+            std::vector<std::vector<int>> _next;
+        public:
+            FrameSchedule() = default;
+
+            /**
+             * This constructor builds schedule for given frame.
+             * Loop range starts at layer of loop Merge nodes, and ends at the layer of the last Exit node of this frame
+             *
+             * @param graph - Graph instance
+             * @param frameId - id of the loop frame
+             */
+            FrameSchedule(Graph* graph, Nd4jLong frameId);
+            ~FrameSchedule() = default;
+
+            /**
+             * These methods return boundaries of the loop range
+             */
+            int firstLayer();
+            int lastLayer();
+
+            /**
+             * This method returns TRUE if given layer belongs to the loop range and has no body nodes
+             */
+            bool isEmptyLayer(int layer);
+
+            /**
+             * This method returns position of the first body node within given layer, starting from given position.
+             * For layers outside of loop range given position is returned as is.
+             */
+            int nextNode(int layer, int position);
+
+            /**
+             * This method returns total number of body nodes
+             */
+            int numberOfNodes();
+        };
+    }
+}
+
+#endif //LIBND4J_FRAMESCHEDULE_H
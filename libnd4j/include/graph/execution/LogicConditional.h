@@ -40,7 +40,7 @@ namespace nd4j {
          */
         class LogicConditional {
         public:
-            static Nd4jStatus processNode(Graph* graph, Node* node);
+            static Nd4jStatus processNode(Graph* graph, Node* node, VariableSpace* variableSpace = nullptr);
         };
     }
 }
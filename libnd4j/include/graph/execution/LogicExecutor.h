@@ -33,7 +33,7 @@ namespace nd4j {
          */
         class LogicExecutor {
         public:
-            static Nd4jStatus processNode(Graph* graph, Node* node);
+            static Nd4jStatus processNode(Graph* graph, Node* node, VariableSpace* variableSpace = nullptr);
         };
     }
 }
@@ -29,7 +29,7 @@ namespace nd4j {
     namespace graph {
         class LogicExpose {
         public:
-            static Nd4jStatus processNode(Graph* graph, Node* node);
+            static Nd4jStatus processNode(Graph* graph, Node* node, VariableSpace* variableSpace = nullptr);
         };
     }
 }
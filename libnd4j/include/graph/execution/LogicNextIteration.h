@@ -28,7 +28,7 @@ namespace nd4j {
     namespace graph {
         class LogicNextIeration {
         public:
-            static Nd4jStatus processNode(Graph* graph, Node* node);
+            static Nd4jStatus processNode(Graph* graph, Node* node, VariableSpace* variableSpace = nullptr);
         };
     }
 }
@@ -36,7 +36,7 @@ namespace nd4j {
          */
         class LogicSwitch {
         public:
-            static Nd4jStatus processNode(Graph* graph, Node* node);
+            static Nd4jStatus processNode(Graph* graph, Node* node, VariableSpace* variableSpace = nullptr);
         };
     }
 }
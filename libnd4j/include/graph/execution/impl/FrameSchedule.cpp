@@ -0,0 +1,187 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/execution/FrameSchedule.h>
+#include <graph/Graph.h>
+#include <unordered_set>
+#include <unordered_map>
+#include <algorithm>
+#include <limits>
+
+namespace nd4j {
+    namespace graph {
+        static bool isLogicOp(Node* node, int opNum) {
+            return node->opType() == OpType_LOGIC && node->opNum() == opNum;
+        }
+
+        FrameSchedule::FrameSchedule(Graph* graph, Nd4jLong frameId) {
+            auto onion = graph->getOnion();
+
+            std::unordered_map<int, std::vector<Node*>> consumers;
+            std::vector<Node*> merges;
+            std::vector<Node*> enters;
+            std::unordered_set<int> mergeIds;
+
+            for (auto &layer: *onion)
+                for (auto node: *layer.second) {
+                    for (auto &p: *node->input())
+                        consumers[p.first].emplace_back(node);
+
+                    if (isLogicOp(node, nd4j::logic::Enter) && node->getFrameId() == frameId)
+                        enters.emplace_back(node);
+                }
+
+            // loop Merge nodes take initial values of loop variables from Enter nodes of this frame
+            for (auto enter: enters)
+                for (auto node: consumers[enter->id()])
+                    if (isLogicOp(node, nd4j::logic::Merge) && mergeIds.count(node->id()) == 0) {
+                        merges.emplace_back(node);
+                        mergeIds.insert(node->id());
+                    }
+
+            // Exit node belongs to this frame if its Switch is fed by loop Merge of this frame
+            auto isFrameExit = [&] (Node* node) -> bool {
+                if (!isLogicOp(node, nd4j::logic::Exit))
+                    return false;
+
+                if (node->getFrameId() == frameId)
+                    return true;
+
+                for (auto &p: *node->input()) {
+                    if (!graph->hasNode(p.first))
+                        continue;
+
+                    auto sw = graph->nodeById(p.first);
+                    if (!isLogicOp(sw, nd4j::logic::Switch))
+                        continue;
+
+                    for (auto &q: *sw->input())
+                        if (mergeIds.count(q.first) > 0)
+                            return true;
+                }
+
+                return false;
+            };
+
+            // forward closure of given nodes. optionally it stops at Exit nodes of this frame
+            auto closure = [&] (std::vector<Node*> &seeds, bool stopAtExit) -> std::unordered_set<int> {
+                std::unordered_set<int> result;
+                std::vector<Node*> queue(seeds);
+                for (auto node: seeds)
+                    result.insert(node->id());
+
+                while (!queue.empty()) {
+                    auto node = queue.back();
+                    queue.pop_back();
+
+                    if (stopAtExit && isFrameExit(node))
+                        continue;
+
+                    for (auto next: consumers[node->id()])
+                        if (result.count(next->id()) == 0) {
+                            result.insert(next->id());
+                            queue.emplace_back(next);
+                        }
+                }
+
+                return result;
+            };
+
+            // no loop Merge means there's nothing to rewind: frame just spans layers reachable from its Enter nodes
+            auto &seeds = merges.empty() ? enters : merges;
+
+            if (seeds.empty())
+                return;
+
+            _firstLayer = std::numeric_limits<int>::max();
+            for (auto node: seeds)
+                _firstLayer = std::min<int>(_firstLayer, node->getLayer());
+
+            auto body = closure(seeds, true);
+            _lastLayer = _firstLayer;
+            for (auto id: body)
+                if (graph->hasNode(id))
+                    _lastLayer = std::max<int>(_lastLayer, graph->nodeById(id)->getLayer());
+
+            // nested frames have to be registered on every iteration, so their Enter nodes are always visited
+            std::vector<Node*> visited(seeds);
+            for (int l = _firstLayer; l <= _lastLayer; l++)
+                if (onion->count(l) > 0)
+                    for (auto node: *onion->at(l))
+                        if (isLogicOp(node, nd4j::logic::Enter) && node->getFrameId() != frameId)
+                            visited.emplace_back(node);
+
+            // nodes that follow Exit within loop range are visited too, they'll be executed once loop is over
+            auto members = closure(visited, false);
+
+            for (int l = _firstLayer; l <= _lastLayer; l++) {
+                std::vector<int> next;
+
+                if (onion->count(l) > 0) {
+                    auto layer = onion->at(l);
+                    next.resize(layer->size() + 1);
+                    next[layer->size()] = (int) layer->size();
+
+                    for (int n = (int) layer->size() - 1; n >= 0; n--)
+                        next[n] = members.count(layer->at(n)->id()) > 0 ? n : next[n + 1];
+                } else
+                    next.emplace_back(0);
+
+                _next.emplace_back(next);
+            }
+
+            nd4j_debug("Frame [%lld]: %i body nodes within layers [%i..%i]\n", frameId, numberOfNodes(), _firstLayer, _lastLayer);
+        }
+
+        int FrameSchedule::firstLayer() {
+            return _firstLayer;
+        }
+
+        int FrameSchedule::lastLayer() {
+            return _lastLayer;
+        }
+
+        bool FrameSchedule::isEmptyLayer(int layer) {
+            if (layer < _firstLayer || layer > _lastLayer)
+                return false;
+
+            auto &next = _next[layer - _firstLayer];
+            return next[0] == (int) next.size() - 1;
+        }
+
+        int FrameSchedule::nextNode(int layer, int position) {
+            if (layer < _firstLayer || layer > _lastLayer)
+                return position;
+
+            auto &next = _next[layer - _firstLayer];
+            return position < (int) next.size() ? next[position] : position;
+        }
+
+        int FrameSchedule::numberOfNodes() {
+            int result = 0;
+            for (auto &next: _next)
+                for (int e = 0; e < (int) next.size() - 1; e++)
+                    if (next[e] == e)
+                        result++;
+
+            return result;
+        }
+    }
+}
@@ -26,8 +26,8 @@
 
 namespace nd4j {
     namespace graph {
-        Nd4jStatus LogicConditional::processNode(Graph *graph, Node *node) {
-            auto __variableSpace = graph->getVariableSpace();
+        Nd4jStatus LogicConditional::processNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
+            auto __variableSpace = variableSpace == nullptr ? graph->getVariableSpace() : variableSpace;
 
             auto size = node->input()->size();
 
@@ -86,7 +86,7 @@ namespace nd4j {
                 auto *node = scopeFalse->nodes()->at(nodes -1);
                 if (node->opType() == OpType_LOGIC && node->opNum() == 40) {
                     isReturn = true;
-                    LogicReturn::processNode(graph, node);
+                    LogicReturn::processNode(graph, node, __variableSpace);
                 } else {
                     GraphExecutioner::executeFlatNode(graph, node, __variableSpace);
                     lastNode = node->id();
@@ -105,7 +105,7 @@ namespace nd4j {
                 auto node = scopeTrue->nodes()->at(nodes -1);
                 if (node->opType() == OpType_LOGIC && node->opNum() == 40) {
                     isReturn = true;
-                    LogicReturn::processNode(graph, node);
+                    LogicReturn::processNode(graph, node, __variableSpace);
                 } else {
                     GraphExecutioner::executeFlatNode(graph, node, __variableSpace);
                     lastNode = node->id();
@@ -24,11 +24,11 @@
 
 namespace nd4j {
     namespace graph {
-        Nd4jStatus LogicEnter::processNode(Graph *graph, Node *node) {
+        Nd4jStatus LogicEnter::processNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
             // this op replicates input variable into the frame. basically happens once for single loop.
             // sure, if there's inner loop within outer loop, it'll be called once for outer loop and multiple times for inner loop
 
-            auto __variableSpace = graph->getVariableSpace();
+            auto __variableSpace = variableSpace == nullptr ? graph->getVariableSpace() : variableSpace;
             auto __flowPath = __variableSpace->flowPath();
 
             // basically, first non-null variable is our target
@@ -34,30 +34,30 @@
 
 namespace nd4j {
     namespace graph {
-        Nd4jStatus LogicExecutor::processNode(Graph *graph, Node *node) {
+        Nd4jStatus LogicExecutor::processNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
             switch (node->opNum()) {
                 case nd4j::logic::While:
-                    return LogicWhile::processNode(graph, node);
+                    return LogicWhile::processNode(graph, node, variableSpace);
                 case nd4j::logic::Scope:
-                    return LogicScope::processNode(graph, node);
+                    return LogicScope::processNode(graph, node, variableSpace);
                 case nd4j::logic::Conditional:
-                    return LogicConditional::processNode(graph, node);
+                    return LogicConditional::processNode(graph, node, variableSpace);
                 case nd4j::logic::Switch:
-                    return LogicSwitch::processNode(graph, node);
+                    return LogicSwitch::processNode(graph, node, variableSpace);
                 case nd4j::logic::Return:
-                    return LogicReturn::processNode(graph, node);
+                    return LogicReturn::processNode(graph, node, variableSpace);
                 case nd4j::logic::Expose:
-                    return LogicExpose::processNode(graph, node);
+                    return LogicExpose::processNode(graph, node, variableSpace);
                 case nd4j::logic::Merge:
-                    return LogicMerge::processNode(graph, node);
+                    return LogicMerge::processNode(graph, node, variableSpace);
                 case nd4j::logic::LoopCond:
-                    return LogicLoopCond::processNode(graph, node);
+                    return LogicLoopCond::processNode(graph, node, variableSpace);
                 case nd4j::logic::NextIteration:
-                    return LogicNextIeration::processNode(graph, node);
+                    return LogicNextIeration::processNode(graph, node, variableSpace);
                 case nd4j::logic::Exit:
-                    return LogicExit::processNode(graph, node);
+                    return LogicExit::processNode(graph, node, variableSpace);
                 case nd4j::logic::Enter:
-                    return LogicEnter::processNode(graph, node);
+                    return LogicEnter::processNode(graph, node, variableSpace);
             }
 
             if (node->getName() == nullptr) {
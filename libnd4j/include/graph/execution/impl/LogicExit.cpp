@@ -23,11 +23,11 @@
 
 namespace nd4j {
     namespace graph {
-        Nd4jStatus LogicExit::processNode(Graph *graph, Node *node) {
+        Nd4jStatus LogicExit::processNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
             // this op is basically no-op
             // we just know it exists
 
-            auto __variableSpace = graph->getVariableSpace();
+            auto __variableSpace = variableSpace == nullptr ? graph->getVariableSpace() : variableSpace;
             auto __flowPath = __variableSpace->flowPath();
 
             Context ctx(node->getContextPrototype(), __variableSpace);
@@ -22,7 +22,7 @@
 
 namespace nd4j {
     namespace graph {
-        Nd4jStatus LogicExpose::processNode(Graph *graph, Node *node) {
+        Nd4jStatus LogicExpose::processNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
             // do we really want this?
             return ND4J_STATUS_OK;
         }
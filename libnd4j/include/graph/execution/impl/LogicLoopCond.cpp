@@ -23,8 +23,8 @@
 
 namespace nd4j {
     namespace graph {
-        Nd4jStatus LogicLoopCond::processNode(Graph *graph, Node *node) {
-            auto __variableSpace = graph->getVariableSpace();
+        Nd4jStatus LogicLoopCond::processNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
+            auto __variableSpace = variableSpace == nullptr ? graph->getVariableSpace() : variableSpace;
             auto __flowPath = __variableSpace->flowPath();
 
             Context ctx(node->getContextPrototype(), __variableSpace);
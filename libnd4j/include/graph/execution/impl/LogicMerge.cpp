@@ -23,9 +23,9 @@
 
 namespace nd4j {
     namespace graph {
-        Nd4jStatus LogicMerge::processNode(Graph *graph, Node *node) {
+        Nd4jStatus LogicMerge::processNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
             // at merge node only one of inputs exist if that's just switch and other node isn't LogicNextItration
-            auto __variableSpace = graph->getVariableSpace();
+            auto __variableSpace = variableSpace == nullptr ? graph->getVariableSpace() : variableSpace;
             auto __flowPath = __variableSpace->flowPath();
 
             // merge MUST have 2 inputs
@@ -23,26 +23,71 @@
 
 namespace nd4j {
     namespace graph {
-        Nd4jStatus LogicNextIeration::processNode(Graph *graph, Node *node) {
-            auto __variableSpace = graph->getVariableSpace();
+        Nd4jStatus LogicNextIeration::processNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
+            auto __variableSpace = variableSpace == nullptr ? graph->getVariableSpace() : variableSpace;
             auto __flowPath = __variableSpace->flowPath();
 
             auto inputAddr = node->input()->at(0);
 
             auto var = __variableSpace->getVariable(inputAddr);
 
-            Variable *lvar = nullptr;
-            if (__variableSpace->hasVariable(node->id(), 0))
-                lvar = __variableSpace->getVariable(node->id(), 0);
-            else
-                lvar = new Variable(nullptr, node->getName()->c_str(), node->id(), 0);
+            std::pair<int, int> pair0(node->id(), 0);
+            std::pair<int, int> pair1(node->id(), 1);
 
-//            if (lvar->hasNDArray())
-//                delete lvar->getNDArray();
+            if (!__variableSpace->hasVariable(pair0))
+                __variableSpace->putVariable(pair0, new Variable(nullptr, node->getName()->c_str(), node->id(), 0));
 
-            auto array = var->getNDArray();
-            lvar->setNDArray(array);
-            lvar->markReadOnly(true);
+            auto lvar = __variableSpace->getVariable(pair0);
+
+            /*
+             * Value of the loop variable is copied into buffer owned by this node: buffers of the loop body are reused
+             * by the next iteration, while Merge keeps exposing this value to the nodes of the current iteration.
+             * Two buffers are used in turn: the one Merge currently exposes, and the spare one for the next value.
+             */
+            if (!__variableSpace->hasVariable(pair1))
+                __variableSpace->putVariable(pair1, new Variable(nullptr, node->getName()->c_str(), node->id(), 1));
+
+            auto svar = __variableSpace->getVariable(pair1);
+
+            auto input = var->getNDArray();
+            auto previous = lvar->hasNDArray() && !lvar->isReadOnly() && lvar->isRemovable() ? lvar->getNDArray() : nullptr;
+            auto spare = svar->hasNDArray() && !svar->isReadOnly() && svar->isRemovable() ? svar->getNDArray() : nullptr;
+
+            if (!var->hasNDArray() || input->isEmpty()) {
+                // nothing to copy, so buffers owned by this node aren't needed anymore
+                if (previous != nullptr && previous != input)
+                    delete previous;
+
+                if (spare != nullptr && spare != input && spare != previous)
+                    delete spare;
+
+                svar->setNDArray(nullptr);
+
+                lvar->setNDArray(input);
+                lvar->markReadOnly(true);
+
+                return ND4J_STATUS_OK;
+            }
+
+            NDArray* target = nullptr;
+            if (spare != nullptr && spare != input && spare->isSameShape(input) && spare->dataType() == input->dataType()) {
+                target = spare;
+                target->assign(input);
+            } else {
+                // shape of the loop variable has changed, so spare buffer can't be reused anymore
+                if (spare != nullptr && spare != input && spare != previous)
+                    delete spare;
+
+                target = input->dup();
+            }
+
+            lvar->setNDArray(target);
+            lvar->markReadOnly(false);
+            lvar->markRemovable(true);
+
+            svar->setNDArray(previous);
+            svar->markReadOnly(false);
+            svar->markRemovable(true);
 
             return ND4J_STATUS_OK;
         }
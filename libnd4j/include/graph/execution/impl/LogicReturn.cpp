@@ -24,8 +24,8 @@
 
 namespace nd4j {
     namespace graph {
-        Nd4jStatus LogicReturn::processNode(Graph *graph, Node *node) {
-            auto __variableSpace = graph->getVariableSpace();
+        Nd4jStatus LogicReturn::processNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
+            auto __variableSpace = variableSpace == nullptr ? graph->getVariableSpace() : variableSpace;
 
             for (int e = 0; e < node->input()->size(); e++) {
                 auto inputAddr = node->input()->at(e);
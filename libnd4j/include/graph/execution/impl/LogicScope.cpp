@@ -24,7 +24,7 @@
 
 namespace nd4j {
     namespace graph {
-        Nd4jStatus LogicScope::processNode(Graph *graph, Node *node) {
+        Nd4jStatus LogicScope::processNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
             // this op is basically no-op
             // we just know it exists
             return nd4j::Status::OK();
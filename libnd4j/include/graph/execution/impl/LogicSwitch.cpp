@@ -25,8 +25,8 @@
 
 namespace nd4j {
     namespace graph {
-        Nd4jStatus LogicSwitch::processNode(Graph* graph, Node* node) {
-            auto __variableSpace = graph->getVariableSpace();
+        Nd4jStatus LogicSwitch::processNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
+            auto __variableSpace = variableSpace == nullptr ? graph->getVariableSpace() : variableSpace;
             auto __flowPath = __variableSpace->flowPath();
 
             Context ctx(node->getContextPrototype(), __variableSpace);
@@ -27,8 +27,8 @@
 
 namespace nd4j {
     namespace graph {
-        Nd4jStatus LogicWhile::processNode(Graph *graph, Node *node) {
-            auto __variableSpace = graph->getVariableSpace();
+        Nd4jStatus LogicWhile::processNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
+            auto __variableSpace = variableSpace == nullptr ? graph->getVariableSpace() : variableSpace;
 
             nd4j_debug("Starting on WHILE loop: [%i]\n", node->id());
 
@@ -77,7 +77,7 @@ namespace nd4j {
                     //v->getBlock()->updateVariables();
                     if (v->opType() == OpType_LOGIC) {
                         nd4j_debug("Falling back to logic\n","");
-                        LogicExecutor::processNode(graph, v);
+                        LogicExecutor::processNode(graph, v, __variableSpace);
                     } else {
                         nd4j_debug("Op [<%s>]\n", v->getName()->c_str());
                         Nd4jStatus status = GraphExecutioner::executeFlatNode(graph, v, __variableSpace);
@@ -112,7 +112,7 @@ namespace nd4j {
 
                         if (v->opType() == OpType_LOGIC) {
                             nd4j_debug("Falling back to logic\n","");
-                            LogicExecutor::processNode(graph, v);
+                            LogicExecutor::processNode(graph, v, __variableSpace);
                         } else {
                             nd4j_debug("Op [<%s>]\n", v->getName()->c_str());
                             //v->getBlock()->updateVariables();
@@ -126,7 +126,7 @@ namespace nd4j {
 
                     // now execute return statement
                     Node* ret = scopeBody->nodes()->at(e);
-                    LogicReturn::processNode(graph, ret);
+                    LogicReturn::processNode(graph, ret, __variableSpace);
                 }
 
                 breaker++;
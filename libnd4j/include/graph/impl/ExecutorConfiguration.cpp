@@ -48,6 +48,8 @@ namespace nd4j {
             clone->_direction = _direction;
             clone->_footprintForward = _footprintForward;
             clone->_footprintBackward = _footprintBackward;
+            clone->_maxSteps = _maxSteps;
+            clone->_maxIterations = _maxIterations;
 
             return clone;
         };
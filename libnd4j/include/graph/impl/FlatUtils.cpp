@@ -36,7 +36,7 @@ namespace nd4j {
             return std::pair<Nd4jLong, Nd4jLong>(pair->first(), pair->second());
         }
 
-        NDArray* FlatUtils::fromFlatArray(const nd4j::graph::FlatArray *flatArray) {
+        NDArray* FlatUtils::fromFlatArray(const nd4j::graph::FlatArray *flatArray, bool zeroCopy) {
             auto rank = static_cast<int>(flatArray->shape()->Get(0));
             auto newShape = new Nd4jLong[shape::shapeInfoLength(rank)];
             memcpy(newShape, flatArray->shape()->data(), shape::shapeInfoByteLength(rank));
@@ -91,7 +91,18 @@ namespace nd4j {
             }
 
 
-            auto newBuffer = new int8_t[length * DataTypeUtils::sizeOf(dtype)];
+            // conversion is needed only if byte order differs, or buffer can't be addressed as is
+            auto rawBuffer = (void *) flatArray->buffer()->data();
+            auto byteLength = length * DataTypeUtils::sizeOf(dtype);
+            if (zeroCopy && ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder()) == (BitwiseUtils::isBE() ? nd4j::ByteOrder::BE : nd4j::ByteOrder::LE)
+                    && (Nd4jLong) flatArray->buffer()->size() >= byteLength && reinterpret_cast<uintptr_t>(rawBuffer) % DataTypeUtils::sizeOf(dtype) == 0) {
+                auto array = new NDArray(rawBuffer, newShape);
+                array->triggerAllocationFlag(false, true);
+
+                return array;
+            }
+
+            auto newBuffer = new int8_t[byteLength];
 
             BUILD_SINGLE_SELECTOR(dtype, DataTypeConversions, ::convertType(newBuffer, (void *)flatArray->buffer()->data(), dtype, ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder()),  length), LIBND4J_TYPES);
 
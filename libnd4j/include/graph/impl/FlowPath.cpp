@@ -135,6 +135,15 @@ namespace nd4j {
             return _frames[frameId].getNumberOfCycles();
         }
 
+        FrameSchedule* FlowPath::frameSchedule(Nd4jLong frameId) {
+            auto it = _schedules.find(frameId);
+            return it == _schedules.end() ? nullptr : &it->second;
+        }
+
+        void FlowPath::setFrameSchedule(Nd4jLong frameId, const FrameSchedule &schedule) {
+            _schedules[frameId] = schedule;
+        }
+
 
         bool FlowPath::wasExecuted(int nodeId) {
             return _states[nodeId].wasExecuted();
@@ -147,5 +156,13 @@ namespace nd4j {
         GraphProfile* FlowPath::profile() {
             return &_profile;
         }
+
+        void FlowPath::setMemoryArena(MemoryArena* arena) {
+            _arena = arena;
+        }
+
+        MemoryArena* FlowPath::memoryArena() {
+            return _arena;
+        }
     }
 }
\ No newline at end of file
@@ -23,6 +23,7 @@
 #include <graph/FlatUtils.h>
 #include <NativeOps.h>
 #include <vector>
+#include <set>
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <graph/VariableProxy.h>
@@ -225,7 +226,8 @@ namespace nd4j {
             return _configuration;
         }
 
-        std::vector<Variable *> * Graph::fetchOutputs() {
+        std::vector<Variable *> * Graph::fetchOutputs(VariableSpace *variableSpace) {
+            auto __variableSpace = variableSpace == nullptr ? _variableSpace : variableSpace;
             auto res = new std::vector<Variable *>();
 
             nd4j_debug("Graph output size: %i\n", _output.size());
@@ -234,8 +236,8 @@ namespace nd4j {
                 nd4j_debug("Output node: %i\n", nodeId);
 
                 for (int e = 0; e < DataTypeUtils::max<int>(); e++) {
-                    if (_variableSpace->hasVariable(nodeId, e)) {
-                        res->push_back(_variableSpace->getVariable(nodeId, e));
+                    if (__variableSpace->hasVariable(nodeId, e)) {
+                        res->push_back(__variableSpace->getVariable(nodeId, e));
                     } else {
                         if (e == 0) {
                             throw unresolved_output_exception::build("Can't find output variable", nodeId, e);
@@ -284,6 +286,10 @@ namespace nd4j {
             return _variableSpace;
         }
 
+        std::shared_ptr<MappedFile> Graph::getStorage() {
+            return _storage;
+        }
+
         Graph::~Graph() {
             for (auto &v: *_mapped)
                 delete v.second;
@@ -864,7 +870,8 @@ namespace nd4j {
             }
         }
 
-        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace) {
+        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace, const std::shared_ptr<MappedFile> &storage) {
+            this->_storage = storage;
             this->_onion = new std::map<int, std::vector<Node *> *>();
             this->_mapped = new std::map<int, Node *> ();
             this->_nodes = new std::vector<int>();
@@ -891,7 +898,7 @@ namespace nd4j {
                 for (unsigned int e = 0; e < flatGraph->variables()->size(); e++) {
                     auto flatVar = flatGraph->variables()->Get(e);
 
-                    auto var = new Variable(flatVar);
+                    auto var = new Variable(flatVar, storage != nullptr);
                     std::pair<int, int> pair(flatVar->id()->first(), flatVar->id()->second());
                     _variableSpace->putVariable(pair, var);
 
@@ -1276,10 +1283,21 @@ namespace nd4j {
             _configuration = configuration;
         }
 
+        void Graph::markSharedVariables() {
+            // op outputs are stored under id of the node that produces them
+            std::set<int> producers;
+            for (auto node: _handles)
+                producers.insert(node->id());
+
+            for (auto variable: _variableSpace->getVariables())
+                variable->markShared(producers.count(variable->id()) == 0 && (variable->hasNDArray() || variable->hasNDArrayList()));
+        }
+
         Graph* Graph::cloneWithProxy() {
             auto clone = new Graph();
 
             clone->replaceState(new VariableProxy(this->_variableSpace), this->_configuration->clone());
+            clone->_storage = _storage;
 
             // transfer nodes
             for (int e = 0; e < _nodes->size(); e++)
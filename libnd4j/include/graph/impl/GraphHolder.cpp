@@ -22,9 +22,40 @@
 #include <GraphExecutioner.h>
 #include <graph/exceptions/graph_exists_exception.h>
 #include <graph/exceptions/graph_execution_exception.h>
+#include <algorithm>
 
 namespace nd4j {
     namespace graph {
+        GraphHolder::GraphVersion::GraphVersion(Nd4jLong version, Graph *graph) {
+            _version = version;
+            _graph = graph;
+            _owned = true;
+        }
+
+        GraphHolder::GraphVersion::~GraphVersion() {
+            if (_owned.load())
+                delete _graph;
+        }
+
+        Nd4jLong GraphHolder::GraphVersion::version() {
+            return _version;
+        }
+
+        Graph* GraphHolder::GraphVersion::graph() {
+            return _graph;
+        }
+
+        void GraphHolder::GraphVersion::detach() {
+            _owned = false;
+        }
+
+        GraphHolder::GraphHolder() {
+            _registry = std::make_shared<const Registry>();
+            _retainedVersions = 1;
+            _newestShare = 100;
+            _requests = 0;
+        }
+
         GraphHolder* GraphHolder::getInstance() {
             if (_INSTANCE == 0)
                 _INSTANCE = new GraphHolder();
@@ -32,14 +63,42 @@ namespace nd4j {
             return _INSTANCE;
         };
 
+        std::shared_ptr<const GraphHolder::Registry> GraphHolder::snapshot() {
+            return std::atomic_load(&_registry);
+        }
+
+        void GraphHolder::publish(Registry *registry) {
+            std::shared_ptr<const Registry> next(registry);
+            std::atomic_store(&_registry, next);
+        }
+
+        std::vector<std::shared_ptr<GraphHolder::GraphVersion>> GraphHolder::versionsOf(Nd4jLong graphId) {
+            auto registry = snapshot();
+            auto it = registry->find(graphId);
+            if (it == registry->end())
+                return std::vector<std::shared_ptr<GraphVersion>>();
+
+            return it->second;
+        }
+
+        std::shared_ptr<Graph> GraphHolder::pin(std::shared_ptr<GraphVersion> version) {
+            // returned pointer shares ownership of the whole version
+            return std::shared_ptr<Graph>(version, version->graph());
+        }
+
         void GraphHolder::registerGraph(Nd4jLong graphId, Graph* graph) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
             if (hasGraphAny(graphId))
                 throw graph_exists_exception(graphId);
 
-            _graphF[graphId] = graph;
+            // graph is going to be shared between concurrent requests, so we build it once here
+            graph->buildGraph();
+            graph->markSharedVariables();
 
-            nd4j::SimpleReadWriteLock lock;
-            _locks[graphId] = lock;
+            auto registry = new Registry(*snapshot());
+            (*registry)[graphId].emplace_back(std::make_shared<GraphVersion>(1L, graph));
+            publish(registry);
         }
 
         Graph* GraphHolder::cloneGraph(Nd4jLong graphId) {
@@ -48,7 +107,7 @@ namespace nd4j {
                 throw std::runtime_error("Bad argument");
             }
 
-            auto graph = _graphF[graphId]->cloneWithProxy();
+            auto graph = pinGraph(graphId)->cloneWithProxy();
 
             return graph;
         }
@@ -59,33 +118,84 @@ namespace nd4j {
                 throw std::runtime_error("Bad argument");
             }
 
-            auto graph = _graphF[graphId];
+            return versionsOf(graphId).front()->graph();
+        }
 
-            return graph;
+        std::shared_ptr<Graph> GraphHolder::pinGraph(Nd4jLong graphId) {
+            auto versions = versionsOf(graphId);
+            if (versions.empty())
+                throw unknown_graph_exception(graphId);
+
+            return pin(versions.front());
+        }
+
+        std::shared_ptr<Graph> GraphHolder::pinGraph(Nd4jLong graphId, Nd4jLong version) {
+            for (auto &v: versionsOf(graphId))
+                if (v->version() == version)
+                    return pin(v);
+
+            throw unknown_graph_exception(graphId);
+        }
+
+        std::shared_ptr<Graph> GraphHolder::routeGraph(Nd4jLong graphId) {
+            auto versions = versionsOf(graphId);
+            if (versions.empty())
+                throw unknown_graph_exception(graphId);
+
+            if (versions.size() == 1)
+                return pin(versions.front());
+
+            // requests are interleaved deterministically: first N of each 100 go to the newest version
+            auto r = _requests++ % 100;
+            return pin(r < _newestShare.load() ? versions.at(0) : versions.at(1));
+        }
+
+        std::vector<Nd4jLong> GraphHolder::versions(Nd4jLong graphId) {
+            std::vector<Nd4jLong> result;
+            for (auto &v: versionsOf(graphId))
+                result.emplace_back(v->version());
+
+            return result;
+        }
+
+        void GraphHolder::setRetainedVersions(int numVersions) {
+            _retainedVersions = numVersions > 0 ? numVersions : 1;
+        }
+
+        void GraphHolder::setNewestShare(int percent) {
+            _newestShare = std::min<int>(std::max<int>(percent, 0), 100);
         }
 
         void GraphHolder::forgetGraph(Nd4jLong graphId) {
-            if (this->hasGraph(graphId))
-                _graphF.erase(graphId);
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if (!this->hasGraph(graphId))
+                return;
+
+            auto registry = new Registry(*snapshot());
+
+            // graphs are owned by caller from now on
+            for (auto &v: registry->at(graphId))
+                v->detach();
+
+            registry->erase(graphId);
+            publish(registry);
         }
 
         void GraphHolder::dropGraph(Nd4jLong graphId) {
-            if (this->hasGraph(graphId)) {
-                auto g = _graphF[graphId];
-                forgetGraph(graphId);
-                delete g;
-            }
-        }
+            std::lock_guard<std::mutex> lock(_mutex);
 
-        void GraphHolder::dropGraphAny(Nd4jLong graphId) {
-            if (!hasGraphAny(graphId))
+            if (!this->hasGraph(graphId))
                 return;
 
-            this->lockWrite(graphId);
+            // versions are released once requests still using them are finished
+            auto registry = new Registry(*snapshot());
+            registry->erase(graphId);
+            publish(registry);
+        }
 
+        void GraphHolder::dropGraphAny(Nd4jLong graphId) {
             this->dropGraph(graphId);
-
-            this->unlockWrite(graphId);
         }
 
         bool GraphHolder::hasGraphAny(Nd4jLong graphId) {
@@ -93,36 +203,33 @@ namespace nd4j {
         }
 
         bool GraphHolder::hasGraph(Nd4jLong graphId) {
-                return _graphF.count(graphId) > 0;
+            return snapshot()->count(graphId) > 0;
         }
 
         void GraphHolder::replaceGraph(Nd4jLong graphId, Graph* graph) {
-            if (!hasGraph(graphId)) {
-                registerGraph(graphId, graph);
-                return;
-            }
+            // building happens before publishing, so requests never see half-built graph
+            graph->buildGraph();
+            graph->markSharedVariables();
 
-            this->lockWrite(graphId);
+            std::lock_guard<std::mutex> lock(_mutex);
 
-            _graphF[graphId] = graph;
-
-            this->unlockWrite(graphId);
-        }
+            auto registry = new Registry(*snapshot());
+            auto &versions = (*registry)[graphId];
+            auto version = versions.empty() ? 1L : versions.front()->version() + 1;
 
+            versions.insert(versions.begin(), std::make_shared<GraphVersion>(version, graph));
+            if ((int) versions.size() > _retainedVersions.load())
+                versions.resize(_retainedVersions.load());
 
+            publish(registry);
 
+            nd4j_debug("Graph [%lld]: version %lld published\n", graphId, version);
+        }
 
         flatbuffers::Offset<FlatResult> GraphHolder::execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
-            if (!hasGraph(graphId))
-                throw unknown_graph_exception(graphId);
-
-            lockRead(graphId);
-
-            auto graph = cloneGraph(graphId);
-            auto res = GraphExecutioner::execute(graph, builder, request);
-            delete graph;
-
-            unlockRead(graphId);
+            // registered graph is shared between requests, every request gets its own VariableProxy within executioner
+            auto graph = routeGraph(graphId);
+            auto res = GraphExecutioner::execute(graph.get(), builder, request);
 
             return res;
         }
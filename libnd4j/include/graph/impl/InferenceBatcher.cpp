@@ -0,0 +1,299 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/InferenceBatcher.h>
+#include <graph/GraphHolder.h>
+#include <graph/VariableProxy.h>
+#include <graph/ExecutionResult.h>
+#include <GraphExecutioner.h>
+#include <Status.h>
+#include <graph/exceptions/unknown_graph_exception.h>
+#include <graph/exceptions/no_results_exception.h>
+#include <graph/exceptions/graph_execution_exception.h>
+
+namespace nd4j {
+    namespace graph {
+        InferenceBatcher::PendingRequest::PendingRequest(const FlatInferenceRequest* request) {
+            if (request != nullptr && request->variables() != nullptr) {
+                auto vars = request->variables();
+                for (flatbuffers::uoffset_t e = 0; e < vars->size(); e++)
+                    inputs.emplace_back(new Variable(vars->Get(e)));
+            }
+
+            enqueued = std::chrono::steady_clock::now();
+        }
+
+        InferenceBatcher::PendingRequest::~PendingRequest() {
+            for (auto v: inputs)
+                delete v;
+
+            for (auto v: outputs)
+                delete v;
+        }
+
+        InferenceBatcher::InferenceBatcher(Nd4jLong graphId, int maxBatchSize, Nd4jLong window) {
+            _graphId = graphId;
+            _maxBatchSize = maxBatchSize > 0 ? maxBatchSize : 1;
+            _window = window > 0 ? window : 0;
+
+            _numRequests = 0;
+            _numBatches = 0;
+            _waitTime = 0;
+            _queueDepth = 0;
+        }
+
+        flatbuffers::Offset<FlatResult> InferenceBatcher::execute(flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
+            PendingRequest pending(request);
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _queue.emplace_back(&pending);
+            _queueDepth++;
+            _condition.notify_all();
+
+            while (!pending.done) {
+                if (_leaderActive) {
+                    _condition.wait(lock);
+                    continue;
+                }
+
+                // this thread becomes batch leader: waiting for the batch to fill up, or for the window to close
+                _leaderActive = true;
+                auto deadline = _queue.front()->enqueued + std::chrono::microseconds(_window);
+                _condition.wait_until(lock, deadline, [&] { return _queue.size() >= (size_t) _maxBatchSize; });
+
+                std::vector<PendingRequest*> batch;
+                while (!_queue.empty() && batch.size() < (size_t) _maxBatchSize) {
+                    batch.emplace_back(_queue.front());
+                    _queue.pop_front();
+                }
+                _queueDepth -= batch.size();
+
+                lock.unlock();
+                executeBatch(batch);
+                lock.lock();
+
+                for (auto r: batch)
+                    r->done = true;
+
+                _leaderActive = false;
+                _condition.notify_all();
+            }
+            lock.unlock();
+
+            if (pending.exception)
+                std::rethrow_exception(pending.exception);
+
+            ExecutionResult result;
+            for (auto v: pending.outputs)
+                result.emplace_back(v);
+
+            return result.asFlatResult(builder);
+        }
+
+        bool InferenceBatcher::canMerge(std::vector<PendingRequest*> &batch) {
+            for (auto r: batch) {
+                if (r->inputs.empty())
+                    return false;
+
+                r->rows = -1;
+                for (auto v: r->inputs) {
+                    if (!v->hasNDArray() || v->getNDArray()->rankOf() < 1)
+                        return false;
+
+                    auto rows = v->getNDArray()->sizeAt(0);
+                    if (r->rows >= 0 && r->rows != rows)
+                        return false;
+
+                    r->rows = rows;
+                }
+            }
+
+            auto first = batch.front();
+            for (auto r: batch) {
+                if (r->inputs.size() != first->inputs.size())
+                    return false;
+
+                for (size_t e = 0; e < first->inputs.size(); e++) {
+                    auto x = first->inputs[e];
+                    auto y = r->inputs[e];
+
+                    if (x->id() != y->id() || x->index() != y->index() || *x->getName() != *y->getName())
+                        return false;
+
+                    auto xa = x->getNDArray();
+                    auto ya = y->getNDArray();
+                    if (xa->dataType() != ya->dataType() || xa->rankOf() != ya->rankOf())
+                        return false;
+
+                    for (int d = 1; d < xa->rankOf(); d++)
+                        if (xa->sizeAt(d) != ya->sizeAt(d))
+                            return false;
+                }
+            }
+
+            return true;
+        }
+
+        std::vector<Variable*> InferenceBatcher::executeGraph(std::vector<Variable*> &inputs) {
+            std::vector<Variable*> result;
+
+            // graph version is pinned until execution is finished, even if graph gets replaced meanwhile
+            auto graph = GraphHolder::getInstance()->routeGraph(_graphId);
+            VariableProxy varSpace(graph->getVariableSpace());
+
+            // proxy takes ownership of inputs
+            for (auto v: inputs)
+                varSpace.replaceVariable(v);
+            inputs.clear();
+
+            auto status = GraphExecutioner::execute(graph.get(), &varSpace);
+            if (status != nd4j::Status::OK())
+                throw graph_execution_exception(_graphId);
+
+            auto outputs = graph->fetchOutputs(&varSpace);
+            if (outputs->empty()) {
+                delete outputs;
+                throw no_results_exception(_graphId);
+            }
+
+            // outputs belong to the proxy, so we detach them before it's gone
+            for (auto v: *outputs)
+                result.emplace_back(new Variable(v->getNDArray()->dup(), v->getName()->c_str(), v->id(), v->index()));
+
+            delete outputs;
+
+            return result;
+        }
+
+        void InferenceBatcher::executeBatch(std::vector<PendingRequest*> &batch) {
+            auto now = std::chrono::steady_clock::now();
+            for (auto r: batch)
+                _waitTime += std::chrono::duration_cast<std::chrono::microseconds>(now - r->enqueued).count();
+
+            _numRequests += batch.size();
+
+            if (batch.size() > 1 && canMerge(batch)) {
+                Nd4jLong totalRows = 0;
+                for (auto r: batch)
+                    totalRows += r->rows;
+
+                // concatenating inputs along dimension 0
+                std::vector<Variable*> merged;
+                auto first = batch.front();
+                for (size_t e = 0; e < first->inputs.size(); e++) {
+                    auto proto = first->inputs[e]->getNDArray();
+                    auto shape = proto->getShapeAsVector();
+                    shape[0] = totalRows;
+
+                    auto array = new NDArray('c', shape, proto->dataType());
+                    std::vector<Nd4jLong> idx(2 * shape.size(), 0);
+                    Nd4jLong start = 0;
+                    for (auto r: batch) {
+                        idx[0] = start;
+                        idx[1] = start + r->rows;
+
+                        auto view = (*array)(idx, true);
+                        view.assign(r->inputs[e]->getNDArray());
+                        start += r->rows;
+                    }
+
+                    merged.emplace_back(new Variable(array, first->inputs[e]->getName()->c_str(), first->inputs[e]->id(), first->inputs[e]->index()));
+                }
+
+                std::vector<Variable*> outputs;
+                try {
+                    _numBatches++;
+                    outputs = executeGraph(merged);
+                } catch (...) {
+                    for (auto v: merged)
+                        delete v;
+
+                    auto ex = std::current_exception();
+                    for (auto r: batch)
+                        r->exception = ex;
+
+                    return;
+                }
+
+                bool splittable = true;
+                for (auto v: outputs)
+                    if (v->getNDArray()->rankOf() < 1 || v->getNDArray()->sizeAt(0) != totalRows)
+                        splittable = false;
+
+                if (splittable) {
+                    // splitting outputs back along dimension 0
+                    for (auto v: outputs) {
+                        auto array = v->getNDArray();
+                        std::vector<Nd4jLong> idx(2 * array->rankOf(), 0);
+                        Nd4jLong start = 0;
+                        for (auto r: batch) {
+                            idx[0] = start;
+                            idx[1] = start + r->rows;
+
+                            auto view = (*array)(idx, true);
+                            r->outputs.emplace_back(new Variable(view.dup(), v->getName()->c_str(), v->id(), v->index()));
+                            start += r->rows;
+                        }
+                    }
+
+                    for (auto v: outputs)
+                        delete v;
+
+                    return;
+                }
+
+                nd4j_debug("InferenceBatcher: outputs of graph [%lld] can't be split along dimension 0, executing requests one by one\n", _graphId);
+                for (auto v: outputs)
+                    delete v;
+            }
+
+            for (auto r: batch) {
+                try {
+                    _numBatches++;
+                    r->outputs = executeGraph(r->inputs);
+                } catch (...) {
+                    r->exception = std::current_exception();
+                }
+            }
+        }
+
+        int InferenceBatcher::queueDepth() {
+            return _queueDepth.load();
+        }
+
+        Nd4jLong InferenceBatcher::numberOfRequests() {
+            return _numRequests.load();
+        }
+
+        Nd4jLong InferenceBatcher::numberOfBatches() {
+            return _numBatches.load();
+        }
+
+        double InferenceBatcher::averageBatchSize() {
+            auto batches = _numBatches.load();
+            return batches > 0 ? (double) _numRequests.load() / (double) batches : 0.0;
+        }
+
+        double InferenceBatcher::averageWaitTime() {
+            auto requests = _numRequests.load();
+            return requests > 0 ? (double) _waitTime.load() / (double) requests : 0.0;
+        }
+    }
+}
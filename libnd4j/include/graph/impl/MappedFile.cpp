@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/MappedFile.h>
+#include <helpers/logger.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <cstdio>
+#include <stdexcept>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+namespace nd4j {
+    namespace graph {
+        MappedFile::MappedFile(const char *filename) {
+            struct stat stat_buf;
+            if (stat(filename, &stat_buf) != 0) {
+                nd4j_printf("File [%s] wasn't found. Please check path and permissions\n", filename);
+                throw std::runtime_error("File not found");
+            }
+
+            _size = stat_buf.st_size;
+            if (_size <= 0)
+                throw std::runtime_error("MappedFile: file is empty");
+
+#if !defined(_WIN32) && !defined(_WIN64)
+            int fd = open(filename, O_RDONLY);
+            if (fd >= 0) {
+                // private mapping: pages are shared via page cache until written. Zero-copy VARIABLE and CONSTANT arrays are
+                // ordinary mutable NDArrays, and in-place ops or assign() may write into them, so the mapping must stay writable:
+                // kernel copies only the pages actually written, and the file itself is never modified
+                auto ptr = mmap(nullptr, (size_t) _size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                close(fd);
+
+                if (ptr != MAP_FAILED) {
+                    _data = reinterpret_cast<uint8_t *>(ptr);
+                    _mapped = true;
+                    return;
+                }
+            }
+
+            nd4j_debug("MappedFile: mmap of [%s] failed, reading file instead\n", filename);
+#endif
+
+            FILE *in = fopen(filename, "rb");
+            if (in == nullptr)
+                throw std::runtime_error("MappedFile: can't open file");
+
+            _data = new uint8_t[_size];
+            auto cnt = fread(_data, 1, (size_t) _size, in);
+            fclose(in);
+
+            if ((Nd4jLong) cnt != _size) {
+                delete[] _data;
+                throw std::runtime_error("MappedFile: can't read file");
+            }
+        }
+
+        MappedFile::~MappedFile() {
+#if !defined(_WIN32) && !defined(_WIN64)
+            if (_mapped) {
+                munmap(_data, (size_t) _size);
+                return;
+            }
+#endif
+            delete[] _data;
+        }
+
+        uint8_t* MappedFile::data() const {
+            return _data;
+        }
+
+        Nd4jLong MappedFile::size() const {
+            return _size;
+        }
+
+        bool MappedFile::isMapped() const {
+            return _mapped;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/MemoryArena.h>
+#include <helpers/ShapeBuilders.h>
+#include <array/ArrayOptions.h>
+#include <array/DataTypeUtils.h>
+#include <cstring>
+
+namespace nd4j {
+    namespace graph {
+        MemoryArena::MemoryArena(MemoryPlan* plan, nd4j::memory::Workspace* workspace) {
+            _plan = plan;
+            _workspace = workspace;
+        }
+
+        NDArray* MemoryArena::allocate(int nodeId, int index, Nd4jLong* shapeInfo, nd4j::memory::Workspace* workspace) {
+            if (ArrayOptions::hasPropertyBitSet(shapeInfo, ARRAY_EMPTY))
+                return new NDArray(shapeInfo, true, workspace);
+
+            Nd4jLong bytes = shape::length(shapeInfo) * DataTypeUtils::sizeOfElement(ArrayOptions::dataType(shapeInfo));
+
+            if (_plan != nullptr) {
+                auto slot = _plan->slot(nodeId, index);
+
+                // shapes might differ from what we've planned for, i.e. if some op produces data-dependent shapes
+                if (slot != nullptr && bytes <= slot->bytes) {
+                    std::call_once(_reserved, [&] {
+                        // extra bytes are reserved, so arena start can be aligned
+                        auto ptr = reinterpret_cast<int8_t *>(_workspace->allocateBytes(_plan->arenaSize() + MemoryPlan::ALIGNMENT));
+                        auto shift = reinterpret_cast<Nd4jLong>(ptr) % MemoryPlan::ALIGNMENT;
+                        _base = shift == 0 ? ptr : ptr + (MemoryPlan::ALIGNMENT - shift);
+                    });
+
+                    auto buffer = _base + slot->offset;
+                    memset(buffer, 0, bytes);
+
+                    return new NDArray(buffer, ShapeBuilders::copyShapeInfo(shapeInfo, true, workspace), workspace, false, true);
+                }
+
+                return new NDArray(shapeInfo, true, workspace);
+            }
+
+            auto array = new NDArray(shapeInfo, true, workspace);
+
+            Allocation allocation;
+            allocation.nodeId = nodeId;
+            allocation.index = index;
+            allocation.buffer = reinterpret_cast<int8_t *>(array->buffer());
+            allocation.bytes = bytes;
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _allocations.emplace_back(allocation);
+
+            return array;
+        }
+
+        bool MemoryArena::isRecording() {
+            return _plan == nullptr;
+        }
+
+        MemoryPlan* MemoryArena::plan() {
+            return _plan;
+        }
+
+        std::vector<MemoryArena::Allocation>& MemoryArena::allocations() {
+            return _allocations;
+        }
+
+        Nd4jLong MemoryArena::recordedBytes() {
+            Nd4jLong result = 0L;
+            for (auto &a: _allocations)
+                result += a.bytes;
+
+            return result;
+        }
+    }
+}
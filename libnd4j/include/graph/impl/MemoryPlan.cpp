@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/MemoryPlan.h>
+#include <templatemath.h>
+
+namespace nd4j {
+    namespace graph {
+        MemoryPlan::MemoryPlan() {
+            _footprint = 0L;
+        }
+
+        void MemoryPlan::addSlot(int nodeId, int index, Nd4jLong offset, Nd4jLong bytes) {
+            Slot slot;
+            slot.offset = offset;
+            slot.bytes = bytes;
+
+            _slots[std::pair<int, int>(nodeId, index)] = slot;
+
+            _arenaSize = nd4j::math::nd4j_max<Nd4jLong>(_arenaSize, offset + bytes);
+            _totalBytes += bytes;
+        }
+
+        bool MemoryPlan::hasSlot(int nodeId, int index) {
+            return _slots.count(std::pair<int, int>(nodeId, index)) > 0;
+        }
+
+        MemoryPlan::Slot* MemoryPlan::slot(int nodeId, int index) {
+            auto it = _slots.find(std::pair<int, int>(nodeId, index));
+            return it == _slots.end() ? nullptr : &it->second;
+        }
+
+        int MemoryPlan::numberOfSlots() {
+            return (int) _slots.size();
+        }
+
+        Nd4jLong MemoryPlan::arenaSize() {
+            return _arenaSize;
+        }
+
+        Nd4jLong MemoryPlan::totalBytes() {
+            return _totalBytes;
+        }
+
+        Nd4jLong MemoryPlan::footprint() {
+            return _footprint.load();
+        }
+
+        void MemoryPlan::setFootprintIfGreater(Nd4jLong bytes) {
+            auto current = _footprint.load();
+            while (bytes > current && !_footprint.compare_exchange_weak(current, bytes));
+        }
+    }
+}
@@ -0,0 +1,252 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <graph/MemoryPlanner.h>
+#include <templatemath.h>
+#include <algorithm>
+#include <climits>
+
+namespace nd4j {
+    namespace graph {
+        MemoryPlanner::MemoryPlanner() {
+            //
+        }
+
+        MemoryPlanner::~MemoryPlanner() {
+            for (auto &v: _plans)
+                delete v.second;
+        }
+
+        MemoryPlanner* MemoryPlanner::getInstance() {
+            if (_INSTANCE == 0)
+                _INSTANCE = new MemoryPlanner();
+
+            return _INSTANCE;
+        }
+
+        bool MemoryPlanner::isPlannable(Graph* graph) {
+            // in this mode every variable is considered graph output
+            if (graph->getExecutorConfiguration()->_outputMode == OutputMode_VARIABLE_SPACE)
+                return false;
+
+            for (auto &v: *graph->getMapped()) {
+                auto node = v.second;
+                if (node->opType() == OpType_LOGIC || node->opType() == OpType_GRAPH || node->hasGraphEmbedded())
+                    return false;
+            }
+
+            return true;
+        }
+
+        static FORCEINLINE void combine(uint64_t &hash, uint64_t value) {
+            hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        }
+
+        Nd4jLong MemoryPlanner::signature(Graph* graph, VariableSpace* variableSpace) {
+            uint64_t hash = 0;
+
+            for (auto &l: *graph->getOnion()) {
+                combine(hash, (uint64_t) l.first);
+
+                for (auto node: *l.second) {
+                    combine(hash, (uint64_t) node->id());
+                    combine(hash, (uint64_t) node->opType());
+                    combine(hash, (uint64_t) node->opNum());
+
+                    for (auto &p: *node->input()) {
+                        combine(hash, (uint64_t) p.first);
+                        combine(hash, (uint64_t) p.second);
+
+                        // external inputs contribute their shapes and data types
+                        if (p.first < 0 && variableSpace->hasVariable(p)) {
+                            auto var = variableSpace->getVariable(p);
+                            if (var->hasNDArray() && var->getNDArray() != nullptr) {
+                                auto shapeInfo = var->getNDArray()->shapeInfo();
+                                auto length = shape::shapeInfoLength(shapeInfo);
+                                for (int e = 0; e < length; e++)
+                                    combine(hash, (uint64_t) shapeInfo[e]);
+                            }
+                        }
+                    }
+                }
+            }
+
+            return (Nd4jLong) hash;
+        }
+
+        bool MemoryPlanner::hasPlan(Nd4jLong hash, Nd4jLong signature) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _plans.count(std::pair<Nd4jLong, Nd4jLong>(hash, signature)) > 0;
+        }
+
+        MemoryPlan* MemoryPlanner::getPlan(Nd4jLong hash, Nd4jLong signature) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _plans.find(std::pair<Nd4jLong, Nd4jLong>(hash, signature));
+            return it == _plans.end() ? nullptr : it->second;
+        }
+
+        MemoryPlan* MemoryPlanner::buildPlan(Graph* graph, VariableSpace* variableSpace, MemoryArena* arena, Nd4jLong temporaryBytes, Nd4jLong hash, Nd4jLong signature) {
+            // intervals are sorted by buffer address, so we can map any array to the allocation it belongs to
+            struct Interval {
+                MemoryArena::Allocation allocation;
+                Nd4jLong bytes;
+                Nd4jLong offset;
+                int start;
+                int end;
+            };
+
+            std::vector<Interval> intervals;
+            std::map<int, int> layers;
+            int lastLayer = 0;
+
+            for (auto &l: *graph->getOnion()) {
+                for (auto node: *l.second)
+                    layers[node->id()] = l.first;
+
+                lastLayer = nd4j::math::nd4j_max<int>(lastLayer, l.first);
+            }
+
+            for (auto &a: arena->allocations()) {
+                if (layers.count(a.nodeId) == 0 || a.bytes < 1)
+                    continue;
+
+                Interval interval;
+                interval.allocation = a;
+                interval.bytes = ((a.bytes + MemoryPlan::ALIGNMENT - 1) / MemoryPlan::ALIGNMENT) * MemoryPlan::ALIGNMENT;
+                interval.offset = 0L;
+                interval.start = layers[a.nodeId];
+                interval.end = interval.start;
+                intervals.emplace_back(interval);
+            }
+
+            if (intervals.empty())
+                return nullptr;
+
+            std::sort(intervals.begin(), intervals.end(), [] (const Interval &x, const Interval &y) { return x.allocation.buffer < y.allocation.buffer; });
+
+            // arrays can alias recorded buffers (i.e. in-place ops, or views), so liveness is tracked by memory, not by variable ids
+            auto extend = [&] (NDArray* array, int layer) {
+                if (array == nullptr || array->buffer() == nullptr)
+                    return;
+
+                auto ptr = reinterpret_cast<int8_t *>(array->buffer());
+                auto it = std::upper_bound(intervals.begin(), intervals.end(), ptr, [] (int8_t* p, const Interval &x) { return p < x.allocation.buffer; });
+                if (it == intervals.begin())
+                    return;
+
+                --it;
+                if (ptr < it->allocation.buffer + it->allocation.bytes)
+                    it->end = nd4j::math::nd4j_max<int>(it->end, layer);
+            };
+
+            for (auto &l: *graph->getOnion()) {
+                for (auto node: *l.second) {
+                    for (auto &p: *node->input()) {
+                        if (!variableSpace->hasVariable(p))
+                            continue;
+
+                        auto var = variableSpace->getVariable(p);
+                        if (var->hasNDArray())
+                            extend(var->getNDArray(), l.first);
+                    }
+                }
+            }
+
+            // graph outputs must survive till the end of the run
+            std::vector<Variable*>* outputs = nullptr;
+            try {
+                outputs = graph->fetchOutputs(variableSpace);
+            } catch (...) {
+                nd4j_debug("MemoryPlanner: can't fetch outputs of graph [%lld], skipping plan\n", hash);
+                return nullptr;
+            }
+
+            for (auto v: *outputs)
+                if (v->hasNDArray())
+                    extend(v->getNDArray(), INT_MAX);
+
+            delete outputs;
+
+            // greedy interval colouring: biggest buffers go first, each one takes the lowest gap among buffers alive at the same time
+            std::vector<Interval*> order;
+            for (auto &v: intervals)
+                order.emplace_back(&v);
+
+            std::stable_sort(order.begin(), order.end(), [] (const Interval* x, const Interval* y) { return x->bytes > y->bytes; });
+
+            std::vector<Interval*> placed;
+            std::vector<Interval*> alive;
+            for (auto v: order) {
+                alive.clear();
+                for (auto p: placed)
+                    if (p->start <= v->end && v->start <= p->end)
+                        alive.emplace_back(p);
+
+                std::sort(alive.begin(), alive.end(), [] (const Interval* x, const Interval* y) { return x->offset < y->offset; });
+
+                Nd4jLong offset = 0L;
+                for (auto p: alive) {
+                    if (offset + v->bytes <= p->offset)
+                        break;
+
+                    offset = nd4j::math::nd4j_max<Nd4jLong>(offset, p->offset + p->bytes);
+                }
+
+                v->offset = offset;
+                placed.emplace_back(v);
+            }
+
+            auto plan = new MemoryPlan();
+            for (auto &v: intervals)
+                plan->addSlot(v.allocation.nodeId, v.allocation.index, v.offset, v.bytes);
+
+            plan->setFootprintIfGreater(plan->arenaSize() + MemoryPlan::ALIGNMENT + nd4j::math::nd4j_max<Nd4jLong>(0L, temporaryBytes));
+
+            nd4j_debug("MemoryPlanner: graph [%lld] planned with %i outputs: %lld bytes arena vs %lld bytes total\n", hash, plan->numberOfSlots(), plan->arenaSize(), plan->totalBytes());
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::pair<Nd4jLong, Nd4jLong> key(hash, signature);
+
+            // concurrent session might have built the same plan already
+            if (_plans.count(key) > 0) {
+                delete plan;
+                return _plans[key];
+            }
+
+            _plans[key] = plan;
+            return plan;
+        }
+
+        int MemoryPlanner::numberOfPlans() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return (int) _plans.size();
+        }
+
+        void MemoryPlanner::clear() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto &v: _plans)
+                delete v.second;
+
+            _plans.clear();
+        }
+
+        MemoryPlanner* MemoryPlanner::_INSTANCE = 0;
+    }
+}
@@ -140,6 +140,15 @@ namespace nd4j {
             this->_readOnly = reallyReadOnly;
         }
 
+        bool nd4j::graph::Variable::isShared() {
+            return _shared;
+        }
+
+
+        void nd4j::graph::Variable::markShared(bool reallyShared) {
+            this->_shared = reallyShared;
+        }
+
         nd4j::NDArray * nd4j::graph::Variable::getNDArray() {
             if (_variableType != VariableType::NDARRAY) {
                 nd4j_printf("Variable[%i:%i/<%s>] is has [%s] type, but NDArray was requested\n", this->_id, this->_index, this->_name.c_str(), EnumUtils::_VariableTypeToString(_variableType));
@@ -189,7 +198,7 @@ namespace nd4j {
         }
 
         
-        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable) {
+        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy) {
             auto vid = flatVariable->id();
             this->_id = vid->first();
             this->_index = vid->second();
@@ -206,10 +215,10 @@ namespace nd4j {
                 case VarType_VARIABLE: {
 
                         // ?????
+                        // allocation flags are set by FlatUtils: zero-copy arrays don't own their buffers
                         if (flatVariable->ndarray() != nullptr) {
                             auto ar = flatVariable->ndarray();
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                            _ndarray->triggerAllocationFlag(true, true);
+                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar, zeroCopy);
                         }
 
                         _variableType = VariableType::NDARRAY;
@@ -220,12 +229,7 @@ namespace nd4j {
                             throw std::runtime_error("CONSTANT variable must have NDArray bundled");
 
                         auto ar = flatVariable->ndarray();
-                        if (ar->dtype() == DataType_UTF8) {
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                        } else {
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                        }
-                        _ndarray->triggerAllocationFlag(true, true);
+                        _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar, zeroCopy);
 
                         _variableType = VariableType::NDARRAY;
                     }
@@ -37,6 +37,33 @@ namespace nd4j {
             delete _current;
         }
 
+
+        Variable* VariableProxy::shadow(Variable *variable) {
+            // weights and constants, marked at graph registration, are shared as is
+            if (variable->isShared())
+                return variable;
+
+            // everything else (i.e. op outputs or placeholders) is filled per session, so it goes to the local space.
+            // Nodes of the same layer may be executed concurrently, so slot is replicated only once
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+            std::pair<int, int> pair(variable->id(), variable->index());
+            if (_current->hasVariable(pair))
+                return _current->getVariable(pair);
+
+            // op output left from previous execution of the graph is replaced with empty slot, there's no point in copying it
+            Variable *local = nullptr;
+            if (variable->hasNDArray() || variable->hasNDArrayList())
+                local = new Variable(nullptr, variable->getName()->c_str(), variable->id(), variable->index());
+            else
+                local = variable->clone();
+
+            // slots of inplace ops hold arrays of their inputs, so they must not release them
+            local->markRemovable(variable->isRemovable());
+            _current->putVariable(pair, local);
+
+            return local;
+        }
+
         
         int VariableProxy::numberOfPlaceholders() {
             return _backed->numberOfPlaceholders();
@@ -126,7 +153,7 @@ namespace nd4j {
                 return _current->getVariable(id);
             
             if (_backed->hasVariable(id))
-                return _backed->getVariable(id);
+                return shadow(_backed->getVariable(id));
 
             nd4j_printf("Unable to get Variable to proxy: [%i]\n", id);
             throw std::runtime_error("Bad arguments");
@@ -138,7 +165,7 @@ namespace nd4j {
                 return _current->getVariable(id, idx);
             
             if (_backed->hasVariable(id, idx))
-                return _backed->getVariable(id, idx);
+                return shadow(_backed->getVariable(id, idx));
 
             nd4j_printf("Unable to get Variable to proxy: [%i:%i]\n", id, idx);
             throw std::runtime_error("Bad arguments");
@@ -150,7 +177,7 @@ namespace nd4j {
                 return _current->getVariable(pair);
             
             if (_backed->hasVariable(pair))
-                return _backed->getVariable(pair);
+                return shadow(_backed->getVariable(pair));
 
             nd4j_printf("Unable to get Variable to proxy: [%i:%i]\n", pair.first, pair.second);
             throw std::runtime_error("Bad arguments");
@@ -162,7 +189,7 @@ namespace nd4j {
                 return _current->getVariable(symbol);
             
             if (_backed->hasVariable(symbol))
-                return _backed->getVariable(symbol);
+                return shadow(_backed->getVariable(symbol));
 
             nd4j_printf("Unable to get Variable to proxy: [%s]\n", symbol->c_str());
             throw std::runtime_error("Bad arguments");
@@ -90,10 +90,12 @@ namespace nd4j {
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(std::string *symbol) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             return _symbolic.count(*symbol) == 1;
         }
 
         nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariable(std::string *symbol) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             return _symbolic.at(*symbol);
         }
 
@@ -132,6 +134,7 @@ namespace nd4j {
         }
 
         nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariable(std::pair<int, int>& pair) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
 //            if (pair.first == 0)
 //                throw "0 requested";
 
@@ -152,10 +155,12 @@ namespace nd4j {
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(int id) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             return _variables.count(id) == 1 || _temporary.count(id) == 1;
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(std::pair<int,int>& id) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             return _paired.count(id) > 0;
         }
 
@@ -235,6 +240,7 @@ namespace nd4j {
         }
 
         void nd4j::graph::VariableSpace::putVariable(std::pair<int,int>& pair, Variable *variable) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             silentPutVariable(pair, variable);
 
             if (variable->isPlaceholder())
@@ -257,10 +263,12 @@ namespace nd4j {
         }
 
         void VariableSpace::trackList(nd4j::NDArrayList* list) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             _lists.emplace_back(list);
         }
 
         void nd4j::graph::VariableSpace::putVariable(int id, Variable *variable) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             // we don't want to add variables more then once
             if (_variables.count(id) > 0 || _temporary.count(id) > 0) {
                 // nd4j_verbose("Trying to update variable for node_%i\n", id);
@@ -320,16 +328,14 @@ namespace nd4j {
         }
 
         nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariable(int id) {
-//            _varmap.lock();
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
 
             if (id < 0) {
                 auto  v = _variables.at(id);
-   //             _varmap.unlock();
 
                 return v;
             } else {
                 auto v = _temporary.at(id);
-    //            _varmap.unlock();
 
                 return v;
             }
@@ -25,32 +25,148 @@
 #include <dll.h>
 #include <pointercast.h>
 #include <map>
+#include <deque>
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <limits>
 #include <array/ShapeDescriptor.h>
 #include <array/TadDescriptor.h>
 #include <array/DataBuffer.h>
 #include <array/TadPack.h>
 
 namespace nd4j {
+    /**
+     * This class provides cached TAD packs.
+     *
+     * Cache is split into shards, and lookups of existing entries don't take any locks: entries are published into
+     * buckets atomically, and only insertions/evictions within the same shard are serialized.
+     *
+     * Optionally cache can be bounded, in this case least recently used entries are evicted within each shard.
+     * Evicted entries are reclaimed with epochs: each reader announces global epoch before walking buckets, and
+     * entry is released only once every reader active at the moment of its eviction has left the cache.
+     */
     class ND4J_EXPORT ConstantTadHelper {
     private:
+        static const int NUM_SHARDS = 16;
+        static const int NUM_BUCKETS = 256;
+
+        // epoch value of reader that isn't inside the cache right now
+        static const Nd4jLong IDLE = std::numeric_limits<Nd4jLong>::max();
+
+        class CacheEntry {
+        public:
+            TadDescriptor descriptor;
+
+            // pack handed out while cache isn't bounded: it doesn't hold any reference
+            TadPack pack;
+
+            // pack handed out while cache is bounded: it keeps buffers alive after eviction
+            TadPack ownedPack;
+
+            std::atomic<Nd4jLong> lastUsed;
+            std::atomic<CacheEntry*> next;
+
+            // true if non-owning pack was handed out at least once, so buffers can't be released on eviction
+            std::atomic<bool> pinned;
+
+            // epoch this entry was evicted at
+            Nd4jLong retiredAt = 0;
+
+            explicit CacheEntry(TadDescriptor &descriptor);
+            ~CacheEntry() = default;
+        };
+
+        class Shard {
+        public:
+            std::mutex mutex;
+            std::atomic<CacheEntry*> buckets[NUM_BUCKETS];
+            Nd4jLong size = 0;
+
+            // evicted entries, ordered by eviction epoch
+            std::deque<CacheEntry*> retired;
+
+            // buffers of evicted entries that might be still referenced by non-owning packs
+            std::vector<TadPack> pinned;
+
+            Shard();
+        };
+
+        /**
+         * Per-thread record: announced epoch and statistics counters, so hits don't touch any shared cache line.
+         * Records are never released, but they're reused once their thread is gone
+         */
+        class ReaderRecord {
+        public:
+            std::atomic<Nd4jLong> epoch;
+            std::atomic<bool> used;
+            std::atomic<Nd4jLong> hits;
+            std::atomic<Nd4jLong> misses;
+            ReaderRecord* next = nullptr;
+
+            // keeps records of different threads on separate cache lines
+            char padding[64];
+
+            ReaderRecord();
+        };
+
+        class ReaderHandle {
+        public:
+            ReaderRecord* record = nullptr;
+
+            ~ReaderHandle();
+        };
+
         static ConstantTadHelper *_INSTANCE;
 
-        std::mutex _mutex;
-        std::vector<std::map<TadDescriptor, TadPack>> _cache;
+        Shard _shards[NUM_SHARDS];
+
+        std::atomic<ReaderRecord*> _readers;
+        std::atomic<Nd4jLong> _epoch;
+
+        // 0 means cache isn't bounded
+        std::atomic<Nd4jLong> _capacity;
+        std::atomic<Nd4jLong> _clock;
+
+        std::atomic<Nd4jLong> _evictions;
 
         ConstantTadHelper();
+
+        ReaderRecord* reader();
+        CacheEntry* lookup(std::atomic<CacheEntry*> &bucket, TadDescriptor &descriptor);
+        TadPack handOut(CacheEntry *entry, Nd4jLong capacity);
+        void evict(Shard &shard);
+        void reclaim(Shard &shard);
     public:
         ~ConstantTadHelper() = default;
 
         static ConstantTadHelper* getInstance();
 
-        TadPack& tadForDimensions(Nd4jLong *originalShape, const std::vector<int> &dimensions);
-        TadPack& tadForDimensions(Nd4jLong *originalShape, int* dimensions, int dimLength);
-        TadPack& tadForDimensions(Nd4jLong *originalShape, int dimensions);
-        TadPack& tadForDimensions(ShapeDescriptor &descriptor, std::vector<int> &dimensions);
-        TadPack& tadForDimensions(TadDescriptor &descriptor);
+        /**
+         * These methods return TAD pack for given shape and dimensions.
+         * If cache is bounded, returned copy keeps underlying buffers alive, even if pack gets evicted from cache meanwhile.
+         * Otherwise cached packs live forever, and returned copy doesn't hold any reference
+         */
+        TadPack tadForDimensions(Nd4jLong *originalShape, const std::vector<int> &dimensions);
+        TadPack tadForDimensions(Nd4jLong *originalShape, int* dimensions, int dimLength);
+        TadPack tadForDimensions(Nd4jLong *originalShape, int dimensions);
+        TadPack tadForDimensions(ShapeDescriptor &descriptor, std::vector<int> &dimensions);
+        TadPack tadForDimensions(TadDescriptor &descriptor);
+
+        /**
+         * This method sets max number of cached TAD packs. 0 means no limit, which is default
+         */
+        void setCapacity(Nd4jLong capacity);
+        Nd4jLong capacity();
+
+        /**
+         * This method returns number of TAD packs currently cached
+         */
+        Nd4jLong cachedEntries();
+
+        Nd4jLong cacheHits();
+        Nd4jLong cacheMisses();
+        Nd4jLong cacheEvictions();
     };
 }
 
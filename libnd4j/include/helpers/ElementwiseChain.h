@@ -0,0 +1,99 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_ELEMENTWISECHAIN_H
+#define LIBND4J_ELEMENTWISECHAIN_H
+
+#include <NDArray.h>
+#include <op_enums.h>
+#include <vector>
+
+namespace nd4j {
+    /**
+     * This class records a chain of elementwise ops applied to one accumulator, i.e. z = op3(op2(op1(x, y1), s), y2) etc,
+     * and evaluates it in a single pass over memory.
+     *
+     * Fused evaluation is used when x, z and every array operand have the same shape, order and floating point data type, and ews == 1:
+     * the chain is applied block by block with the accumulator kept in cache, so no intermediate arrays are created.
+     * In all other cases, or if an op isn't supported by fused loop, recorded ops are executed one by one.
+     */
+    class ND4J_EXPORT ElementwiseChain {
+    protected:
+        enum StepType {
+            PAIRWISE,
+            SCALAR,
+            TRANSFORM_SAME,
+            TRANSFORM_FLOAT,
+            TRANSFORM_STRICT,
+        };
+
+        struct Step {
+            StepType type;
+            int op;
+            const NDArray *array;
+            double scalar;
+        };
+
+        const NDArray *_x;
+        std::vector<Step> _steps;
+
+        static bool isSupported(const Step &step);
+
+        template <typename T>
+        static void fusedLoop(const NDArray &x, const std::vector<Step> &steps, NDArray &z);
+
+        void executeFused(NDArray &z) const;
+        void executeSequential(NDArray &z) const;
+    public:
+        /**
+         * x must stay alive until chain is evaluated, same applies to all array operands
+         */
+        explicit ElementwiseChain(const NDArray &x);
+        ~ElementwiseChain() = default;
+
+        // accumulator = op(accumulator, y)
+        ElementwiseChain& apply(nd4j::pairwise::Ops op, const NDArray &y);
+
+        // accumulator = op(accumulator, scalar)
+        ElementwiseChain& apply(nd4j::scalar::Ops op, double scalar);
+
+        // accumulator = op(accumulator)
+        ElementwiseChain& apply(nd4j::transform::SameOps op);
+        ElementwiseChain& apply(nd4j::transform::FloatOps op);
+        ElementwiseChain& apply(nd4j::transform::StrictOps op);
+
+        /**
+         * returns true if chain will be evaluated in single pass into z
+         */
+        bool isFused(const NDArray &z) const;
+
+        /**
+         * evaluates chain into z, z may be the same array as x or any of operands
+         */
+        void execute(NDArray &z) const;
+
+        /**
+         * evaluates chain into new array of x shape and type
+         */
+        NDArray evaluate() const;
+    };
+}
+
+#endif //LIBND4J_ELEMENTWISECHAIN_H
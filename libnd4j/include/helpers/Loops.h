@@ -22,6 +22,7 @@
 #define LIBND4J_LOOPS_H
 
 #include <functional>
+#include <memory>
 #include <pointercast.h>
 #include <shape.h>
 #include <OmpLaunchHelper.h>
@@ -43,6 +44,10 @@ namespace nd4j {
         //////////////////////////////////////////////////////////////////////////////
         template <typename OpType>
         static FORCEINLINE void loopTadXZ(X* x, Nd4jLong* xShapeInfo, Z* z, Nd4jLong* zShapeInfo, Nd4jLong* tadShapeInfo, Nd4jLong* tadOffsets, E* extraParams);
+        //////////////////////////////////////////////////////////////////////////////
+        // reduces elements [start, end) of strided buffer, using independent accumulators and pairwise split of long ranges
+        template <typename OpType>
+        static auto reduceRange(X* x, const Nd4jLong stride, const Nd4jLong start, const Nd4jLong end, E* extraParams) -> decltype(OpType::startingValue(x));
     };
 
     template <typename X, typename Z>
@@ -383,6 +388,51 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
 
 
 
+//////////////////////////////////////////////////////////////////////////////
+    template<typename X, typename Z, typename E>
+    template <typename OpType>
+    auto nd4j::ReductionLoops<X, Z, E>::reduceRange(X* x, const Nd4jLong stride, const Nd4jLong start, const Nd4jLong end, E* extraParams) -> decltype(OpType::startingValue(x)) {
+
+        // long ranges are split in halves, so rounding error grows as log(N) instead of N
+        const Nd4jLong pairwiseBlock = 8192;
+        if (end - start > pairwiseBlock) {
+            const Nd4jLong middle = start + (end - start) / 2;
+            return OpType::update(reduceRange<OpType>(x, stride, start, middle, extraParams), reduceRange<OpType>(x, stride, middle, end, extraParams), extraParams);
+        }
+
+        // 4 independent accumulators break dependency chain between iterations
+        auto acc0 = OpType::startingValue(x);
+        auto acc1 = acc0;
+        auto acc2 = acc0;
+        auto acc3 = acc0;
+
+        Nd4jLong j = start;
+        if (stride == 1) {
+            for (; j + 4 <= end; j += 4) {
+                acc0 = OpType::update(acc0, OpType::op(x[j], extraParams), extraParams);
+                acc1 = OpType::update(acc1, OpType::op(x[j + 1], extraParams), extraParams);
+                acc2 = OpType::update(acc2, OpType::op(x[j + 2], extraParams), extraParams);
+                acc3 = OpType::update(acc3, OpType::op(x[j + 3], extraParams), extraParams);
+            }
+        }
+        else {
+            for (; j + 4 <= end; j += 4) {
+                acc0 = OpType::update(acc0, OpType::op(x[j * stride], extraParams), extraParams);
+                acc1 = OpType::update(acc1, OpType::op(x[(j + 1) * stride], extraParams), extraParams);
+                acc2 = OpType::update(acc2, OpType::op(x[(j + 2) * stride], extraParams), extraParams);
+                acc3 = OpType::update(acc3, OpType::op(x[(j + 3) * stride], extraParams), extraParams);
+            }
+        }
+
+        for (; j < end; j++)
+            acc0 = OpType::update(acc0, OpType::op(x[j * stride], extraParams), extraParams);
+
+        acc0 = OpType::update(acc0, acc1, extraParams);
+        acc2 = OpType::update(acc2, acc3, extraParams);
+
+        return OpType::update(acc0, acc2, extraParams);
+    }
+
 //////////////////////////////////////////////////////////////////////////////
     template<typename X, typename Z, typename E>
     template <typename OpType>
@@ -404,6 +454,59 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
 
         int numThreads = OmpLaunchHelper::tadThreads(tadLen, zLen);
 
+        // few long TADs: each TAD is split into chunks reduced by different threads, then partial results are combined
+        const int numChunks = kindOfLoop == SMALLARR2DX ? 1 : OmpLaunchHelper::tadChunks(tadLen, zLen);
+        if (numChunks > 1) {
+            uint castTadShapeInfo[MAX_RANK];
+            uint castZShapeInfo[MAX_RANK];
+            const bool canCastTad = nd4j::DataTypeUtils::castShapeInfo<uint>(tadShapeInfo, castTadShapeInfo);
+            const bool canCastZ   = nd4j::DataTypeUtils::castShapeInfo<uint>(zShapeInfo,   castZShapeInfo);
+
+            // TAD elements are accessible via single stride
+            Nd4jLong tadStep = 0;
+            if (kindOfLoop == EWS1 || kindOfLoop == EWSNONZERO || kindOfLoop == X_EWSNONZERO)
+                tadStep = tadEws;
+            else if (kindOfLoop == RANK1)
+                tadStep = tadStride[0];
+
+            const Nd4jLong chunkLen = (tadLen + numChunks - 1) / numChunks;
+            // std::vector isn't used here, since accumulator type might be bool
+            typedef decltype(OpType::startingValue(x)) AccType;
+            std::unique_ptr<AccType[]> partials(new AccType[zLen * numChunks]);
+
+            PRAGMA_OMP_PARALLEL_FOR_ARGS(num_threads(nd4j::math::nd4j_min<Nd4jLong>(zLen * numChunks, omp_get_max_threads())) collapse(2))
+            for (Nd4jLong i = 0; i < zLen; i++) {
+                for (int c = 0; c < numChunks; c++) {
+                    auto tad = x + tadOffsets[i];
+                    const Nd4jLong start = c * chunkLen;
+                    const Nd4jLong end = nd4j::math::nd4j_min<Nd4jLong>(start + chunkLen, tadLen);
+
+                    if (tadStep > 0) {
+                        partials[i * numChunks + c] = reduceRange<OpType>(tad, tadStep, start, end, extraParams);
+                    }
+                    else {
+                        auto acc = OpType::startingValue(tad);
+                        for (Nd4jLong j = start; j < end; j++) {
+                            auto tadOffset = shape::indexOffset(j, tadShapeInfo, castTadShapeInfo, tadLen, canCastTad);
+                            acc = OpType::update(acc, OpType::op(tad[tadOffset], extraParams), extraParams);
+                        }
+                        partials[i * numChunks + c] = acc;
+                    }
+                }
+            }
+
+            for (Nd4jLong i = 0; i < zLen; i++) {
+                auto start = partials[i * numChunks];
+                for (int c = 1; c < numChunks; c++)
+                    start = OpType::update(start, partials[i * numChunks + c], extraParams);
+
+                auto zOffset = shape::indexOffset(i, zShapeInfo, castZShapeInfo, zLen, canCastZ);
+                z[zOffset] = OpType::postProcess(start, tadLen, extraParams);
+            }
+
+            return;
+        }
+
         switch (kindOfLoop) {
             //*********************************************//
             // case SMALLARR2DX: {
@@ -446,10 +549,7 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
                 for (uint i = 0; i < zLen; i++) {
                     auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
-
-                    for (uint j = 0; j < tadLen; j++)
-                        start = OpType::update(start, OpType::op(tad[j], extraParams), extraParams);
+                    auto start = reduceRange<OpType>(tad, 1, 0, tadLen, extraParams);
 
                     z[i] = OpType::postProcess(start, tadLen, extraParams);
                 }
@@ -462,10 +562,7 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
                 for (uint i = 0; i < zLen; i++) {
                     auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
-
-                    for (uint j = 0; j < tadLen; j++)
-                        start = OpType::update(start, OpType::op(tad[j * tadEws], extraParams), extraParams);
+                    auto start = reduceRange<OpType>(tad, tadEws, 0, tadLen, extraParams);
 
                     z[i * zEws] = OpType::postProcess(start, tadLen, extraParams);
                 }
@@ -570,10 +667,7 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
                 for (uint i = 0; i < zLen; i++) {
                     auto tad = x + tadOffsets[i];
-                    auto start = OpType::startingValue(tad);
-
-                    for (uint j = 0; j < tadLen; j++)
-                        start = OpType::update(start, OpType::op(tad[j * tadEws], extraParams), extraParams);
+                    auto start = reduceRange<OpType>(tad, tadEws, 0, tadLen, extraParams);
 
                     auto zOffset = shape::indexOffset(i, zShapeInfo, castZShapeInfo, zLen, canCastZ);
                     z[zOffset] = OpType::postProcess(start, tadLen, extraParams);
@@ -27,11 +27,65 @@
 
 #ifdef HAVE_MKLDNN
 #include <mkldnn.hpp>
+#include <string>
+#include <vector>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <dll.h>
 
 namespace nd4j {
+    /**
+     * Primitives & memory descriptors built by MKLDNNStream, along with information about which of user arrays
+     * each memory wraps, so they can be reused for other arrays of the same shapes
+     */
+    class MKLDNNStreamState {
+    public:
+        std::vector<mkldnn::memory> memory;
+        std::vector<mkldnn::primitive> operations;
+
+        // index of array each memory wraps: inputs first, then outputs. -1 for memory allocated by MKL-DNN itself
+        std::vector<int> bindings;
+    };
+
+    /**
+     * This class holds MKL-DNN primitives built for some op, keyed by op name, shapes, data types and arguments.
+     * Each state can be used by one stream at a time, so streams check states out, and return them back once done.
+     */
+    class ND4J_EXPORT MKLDNNPrimitiveCache {
+    private:
+        static MKLDNNPrimitiveCache *_INSTANCE;
+
+        std::mutex _mutex;
+
+        // most recently returned states go first
+        std::list<std::pair<std::string, MKLDNNStreamState>> _states;
+        std::unordered_multimap<std::string, std::list<std::pair<std::string, MKLDNNStreamState>>::iterator> _index;
+
+        size_t _limit = 1024;
+
+        MKLDNNPrimitiveCache() = default;
+    public:
+        static MKLDNNPrimitiveCache* getInstance();
+
+        /**
+         * This method moves cached state for given key into state argument, and returns true if one was available
+         */
+        bool checkout(const std::string &key, MKLDNNStreamState &state);
+
+        /**
+         * This method returns state back into cache, so other streams with the same key can reuse it
+         */
+        void checkin(const std::string &key, MKLDNNStreamState &state);
+
+        void setLimit(size_t limit);
+        size_t size();
+    };
+
     class MKLDNNStream {
     protected:
         std::string _opName;
+        std::string _key;
 
         std::vector<const NDArray*> _inputs;
         std::vector<const NDArray*> _outputs;
@@ -41,6 +95,88 @@ namespace nd4j {
         mkldnn::engine _engine = mkldnn::engine(mkldnn::engine::cpu, 0);
         std::vector<mkldnn::memory> _memory;
         std::vector<mkldnn::primitive> _operations;
+        std::vector<int> _bindings;
+
+        // false if some memory can't be attributed to exactly one array, so primitives can't be rebound to other arrays
+        bool _reusable = true;
+
+        static void appendArray(std::string &key, const NDArray* array) {
+            if (array == nullptr) {
+                key += 'n';
+                return;
+            }
+
+            auto shapeInfo = array->getShapeInfo();
+            key.append(reinterpret_cast<const char *>(shapeInfo), shape::shapeInfoByteLength(shapeInfo));
+        }
+
+        static std::string buildKey(const std::string &opName, const std::vector<const NDArray*> &inputs, const std::vector<const NDArray*> &outputs,
+                const std::vector<float> &floatArguments, const std::vector<int> &intArguments) {
+            std::string key(opName);
+            key += '\0';
+
+            for (auto v: inputs)
+                appendArray(key, v);
+
+            key += '|';
+            for (auto v: outputs)
+                appendArray(key, v);
+
+            key += '|';
+            key.append(reinterpret_cast<const char *>(floatArguments.data()), floatArguments.size() * sizeof(float));
+            key += '|';
+            key.append(reinterpret_cast<const char *>(intArguments.data()), intArguments.size() * sizeof(int));
+
+            return key;
+        }
+
+        const NDArray* arrayAt(int index) {
+            return index < (int) _inputs.size() ? _inputs[index] : _outputs[index - _inputs.size()];
+        }
+
+        int bindingOf(const mkldnn::memory &memory) {
+            auto handle = memory.get_data_handle();
+            int result = -1;
+            for (int e = 0; e < (int) (_inputs.size() + _outputs.size()); e++) {
+                auto array = arrayAt(e);
+                if (array == nullptr || const_cast<NDArray*>(array)->buffer() != handle)
+                    continue;
+
+                if (result >= 0)
+                    _reusable = false;
+
+                result = e;
+            }
+
+            return result;
+        }
+
+        /**
+         * This method points user memories to buffers of current arrays
+         */
+        void rebind() {
+            for (int e = 0; e < (int) _memory.size(); e++)
+                if (_bindings[e] >= 0)
+                    _memory[e].set_data_handle(const_cast<NDArray*>(arrayAt(_bindings[e]))->buffer());
+        }
+
+        /**
+         * This method returns built primitives into global cache
+         */
+        void release() {
+            if (!_key.empty() && !_operations.empty() && _reusable) {
+                MKLDNNStreamState state;
+                state.memory = std::move(_memory);
+                state.operations = std::move(_operations);
+                state.bindings = std::move(_bindings);
+                MKLDNNPrimitiveCache::getInstance()->checkin(_key, state);
+            }
+
+            _memory.clear();
+            _operations.clear();
+            _bindings.clear();
+            _key.clear();
+        }
 
     public:
         template <typename X, typename Y>
@@ -59,26 +195,88 @@ namespace nd4j {
 
         MKLDNNStream(const std::string &opName) : _opName(opName) { }
 
+        // primitives are never shared between streams, so copy starts empty
+        MKLDNNStream(const MKLDNNStream &other) : _opName(other._opName), _engine(other._engine) { }
+
+        MKLDNNStream(MKLDNNStream &&other) noexcept : _opName(std::move(other._opName)), _key(std::move(other._key)),
+                _inputs(std::move(other._inputs)), _outputs(std::move(other._outputs)),
+                _floatArguments(std::move(other._floatArguments)), _intArguments(std::move(other._intArguments)),
+                _engine(other._engine), _memory(std::move(other._memory)), _operations(std::move(other._operations)),
+                _bindings(std::move(other._bindings)), _reusable(other._reusable) {
+            other._key.clear();
+            other._operations.clear();
+        }
+
+        MKLDNNStream& operator=(const MKLDNNStream &other) {
+            if (this != &other) {
+                release();
+                _opName = other._opName;
+                _engine = other._engine;
+                _inputs.clear();
+                _outputs.clear();
+            }
+            return *this;
+        }
+
+        ~MKLDNNStream() {
+            release();
+        }
+
+        /**
+         * This method returns true if primitives have to be built for given arrays & arguments.
+         * Otherwise primitives built earlier for the same shapes and arguments (by this or any other stream) are reused,
+         * with memory pointed to given arrays.
+         */
         bool checkAndReset(const std::vector<const NDArray*> &inputs, const std::vector<const NDArray*> &outputs,
                 const std::vector<float> &floatArguments, const std::vector<int> &intArguments) {
-            if (inputs != _inputs || outputs != _outputs || floatArguments != _floatArguments || intArguments != _intArguments) {
-                _inputs = inputs;
-                _outputs = outputs;
-                _floatArguments = floatArguments;
-                _intArguments = intArguments;
-                _operations.clear();
-                _memory.clear();
-                return true;
+            if (inputs == _inputs && outputs == _outputs && floatArguments == _floatArguments && intArguments == _intArguments)
+                return false;
+
+            auto key = buildKey(_opName, inputs, outputs, floatArguments, intArguments);
+
+            if (key != _key || !_reusable)
+                release();
+
+            _inputs = inputs;
+            _outputs = outputs;
+            _floatArguments = floatArguments;
+            _intArguments = intArguments;
+
+            if (key == _key) {
+                rebind();
+                return false;
             }
-            return false;
+
+            _key = key;
+            _reusable = true;
+
+            MKLDNNStreamState state;
+            if (MKLDNNPrimitiveCache::getInstance()->checkout(_key, state)) {
+                _memory = std::move(state.memory);
+                _operations = std::move(state.operations);
+                _bindings = std::move(state.bindings);
+                rebind();
+                return false;
+            }
+
+            nd4j_debug("Building MKL-DNN primitives for %s\n", _opName.c_str());
+            return true;
         }
 
         const mkldnn::engine &getEngine() { return _engine; }
         void setEngine(const mkldnn::engine &engine) { _engine = engine; }
 
         const std::vector<mkldnn::memory> &getMemory() { return _memory; }
-        void setMemory(const std::vector<mkldnn::memory> &memory) { _memory = memory; }
-        void addMemory(const mkldnn::memory &memory) { _memory.push_back(memory); }
+        void setMemory(const std::vector<mkldnn::memory> &memory) {
+            _memory.clear();
+            _bindings.clear();
+            for (auto &m: memory)
+                addMemory(m);
+        }
+        void addMemory(const mkldnn::memory &memory) {
+            _memory.push_back(memory);
+            _bindings.push_back(bindingOf(memory));
+        }
 
         const std::vector<mkldnn::primitive> &getOperations() { return _operations; }
         void setOperations(const std::vector<mkldnn::primitive> &operations) { _operations = operations; }
@@ -47,6 +47,11 @@ class OmpLaunchHelper {
 
         static int tadThreads(Nd4jLong tadLength, Nd4jLong numTads);
 
+        /**
+         * This method returns number of chunks each TAD should be split into, so few long TADs are reduced by multiple threads
+         */
+        static int tadChunks(Nd4jLong tadLength, Nd4jLong numTads);
+
         int _numThreads;
 		unsigned int _itersPerThread;
         unsigned int _remainder;
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_SELECTION_H
+#define LIBND4J_SELECTION_H
+
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <helpers/shape.h>
+#include <algorithm>
+
+namespace nd4j {
+    /**
+     * This class provides order statistics over TADs without full sort: each TAD is copied into contiguous
+     * buffer, and k-th element is found with introselect (std::nth_element), which is O(N) on average
+     */
+    template <typename T>
+    class Selection {
+    protected:
+        // NaNs are placed after all other values, so ordering stays strict weak
+        static FORCEINLINE bool lessThan(const T a, const T b) {
+            return a < b || (b != b && a == a);
+        }
+
+    public:
+        /**
+         * This method copies TAD into contiguous buffer
+         *
+         * @param x - pointer to the first element of TAD
+         * @param tadShapeInfo - TAD shape info
+         * @param length - TAD length
+         * @param buffer - output buffer, at least length elements
+         */
+        static void gather(const T* x, const Nd4jLong* tadShapeInfo, const Nd4jLong length, T* buffer) {
+            const auto ews = shape::elementWiseStride(tadShapeInfo);
+            if (ews == 1 && shape::order(tadShapeInfo) == 'c')
+                std::copy(x, x + length, buffer);
+            else if (ews >= 1 && shape::order(tadShapeInfo) == 'c')
+                for (Nd4jLong e = 0; e < length; e++)
+                    buffer[e] = x[e * ews];
+            else
+                for (Nd4jLong e = 0; e < length; e++)
+                    buffer[e] = x[shape::getIndexOffset(e, tadShapeInfo, length)];
+        }
+
+        /**
+         * This method returns element which would be at position k if buffer was sorted in ascending order.
+         * Buffer is partially reordered
+         */
+        static T select(T* buffer, const Nd4jLong length, const Nd4jLong k) {
+            std::nth_element(buffer, buffer + k, buffer + length, lessThan);
+            return buffer[k];
+        }
+    };
+}
+
+#endif //LIBND4J_SELECTION_H
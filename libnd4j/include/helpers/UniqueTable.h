@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_UNIQUETABLE_H
+#define LIBND4J_UNIQUETABLE_H
+
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <helpers/OmpLaunchHelper.h>
+#include <Environment.h>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+namespace nd4j {
+    /**
+     * This class is open addressing hash table of distinct values, used by unique, listdiff and similar ops.
+     *
+     * Distinct values are kept in order of their first occurrence, together with number of occurrences and
+     * position of the first occurrence. Hash slots store only ids of distinct values, so table stays compact.
+     */
+    template <typename T>
+    class UniqueTable {
+    protected:
+        std::vector<T> _values;
+        std::vector<Nd4jLong> _counts;
+        std::vector<Nd4jLong> _first;
+
+        // ids of distinct values, -1 for empty slot. Capacity is always power of 2
+        std::vector<Nd4jLong> _slots;
+        uint64_t _mask = 0;
+
+        static FORCEINLINE uint64_t hashOf(T value) {
+            // +0.0 and -0.0 are equal, so they must have equal hash. Same applies to NaNs
+            if (value == static_cast<T>(0))
+                value = static_cast<T>(0);
+            else if (value != value)
+                return 0;
+
+            uint64_t bits = 0;
+            memcpy(&bits, &value, sizeof(T) < sizeof(uint64_t) ? sizeof(T) : sizeof(uint64_t));
+
+            // splitmix64 finalizer
+            bits ^= bits >> 30;
+            bits *= 0xbf58476d1ce4e5b9ULL;
+            bits ^= bits >> 27;
+            bits *= 0x94d049bb133111ebULL;
+            bits ^= bits >> 31;
+            return bits;
+        }
+
+        // NaN values are considered equal to each other, so they end up as single distinct value
+        static FORCEINLINE bool isSame(const T a, const T b) {
+            return a == b || (a != a && b != b);
+        }
+
+        void rehash(Nd4jLong capacity) {
+            uint64_t size = 16;
+            while (size < (uint64_t) capacity)
+                size <<= 1;
+
+            _slots.assign(size, -1);
+            _mask = size - 1;
+
+            for (Nd4jLong id = 0; id < (Nd4jLong) _values.size(); id++) {
+                auto slot = hashOf(_values[id]) & _mask;
+                while (_slots[slot] >= 0)
+                    slot = (slot + 1) & _mask;
+
+                _slots[slot] = id;
+            }
+        }
+
+    public:
+        explicit UniqueTable(Nd4jLong expected = 16) {
+            rehash(2 * expected);
+        }
+
+        ~UniqueTable() = default;
+
+        /**
+         * This method returns id of given value, adding it to the table if it's not there yet
+         *
+         * @param value
+         * @param position - position of this occurrence in the input
+         * @param count - number of occurrences to add
+         */
+        Nd4jLong insert(const T value, const Nd4jLong position, const Nd4jLong count = 1) {
+            auto slot = hashOf(value) & _mask;
+            while (_slots[slot] >= 0) {
+                auto id = _slots[slot];
+                if (isSame(_values[id], value)) {
+                    _counts[id] += count;
+                    return id;
+                }
+
+                slot = (slot + 1) & _mask;
+            }
+
+            auto id = (Nd4jLong) _values.size();
+            _slots[slot] = id;
+            _values.emplace_back(value);
+            _counts.emplace_back(count);
+            _first.emplace_back(position);
+
+            // load factor is kept below 1/2
+            if (2 * _values.size() > _slots.size())
+                rehash(2 * _slots.size());
+
+            return id;
+        }
+
+        /**
+         * This method returns id of given value, or -1 if there's no such value in the table
+         */
+        Nd4jLong find(const T value) const {
+            auto slot = hashOf(value) & _mask;
+            while (_slots[slot] >= 0) {
+                auto id = _slots[slot];
+                if (isSame(_values[id], value))
+                    return id;
+
+                slot = (slot + 1) & _mask;
+            }
+
+            return -1;
+        }
+
+        /**
+         * This method builds table from strided buffer. Large inputs are split into chunks, hashed in parallel and
+         * merged in chunk order, so order of first occurrences is the same as for sequential build
+         */
+        void build(const T* buffer, const Nd4jLong length, const Nd4jLong stride = 1) {
+            const int numChunks = OmpLaunchHelper::betterThreads(length);
+
+            if (numChunks <= 1) {
+                for (Nd4jLong e = 0; e < length; e++)
+                    insert(buffer[e * stride], e);
+
+                return;
+            }
+
+            std::vector<UniqueTable<T>*> partial(numChunks);
+            const Nd4jLong span = length / numChunks + 1;
+
+            PRAGMA_OMP_PARALLEL_FOR_THREADS(numChunks)
+            for (int c = 0; c < numChunks; c++) {
+                const Nd4jLong start = c * span;
+                const Nd4jLong end = start + span < length ? start + span : length;
+
+                auto table = new UniqueTable<T>(span / 4);
+                for (Nd4jLong e = start; e < end; e++)
+                    table->insert(buffer[e * stride], e);
+
+                partial[c] = table;
+            }
+
+            for (auto table: partial) {
+                for (Nd4jLong id = 0; id < table->size(); id++)
+                    insert(table->_values[id], table->_first[id], table->_counts[id]);
+
+                delete table;
+            }
+        }
+
+        /**
+         * This method stores id of each input element into output buffer
+         */
+        void lookup(const T* buffer, const Nd4jLong length, const Nd4jLong stride, Nd4jLong* ids) const {
+            PRAGMA_OMP_PARALLEL_FOR_IF(length > Environment::getInstance()->elementwiseThreshold())
+            for (Nd4jLong e = 0; e < length; e++)
+                ids[e] = find(buffer[e * stride]);
+        }
+
+        Nd4jLong size() const {
+            return (Nd4jLong) _values.size();
+        }
+
+        const std::vector<T>& values() const {
+            return _values;
+        }
+
+        const std::vector<Nd4jLong>& counts() const {
+            return _counts;
+        }
+
+        const std::vector<Nd4jLong>& firstPositions() const {
+            return _first;
+        }
+    };
+}
+
+#endif //LIBND4J_UNIQUETABLE_H
@@ -22,9 +22,60 @@
 #include <TAD.h>
 
 namespace nd4j {
+    ConstantTadHelper::CacheEntry::CacheEntry(TadDescriptor &descriptor) : descriptor(descriptor) {
+        auto shapeInfo = descriptor.originalShape().toShapeInfo();
+        shape::TAD tad;
+        tad.init(shapeInfo, descriptor.axis().data(), descriptor.axis().size());
+        tad.createTadOnlyShapeInfo();
+        tad.createOffsets();
+
+        auto sPtr = new Nd4jLong[shape::shapeInfoLength(tad.tadOnlyShapeInfo)];
+        auto oPtr = new Nd4jLong[tad.numTads];
+
+        memcpy(sPtr, tad.tadOnlyShapeInfo, shape::shapeInfoByteLength(tad.tadOnlyShapeInfo));
+        memcpy(oPtr, tad.tadOffsets, tad.numTads * sizeof(Nd4jLong));
+
+        DataBuffer shapesBuffer(sPtr, nullptr);
+        DataBuffer offsetsBuffer(oPtr, nullptr);
+        std::shared_ptr<void> owner(sPtr, [oPtr] (void *ptr) {
+            delete[] reinterpret_cast<Nd4jLong *>(ptr);
+            delete[] oPtr;
+        });
+
+        pack = TadPack(shapesBuffer, offsetsBuffer, tad.numTads);
+        ownedPack = TadPack(shapesBuffer, offsetsBuffer, tad.numTads, owner);
+
+        lastUsed = 0;
+        next = nullptr;
+        pinned = false;
+
+        delete[] shapeInfo;
+    }
+
+    ConstantTadHelper::Shard::Shard() {
+        for (int e = 0; e < NUM_BUCKETS; e++)
+            buckets[e] = nullptr;
+    }
+
+    ConstantTadHelper::ReaderRecord::ReaderRecord() {
+        epoch = IDLE;
+        used = false;
+        hits = 0;
+        misses = 0;
+    }
+
+    ConstantTadHelper::ReaderHandle::~ReaderHandle() {
+        // record becomes available for other threads
+        if (record != nullptr)
+            record->used.store(false, std::memory_order_release);
+    }
+
     ConstantTadHelper::ConstantTadHelper() {
-        std::map<TadDescriptor, TadPack> pack;
-        _cache.emplace_back(pack);
+        _readers = nullptr;
+        _epoch = 0;
+        _capacity = 0;
+        _clock = 0;
+        _evictions = 0;
     }
 
     ConstantTadHelper* ConstantTadHelper::getInstance() {
@@ -34,59 +85,224 @@ namespace nd4j {
         return _INSTANCE;
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(Nd4jLong *originalShape, int dimensions) {
+    ConstantTadHelper::ReaderRecord* ConstantTadHelper::reader() {
+        static thread_local ReaderHandle handle;
+        if (handle.record != nullptr)
+            return handle.record;
+
+        // trying to reuse record of some finished thread first
+        for (auto r = _readers.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+            bool expected = false;
+            if (!r->used.load(std::memory_order_relaxed) && r->used.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                handle.record = r;
+                return r;
+            }
+        }
+
+        auto record = new ReaderRecord();
+        record->used = true;
+
+        auto head = _readers.load(std::memory_order_relaxed);
+        do {
+            record->next = head;
+        } while (!_readers.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+
+        handle.record = record;
+        return record;
+    }
+
+    TadPack ConstantTadHelper::tadForDimensions(Nd4jLong *originalShape, int dimensions) {
         return tadForDimensions(originalShape, &dimensions, 1);
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(Nd4jLong *originalShape, const std::vector<int> &dimensions) {
+    TadPack ConstantTadHelper::tadForDimensions(Nd4jLong *originalShape, const std::vector<int> &dimensions) {
         return tadForDimensions(originalShape, const_cast<int *>(dimensions.data()), dimensions.size());
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(Nd4jLong *originalShape, int* dimensions, int dimLength) {
+    TadPack ConstantTadHelper::tadForDimensions(Nd4jLong *originalShape, int* dimensions, int dimLength) {
         TadDescriptor tadDescriptor(originalShape, dimensions, dimLength);
         return tadForDimensions(tadDescriptor);
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(ShapeDescriptor &descriptor, std::vector<int> &dimensions) {
+    TadPack ConstantTadHelper::tadForDimensions(ShapeDescriptor &descriptor, std::vector<int> &dimensions) {
         TadDescriptor tadDescriptor(descriptor, dimensions);
         return tadForDimensions(tadDescriptor);
     }
 
-    TadPack& ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
-        const int deviceId = 0;
+    ConstantTadHelper::CacheEntry* ConstantTadHelper::lookup(std::atomic<CacheEntry*> &bucket, TadDescriptor &descriptor) {
+        for (auto e = bucket.load(std::memory_order_acquire); e != nullptr; e = e->next.load(std::memory_order_acquire))
+            if (e->descriptor == descriptor)
+                return e;
 
-        _mutex.lock();
-        if (_cache[deviceId].count(descriptor) == 0) {
-            auto shapeInfo = descriptor.originalShape().toShapeInfo();
-            shape::TAD tad;
-            tad.init(shapeInfo, descriptor.axis().data(), descriptor.axis().size());
-            tad.createTadOnlyShapeInfo();
-            tad.createOffsets();
+        return nullptr;
+    }
+
+    TadPack ConstantTadHelper::handOut(CacheEntry *entry, Nd4jLong capacity) {
+        if (capacity > 0)
+            return entry->ownedPack;
+
+        // non-owning copy is out there now, so buffers of this entry must outlive any later eviction
+        if (!entry->pinned.load(std::memory_order_relaxed))
+            entry->pinned.store(true, std::memory_order_relaxed);
+
+        return entry->pack;
+    }
 
-            auto sPtr = new Nd4jLong[shape::shapeInfoLength(tad.tadOnlyShapeInfo)];
-            auto oPtr = new Nd4jLong[tad.numTads];
+    TadPack ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
+        auto hash = static_cast<uint64_t>(descriptor.hash());
+        auto &shard = _shards[hash % NUM_SHARDS];
+        auto &bucket = shard.buckets[(hash / NUM_SHARDS) % NUM_BUCKETS];
+        auto capacity = _capacity.load(std::memory_order_relaxed);
+        auto record = reader();
 
-            memcpy(sPtr, tad.tadOnlyShapeInfo, shape::shapeInfoByteLength(tad.tadOnlyShapeInfo));
-            memcpy(oPtr, tad.tadOffsets, tad.numTads * sizeof(Nd4jLong));
+        // fast path: no locks for entries that are already cached. epoch is announced before touching any entry
+        record->epoch.store(_epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto entry = lookup(bucket, descriptor);
+        if (entry != nullptr) {
+            // clock only moves on misses, so repeated hits don't write into shared entry
+            if (capacity > 0) {
+                auto clock = _clock.load(std::memory_order_relaxed);
+                if (entry->lastUsed.load(std::memory_order_relaxed) != clock)
+                    entry->lastUsed.store(clock, std::memory_order_relaxed);
+            }
+
+            auto result = handOut(entry, capacity);
+            record->epoch.store(IDLE, std::memory_order_release);
+
+            // only owner thread updates its counters
+            record->hits.store(record->hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return result;
+        }
+
+        record->epoch.store(IDLE, std::memory_order_release);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        // other thread might have created this pack while we were waiting for the lock
+        entry = lookup(bucket, descriptor);
+        if (entry != nullptr) {
+            record->hits.store(record->hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return handOut(entry, capacity);
+        }
 
-            DataBuffer shapesBuffer(sPtr, nullptr);
-            DataBuffer offsetsBuffer(oPtr, nullptr);
-            TadPack t(shapesBuffer, offsetsBuffer, tad.numTads);
-            _cache[deviceId][descriptor] = t;
+        record->misses.store(record->misses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 
-            TadPack &r = _cache[deviceId][descriptor];
-            _mutex.unlock();
+        entry = new CacheEntry(descriptor);
+        entry->lastUsed = _clock.fetch_add(1, std::memory_order_relaxed) + 1;
+        entry->next.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
 
-            delete[] shapeInfo;
+        // entry is fully built before it becomes visible to lock-free readers
+        bucket.store(entry, std::memory_order_release);
+        shard.size++;
 
-            return r;
+        auto result = handOut(entry, capacity);
+
+        if (capacity > 0) {
+            auto shardCapacity = nd4j::math::nd4j_max<Nd4jLong>(1, (capacity + NUM_SHARDS - 1) / NUM_SHARDS);
+            while (shard.size > shardCapacity)
+                evict(shard);
+        }
+
+        return result;
+    }
+
+    void ConstantTadHelper::evict(Shard &shard) {
+        // looking for least recently used entry within this shard. newest entry has the highest stamp, so it's never picked
+        CacheEntry* victim = nullptr;
+        int victimBucket = -1;
+        for (int b = 0; b < NUM_BUCKETS; b++) {
+            for (auto e = shard.buckets[b].load(std::memory_order_relaxed); e != nullptr; e = e->next.load(std::memory_order_relaxed)) {
+                if (victim == nullptr || e->lastUsed.load(std::memory_order_relaxed) < victim->lastUsed.load(std::memory_order_relaxed)) {
+                    victim = e;
+                    victimBucket = b;
+                }
+            }
+        }
+
+        if (victim == nullptr)
+            return;
+
+        // unlinking victim. readers standing on it can still move forward, since its own link stays intact
+        auto &bucket = shard.buckets[victimBucket];
+        auto next = victim->next.load(std::memory_order_relaxed);
+        if (bucket.load(std::memory_order_relaxed) == victim) {
+            bucket.store(next, std::memory_order_release);
         } else {
-            TadPack &r = _cache[deviceId][descriptor];
-            _mutex.unlock();
+            auto prev = bucket.load(std::memory_order_relaxed);
+            while (prev->next.load(std::memory_order_relaxed) != victim)
+                prev = prev->next.load(std::memory_order_relaxed);
+
+            prev->next.store(next, std::memory_order_release);
+        }
+
+        shard.size--;
+        _evictions++;
+
+        // readers that announce newer epoch are guaranteed to not see the victim anymore
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        victim->retiredAt = _epoch.fetch_add(1);
+
+        shard.retired.emplace_back(victim);
+        reclaim(shard);
+    }
+
+    void ConstantTadHelper::reclaim(Shard &shard) {
+        // oldest epoch announced by readers that are inside the cache right now
+        auto oldest = IDLE;
+        for (auto r = _readers.load(std::memory_order_acquire); r != nullptr; r = r->next)
+            oldest = nd4j::math::nd4j_min<Nd4jLong>(oldest, r->epoch.load(std::memory_order_acquire));
+
+        while (!shard.retired.empty() && shard.retired.front()->retiredAt < oldest) {
+            auto entry = shard.retired.front();
+            shard.retired.pop_front();
+
+            // non-owning copies of this pack might be still in use, so buffers are kept
+            if (entry->pinned.load(std::memory_order_relaxed))
+                shard.pinned.emplace_back(entry->ownedPack);
 
-            return r;
+            delete entry;
         }
     }
 
+    void ConstantTadHelper::setCapacity(Nd4jLong capacity) {
+        _capacity = capacity > 0 ? capacity : 0;
+    }
+
+    Nd4jLong ConstantTadHelper::capacity() {
+        return _capacity.load();
+    }
+
+    Nd4jLong ConstantTadHelper::cachedEntries() {
+        Nd4jLong result = 0;
+        for (int e = 0; e < NUM_SHARDS; e++) {
+            std::lock_guard<std::mutex> lock(_shards[e].mutex);
+            result += _shards[e].size;
+        }
+
+        return result;
+    }
+
+    Nd4jLong ConstantTadHelper::cacheHits() {
+        Nd4jLong result = 0;
+        for (auto r = _readers.load(std::memory_order_acquire); r != nullptr; r = r->next)
+            result += r->hits.load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+    Nd4jLong ConstantTadHelper::cacheMisses() {
+        Nd4jLong result = 0;
+        for (auto r = _readers.load(std::memory_order_acquire); r != nullptr; r = r->next)
+            result += r->misses.load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+    Nd4jLong ConstantTadHelper::cacheEvictions() {
+        return _evictions.load();
+    }
+
     nd4j::ConstantTadHelper* nd4j::ConstantTadHelper::_INSTANCE = 0;
-}
\ No newline at end of file
+}
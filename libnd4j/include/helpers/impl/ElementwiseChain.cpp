@@ -0,0 +1,297 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <helpers/ElementwiseChain.h>
+#include <NDArrayFactory.h>
+#include <ops/ops.h>
+#include <templatemath.h>
+
+namespace nd4j {
+    // number of elements processed by one step of fused loop, accumulator block has to stay in L1
+    static const Nd4jLong CHAIN_BLOCK = 1024;
+
+    ElementwiseChain::ElementwiseChain(const NDArray &x) {
+        _x = &x;
+    }
+
+    ElementwiseChain& ElementwiseChain::apply(nd4j::pairwise::Ops op, const NDArray &y) {
+        _steps.push_back({PAIRWISE, static_cast<int>(op), &y, 0.0});
+        return *this;
+    }
+
+    ElementwiseChain& ElementwiseChain::apply(nd4j::scalar::Ops op, double scalar) {
+        _steps.push_back({SCALAR, static_cast<int>(op), nullptr, scalar});
+        return *this;
+    }
+
+    ElementwiseChain& ElementwiseChain::apply(nd4j::transform::SameOps op) {
+        _steps.push_back({TRANSFORM_SAME, static_cast<int>(op), nullptr, 0.0});
+        return *this;
+    }
+
+    ElementwiseChain& ElementwiseChain::apply(nd4j::transform::FloatOps op) {
+        _steps.push_back({TRANSFORM_FLOAT, static_cast<int>(op), nullptr, 0.0});
+        return *this;
+    }
+
+    ElementwiseChain& ElementwiseChain::apply(nd4j::transform::StrictOps op) {
+        _steps.push_back({TRANSFORM_STRICT, static_cast<int>(op), nullptr, 0.0});
+        return *this;
+    }
+
+    bool ElementwiseChain::isSupported(const Step &step) {
+        switch (step.type) {
+            case PAIRWISE:
+                switch (step.op) {
+                    case nd4j::pairwise::Add:
+                    case nd4j::pairwise::Subtract:
+                    case nd4j::pairwise::Multiply:
+                    case nd4j::pairwise::Divide:
+                    case nd4j::pairwise::ReverseSubtract:
+                    case nd4j::pairwise::ReverseDivide:
+                        return true;
+                    default:
+                        return false;
+                }
+            case SCALAR:
+                switch (step.op) {
+                    case nd4j::scalar::Add:
+                    case nd4j::scalar::Subtract:
+                    case nd4j::scalar::Multiply:
+                    case nd4j::scalar::Divide:
+                    case nd4j::scalar::ReverseSubtract:
+                    case nd4j::scalar::ReverseDivide:
+                        return true;
+                    default:
+                        return false;
+                }
+            case TRANSFORM_SAME:
+                return step.op == nd4j::transform::Neg || step.op == nd4j::transform::Abs || step.op == nd4j::transform::Square;
+            case TRANSFORM_FLOAT:
+                return step.op == nd4j::transform::Sqrt;
+            case TRANSFORM_STRICT:
+                return step.op == nd4j::transform::Sigmoid || step.op == nd4j::transform::Tanh || step.op == nd4j::transform::Exp || step.op == nd4j::transform::Log;
+            default:
+                return false;
+        }
+    }
+
+    static FORCEINLINE bool isFusableOperand(const NDArray &arr, const NDArray &x) {
+        return !arr.isEmpty() && arr.dataType() == x.dataType() && arr.ews() == 1 && arr.ordering() == x.ordering() && shape::equalsSoft(arr.getShapeInfo(), x.getShapeInfo());
+    }
+
+    bool ElementwiseChain::isFused(const NDArray &z) const {
+        if (_steps.empty() || !_x->isR() || !isFusableOperand(*_x, *_x) || !isFusableOperand(z, *_x))
+            return false;
+
+        for (const auto &step : _steps) {
+            if (!isSupported(step))
+                return false;
+
+            if (step.array != nullptr && !isFusableOperand(*step.array, *_x))
+                return false;
+        }
+
+        return true;
+    }
+
+    template <typename OpType, typename T>
+    static FORCEINLINE void pairwiseBlock(T *acc, const T *y, const Nd4jLong length) {
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong e = 0; e < length; e++)
+            acc[e] = OpType::op(acc[e], y[e]);
+    }
+
+    template <typename OpType, typename T>
+    static FORCEINLINE void scalarBlock(T *acc, const T scalar, const Nd4jLong length) {
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong e = 0; e < length; e++)
+            acc[e] = OpType::op(acc[e], scalar);
+    }
+
+    template <typename OpType, typename T>
+    static FORCEINLINE void transformBlock(T *acc, const Nd4jLong length) {
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong e = 0; e < length; e++)
+            acc[e] = OpType::op(acc[e], nullptr);
+    }
+
+    template <typename T>
+    static void applyPairwise(const int op, T *acc, const T *y, const Nd4jLong length) {
+        switch (op) {
+            case nd4j::pairwise::Add: pairwiseBlock<simdOps::Add<T,T,T>>(acc, y, length); break;
+            case nd4j::pairwise::Subtract: pairwiseBlock<simdOps::Subtract<T,T,T>>(acc, y, length); break;
+            case nd4j::pairwise::Multiply: pairwiseBlock<simdOps::Multiply<T,T,T>>(acc, y, length); break;
+            case nd4j::pairwise::Divide: pairwiseBlock<simdOps::Divide<T,T,T>>(acc, y, length); break;
+            case nd4j::pairwise::ReverseSubtract: pairwiseBlock<simdOps::ReverseSubtract<T,T,T>>(acc, y, length); break;
+            case nd4j::pairwise::ReverseDivide: pairwiseBlock<simdOps::ReverseDivide<T,T,T>>(acc, y, length); break;
+            default: throw std::runtime_error("ElementwiseChain: unsupported pairwise op");
+        }
+    }
+
+    template <typename T>
+    static void applyScalar(const int op, T *acc, const T scalar, const Nd4jLong length) {
+        switch (op) {
+            case nd4j::scalar::Add: scalarBlock<simdOps::Add<T,T,T>>(acc, scalar, length); break;
+            case nd4j::scalar::Subtract: scalarBlock<simdOps::Subtract<T,T,T>>(acc, scalar, length); break;
+            case nd4j::scalar::Multiply: scalarBlock<simdOps::Multiply<T,T,T>>(acc, scalar, length); break;
+            case nd4j::scalar::Divide: scalarBlock<simdOps::Divide<T,T,T>>(acc, scalar, length); break;
+            case nd4j::scalar::ReverseSubtract: scalarBlock<simdOps::ReverseSubtract<T,T,T>>(acc, scalar, length); break;
+            case nd4j::scalar::ReverseDivide: scalarBlock<simdOps::ReverseDivide<T,T,T>>(acc, scalar, length); break;
+            default: throw std::runtime_error("ElementwiseChain: unsupported scalar op");
+        }
+    }
+
+    template <typename T>
+    static void applyTransformSame(const int op, T *acc, const Nd4jLong length) {
+        switch (op) {
+            case nd4j::transform::Neg: transformBlock<simdOps::Neg<T>>(acc, length); break;
+            case nd4j::transform::Abs: transformBlock<simdOps::Abs<T>>(acc, length); break;
+            case nd4j::transform::Square: transformBlock<simdOps::Square<T>>(acc, length); break;
+            default: throw std::runtime_error("ElementwiseChain: unsupported transform op");
+        }
+    }
+
+    template <typename T>
+    static void applyTransformFloat(const int op, T *acc, const Nd4jLong length) {
+        switch (op) {
+            case nd4j::transform::Sqrt: transformBlock<simdOps::Sqrt<T,T>>(acc, length); break;
+            default: throw std::runtime_error("ElementwiseChain: unsupported transform op");
+        }
+    }
+
+    template <typename T>
+    static void applyTransformStrict(const int op, T *acc, const Nd4jLong length) {
+        switch (op) {
+            case nd4j::transform::Sigmoid: transformBlock<simdOps::Sigmoid<T>>(acc, length); break;
+            case nd4j::transform::Tanh: transformBlock<simdOps::Tanh<T>>(acc, length); break;
+            case nd4j::transform::Exp: transformBlock<simdOps::Exp<T>>(acc, length); break;
+            case nd4j::transform::Log: transformBlock<simdOps::Log<T>>(acc, length); break;
+            default: throw std::runtime_error("ElementwiseChain: unsupported transform op");
+        }
+    }
+
+    template <typename T>
+    void ElementwiseChain::fusedLoop(const NDArray &x, const std::vector<Step> &steps, NDArray &z) {
+        auto x_ = x.bufferAsT<T>();
+        auto z_ = z.bufferAsT<T>();
+
+        const Nd4jLong length = x.lengthOf();
+        const Nd4jLong numBlocks = (length + CHAIN_BLOCK - 1) / CHAIN_BLOCK;
+
+        // all operands share x layout, so every block is a contiguous range of the same offsets in each buffer
+        PRAGMA_OMP_PARALLEL_FOR_IF(length > Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong b = 0; b < numBlocks; b++) {
+            T acc[CHAIN_BLOCK];
+
+            const Nd4jLong start = b * CHAIN_BLOCK;
+            const Nd4jLong blockLength = nd4j::math::nd4j_min<Nd4jLong>(CHAIN_BLOCK, length - start);
+
+            for (Nd4jLong e = 0; e < blockLength; e++)
+                acc[e] = x_[start + e];
+
+            for (const auto &step : steps) {
+                switch (step.type) {
+                    case PAIRWISE:
+                        applyPairwise<T>(step.op, acc, step.array->bufferAsT<T>() + start, blockLength);
+                        break;
+                    case SCALAR:
+                        applyScalar<T>(step.op, acc, static_cast<T>(step.scalar), blockLength);
+                        break;
+                    case TRANSFORM_SAME:
+                        applyTransformSame<T>(step.op, acc, blockLength);
+                        break;
+                    case TRANSFORM_FLOAT:
+                        applyTransformFloat<T>(step.op, acc, blockLength);
+                        break;
+                    case TRANSFORM_STRICT:
+                        applyTransformStrict<T>(step.op, acc, blockLength);
+                        break;
+                }
+            }
+
+            // z is written only after all operands of this block were read, so z may alias x or any operand
+            for (Nd4jLong e = 0; e < blockLength; e++)
+                z_[start + e] = acc[e];
+        }
+    }
+
+    void ElementwiseChain::executeFused(NDArray &z) const {
+        auto xType = _x->dataType();
+        BUILD_SINGLE_SELECTOR(xType, fusedLoop, (*_x, _steps, z), FLOAT_TYPES);
+    }
+
+    void ElementwiseChain::executeSequential(NDArray &z) const {
+        if (_steps.empty()) {
+            z.assign(_x);
+            return;
+        }
+
+        // z is overwritten after the first op, so it can't serve as operand of later ops
+        bool aliased = false;
+        for (size_t e = 1; e < _steps.size(); e++)
+            if (_steps[e].array != nullptr && _steps[e].array->getBuffer() == z.getBuffer())
+                aliased = true;
+
+        NDArray *target = aliased ? new NDArray(z.ordering(), z.getShapeAsVector(), z.dataType(), z.getWorkspace()) : &z;
+        auto source = const_cast<NDArray*>(_x);
+
+        for (const auto &step : _steps) {
+            switch (step.type) {
+                case PAIRWISE:
+                    source->applyPairwiseTransform(static_cast<nd4j::pairwise::Ops>(step.op), step.array, target, nullptr);
+                    break;
+                case SCALAR: {
+                        auto scalar = NDArrayFactory::create(target->dataType(), step.scalar, target->getWorkspace());
+                        source->applyScalarArr(static_cast<nd4j::scalar::Ops>(step.op), &scalar, target, nullptr);
+                    }
+                    break;
+                case TRANSFORM_SAME:
+                    source->applyTransform(static_cast<nd4j::transform::SameOps>(step.op), target, nullptr);
+                    break;
+                case TRANSFORM_FLOAT:
+                    source->applyTransform(static_cast<nd4j::transform::FloatOps>(step.op), target, nullptr);
+                    break;
+                case TRANSFORM_STRICT:
+                    source->applyTransform(static_cast<nd4j::transform::StrictOps>(step.op), target, nullptr);
+                    break;
+            }
+            source = target;
+        }
+
+        if (aliased) {
+            z.assign(target);
+            delete target;
+        }
+    }
+
+    void ElementwiseChain::execute(NDArray &z) const {
+        if (isFused(z))
+            executeFused(z);
+        else
+            executeSequential(z);
+    }
+
+    NDArray ElementwiseChain::evaluate() const {
+        NDArray result(_x->ordering(), _x->getShapeAsVector(), _x->dataType(), _x->getWorkspace());
+        execute(result);
+        return result;
+    }
+}
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright (c) 2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <NDArray.h>
+#include <helpers/MKLDNNStream.h>
+
+#ifdef HAVE_MKLDNN
+
+namespace nd4j {
+    MKLDNNPrimitiveCache* MKLDNNPrimitiveCache::getInstance() {
+        if (!_INSTANCE)
+            _INSTANCE = new MKLDNNPrimitiveCache();
+
+        return _INSTANCE;
+    }
+
+    bool MKLDNNPrimitiveCache::checkout(const std::string &key, MKLDNNStreamState &state) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _index.find(key);
+        if (it == _index.end())
+            return false;
+
+        auto entry = it->second;
+        state = std::move(entry->second);
+
+        _index.erase(it);
+        _states.erase(entry);
+
+        return true;
+    }
+
+    void MKLDNNPrimitiveCache::checkin(const std::string &key, MKLDNNStreamState &state) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _states.emplace_front(key, std::move(state));
+        _index.emplace(key, _states.begin());
+
+        // dropping least recently returned states
+        while (_states.size() > _limit) {
+            auto last = std::prev(_states.end());
+            auto range = _index.equal_range(last->first);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == last) {
+                    _index.erase(it);
+                    break;
+                }
+            }
+
+            _states.erase(last);
+        }
+    }
+
+    void MKLDNNPrimitiveCache::setLimit(size_t limit) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _limit = limit;
+    }
+
+    size_t MKLDNNPrimitiveCache::size() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _states.size();
+    }
+
+    MKLDNNPrimitiveCache* MKLDNNPrimitiveCache::_INSTANCE = 0;
+}
+
+#endif
@@ -25,78 +25,11 @@
 #include <helpers/ShapeUtils.h>
 #include <helpers/BlasHelper.h>
 #include <NDArrayFactory.h>
+#include <ops/gemm.h>
 
 namespace nd4j { 
 
 
-//////////////////////////////////////////////////////////////////////////////
-// MXK x KxN = MxN
-template <typename T1, typename T2, typename T3>
-static void usualGemm(const char cOrder, const bool transA, const bool transB, const int M, const int N, const int K, const double alpha, const void* vA, const int lda, const void* vB, const int ldb, const double beta, void* vC, const int ldc) {
-
-    T1* A = reinterpret_cast<T1*>(const_cast<void*>(vA));
-    T2* B = reinterpret_cast<T2*>(const_cast<void*>(vB));
-    T3* C = reinterpret_cast<T3*>(vC);
-    T3 alphaZ(alpha), betaZ(beta);
-    
-    const bool flagC = cOrder == 'f';
-    const bool flagA = (flagC && transA) || (!flagC && !transA);
-    const bool flagB = (flagC && transB) || (!flagC && !transB);   
-
-    PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
-    for(uint row = 0; row < M; ++row) {
-       for(uint col = 0; col < N; ++col) {
-            
-            T3* c = flagC ? (C + row + col * ldc) : (C + row * ldc + col);
-            T3 val = 0;
-
-           PRAGMA_OMP_SIMD
-            for(uint i = 0; i < K; ++i) {
-                T3 a = flagA ? *(A + row * lda + i) : *(A + row + i * lda);
-                T3 b = flagB ? *(B + col + i * ldb) : *(B + col * ldb + i);             
-                val += alphaZ * a * b;
-            }
-            
-            if(betaZ)
-                *c = val + betaZ * *c;
-            else
-                *c = val;
-       }
-    }
-}
-
-//////////////////////////////////////////////////////////////////////////////
-// MXN x N = M
-template <typename T1, typename T2, typename T3>
-static void usualGemv(const char aOrder, const int M, const int N, const double alpha, const void* vA, const int lda, const void* vX, const int incx, const double beta, void* vY, const int incy) {
-
-    T1* A = reinterpret_cast<T1*>(const_cast<void*>(vA));
-    T2* X = reinterpret_cast<T2*>(const_cast<void*>(vX));
-    T3* Y = reinterpret_cast<T3*>(vY);
-    T3 alphaZ(alpha), betaZ(beta);
-    
-    const bool flagA = aOrder == 'f';
-
-    PRAGMA_OMP_PARALLEL_FOR_IF(M > Environment::getInstance()->tadThreshold())
-    for(int row = 0; row < M; ++row) {
-                        
-        T3* y = Y + row * incy;
-        T3 val = 0;
-
-        PRAGMA_OMP_SIMD
-        for(int i = 0; i < N; ++i) {
-            T3 a = flagA ? *(A + row + i * lda) : *(A + row * lda + i);
-            T3 x = *(X + i * incx);
-            val += alphaZ * a * x;
-        }
-        
-        if(betaZ)
-            *y = val + betaZ * *y;
-        else
-            *y = val;
-    }
-}
-
 //////////////////////////////////////////////////////////////////////////////
 // (X*Y) = Z[0]
 template <typename T1, typename T2, typename T3>
@@ -185,7 +118,7 @@ NDArray* MmulHelper::mmulMxM(const NDArray* A, const NDArray* B, NDArray* C, con
     }
     else {
         nd4j_debug("MMUL: Using fallback BLAS impl\n","");
-        BUILD_TRIPLE_SELECTOR(aType, bType, cType, usualGemm, (cOrder, transA, transB, M, N, K, alpha, pA->getBuffer(), lda, pB->getBuffer(), ldb, beta, pC->getBuffer(), ldc), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
+        BUILD_TRIPLE_SELECTOR(aType, bType, cType, nd4j::blas::GEMM, ::op(blasOrder, transAblas, transBblas, M, N, K, alpha, pA->getBuffer(), lda, pB->getBuffer(), ldb, beta, pC->getBuffer(), ldc), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
     }    
 
     if(pC != C) {
@@ -252,7 +185,12 @@ NDArray* MmulHelper::mmulMxV(const NDArray* A, const NDArray* X, nd4j::NDArray*
         BlasHelper::getInstance()->sgemv()(blasOrder, CblasNoTrans, M, N, (float)alpha, (float*)pA->getBuffer(), lda, (float*)X->getBuffer(),  incx, (float)beta, (float*)Y->getBuffer(),  incy);
     }
     else {
-        BUILD_TRIPLE_SELECTOR(aType, xType, yType, usualGemv, (pA->ordering(), M, N, alpha, pA->getBuffer(), lda, X->getBuffer(), incx, beta, Y->getBuffer(), incy), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);        
+        // generic gemv expects column-major A, so c-ordered A is handled as transposed f-ordered one
+        if (pA->ordering() == 'f') {
+            BUILD_TRIPLE_SELECTOR(aType, xType, yType, nd4j::blas::GEMV, ::op(CblasNoTrans, M, N, alpha, pA->getBuffer(), lda, X->getBuffer(), incx, beta, Y->getBuffer(), incy), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
+        } else {
+            BUILD_TRIPLE_SELECTOR(aType, xType, yType, nd4j::blas::GEMV, ::op(CblasTrans, N, M, alpha, pA->getBuffer(), lda, X->getBuffer(), incx, beta, Y->getBuffer(), incy), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
+        }
     }
 
     if(pA != A)
@@ -659,8 +597,6 @@ NDArray* nd4j::MmulHelper::tensorDot(const nd4j::NDArray* a, const nd4j::NDArray
             delete zT;
     }
 
-BUILD_TRIPLE_TEMPLATE(template void usualGemm, (const char cOrder, const bool transA, const bool transB, const int M, const int N, const int K, const double alpha, const void* A, const int lda, const void* B, const int ldb, const double beta, void* C, const int ldc), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
-BUILD_TRIPLE_TEMPLATE(template void usualGemv, (const char aOrder, const int M, const int N, const double alpha, const void* A, const int lda, const void* B, const int incx, const double beta, void* C, const int incy), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
 BUILD_TRIPLE_TEMPLATE(template void usualDot,  (const Nd4jLong length, const double alpha, const void* vX, const Nd4jLong incx, const void* vY, const Nd4jLong incy, const double beta, void* vZ), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
 
 }
@@ -108,4 +108,26 @@ Nd4jLong OmpLaunchHelper::betterSpan(Nd4jLong N) {
         // by default we're spawning as many threads we can, but not more than number of TADs
         return nd4j::math::nd4j_min<int>(numTads, maxThreads);
     }
+
+    int OmpLaunchHelper::tadChunks(Nd4jLong tadLength, Nd4jLong numTads) {
+#ifdef _OPENMP
+        auto maxThreads = omp_get_max_threads();
+#else
+        auto maxThreads = 1;
+#endif
+
+        // there are enough TADs to keep all threads busy
+        if (maxThreads <= 1 || numTads >= maxThreads)
+            return 1;
+
+        auto totalLength = tadLength * numTads;
+        if (totalLength < Environment::getInstance()->elementwiseThreshold())
+            return 1;
+
+        // each chunk should have at least elementwiseThreshold elements
+        Nd4jLong numChunks = (maxThreads + numTads - 1) / numTads;
+        numChunks = nd4j::math::nd4j_min<Nd4jLong>(numChunks, tadLength / Environment::getInstance()->elementwiseThreshold());
+
+        return static_cast<int>(nd4j::math::nd4j_max<Nd4jLong>(numChunks, 1));
+    }
 }
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_HOSTALLOCATOR_H
+#define LIBND4J_HOSTALLOCATOR_H
+
+#include <dll.h>
+#include <pointercast.h>
+
+namespace nd4j {
+    namespace memory {
+        enum HugePagesMode {
+            HUGE_PAGES_NONE = 0,
+            // madvise(MADV_HUGEPAGE), kernel backs region with transparent huge pages when it can
+            HUGE_PAGES_TRANSPARENT = 1,
+            // mmap(MAP_HUGETLB) from preallocated pool, falls back to transparent huge pages if pool is exhausted
+            HUGE_PAGES_EXPLICIT = 2,
+        };
+
+        enum NumaPolicy {
+            // first touch placement
+            NUMA_DEFAULT = 0,
+            // pages are placed on the node of the thread which touches them, regardless of process policy
+            NUMA_LOCAL = 1,
+            // pages are spread over all online nodes
+            NUMA_INTERLEAVE = 2,
+        };
+
+        /**
+         * This class provides host memory for workspaces. Allocations above Environment::largeAllocationThreshold()
+         * are backed by huge pages and NUMA policy configured via Environment, everything else comes from malloc.
+         *
+         * Settings only take effect on Linux, other platforms always use malloc.
+         */
+        class ND4J_EXPORT HostAllocator {
+        public:
+            // every pointer returned by allocate() is aligned to this boundary
+            static const Nd4jLong ALIGNMENT = 64;
+
+            static void* allocate(Nd4jLong numBytes);
+            static void release(void *ptr);
+
+            /**
+             * This method applies huge pages and NUMA settings to the buffer allocated elsewhere, i.e. with new[].
+             * Ownership doesn't change, only pages fully covered by the buffer and not touched yet are affected.
+             */
+            static void advise(void *ptr, Nd4jLong numBytes);
+        };
+    }
+}
+
+#endif //LIBND4J_HOSTALLOCATOR_H
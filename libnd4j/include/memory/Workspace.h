@@ -27,10 +27,12 @@
 #include <atomic>
 #include <vector>
 #include <mutex>
+#include <utility>
 #include <dll.h>
 #include <pointercast.h>
 #include <types/float16.h>
 #include <memory/ExternalWorkspace.h>
+#include <memory/HostAllocator.h>
 
 namespace nd4j {
     namespace memory {
@@ -43,6 +45,12 @@ namespace nd4j {
         };
 
         class ND4J_EXPORT Workspace {
+        public:
+            // alignment of host buffers, spills, and allocations made in aligned mode
+            static const Nd4jLong ALIGNMENT = HostAllocator::ALIGNMENT;
+
+            // spills are rounded up to power of 2 size classes, starting from ALIGNMENT bytes
+            static const int MAX_SPILL_CLASSES = 58;
         protected:
             char* _ptrHost = nullptr;
             char* _ptrDevice = nullptr;
@@ -55,18 +63,24 @@ namespace nd4j {
             Nd4jLong _initialSize = 0L;
             Nd4jLong _currentSize = 0L;
 
-            std::mutex _mutexAllocation;
             std::mutex _mutexSpills;
 
             bool _externalized = false;
+            bool _aligned = false;
+
+            // spills used in current cycle, along with their size classes
+            std::vector<std::pair<void*, int>> _spills;
 
-            std::vector<void*> _spills;
+            // released spills, available for reuse
+            std::vector<void*> _spillPool[MAX_SPILL_CLASSES];
 
             std::atomic<Nd4jLong> _spillsSize;
             std::atomic<Nd4jLong> _cycleAllocations;
 
             void init(Nd4jLong bytes);
             void freeSpills();
+            void recycleSpills();
+            void* allocateSpill(Nd4jLong numBytes);
         public:
             explicit Workspace(ExternalWorkspace *external);
             explicit Workspace(Nd4jLong initialSize = 0);
@@ -78,6 +92,12 @@ namespace nd4j {
             Nd4jLong getSpilledSize();
             Nd4jLong getUsedSize();
 
+            /**
+             * In aligned mode every allocation starts at ALIGNMENT boundary, at the cost of padding between allocations
+             */
+            void setAligned(bool aligned);
+            bool isAligned();
+
             void expandBy(Nd4jLong numBytes);
             void expandTo(Nd4jLong numBytes);
 
@@ -0,0 +1,211 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include "../HostAllocator.h"
+#include <Environment.h>
+#include <helpers/logger.h>
+#include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace nd4j {
+    namespace memory {
+        const Nd4jLong HostAllocator::ALIGNMENT;
+
+        // stored right before the pointer returned to the caller
+        struct AllocationHeader {
+            void *base;
+
+            // 0 for malloc'ed memory
+            Nd4jLong mappedLength;
+        };
+
+        static_assert(sizeof(AllocationHeader) <= HostAllocator::ALIGNMENT, "AllocationHeader must fit into alignment gap");
+
+        static void* mallocAligned(Nd4jLong numBytes) {
+            auto base = (char *) malloc(numBytes + 2 * HostAllocator::ALIGNMENT);
+            if (base == nullptr)
+                return nullptr;
+
+            auto result = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(base) + 2 * HostAllocator::ALIGNMENT - 1) & ~static_cast<uintptr_t>(HostAllocator::ALIGNMENT - 1));
+            auto header = reinterpret_cast<AllocationHeader *>(result - HostAllocator::ALIGNMENT);
+            header->base = base;
+            header->mappedLength = 0;
+
+            return result;
+        }
+
+#if defined(__linux__)
+        static const Nd4jLong HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+        // values from linux/mempolicy.h, so we don't depend on libnuma headers
+        static const int POLICY_INTERLEAVE = 3;
+        static const int POLICY_LOCAL = 4;
+
+        static const int MAX_NUMA_NODES = 1024;
+
+        // online nodes, parsed from sysfs. Format is the list of ranges, i.e. "0-1,3"
+        struct NodeMask {
+            unsigned long bits[MAX_NUMA_NODES / (8 * sizeof(unsigned long))] = {0};
+
+            NodeMask() {
+                const int width = 8 * sizeof(unsigned long);
+                auto file = fopen("/sys/devices/system/node/online", "r");
+                if (file == nullptr) {
+                    bits[0] = 1UL;
+                    return;
+                }
+
+                int first = 0, last = 0;
+                char separator = 0;
+                while (fscanf(file, "%d", &first) == 1) {
+                    last = first;
+                    separator = 0;
+                    if (fscanf(file, "%c", &separator) == 1 && separator == '-') {
+                        if (fscanf(file, "%d", &last) != 1)
+                            break;
+
+                        if (fscanf(file, "%c", &separator) != 1)
+                            separator = 0;
+                    }
+
+                    for (int e = first; e <= last && e < MAX_NUMA_NODES; e++)
+                        bits[e / width] |= 1UL << (e % width);
+
+                    if (separator != ',')
+                        break;
+                }
+
+                fclose(file);
+            }
+        };
+
+        static const unsigned long* onlineNodes() {
+            static NodeMask mask;
+            return mask.bits;
+        }
+
+        static void applyPolicy(void *ptr, Nd4jLong numBytes) {
+            auto env = Environment::getInstance();
+
+            auto hugePages = env->hugePagesMode();
+#ifdef MADV_HUGEPAGE
+            if (hugePages != HUGE_PAGES_NONE && madvise(ptr, numBytes, MADV_HUGEPAGE) != 0)
+                nd4j_debug("madvise(MADV_HUGEPAGE) failed for %lld bytes\n", numBytes);
+#endif
+
+#ifdef SYS_mbind
+            auto numa = env->numaPolicy();
+            if (numa == NUMA_DEFAULT)
+                return;
+
+            long status;
+            if (numa == NUMA_INTERLEAVE)
+                status = syscall(SYS_mbind, ptr, (unsigned long) numBytes, POLICY_INTERLEAVE, onlineNodes(), (unsigned long) MAX_NUMA_NODES, 0);
+            else
+                status = syscall(SYS_mbind, ptr, (unsigned long) numBytes, POLICY_LOCAL, nullptr, 0UL, 0);
+
+            if (status != 0)
+                nd4j_debug("mbind failed for %lld bytes\n", numBytes);
+#endif
+        }
+
+        static void* mapAligned(Nd4jLong numBytes) {
+            auto hugePages = Environment::getInstance()->hugePagesMode();
+            auto length = ((numBytes + HostAllocator::ALIGNMENT + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) * HUGE_PAGE_SIZE;
+
+            void *base = MAP_FAILED;
+#ifdef MAP_HUGETLB
+            if (hugePages == HUGE_PAGES_EXPLICIT) {
+                base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (base == MAP_FAILED)
+                    nd4j_debug("MAP_HUGETLB failed for %lld bytes, falling back to transparent huge pages\n", length);
+            }
+#endif
+
+            if (base == MAP_FAILED) {
+                base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (base == MAP_FAILED)
+                    return nullptr;
+            }
+
+            // policy must be set before the first touch, and header below is the first touch
+            applyPolicy(base, length);
+
+            auto result = (char *) base + HostAllocator::ALIGNMENT;
+            auto header = reinterpret_cast<AllocationHeader *>(base);
+            header->base = base;
+            header->mappedLength = length;
+
+            return result;
+        }
+#endif
+
+        void* HostAllocator::allocate(Nd4jLong numBytes) {
+#if defined(__linux__)
+            auto env = Environment::getInstance();
+            if (numBytes >= env->largeAllocationThreshold() && (env->hugePagesMode() != HUGE_PAGES_NONE || env->numaPolicy() != NUMA_DEFAULT)) {
+                auto result = mapAligned(numBytes);
+                if (result != nullptr)
+                    return result;
+
+                nd4j_debug("mmap failed for %lld bytes, falling back to malloc\n", numBytes);
+            }
+#endif
+            return mallocAligned(numBytes);
+        }
+
+        void HostAllocator::release(void *ptr) {
+            if (ptr == nullptr)
+                return;
+
+            auto header = reinterpret_cast<AllocationHeader *>((char *) ptr - ALIGNMENT);
+#if defined(__linux__)
+            if (header->mappedLength > 0) {
+                munmap(header->base, header->mappedLength);
+                return;
+            }
+#endif
+            free(header->base);
+        }
+
+        void HostAllocator::advise(void *ptr, Nd4jLong numBytes) {
+#if defined(__linux__)
+            auto env = Environment::getInstance();
+            if (ptr == nullptr || numBytes < env->largeAllocationThreshold() || (env->hugePagesMode() == HUGE_PAGES_NONE && env->numaPolicy() == NUMA_DEFAULT))
+                return;
+
+            // madvise and mbind only accept page aligned ranges
+            auto pageSize = (uintptr_t) sysconf(_SC_PAGESIZE);
+            auto first = (reinterpret_cast<uintptr_t>(ptr) + pageSize - 1) & ~(pageSize - 1);
+            auto last = (reinterpret_cast<uintptr_t>(ptr) + numBytes) & ~(pageSize - 1);
+
+            if (last > first)
+                applyPolicy(reinterpret_cast<void *>(first), (Nd4jLong) (last - first));
+#endif
+        }
+    }
+}
@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "../Workspace.h"
+#include "../HostAllocator.h"
 #include <helpers/logger.h>
 #include <templatemath.h>
 #include <cstring>
@@ -33,6 +34,17 @@
 
 namespace nd4j {
     namespace memory {
+        const Nd4jLong Workspace::ALIGNMENT;
+        const int Workspace::MAX_SPILL_CLASSES;
+
+        static FORCEINLINE int spillClass(Nd4jLong numBytes) {
+            int sizeClass = 0;
+            while ((Workspace::ALIGNMENT << sizeClass) < numBytes)
+                sizeClass++;
+
+            return sizeClass;
+        }
+
         Workspace::Workspace(ExternalWorkspace *external) {
             if (external->sizeHost() > 0) {
                 _ptrHost = (char *) external->pointerHost();
@@ -50,11 +62,11 @@ namespace nd4j {
 
         Workspace::Workspace(Nd4jLong initialSize) {
             if (initialSize > 0) {
-                this->_ptrHost = (char *) malloc(initialSize);
+                // memory isn't zeroed here: arrays created in workspace initialize their buffers anyway
+                this->_ptrHost = (char *) HostAllocator::allocate(initialSize);
 
                 CHECK_ALLOC(this->_ptrHost, "Failed to allocate new workspace");
 
-                memset(this->_ptrHost, 0, initialSize);
                 this->_allocatedHost = true;
             } else
                 this->_allocatedHost = false;
@@ -69,13 +81,13 @@ namespace nd4j {
         void Workspace::init(Nd4jLong bytes) {
             if (this->_currentSize < bytes) {
                 if (this->_allocatedHost && !_externalized)
-                    free((void *)this->_ptrHost);
+                    HostAllocator::release((void *)this->_ptrHost);
 
-                this->_ptrHost =(char *) malloc(bytes);
+                this->_ptrHost = (char *) HostAllocator::allocate(bytes);
 
                 CHECK_ALLOC(this->_ptrHost, "Failed to allocate new workspace");
 
-                memset(this->_ptrHost, 0, bytes);
+                _externalized = false;
                 this->_currentSize = bytes;
                 this->_allocatedHost = true;
             }
@@ -89,21 +101,73 @@ namespace nd4j {
             this->init(numBytes);
         }
 
+        void Workspace::setAligned(bool aligned) {
+            _aligned = aligned;
+        }
+
+        bool Workspace::isAligned() {
+            return _aligned;
+        }
+
         void Workspace::freeSpills() {
+            std::lock_guard<std::mutex> lock(_mutexSpills);
             _spillsSize = 0;
 
-            if (_spills.size() < 1)
-                return;
+            for (auto &v:_spills)
+                HostAllocator::release(v.first);
+
+            _spills.clear();
+
+            for (auto &pool:_spillPool) {
+                for (auto v:pool)
+                    HostAllocator::release(v);
+
+                pool.clear();
+            }
+        }
+
+        void Workspace::recycleSpills() {
+            std::lock_guard<std::mutex> lock(_mutexSpills);
+            _spillsSize = 0;
 
-            for (auto v:_spills)
-                free(v);
+            for (auto &v:_spills)
+                _spillPool[v.second].emplace_back(v.first);
 
             _spills.clear();
         }
 
+        void* Workspace::allocateSpill(Nd4jLong numBytes) {
+            nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
+
+            auto sizeClass = spillClass(numBytes);
+            void *p = nullptr;
+
+            _mutexSpills.lock();
+            if (!_spillPool[sizeClass].empty()) {
+                p = _spillPool[sizeClass].back();
+                _spillPool[sizeClass].pop_back();
+            }
+            _mutexSpills.unlock();
+
+            if (p == nullptr) {
+                p = HostAllocator::allocate(Workspace::ALIGNMENT << sizeClass);
+
+                CHECK_ALLOC(p, "Failed to allocate new workspace");
+            }
+
+            _mutexSpills.lock();
+            _spills.emplace_back(p, sizeClass);
+            _mutexSpills.unlock();
+
+            _spillsSize += numBytes;
+            _cycleAllocations += numBytes;
+
+            return p;
+        }
+
         Workspace::~Workspace() {
             if (this->_allocatedHost && !_externalized)
-                free((void *)this->_ptrHost);
+                HostAllocator::release((void *)this->_ptrHost);
 
             freeSpills();
         }
@@ -127,35 +191,26 @@ namespace nd4j {
                 throw std::invalid_argument("Number of bytes for allocation should be positive");
             }
 
-            //numBytes += 32;
-            void* result = nullptr;
-            this->_cycleAllocations += numBytes;
-            this->_mutexAllocation.lock();
+            // bump pointer: concurrent allocations just retry with updated offset, no locks involved
+            auto base = reinterpret_cast<uintptr_t>(_ptrHost);
+            auto current = _offset.load();
+            Nd4jLong start, end;
+            do {
+                start = current;
+                if (_aligned)
+                    start += (Workspace::ALIGNMENT - ((base + current) & (Workspace::ALIGNMENT - 1))) & (Workspace::ALIGNMENT - 1);
 
-            if (_offset.load() + numBytes > _currentSize) {
-                nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
-                this->_mutexAllocation.unlock();
+                end = start + numBytes;
+                if (end > _currentSize)
+                    return allocateSpill(numBytes);
+            } while (!_offset.compare_exchange_weak(current, end));
 
-                void *p = malloc(numBytes);
-
-                CHECK_ALLOC(p, "Failed to allocate new workspace");
+            // padding counts as well, so next cycle has enough space
+            this->_cycleAllocations += end - current;
 
-                _mutexSpills.lock();
-                _spills.push_back(p);
-                _mutexSpills.unlock();
+            auto result = (void *)(_ptrHost + start);
 
-                _spillsSize += numBytes;
-
-                return p;
-            }
-
-            result = (void *)(_ptrHost + _offset.load());
-            _offset += numBytes;
-            //memset(result, 0, (int) numBytes);
-
-            nd4j_debug("Allocating %lld bytes from workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result, _offset.load());
-
-            this->_mutexAllocation.unlock();
+            nd4j_debug("Allocating %lld bytes from workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result, end);
 
             return result;
         }
@@ -165,13 +220,19 @@ namespace nd4j {
         }
 
         void Workspace::scopeIn() {
-            freeSpills();
+            // if workspace is going to grow, spills won't be needed anymore
+            if (_cycleAllocations.load() > _currentSize)
+                freeSpills();
+            else
+                recycleSpills();
+
             init(_cycleAllocations.load());
             _cycleAllocations = 0;
         }
 
         void Workspace::scopeOut() {
             _offset = 0;
+            recycleSpills();
         }
 
         Nd4jLong Workspace::getSpilledSize() {
@@ -187,7 +248,10 @@ namespace nd4j {
 
         Workspace* Workspace::clone() {
             // for clone we take whatever is higher: current allocated size, or allocated size of current loop
-            return new Workspace(nd4j::math::nd4j_max<Nd4jLong >(this->getCurrentSize(), this->_cycleAllocations.load()));
+            auto result = new Workspace(nd4j::math::nd4j_max<Nd4jLong >(this->getCurrentSize(), this->_cycleAllocations.load()));
+            result->setAligned(_aligned);
+
+            return result;
         }
     }
 }
@@ -31,6 +31,7 @@
 #include <array/ShapeList.h>
 #include <array/ResultSet.h>
 #include <helpers/OpArgsHolder.h>
+#include <ops/declarable/ShapeCache.h>
 #include <dll.h>
 //#include <ops/declarable/declarable_ops.h>
 
@@ -72,6 +73,9 @@ namespace nd4j {
             OpDescriptor *_descriptor;
             NDArray _scalar;
 
+            // output shapes calculated for previous executions of this op
+            ShapeCache _shapeCache;
+
             virtual void registerTypes();
 
             /**
@@ -131,6 +135,9 @@ namespace nd4j {
             // this method returns OpDescriptor, describing this Op instance
             OpDescriptor *getOpDescriptor();
 
+            // this method returns cache of output shapes, calculated for previous executions of this Op
+            ShapeCache *getShapeCache();
+
             Nd4jStatus validateDataTypes(Context& block);
 
             /**
@@ -80,6 +80,9 @@ namespace nd4j {
 
 
             bool _sameMode = false;
+
+            // flag for ops with output shapes depending only on shapes of inputs, op arguments and short integer inputs, so they can be cached
+            bool _cacheableShape = false;
             std::vector<nd4j::DataType> _allowedIns;
             std::vector<nd4j::DataType> _allowedOuts;
 
@@ -165,6 +168,7 @@ namespace nd4j {
             OpDescriptor* setAllowedInputTypes(nd4j::DataType dtype);
             OpDescriptor* setAllowedOutputTypes(nd4j::DataType dtype);
             OpDescriptor* setSameMode(bool reallySame);
+            OpDescriptor* setCacheableShape(bool reallyCacheable);
             OpDescriptor* setInputType(int idx, nd4j::DataType dtype);
             OpDescriptor* setOutputType(int idx, nd4j::DataType dtype);
 
@@ -174,6 +178,9 @@ namespace nd4j {
             bool checkOutputMatch(int index, nd4j::DataType dataType);
             bool isSameMode();
 
+            // returns TRUE if output shapes of this op can be cached by input shapes and arguments
+            bool isCacheableShape();
+
             bool isInherit(int index);
         };
     }
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#ifndef LIBND4J_SHAPECACHE_H
+#define LIBND4J_SHAPECACHE_H
+
+#include <unordered_map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <pointercast.h>
+#include <dll.h>
+#include <NDArray.h>
+#include <graph/Context.h>
+#include <array/ShapeList.h>
+
+namespace nd4j {
+    namespace ops {
+        /**
+         * This class holds output shapes calculated by the single op, so repeated executions with the same inputs
+         * (which is the normal case for inference) skip shape function.
+         *
+         * Caching is opt-in: only ops marked via OpDescriptor::setCacheableShape() use it, since their output shapes
+         * depend only on shapes and data types of inputs, op arguments, and content of short integer inputs
+         * (i.e. axis, begin/end) or scalars. All of that goes into the key.
+         *
+         * Entries are split into shards with separate locks, and each thread keeps a small front cache of recently
+         * used entries, so repeated lookups of the same key don't take any locks.
+         */
+        class ND4J_EXPORT ShapeCache {
+        public:
+            // output shapes for the single key. Entries are immutable once published
+            typedef std::vector<std::vector<Nd4jLong>> Entry;
+
+            // integer inputs up to this length are considered to be op arguments, so their content goes into the key
+            static const Nd4jLong MAX_CONTENT_LENGTH = 2 * MAX_RANK;
+
+            static const int NUM_SHARDS = 8;
+
+            // number of slots in per-thread front cache, shared by all ops
+            static const int FRONT_SIZE = 64;
+        protected:
+            class KeyHash {
+            public:
+                size_t operator()(const std::vector<Nd4jLong> &key) const;
+            };
+
+            class Shard {
+            public:
+                std::mutex mutex;
+                std::unordered_map<std::vector<Nd4jLong>, std::shared_ptr<Entry>, KeyHash> entries;
+
+                // insertion order, oldest entries are evicted first
+                std::deque<std::vector<Nd4jLong>> order;
+            };
+
+            // statistics counter, padded to its own cache line
+            class Counter {
+            public:
+                std::atomic<Nd4jLong> value{0};
+                char padding[64];
+            };
+
+            Shard _shards[NUM_SHARDS];
+            std::atomic<int> _capacity{64};
+
+            // unique among all caches, and changes on every clear: front cache slots with other generations are stale
+            std::atomic<Nd4jLong> _generation;
+
+            Counter _hits[NUM_SHARDS];
+            Counter _misses[NUM_SHARDS];
+
+            static Nd4jLong nextGeneration();
+            static int counterIndex();
+
+            Shard& shardFor(size_t hash);
+            void evict(Shard &shard, int shardCapacity);
+        public:
+            ShapeCache();
+            ~ShapeCache() = default;
+
+            /**
+             * This method builds cache key for given execution
+             *
+             * @param ctx - execution context
+             * @param inputs - input arrays
+             * @param key - output vector
+             * @return FALSE if this execution can't be cached, i.e. one of inputs is unknown
+             */
+            static bool buildKey(nd4j::graph::Context &ctx, const std::vector<NDArray*> &inputs, std::vector<Nd4jLong> &key);
+
+            /**
+             * This method returns cached output shapes for given key, or nullptr if there's nothing cached yet.
+             * Returned entry stays valid until next get() or put() call from the same thread
+             */
+            Entry* get(const std::vector<Nd4jLong> &key);
+
+            /**
+             * This method stores copies of given output shapes, and returns cached entry.
+             * Returned entry stays valid until next get() or put() call from the same thread
+             */
+            Entry* put(const std::vector<Nd4jLong> &key, ShapeList *shapes);
+
+            /**
+             * This method sets max number of entries kept. 0 disables caching
+             */
+            void setCapacity(int capacity);
+
+            int size();
+            void clear();
+
+            Nd4jLong hits();
+            Nd4jLong misses();
+        };
+    }
+}
+
+#endif //LIBND4J_SHAPECACHE_H
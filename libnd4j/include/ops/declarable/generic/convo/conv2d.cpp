@@ -143,7 +143,8 @@ DECLARE_SHAPE_FN(conv2d) {
                 ->setAllowedInputTypes(0, nd4j::DataType::ANY)
                 ->setAllowedInputTypes(1, {ALL_FLOATS})
                 ->setAllowedInputTypes(2, {ALL_FLOATS})
-                ->setAllowedOutputTypes({ALL_FLOATS});
+                ->setAllowedOutputTypes({ALL_FLOATS})
+                ->setCacheableShape(true);
     }
 
     DECLARE_TYPES(conv2d_bp) {
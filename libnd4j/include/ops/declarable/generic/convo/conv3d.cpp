@@ -331,7 +331,7 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
 
             auto conv_prim_desc = convolution_forward::primitive_desc(conv_desc, streams[0].getEngine());
 
-            if (gradW != nullptr) {
+            if (gradW != nullptr && resetW) {
                 auto convW_desc = gradB != nullptr
                         ? convolution_backward_weights::desc(
                                 convolution_direct, conv_src_md, conv_diff_weights_md, conv_bias_md,
@@ -386,7 +386,7 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
                 }
             }
 
-            if (gradI != nullptr) {
+            if (gradI != nullptr && resetI) {
                 auto convI_desc =
                         convolution_backward_data::desc(
                                 convolution_direct, conv_diff_src_md, conv_weights_md,
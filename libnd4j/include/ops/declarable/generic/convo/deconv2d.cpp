@@ -90,7 +90,8 @@ CUSTOM_OP_IMPL(deconv2d, 2, 1, false, 0, 9) {
     DECLARE_TYPES(deconv2d) {
         getOpDescriptor()
                 ->setAllowedInputTypes(nd4j::DataType::ANY)
-                ->setAllowedOutputTypes({ALL_FLOATS});
+                ->setAllowedOutputTypes({ALL_FLOATS})
+                ->setCacheableShape(true);
     }
 
 DECLARE_SHAPE_FN(deconv2d) {
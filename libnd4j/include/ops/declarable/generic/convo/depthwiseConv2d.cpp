@@ -70,7 +70,8 @@ CUSTOM_OP_IMPL(depthwise_conv2d, 2, 1, false, 0, 9) {
     DECLARE_TYPES(depthwise_conv2d) {
         getOpDescriptor()
                 ->setAllowedInputTypes(nd4j::DataType::ANY)
-                ->setAllowedOutputTypes({ALL_FLOATS});
+                ->setAllowedOutputTypes({ALL_FLOATS})
+                ->setCacheableShape(true);
     }
 DECLARE_SHAPE_FN(depthwise_conv2d) {
 
@@ -87,7 +87,8 @@ DECLARE_SYN(maxpool, maxpool2d);
         DECLARE_TYPES(maxpool2d) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setSameMode(true);
+                    ->setSameMode(true)
+                    ->setCacheableShape(true);
         }
 
 
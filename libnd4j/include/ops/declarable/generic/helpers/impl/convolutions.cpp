@@ -777,7 +777,7 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
 
             auto conv_prim_desc = convolution_forward::primitive_desc(conv_desc, streams[0].getEngine());
 
-            if (gradW != nullptr) {
+            if (gradW != nullptr && resetW) {
                 auto convW_desc = gradB != nullptr
                         ? convolution_backward_weights::desc(
                                 convolution_direct, conv_src_md, conv_diff_weights_md, conv_bias_md,
@@ -832,7 +832,7 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
                 }
             }
 
-            if (gradI != nullptr) {
+            if (gradI != nullptr && resetI) {
                 auto convI_desc =
                         convolution_backward_data::desc(
                                 convolution_direct, conv_diff_src_md, conv_weights_md,
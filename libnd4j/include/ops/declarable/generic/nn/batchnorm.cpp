@@ -222,7 +222,8 @@ CUSTOM_OP_IMPL(batchnorm_new, 3, 1, false, 1, 2) {
         weights({0, 1, 0, 0}).assign(1.0f);
         weights({1, 2, 0, 0}).assign(0.0f);
 
-        if (streams[0].checkAndReset({input, mean, variance, gamma, beta}, {output}, {(float)epsilon}, axes)) {
+        // weights are rebuilt on every call, so they are bound to the stream just like other arrays
+        if (streams[0].checkAndReset({input, mean, variance, gamma, beta, &weights}, {output}, {(float)epsilon}, axes)) {
             mkldnn_memory_desc_t empty;
             mkldnn::memory::desc batchnorm_src_md(empty), batchnorm_dst_md(empty), user_src_md(empty), user_dst_md(empty);
 
@@ -28,7 +28,8 @@ namespace nd4j {
         DECLARE_TYPES(biasadd) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setAllowedOutputTypes({ALL_FLOATS});
+                    ->setAllowedOutputTypes({ALL_FLOATS})
+                    ->setCacheableShape(true);
         }
 
         CUSTOM_OP_IMPL(biasadd, 2, 1, true, 0, 0) {
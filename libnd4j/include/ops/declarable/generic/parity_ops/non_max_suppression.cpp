@@ -46,7 +46,18 @@ namespace nd4j {
             if (block.getTArguments()->size() > 0)
                 threshold = T_ARG(0);
 
-            helpers::nonMaxSuppressionV2(boxes, scales, maxOutputSize, threshold, output);
+            // optional score threshold and soft-NMS sigma
+            double scoreThreshold = -DataTypeUtils::max<double>();
+            if (block.getTArguments()->size() > 1)
+                scoreThreshold = T_ARG(1);
+
+            double sigma = 0.;
+            if (block.getTArguments()->size() > 2)
+                sigma = T_ARG(2);
+
+            REQUIRE_TRUE(sigma >= 0., 0, "image.non_max_suppression: soft-NMS sigma should be non-negative, but %f is given", sigma);
+
+            helpers::nonMaxSuppression(boxes, scales, maxOutputSize, threshold, scoreThreshold, sigma, output);
             return Status::OK();
         }
 
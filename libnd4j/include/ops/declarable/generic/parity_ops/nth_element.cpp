@@ -37,11 +37,8 @@ namespace nd4j {
             REQUIRE_TRUE(input->rankOf() > 0, 0, "nth_element: The rank of input array should be at least 1, but %i is given", input->rankOf());            //
             if (output->lengthOf() == input->lengthOf())
                 output->assign(input);
-            else {
-                if (!input->isVector() && reverse)
-                    n->assign(lastDim - n->e<Nd4jLong>(0) - 1);
+            else
                 helpers::nthElementFunctor(input, n, output, reverse);
-            }
             return ND4J_STATUS_OK;
         }
 
@@ -91,7 +91,8 @@ CUSTOM_OP_IMPL(lstmCell, 8, 2, false, 3, 2) {
         DECLARE_TYPES(lstmCell) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setAllowedOutputTypes({ALL_FLOATS});
+                    ->setAllowedOutputTypes({ALL_FLOATS})
+                    ->setCacheableShape(true);
         }
 
 
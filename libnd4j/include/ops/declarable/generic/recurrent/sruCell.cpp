@@ -65,7 +65,8 @@ CUSTOM_OP_IMPL(sruCell, 4, 2, false, 0, 0) {
         DECLARE_TYPES(sruCell) {
             getOpDescriptor()
                     ->setAllowedInputTypes(nd4j::DataType::ANY)
-                    ->setAllowedOutputTypes({ALL_FLOATS});
+                    ->setAllowedOutputTypes({ALL_FLOATS})
+                    ->setCacheableShape(true);
         }
 
 DECLARE_SHAPE_FN(sruCell) {
@@ -25,9 +25,11 @@
 
 
 #include<ops/declarable/helpers/gru.h>
+#include<ops/declarable/helpers/rnn.h>
 #include <ops/declarable/CustomOperations.h>
 #include<ops/declarable/helpers/transforms.h>
 #include <MmulHelper.h>
+#include <helpers/ElementwiseChain.h>
 
 namespace nd4j 	  {
 namespace ops 	  {
@@ -52,6 +54,60 @@ static FORCEINLINE void tanhInplace(const NDArray& arr) {
     (const_cast<NDArray&>(arr)).applyTransform(transform::Tanh);
 }
 
+//////////////////////////////////////////////////////////////////////////
+// gates [bS, 2*nU] = sigmoid(gates) in place, and hr = hLast◦r in the same pass
+template <typename T>
+static void fusedGruGates(NDArray* gates, const NDArray* hLast, NDArray* hr) {
+
+    const Nd4jLong bS = hLast->sizeAt(0);
+    const Nd4jLong nU = hLast->sizeAt(1);
+
+    auto g_  = gates->bufferAsT<T>();
+    auto h_  = hLast->bufferAsT<T>();
+    auto hr_ = hr->bufferAsT<T>();
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(bS * nU > Environment::getInstance()->elementwiseThreshold())
+    for (Nd4jLong r = 0; r < bS; r++) {
+        auto gr = g_ + r * 2 * nU;
+
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong j = 0; j < nU; j++) {
+            gr[j]      = nd4j::math::nd4j_sigmoid<T,T>(gr[j]);
+            gr[nU + j] = nd4j::math::nd4j_sigmoid<T,T>(gr[nU + j]);
+            hr_[r * nU + j] = gr[j] * h_[r * nU + j];
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// n = tanh(n + bn) in place, and h = u◦hLast + (1-u)◦n in the same pass
+// u is located at uOffset within each row of array u, rows are uStride elements long. bn is optional
+template <typename T>
+static void fusedGruOutput(NDArray* n, const NDArray* bn, const NDArray* u, const Nd4jLong uOffset, const Nd4jLong uStride, const NDArray* hLast, NDArray* h) {
+
+    const Nd4jLong bS = hLast->sizeAt(0);
+    const Nd4jLong nU = hLast->sizeAt(1);
+
+    auto n_  = n->bufferAsT<T>();
+    auto b_  = bn != nullptr ? bn->bufferAsT<T>() : nullptr;
+    auto u_  = u->bufferAsT<T>() + uOffset;
+    auto hl_ = hLast->bufferAsT<T>();
+    auto h_  = h->bufferAsT<T>();
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(bS * nU > Environment::getInstance()->elementwiseThreshold())
+    for (Nd4jLong r = 0; r < bS; r++) {
+        auto ur = u_ + r * uStride;
+
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong j = 0; j < nU; j++) {
+            const auto e = r * nU + j;
+            const T nv = nd4j::math::nd4j_tanh<T,T>(b_ != nullptr ? n_[e] + b_[j] : n_[e]);
+            n_[e] = nv;
+            h_[e] = ur[j] * hl_[e] + (static_cast<T>(1.f) - ur[j]) * nv;
+        }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 void gruCell(const NDArray* x, const NDArray* hLast, const NDArray* Wru, const NDArray* Wc,
              const NDArray* bru, const NDArray* bc,
@@ -103,15 +159,23 @@ void gruCell(const NDArray* x, const NDArray* hLast, const NDArray* Wru, const N
 
     //c = tanh(x * weight_cx + (hLast .* r) * weight_cr + b_c)
     MmulHelper::mmul(concatOut, const_cast<NDArray*>(Wc), c, 1.0, 0.0);       //c = 1.0 * concatOut * Wc + 0.0 * c
-    *c += *bc;
-    tanhInplace(*c);
 
-    //Output: h = (1-u).*c + u .* hPrev
-    //auto hResult = (*u) * (*hLast) + (1.0f - *u) * (*c); const_cast<NDArray*>(h)->assign(&hResult);
-    u->applyPairwiseTransform(pairwise::Multiply, hLast, h, nullptr);        //h = u * hLast
-    auto temp = (1.0f - *u);
-    temp *= (*c);
-    (*h) += temp;
+    const auto dataType = c->dataType();
+    if (isFusable(c, dataType) && isFusable(u, dataType) && isFusable(hLast, dataType) && isFusable(h, dataType) && bc->ews() == 1 && bc->dataType() == dataType) {
+        //c = tanh(c + b_c), h = (1-u).*c + u .* hPrev
+        BUILD_SINGLE_SELECTOR(dataType, fusedGruOutput, (c, bc, u, 0, nU, hLast, h), FLOAT_TYPES);
+    }
+    else {
+        *c += *bc;
+        tanhInplace(*c);
+
+        //Output: h = (1-u).*c + u .* hPrev
+        //auto hResult = (*u) * (*hLast) + (1.0f - *u) * (*c); const_cast<NDArray*>(h)->assign(&hResult);
+        u->applyPairwiseTransform(pairwise::Multiply, hLast, h, nullptr);        //h = u * hLast
+        auto temp = (1.0f - *u);
+        temp *= (*c);
+        (*h) += temp;
+    }
 
     delete result;
 }
@@ -128,18 +192,68 @@ void gruTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* Wx, const N
 // h is cell outputs at each time step [time, bS, nU]
 
 const int time = x->sizeAt(0);
+const int bS   = x->sizeAt(1);
+const int nU   = h0->sizeAt(1);
 
-NDArray ht_1(*h0);
+NDArray ht_1('c', {bS, nU}, h0->dataType(), h0->getWorkspace());
+ht_1.assign(h0);
+
+// input projection doesn't depend on previous state, so it's calculated for all time steps by single gemm, [time*bS, 3*nU]
+NDArray xProj('c', {time * bS, 3 * nU}, h0->dataType(), h0->getWorkspace());
+helpers::rnnProjectInputs(x, Wx, &xProj);
+xProj += *b;
+
+// contiguous copies of recurrent weights for gates and for cell, so gemm doesn't copy them on each step
+auto WhRU = (*Wh)({0,0, 0,2*nU}).dup('c');      // [nU, 2*nU]
+auto WhN  = (*Wh)({0,0, 2*nU,3*nU}).dup('c');   // [nU, nU]
+
+// scratch buffers are allocated once per sequence, and reused by all time steps
+NDArray gates('c', {bS, 2*nU}, h0->dataType(), h0->getWorkspace());
+NDArray hr('c', {bS, nU}, h0->dataType(), h0->getWorkspace());
+NDArray n('c', {bS, nU}, h0->dataType(), h0->getWorkspace());
+
+auto r = gates({0,0, 0, nU});               // reset gate, [bS, nU]
+auto u = gates({0,0, nU, 2*nU});            // update gate, [bS, nU]
+
+const auto dataType = h0->dataType();
+const bool fusable = isFusable(h, dataType);
 
 // loop through time steps
 for (int t = 0; t < time; ++t) {
 
-    auto xt = (*x)({t,t+1, 0,0, 0,0});
+    auto xt = xProj({t*bS,(t+1)*bS, 0,0}, true);
     auto ht = (*h)({t,t+1, 0,0, 0,0});
 
-    //helpers::gruCell(&xt, &ht_1, Wx, Wh, b, &ht);
-    //ht_1.assign(ht);
+    // gates = sigmoid(x*Wx + b  +  h_1*Wh)
+    gates.assign(xt({0,0, 0,2*nU}, true));
+    MmulHelper::mmul(&ht_1, WhRU, &gates, 1.0, 1.0);
+
+    if (fusable) {
+        BUILD_SINGLE_SELECTOR(dataType, fusedGruGates, (&gates, &ht_1, &hr), FLOAT_TYPES);
+    }
+    else {
+        sigmoidInplace(gates);
+        r.applyPairwiseTransform(pairwise::Multiply, &ht_1, &hr, nullptr);
+    }
+
+    // n = tanh(x*Wx + b  +  (r◦h_1)*Wh)
+    n.assign(xt({0,0, 2*nU,3*nU}, true));
+    MmulHelper::mmul(&hr, WhN, &n, 1.0, 1.0);
+
+    // h = u◦h_1 + (1-u)◦n
+    if (fusable) {
+        BUILD_SINGLE_SELECTOR(dataType, fusedGruOutput, (&n, nullptr, &gates, nU, 2*nU, &ht_1, &ht), FLOAT_TYPES);
+    }
+    else {
+        tanhInplace(n);
+        ht.assign(u * ht_1 + (1.f - u) * n);
+    }
+
+    ht_1.assign(ht);
 }
+
+delete WhRU;
+delete WhN;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -209,7 +323,7 @@ auto dhdu   = *h0  - n;              // [bS, nU]
 auto dhdn   = 1.f - u;               // [bS, nU]
 auto dSigdu = u * (1.f - u);         // [bS, nU]
 auto dSigdr = r * (1.f - r);         // [bS, nU]
-auto dActdn = 1.f - n * n;           // [bS, nU]
+auto dActdn = ElementwiseChain(n).apply(transform::Square).apply(scalar::ReverseSubtract, 1.).evaluate();   // 1 - n*n, [bS, nU]
 auto dndr   = mmul(dActdn * (*h0), WhnT);
 auto drdh0  = mmul(dSigdr, WhrT);
 
@@ -19,72 +19,199 @@
 //
 
 #include <ops/declarable/helpers/image_suppression.h>
-//#include <blas/NDArray.h>
+#include <helpers/OmpLaunchHelper.h>
+#include <Environment.h>
+#include <memory>
+#include <queue>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    // boxes in SoA layout, with coordinates normalized so y1 <= y2 and x1 <= x2
     template <typename T>
-    static void nonMaxSuppressionV2_(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output) {
-        std::vector<Nd4jLong> indices(scales->lengthOf());
-        for (size_t i = 0; i < indices.size(); ++i)
-            indices[i] = i;
-        std::sort(indices.begin(), indices.end(), [scales](int i, int j) {return scales->e<T>(i) > scales->e<T>(j);});
-
-        std::vector<int> selected;
-        std::vector<int> selectedIndices(output->lengthOf(), 0);
-        auto needToSuppressWithThreshold = [threshold] (NDArray& boxes, int previousIndex, int nextIndex) -> bool {
-            T minYPrev = nd4j::math::nd4j_min(boxes.e<T>(previousIndex, 0), boxes.e<T>(previousIndex, 2));
-            T minXPrev = nd4j::math::nd4j_min(boxes.e<T>(previousIndex, 1), boxes.e<T>(previousIndex, 3));
-            T maxYPrev = nd4j::math::nd4j_max(boxes.e<T>(previousIndex, 0), boxes.e<T>(previousIndex, 2));
-            T maxXPrev = nd4j::math::nd4j_max(boxes.e<T>(previousIndex, 1), boxes.e<T>(previousIndex, 3));
-            T minYNext = nd4j::math::nd4j_min(boxes.e<T>(nextIndex, 0), boxes.e<T>(nextIndex, 2));
-            T minXNext = nd4j::math::nd4j_min(boxes.e<T>(nextIndex, 1), boxes.e<T>(nextIndex, 3));
-            T maxYNext = nd4j::math::nd4j_max(boxes.e<T>(nextIndex, 0), boxes.e<T>(nextIndex, 2));
-            T maxXNext = nd4j::math::nd4j_max(boxes.e<T>(nextIndex, 1), boxes.e<T>(nextIndex, 3));
-            T areaPrev = (maxYPrev - minYPrev) * (maxXPrev - minXPrev);
-            T areaNext = (maxYNext - minYNext) * (maxXNext - minXNext);
-
-            if (areaNext <= T(0.f) || areaPrev <= T(0.f)) return false;
-
-            T minIntersectionY = nd4j::math::nd4j_max(minYPrev, minYNext);
-            T minIntersectionX = nd4j::math::nd4j_max(minXPrev, minXNext);
-            T maxIntersectionY = nd4j::math::nd4j_min(maxYPrev, maxYNext);
-            T maxIntersectionX = nd4j::math::nd4j_min(maxXPrev, maxXNext);
-            T intersectionArea =
-                    nd4j::math::nd4j_max(T(maxIntersectionY - minIntersectionY), T(0.0f)) *
-                            nd4j::math::nd4j_max(T(maxIntersectionX - minIntersectionX), T(0.0f));
-            T intersectionValue = intersectionArea / (areaPrev + areaNext - intersectionArea);
-            return intersectionValue > threshold;
-
-        };
-        int numSelected = 0;
-        for (int i = 0; i < boxes->sizeAt(0); ++i) {
-            if (selected.size() >= output->lengthOf()) break;
-            bool shouldSelect = true;
-            // Overlapping boxes are likely to have similar scores,
-            // therefore we iterate through the selected boxes backwards.
-            for (int j = numSelected - 1; j >= 0; --j) {
-                if (needToSuppressWithThreshold(*boxes, indices[i], indices[selectedIndices[j]])) {
-                    shouldSelect = false;
-                    break;
-                }
+    struct BoxesSoA {
+        std::vector<T> y1, x1, y2, x2, area;
+
+        explicit BoxesSoA(Nd4jLong capacity = 0) {
+            y1.reserve(capacity);
+            x1.reserve(capacity);
+            y2.reserve(capacity);
+            x2.reserve(capacity);
+            area.reserve(capacity);
+        }
+
+        void append(const BoxesSoA<T>& other, const Nd4jLong index) {
+            y1.emplace_back(other.y1[index]);
+            x1.emplace_back(other.x1[index]);
+            y2.emplace_back(other.y2[index]);
+            x2.emplace_back(other.x2[index]);
+            area.emplace_back(other.area[index]);
+        }
+
+        Nd4jLong size() const {
+            return (Nd4jLong) area.size();
+        }
+    };
+
+    // candidate box, ordered by score and then by index, so results don't depend on sort stability
+    template <typename T>
+    struct SuppressionCandidate {
+        T score;
+        Nd4jLong index;
+        // number of selected boxes this candidate was already checked against
+        Nd4jLong checked;
+
+        bool operator<(const SuppressionCandidate<T>& other) const {
+            return score < other.score || (score == other.score && index > other.index);
+        }
+    };
+
+    // returns contiguous array of given type, either original one or its copy
+    static NDArray* contiguousOf(NDArray* array, const nd4j::DataType dtype, std::unique_ptr<NDArray>& holder) {
+        if (array->dataType() == dtype && array->ordering() == 'c' && array->ews() == 1)
+            return array;
+
+        holder.reset(new NDArray('c', array->getShapeAsVector(), dtype, array->getWorkspace()));
+        holder->assign(array);
+        return holder.get();
+    }
+
+    // suppression weight of candidate box against selected boxes [start, end): 0 if any IoU is above threshold,
+    // product of gaussian decays exp(scale * IoU^2) otherwise. scale == 0 means hard NMS, so weight is either 0 or 1
+    template <typename T>
+    static T suppressionWeight(const BoxesSoA<T>& boxes, const Nd4jLong candidate, const BoxesSoA<T>& selected, const Nd4jLong start, const Nd4jLong end, const T threshold, const T scale) {
+        const T y1 = boxes.y1[candidate];
+        const T x1 = boxes.x1[candidate];
+        const T y2 = boxes.y2[candidate];
+        const T x2 = boxes.x2[candidate];
+        const T area = boxes.area[candidate];
+
+        // boxes without area never overlap
+        if (area <= static_cast<T>(0))
+            return static_cast<T>(1);
+
+        auto sy1 = selected.y1.data();
+        auto sx1 = selected.x1.data();
+        auto sy2 = selected.y2.data();
+        auto sx2 = selected.x2.data();
+        auto sArea = selected.area.data();
+
+        // selected boxes are checked in blocks, so suppressed candidate exits early
+        const Nd4jLong blockSize = 64;
+        T weight = static_cast<T>(1);
+
+        for (Nd4jLong b = start; b < end; b += blockSize) {
+            const Nd4jLong bEnd = nd4j::math::nd4j_min<Nd4jLong>(b + blockSize, end);
+            int suppressed = 0;
+            T decay = static_cast<T>(0);
+
+            PRAGMA_OMP_SIMD_ARGS(reduction(|:suppressed) reduction(+:decay))
+            for (Nd4jLong j = b; j < bEnd; j++) {
+                const T iy = nd4j::math::nd4j_max<T>(nd4j::math::nd4j_min<T>(y2, sy2[j]) - nd4j::math::nd4j_max<T>(y1, sy1[j]), static_cast<T>(0));
+                const T ix = nd4j::math::nd4j_max<T>(nd4j::math::nd4j_min<T>(x2, sx2[j]) - nd4j::math::nd4j_max<T>(x1, sx1[j]), static_cast<T>(0));
+                const T intersection = iy * ix;
+                const T iou = sArea[j] > static_cast<T>(0) ? intersection / (area + sArea[j] - intersection) : static_cast<T>(0);
+
+                suppressed |= iou > threshold ? 1 : 0;
+                decay += iou * iou;
             }
-            if (shouldSelect) {
-                selected.push_back(indices[i]);
-                selectedIndices[numSelected++] = i;
+
+            if (suppressed)
+                return static_cast<T>(0);
+
+            // product of exponents is exponent of sum
+            if (scale != static_cast<T>(0))
+                weight *= nd4j::math::nd4j_exp<T, T>(scale * decay);
+        }
+
+        return weight;
+    }
+
+    template <typename T>
+    static Nd4jLong nonMaxSuppression_(NDArray* boxes, NDArray* scales, const Nd4jLong maxSize, const double threshold, const double scoreThreshold, const double sigma, std::vector<Nd4jLong>& result) {
+        const Nd4jLong numBoxes = boxes->sizeAt(0);
+        const auto dtype = DataTypeUtils::fromT<T>();
+
+        std::unique_ptr<NDArray> boxesHolder, scalesHolder;
+        auto b = contiguousOf(boxes, dtype, boxesHolder)->template bufferAsT<T>();
+        auto s = contiguousOf(scales, dtype, scalesHolder)->template bufferAsT<T>();
+
+        BoxesSoA<T> soa;
+        soa.y1.resize(numBoxes);
+        soa.x1.resize(numBoxes);
+        soa.y2.resize(numBoxes);
+        soa.x2.resize(numBoxes);
+        soa.area.resize(numBoxes);
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numBoxes > Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong e = 0; e < numBoxes; e++) {
+            auto box = b + e * 4;
+            soa.y1[e] = nd4j::math::nd4j_min<T>(box[0], box[2]);
+            soa.x1[e] = nd4j::math::nd4j_min<T>(box[1], box[3]);
+            soa.y2[e] = nd4j::math::nd4j_max<T>(box[0], box[2]);
+            soa.x2[e] = nd4j::math::nd4j_max<T>(box[1], box[3]);
+            soa.area[e] = (soa.y2[e] - soa.y1[e]) * (soa.x2[e] - soa.x1[e]);
+        }
+
+        // heap is built in O(N), and only candidates actually considered are popped from it
+        std::vector<SuppressionCandidate<T>> candidates;
+        candidates.reserve(numBoxes);
+        for (Nd4jLong e = 0; e < numBoxes; e++)
+            if (static_cast<double>(s[e]) > scoreThreshold)
+                candidates.emplace_back(SuppressionCandidate<T>{s[e], e, 0L});
+
+        std::priority_queue<SuppressionCandidate<T>> queue(std::less<SuppressionCandidate<T>>(), std::move(candidates));
+
+        const T iouThreshold = static_cast<T>(threshold);
+        const T scale = sigma > 0. ? static_cast<T>(-0.5 / sigma) : static_cast<T>(0);
+
+        BoxesSoA<T> selected(maxSize);
+        result.clear();
+
+        while (!queue.empty() && (Nd4jLong) result.size() < maxSize) {
+            auto candidate = queue.top();
+            queue.pop();
+
+            const T originalScore = candidate.score;
+            auto weight = suppressionWeight<T>(soa, candidate.index, selected, candidate.checked, selected.size(), iouThreshold, scale);
+            if (weight == static_cast<T>(0))
+                continue;
+
+            candidate.score *= weight;
+            candidate.checked = selected.size();
+
+            if (candidate.score == originalScore) {
+                // nothing decayed this candidate, so it's still the best one
+                selected.append(soa, candidate.index);
+                result.emplace_back(candidate.index);
+            }
+            else if (static_cast<double>(candidate.score) > scoreThreshold) {
+                // soft-NMS: decayed score goes back into the queue
+                queue.push(candidate);
             }
         }
-        for (size_t e = 0; e < selected.size(); ++e)
-            output->p<int>(e, selected[e]);
+
+        return (Nd4jLong) result.size();
+    }
+
+    void nonMaxSuppression(NDArray* boxes, NDArray* scales, int maxSize, double threshold, double scoreThreshold, double sigma, NDArray* output) {
+        std::vector<Nd4jLong> selected;
+
+        // half precision boxes are processed as floats
+        if (boxes->dataType() == nd4j::DataType::DOUBLE)
+            nonMaxSuppression_<double>(boxes, scales, maxSize, threshold, scoreThreshold, sigma, selected);
+        else
+            nonMaxSuppression_<float>(boxes, scales, maxSize, threshold, scoreThreshold, sigma, selected);
+
+        for (size_t e = 0; e < selected.size() && e < (size_t) output->lengthOf(); ++e)
+            output->p<Nd4jLong>(e, selected[e]);
     }
 
     void nonMaxSuppressionV2(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(output->dataType(), nonMaxSuppressionV2_, (boxes, scales, maxSize, threshold, output), NUMERIC_TYPES);
+        nonMaxSuppression(boxes, scales, nd4j::math::nd4j_min<Nd4jLong>(maxSize, output->lengthOf()), threshold, -DataTypeUtils::max<double>(), 0., output);
     }
-    BUILD_SINGLE_TEMPLATE(template void nonMaxSuppressionV2_, (NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output), NUMERIC_TYPES);
 
 }
 }
-}
\ No newline at end of file
+}
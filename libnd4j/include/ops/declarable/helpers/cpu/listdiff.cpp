@@ -20,25 +20,44 @@
 
 #include <ops/declarable/helpers/listdiff.h>
 #include <vector>
+#include <helpers/UniqueTable.h>
 //#include <memory>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
+    // marks elements of values which are absent in keep, and returns number of them
     template <typename T>
-    static Nd4jLong listDiffCount_(NDArray* values, NDArray* keep) {
+    static Nd4jLong listDiffMask(NDArray* values, NDArray* keep, std::vector<int8_t>& mask) {
+        // both inputs are vectors, so they can be read directly unless ews is unknown
+        UniqueTable<T> table(keep->lengthOf());
+        if (keep->ews() > 0)
+            table.build(keep->bufferAsT<T>(), keep->lengthOf(), keep->ews());
+        else
+            for (Nd4jLong e = 0; e < keep->lengthOf(); e++)
+                table.insert(keep->e<T>(e), e);
+
+        const Nd4jLong length = values->lengthOf();
+        const Nd4jLong stride = values->ews();
+        auto buffer = values->bufferAsT<T>();
+        mask.resize(length);
+
         Nd4jLong saved = 0L;
-        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
-            T v = values->e<T>(e);
-            T extras[] = {v, (T) 0.0f, (T) 10.0f};
-            NDArray idx = keep->indexReduceNumber(indexreduce::FirstIndex, extras);
-            Nd4jLong index = idx.e<Nd4jLong>(0);
-            if (index < 0)
-                saved++;
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(length > Environment::getInstance()->elementwiseThreshold()) reduction(+:saved))
+        for (Nd4jLong e = 0; e < length; e++) {
+            mask[e] = table.find(stride > 0 ? buffer[e * stride] : values->e<T>(e)) < 0 ? 1 : 0;
+            saved += mask[e];
         }
+
         return saved;
     }
 
+    template <typename T>
+    static Nd4jLong listDiffCount_(NDArray* values, NDArray* keep) {
+        std::vector<int8_t> mask;
+        return listDiffMask<T>(values, keep, mask);
+    }
+
     Nd4jLong listDiffCount(NDArray* values, NDArray* keep) {
         auto xType = values->dataType();
 
@@ -53,14 +72,15 @@ namespace helpers {
         std::vector<T> saved;
         std::vector<Nd4jLong> indices;
 
-        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
-            T v = values->e<T>(e);
-            T extras[] = {v, (T) 0.0f, (T) 10.0f};
-            NDArray idxScalar = keep->indexReduceNumber(indexreduce::FirstIndex, extras);
-            Nd4jLong idx = idxScalar.e<Nd4jLong>(0);
+        std::vector<int8_t> mask;
+        auto numSaved = listDiffMask<T>(values, keep, mask);
+        saved.reserve(numSaved);
+        indices.reserve(numSaved);
 
-            if (idx < 0) {
-                saved.emplace_back(v);
+        // compaction is sequential, to keep original order of values
+        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
+            if (mask[e]) {
+                saved.emplace_back(values->e<T>(e));
                 indices.emplace_back(e);
             }
         }
@@ -27,6 +27,7 @@
 
 
 #include<ops/declarable/helpers/lstm.h>
+#include<ops/declarable/helpers/rnn.h>
 #include <VariableSpace.h>
 #include <ops/declarable/CustomOperations.h>
 #include<ops/declarable/helpers/transforms.h>
@@ -85,21 +86,59 @@ static void clipping(NDArray* arr, T limit) {
 }
 
 //////////////////////////////////////////////////////////////////////////
-void lstmCell(const NDArray* xt, const NDArray* ht_1, const NDArray* ct_1, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b,
-              NDArray* ht, NDArray* ct, const std::vector<double>& params) {
-
-    // xt   input [bS x inSize]
-    // ht_1 previous cell output [bS x numProj],  that is at previous time step t-1, in case of projection=false -> numProj=numUnits!!!
-    // ct_1 previous cell state  [bS x numUnits], that is at previous time step t-1
-
-    // Wx   input-to-hidden  weights, [inSize  x 4*numUnits]
-    // Wh   hidden-to-hidden weights, [numProj x 4*numUnits]
-    // Wc   diagonal weights for peephole connections [3*numUnits]
-    // Wp   projection weights [numUnits x numProj]
-    // b    biases, [4*numUnits]
+// single pass over all gates: peephole connections, activations, clipping, cell state and output update
+// z [bS x 4*numUnits], ct_1/ct/hOut [bS x numUnits], all c order and contiguous. z is not modified
+template <typename T>
+static void fusedLstmGates(const NDArray* z, const NDArray* ct_1, const NDArray* Wc, NDArray* ct, NDArray* hOut, const bool peephole, const double clippingCellValue, const double forgetBias) {
+
+    const Nd4jLong bS       = ct_1->sizeAt(0);
+    const Nd4jLong numUnits = ct_1->sizeAt(1);
+
+    auto z_    = z->bufferAsT<T>();
+    auto cPrev = ct_1->bufferAsT<T>();
+    auto c_    = ct->bufferAsT<T>();
+    auto h_    = hOut->bufferAsT<T>();
+    auto wc_   = peephole ? Wc->bufferAsT<T>() : nullptr;
+
+    const T fBias = static_cast<T>(forgetBias);
+    const T clip  = static_cast<T>(clippingCellValue);
+    const bool clipping = clippingCellValue > 0.0;
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(bS * numUnits > Environment::getInstance()->elementwiseThreshold())
+    for (Nd4jLong r = 0; r < bS; r++) {
+        auto zr  = z_ + r * 4 * numUnits;
+        auto cr_1 = cPrev + r * numUnits;
+        auto cr  = c_ + r * numUnits;
+        auto hr  = h_ + r * numUnits;
+
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong j = 0; j < numUnits; j++) {
+            T zi = zr[j];
+            T zf = zr[numUnits + j];
+            T zo = zr[3 * numUnits + j];
+
+            if (peephole) {
+                zi += cr_1[j] * wc_[j];
+                zf += cr_1[j] * wc_[numUnits + j];
+            }
+
+            T c = nd4j::math::nd4j_sigmoid<T,T>(zf + fBias) * cr_1[j] + nd4j::math::nd4j_sigmoid<T,T>(zi) * nd4j::math::nd4j_tanh<T,T>(zr[2 * numUnits + j]);
+            if (clipping)
+                c = c > clip ? clip : (c < -clip ? -clip : c);
+
+            if (peephole)
+                zo += c * wc_[2 * numUnits + j];
+
+            cr[j] = c;
+            hr[j] = nd4j::math::nd4j_sigmoid<T,T>(zo) * nd4j::math::nd4j_tanh<T,T>(c);
+        }
+    }
+}
 
-    // ht  current cell output [bS x numProj], that is at current time step t
-    // ct  current cell state  [bS x numUnits], that is at current time step t
+//////////////////////////////////////////////////////////////////////////
+// z is preactivation of all gates, = mmul(xt,Wx) + mmul(ht_1,Wh) + b, [bS x 4*numUnits]. It may be modified in place
+// hScratch is optional [bS x numUnits] buffer for cell output before projection
+static void lstmGates(NDArray& z, const NDArray* ct_1, const NDArray* Wc, const NDArray* Wp, NDArray* ht, NDArray* ct, const std::vector<double>& params, NDArray* hScratch = nullptr) {
 
     const bool peephole   = (bool)params[0];        // if true, provide peephole connections
     const bool projection = (bool)params[1];        // if true, then projection is performed, if false then numProj==numUnits is mandatory!!!!
@@ -107,12 +146,29 @@ void lstmCell(const NDArray* xt, const NDArray* ht_1, const NDArray* ct_1, const
     double clippingProjValue   = params[3];              // clipping value for projected ht, if it is not equal to zero, then projected cell output is clipped
     const double forgetBias    = params[4];
 
-    const int bS   = xt->sizeAt(0);
-    const int inSize      = xt->sizeAt(1);
-    const int numProj     = ht_1->sizeAt(1);
     const int numUnits    = ct_1->sizeAt(1);
 
-    auto z = mmul(*xt, *Wx) + mmul(*ht_1, *Wh) + *b;      // [bS x 4*numUnits] + [bS x 4*numUnits] + [1 x 4*numUnits] = [bS x 4*numUnits]
+    const auto dataType = z.dataType();
+    if (isFusable(&z, dataType) && isFusable(ct_1, dataType) && isFusable(ct, dataType) && (!peephole || (Wc->ews() == 1 && Wc->dataType() == dataType))) {
+
+        NDArray* hOut = ht;
+        if (projection)
+            hOut = hScratch != nullptr ? hScratch : new NDArray('c', {ct_1->sizeAt(0), numUnits}, dataType, ct_1->getWorkspace());
+
+        if (isFusable(hOut, dataType)) {
+            BUILD_SINGLE_SELECTOR(dataType, fusedLstmGates, (&z, ct_1, Wc, ct, hOut, peephole, clippingCellValue, forgetBias), FLOAT_TYPES);
+
+            if (projection) {
+                MmulHelper::mmul(hOut, Wp, ht, 1.0, 0.0);         // [bS x numUnits] * [ numUnits x numProj] = [bS x numProj]
+                if(clippingProjValue != 0.)
+                    clipping(ht, clippingProjValue);
+
+                if (hOut != hScratch)
+                    delete hOut;
+            }
+            return;
+        }
+    }
 
     auto zit = z({0,0, 0,            numUnits});      	// z for input gate,  = mmul(Wxi,xt) + mmul(Whi,ht_1) + bi    = [bS x numUnits]
     auto zft = z({0,0, numUnits,   2*numUnits});      	// z for forget gate, = mmul(Wxf,xt) + mmul(Whf,ht_1) + bf    = [bS x numUnits]
@@ -148,6 +204,31 @@ void lstmCell(const NDArray* xt, const NDArray* ht_1, const NDArray* ct_1, const
         ht->assign(&htNoPeepHole);
 }
 
+//////////////////////////////////////////////////////////////////////////
+void lstmCell(const NDArray* xt, const NDArray* ht_1, const NDArray* ct_1, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b,
+              NDArray* ht, NDArray* ct, const std::vector<double>& params) {
+
+    // xt   input [bS x inSize]
+    // ht_1 previous cell output [bS x numProj],  that is at previous time step t-1, in case of projection=false -> numProj=numUnits!!!
+    // ct_1 previous cell state  [bS x numUnits], that is at previous time step t-1
+
+    // Wx   input-to-hidden  weights, [inSize  x 4*numUnits]
+    // Wh   hidden-to-hidden weights, [numProj x 4*numUnits]
+    // Wc   diagonal weights for peephole connections [3*numUnits]
+    // Wp   projection weights [numUnits x numProj]
+    // b    biases, [4*numUnits]
+
+    // ht  current cell output [bS x numProj], that is at current time step t
+    // ct  current cell state  [bS x numUnits], that is at current time step t
+
+    NDArray z('c', {xt->sizeAt(0), 4 * ct_1->sizeAt(1)}, ct_1->dataType(), ct_1->getWorkspace());
+    MmulHelper::mmul(xt, Wx, &z, 1.0, 0.0);
+    MmulHelper::mmul(ht_1, Wh, &z, 1.0, 1.0);
+    z += *b;                                            // [bS x 4*numUnits] + [bS x 4*numUnits] + [1 x 4*numUnits] = [bS x 4*numUnits]
+
+    lstmGates(z, ct_1, Wc, Wp, ht, ct, params);
+}
+
 template <typename T>
 static void fusedTanh(NDArray *z, NDArray *i, NDArray *c, const NDArray *cLast, NDArray *f, NDArray *h) {
     //cell state = blockInput .* inputGate + prevCellState .* forgetGate
@@ -173,6 +254,71 @@ static void fusedTanh(NDArray *z, NDArray *i, NDArray *c, const NDArray *cLast,
     }
 }
 
+//////////////////////////////////////////////////////////////////////////
+// single pass over all gates of lstmBlockCell, m [bS x 4*numUnits] is gates preactivation, ordered as [i, z, f, o]
+template <typename T>
+static void fusedLstmBlock(const NDArray* m, const NDArray* cLast, const NDArray* Wci, const NDArray* Wcf, const NDArray* Wco,
+                           NDArray* i, NDArray* c, NDArray* f, NDArray* o, NDArray* z, NDArray* h, NDArray* y,
+                           const bool peephole, const double forgetBias, const double clippingCellValue) {
+
+    const Nd4jLong bS       = cLast->sizeAt(0);
+    const Nd4jLong numUnits = cLast->sizeAt(1);
+
+    auto m_     = m->bufferAsT<T>();
+    auto cLast_ = cLast->bufferAsT<T>();
+    auto wci_   = peephole ? Wci->bufferAsT<T>() : nullptr;
+    auto wcf_   = peephole ? Wcf->bufferAsT<T>() : nullptr;
+    auto wco_   = peephole ? Wco->bufferAsT<T>() : nullptr;
+
+    auto i_ = i->bufferAsT<T>();
+    auto c_ = c->bufferAsT<T>();
+    auto f_ = f->bufferAsT<T>();
+    auto o_ = o->bufferAsT<T>();
+    auto z_ = z->bufferAsT<T>();
+    auto h_ = h->bufferAsT<T>();
+    auto y_ = y->bufferAsT<T>();
+
+    const T fBias = static_cast<T>(forgetBias);
+    const T clip  = static_cast<T>(clippingCellValue);
+    const bool clipping = clippingCellValue > 0.0;
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(bS * numUnits > Environment::getInstance()->elementwiseThreshold())
+    for (Nd4jLong r = 0; r < bS; r++) {
+        auto mr = m_ + r * 4 * numUnits;
+
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong j = 0; j < numUnits; j++) {
+            const auto e = r * numUnits + j;
+
+            T zi = mr[j];
+            T zf = mr[2 * numUnits + j] + fBias;
+            T zo = mr[3 * numUnits + j];
+
+            if (peephole) {
+                zi += cLast_[e] * wci_[j];
+                zf += cLast_[e] * wcf_[j];
+            }
+
+            i_[e] = nd4j::math::nd4j_sigmoid<T,T>(zi);
+            z_[e] = nd4j::math::nd4j_tanh<T,T>(mr[numUnits + j]);
+            f_[e] = nd4j::math::nd4j_sigmoid<T,T>(zf);
+
+            //cell state = blockInput .* inputGate + prevCellState .* forgetGate
+            T cv = z_[e] * i_[e] + f_[e] * cLast_[e];
+            if (clipping)
+                cv = cv > clip ? clip : (cv < -clip ? -clip : cv);
+
+            if (peephole)
+                zo += cv * wco_[j];
+
+            c_[e] = cv;
+            o_[e] = nd4j::math::nd4j_sigmoid<T,T>(zo);
+            h_[e] = nd4j::math::nd4j_tanh<T,T>(cv);
+            y_[e] = o_[e] * h_[e];
+        }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 void lstmBlockCell(const NDArray* xt, const NDArray* cLast, const NDArray* yLast,
@@ -214,28 +360,33 @@ void lstmBlockCell(const NDArray* xt, const NDArray* cLast, const NDArray* yLast
     const int inSize      = xt->sizeAt(1);
     const int numUnits    = cLast->sizeAt(1);
 
-    //Concat inputs: [xt, yt-1]: concat([bs,nIn],[bs,nOut]) -> [bs, (nIn+nOut)]
-    nd4j::ops::concat concat;
-    Context cContext(119);
-    auto concatOut = NDArrayFactory::create(xt->ordering(), {xt->sizeAt(0), xt->sizeAt(1) + yLast->sizeAt(1)}, xt->dataType(), xt->getWorkspace());
-    cContext.setInputArray(0, const_cast<NDArray*>(xt), false);
-    cContext.setInputArray(1, const_cast<NDArray*>(yLast), false);
-    cContext.setOutputArray(0, &concatOut, false);
-    cContext.getIArguments()->emplace_back(1);
-
-    concat.execute(&cContext);
-
-    //NDArray* NDArrayFactory::create_( const char order, const std::vector<Nd4jLong> &shape, nd4j::DataType dataType, nd4j::memory::Workspace* workspace) {
-    std::vector<Nd4jLong> shape = {bS, 4*numUnits};
-    auto m = NDArrayFactory::create_('c', shape, xt->dataType(), nullptr);
-    MmulHelper::mmul(&concatOut, W, m, 1.0f, 0.0f, 'c'); //mmul: [bs, (nIn+numUnits)]* [(inSize+numUnits), 4*numUnits] = [bs, 4*numUnits] - C result array
-    *m += (*b);  //addiRowVector
+    // W is concatenation of input-to-hidden and hidden-to-hidden weights, so [xt, yt-1] * W = xt * Wx + yt-1 * Wh, without concatenation of inputs
+    auto Wx = (*W)({0,inSize,                 0,0}, true);         // [inSize, 4*numUnits]
+    auto Wh = (*W)({inSize,inSize+numUnits,   0,0}, true);         // [numUnits, 4*numUnits]
+
+    NDArray m('c', {bS, 4*numUnits}, xt->dataType(), xt->getWorkspace());
+    MmulHelper::mmul(xt, &Wx, &m, 1.0, 0.0);
+    MmulHelper::mmul(yLast, &Wh, &m, 1.0, 1.0);        //mmul: [bs, (nIn+numUnits)]* [(inSize+numUnits), 4*numUnits] = [bs, 4*numUnits] - C result array
+    m += (*b);  //addiRowVector
+
+    const auto dataType = m.dataType();
+    bool fusable = isFusable(cLast, dataType);
+    for (auto arr : {i, c, f, o, z, h, y})
+        fusable &= isFusable(arr, dataType);
+    if (peephole)
+        for (auto arr : {Wci, Wcf, Wco})
+            fusable &= arr->ews() == 1 && arr->dataType() == dataType;
+
+    if (fusable) {
+        BUILD_SINGLE_SELECTOR(dataType, fusedLstmBlock, (&m, cLast, Wci, Wcf, Wco, i, c, f, o, z, h, y, peephole, forgetBias, clippingCellValue), FLOAT_TYPES);
+        return;
+    }
 
     //Note: weights are ordered [inputGate, blockInput, forgetGate, outputGate] to match TF (TF code comments state [i,f,z/ci,o] but behaviour is [i,z,f,o])
-    auto zi = (*m)({0,0, 0,            numUnits});      	// z for input modulation gate, [bS, numUnits]
-    auto zz = (*m)({0,0, numUnits, 2*numUnits});      	    // z for block input, [bS, numUnits]
-    auto zf = (*m)({0,0, 2*numUnits, 3*numUnits});      	// z for forget gate, [bS, numUnits]
-    auto zo = (*m)({0,0, 3*numUnits, 4*numUnits});      	// z for output gate, [bS, numUnits]
+    auto zi = m({0,0, 0,            numUnits});      	// z for input modulation gate, [bS, numUnits]
+    auto zz = m({0,0, numUnits, 2*numUnits});      	    // z for block input, [bS, numUnits]
+    auto zf = m({0,0, 2*numUnits, 3*numUnits});      	// z for forget gate, [bS, numUnits]
+    auto zo = m({0,0, 3*numUnits, 4*numUnits});      	// z for output gate, [bS, numUnits]
 
     if(peephole) {                                              // add peephole connections: z  +  ct_1*Wc
         zi += (*cLast) * (*Wci);       // add peephole connections to input gate
@@ -311,18 +462,34 @@ void lstmTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* c0, const
     // h cell outputs [time x bS x numProj], that is per each time step
     // c cell states  [time x bS x numUnits] that is per each time step
 
-    const int time  = x->sizeAt(0);
+    const int time     = x->sizeAt(0);
+    const int bS       = x->sizeAt(1);
+    const int numUnits = c0->sizeAt(1);
+
+    NDArray currentH('c', h0->getShapeAsVector(), h0->dataType(), h0->getWorkspace());
+    NDArray currentC('c', c0->getShapeAsVector(), c0->dataType(), c0->getWorkspace());
+    currentH.assign(h0);
+    currentC.assign(c0);
 
-    NDArray currentH(*h0);
-    NDArray currentC(*c0);
+    // input projection doesn't depend on previous state, so it's calculated for all time steps by single gemm
+    NDArray xProj('c', {time * bS, 4 * numUnits}, c0->dataType(), c0->getWorkspace());
+    helpers::rnnProjectInputs(x, Wx, &xProj);
+    xProj += *b;
+
+    // scratch buffers are allocated once per sequence, and reused by all time steps
+    NDArray z('c', {bS, 4 * numUnits}, c0->dataType(), c0->getWorkspace());
+    NDArray hScratch('c', {bS, numUnits}, c0->dataType(), c0->getWorkspace());
 
     // loop through time steps
     for (int t = 0; t < time; ++t) {
-        auto xt = (*x)({t,t+1, 0,0, 0,0});
+        auto xt = xProj({t*bS,(t+1)*bS, 0,0}, true);
         auto ht = (*h)({t,t+1, 0,0, 0,0});
         auto ct = (*c)({t,t+1, 0,0, 0,0});
 
-        helpers::lstmCell(&xt,&currentH,&currentC, Wx,Wh,Wc,Wp, b,   &ht, &ct,   params);
+        z.assign(xt);
+        MmulHelper::mmul(&currentH, Wh, &z, 1.0, 1.0);        // z = xt*Wx + b  +  ht_1*Wh
+
+        lstmGates(z, &currentC, Wc, Wp, &ht, &ct, params, &hScratch);
         currentH.assign(ht);
         currentC.assign(ct);
     }
@@ -359,10 +526,28 @@ void lstmBlockTimeLoop(const NDArray* maxSeqLength, const NDArray* xSeq, const N
 
         helpers::lstmBlockCell(xt, c_t1, y_t1, W, Wci, Wcf, Wco, b, it, ct, ft, ot, zt, ht, yt, params);
 
+        // sub-arrays are views, previous cell state and output are kept for the next time step
+        if (c_t1 != c0)
+            delete c_t1;
+        if (y_t1 != y0)
+            delete y_t1;
+
+        delete xt;
+        delete it;
+        delete ft;
+        delete ot;
+        delete zt;
+        delete ht;
+
         c_t1 = ct;
         y_t1 = yt;
     }
 
+    if (c_t1 != c0)
+        delete c_t1;
+    if (y_t1 != y0)
+        delete y_t1;
+
 }
 
 }
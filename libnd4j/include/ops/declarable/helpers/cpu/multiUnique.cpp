@@ -20,6 +20,7 @@
 
 #include <ops/declarable/helpers/multiUnique.h>
 #include <ops/declarable/CustomOperations.h>
+#include <helpers/UniqueTable.h>
 
 namespace nd4j {
 namespace ops {
@@ -28,34 +29,27 @@ namespace helpers {
     bool multiUnique(std::vector<NDArray*> const& inputList, nd4j::memory::Workspace *workspace) {
         Nd4jLong length = 0;
         for (auto array: inputList) {
-            length += array->lengthOf();
-        }
-        auto arrayFull = NDArrayFactory::vector<int>(length, 0, workspace);
-        int val = -1;
-        Nd4jLong border = 0;
-        for (auto& array: inputList) {
             if (array->dataType() != nd4j::DataType::INT32)
                 throw std::runtime_error("multiUnique: this op support INT32 data type only.");
 
-            for (Nd4jLong pos = 0; pos < array->lengthOf(); pos++)
-                arrayFull->p(border + pos, array->e(pos));
-            // memcpy(reinterpret_cast<int*>(arrayFull.buffer() + border), reinterpret_cast<int const*>(array->getBuffer()), array->lengthOf() * array->sizeOf());
-            val--;
-            border += array->lengthOf();
+            length += array->lengthOf();
         }
 
-        nd4j::ops::unique opUnique;
-        auto uResult = opUnique.execute({arrayFull}, {}, {}, {});
-        if (ND4J_STATUS_OK != uResult->status())
-            throw std::runtime_error("multiUnique: cannot execute unique op properly.");
+        // all values are added to the single table, first duplicate means the answer is known
+        UniqueTable<int> table(length);
+        Nd4jLong border = 0;
+        for (auto array: inputList) {
+            for (Nd4jLong pos = 0; pos < array->lengthOf(); pos++) {
+                table.insert(array->e<int>(pos), border + pos);
 
-        auto uniqueVals = uResult->at(0);
+                if (table.size() != border + pos + 1)
+                    return false;
+            }
 
-        bool res = uniqueVals->lengthOf() == arrayFull->lengthOf();
+            border += array->lengthOf();
+        }
 
-        delete uResult;
-        delete arrayFull;
-        return res;
+        return true;
     }
 
 }
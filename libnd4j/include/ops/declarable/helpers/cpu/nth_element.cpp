@@ -22,6 +22,8 @@
 #include <TAD.h>
 #include <ShapeUtils.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/Selection.h>
+#include <helpers/OmpLaunchHelper.h>
 
 namespace nd4j {
 namespace ops {
@@ -30,36 +32,49 @@ namespace helpers {
     template <typename T>
     void nthElementFunctor_(NDArray* input, NDArray* nVal, NDArray* output, bool reverse) {
         Nd4jLong n = nVal->e<Nd4jLong>(0);
-        NDArray sortedVals(*input);
+        auto x = input->bufferAsT<T>();
+
+        // n-th element in descending order is (length - n - 1)-th element in ascending order
         if (input->isVector()) {
-            //std::vector<float> data(input->lengthOf());
-            //memcpy(&data[0], input->getBuffer(), sizeof(T) * data.size());
-            //size_t l = 0;
-            //for (size_t l = 0; l < data.size(); ++l)
-            //    data[l] = input->e<float>(l);
-            //auto nthPos = data.begin();
-            //nthPos += n;
-            //std::nth_element(data.begin(), nthPos, data.end());
-            SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), reverse);
-            output->p(0, sortedVals.e<T>(n));
+            const Nd4jLong length = input->lengthOf();
+            std::unique_ptr<T[]> buffer(new T[length]);
+            Selection<T>::gather(x, input->shapeInfo(), length, buffer.get());
+            output->p(0, Selection<T>::select(buffer.get(), length, reverse ? length - n - 1 : n));
         }
         else { // rank greater than 1
-            std::vector<int> lastDims({input->rankOf() - 1});// = ShapeUtils::evalDimsToExclude(input->rankOf(), {input->rankOf() - 1});
+            std::vector<int> lastDims({input->rankOf() - 1});
+
+            auto tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(input->shapeInfo(), lastDims);
+            auto tadShapeInfo = tadPack.primaryShapeInfo();
+            auto tadOffsets = tadPack.primaryOffsets();
+            const Nd4jLong numTads = tadPack.numberOfTads();
+            const Nd4jLong lastDim = input->sizeAt(-1);
+            const Nd4jLong position = reverse ? lastDim - n - 1 : n;
 
-            auto tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(sortedVals.shapeInfo(), lastDims);
-            SpecialMethods<T>::sortTadGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), lastDims.data(), lastDims.size(), tadPack.primaryShapeInfo(), tadPack.primaryOffsets(), reverse);
+            auto z = output->bufferAsT<T>();
+            const Nd4jLong zEws = output->ordering() == 'c' && output->dataType() == input->dataType() ? output->ews() : 0;
 
-            std::unique_ptr<ResultSet> rows(input->allTensorsAlongDimension(lastDims));
+            int numThreads = OmpLaunchHelper::betterThreads(numTads * lastDim);
+            numThreads = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(numThreads, numTads));
 
-            Nd4jLong oL = output->lengthOf();
+            // each thread selects over its own share of TADs, using its own buffer
+            PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
+            for (int t = 0; t < numThreads; t++) {
+                std::unique_ptr<T[]> buffer(new T[lastDim]);
 
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < oL; e++) {
-                auto row = rows->at(e);
-                output->p(e, row->e<T>(n));
+                for (Nd4jLong e = t; e < numTads; e += numThreads) {
+                    Selection<T>::gather(x + tadOffsets[e], tadShapeInfo, lastDim, buffer.get());
+                    auto value = Selection<T>::select(buffer.get(), lastDim, position);
+
+                    if (zEws >= 1)
+                        z[e * zEws] = value;
+                    else
+                        output->p(e, value);
+                }
             }
         }
     }
+
     void nthElementFunctor(NDArray* input, NDArray* n, NDArray* output, bool reverse) {
     BUILD_SINGLE_SELECTOR(input->dataType(), nthElementFunctor_, (input, n, output, reverse), LIBND4J_TYPES);
 
@@ -19,8 +19,9 @@
 //
 
 #include <ops/declarable/helpers/percentile.h>
-#include <NDArrayFactory.h>
-#include "ResultSet.h"
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/OmpLaunchHelper.h>
+#include <helpers/Selection.h>
 
 namespace nd4j    {
 namespace ops     {
@@ -40,14 +41,11 @@ static void _percentile(const NDArray& input, NDArray& output, std::vector<int>&
         shape::checkDimensions(inputRank, axises);          // check, sort dimensions and remove duplicates if they are present
 
 
-    auto listOfSubArrs = input.allTensorsAlongDimension(axises);
-    
-    std::vector<Nd4jLong> shapeOfSubArr(listOfSubArrs->at(0)->rankOf());
-    for(int i=0; i<shapeOfSubArr.size(); ++i)
-        shapeOfSubArr[i] = listOfSubArrs->at(0)->shapeOf()[i];
-
-    auto flattenedArr = NDArrayFactory::create('c', shapeOfSubArr, input.dataType(), input.getWorkspace());
-    const int len = flattenedArr.lengthOf();
+    auto tadPack = ConstantTadHelper::getInstance()->tadForDimensions(input.getShapeInfo(), axises);
+    auto tadShapeInfo = tadPack.primaryShapeInfo();
+    auto tadOffsets = tadPack.primaryOffsets();
+    const Nd4jLong numTads = tadPack.numberOfTads();
+    const Nd4jLong len = shape::length(tadShapeInfo);
     
     const float fraction = 1.f - q / 100.;
     Nd4jLong position = 0;
@@ -65,17 +63,21 @@ static void _percentile(const NDArray& input, NDArray& output, std::vector<int>&
     }
     position = len - position - 1;
 
-    // FIXME: our sort impl should be used instead, so this operation might be implemented as generic
-    PRAGMA_OMP_PARALLEL_FOR_ARGS(firstprivate(flattenedArr))
-    for(int i=0; i<listOfSubArrs->size(); ++i) {
-        
-        T* buff = reinterpret_cast<T *>(flattenedArr.getBuffer());
-        flattenedArr.assign(listOfSubArrs->at(i));
-        std::sort(buff, buff + len);
-        output.p(i, flattenedArr.e<T>(position));
-    }
+    auto x = input.bufferAsT<T>();
 
-    delete listOfSubArrs;
+    int numThreads = OmpLaunchHelper::betterThreads(numTads * len);
+    numThreads = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(numThreads, numTads));
+
+    // selection instead of full sort, each thread uses its own buffer
+    PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
+    for (int t = 0; t < numThreads; t++) {
+        std::unique_ptr<T[]> buffer(new T[len]);
+
+        for (Nd4jLong i = t; i < numTads; i += numThreads) {
+            Selection<T>::gather(x + tadOffsets[i], tadShapeInfo, len, buffer.get());
+            output.p(i, Selection<T>::select(buffer.get(), len, position));
+        }
+    }
 }
 
     void percentile(const NDArray& input, NDArray& output, std::vector<int>& axises, const float q, const int interpolation) {
@@ -22,6 +22,8 @@
 
 #include<ops/declarable/helpers/rnn.h>
 #include <helpers/BlasHelper.h>
+#include <MmulHelper.h>
+#include <algorithm>
 
 
 namespace nd4j    {
@@ -52,6 +54,30 @@ void rnnCell(const NDArray* xt, const NDArray* Wx, const NDArray* Wh, const NDAr
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+void rnnProjectInputs(const NDArray* x, const NDArray* Wx, NDArray* xProj) {
+
+    // x     input [time x bS x inSize]
+    // Wx    input-to-hidden weights, [inSize x N]
+    // xProj [time*bS x N], rows are ordered as t*bS + e
+
+    const Nd4jLong time   = x->sizeAt(0);
+    const Nd4jLong bS     = x->sizeAt(1);
+    const Nd4jLong inSize = x->sizeAt(2);
+
+    NDArray* xc = const_cast<NDArray*>(x);
+    if(x->ordering() != 'c' || x->ews() != 1)
+        xc = xc->dup('c');
+
+    auto x2d = xc->reshape('c', {time * bS, inSize});
+    MmulHelper::mmul(x2d, Wx, xProj, 1.0, 0.0);        // [time*bS x inSize] * [inSize x N] = [time*bS x N]
+
+    delete x2d;
+    if(xc != x)
+        delete xc;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 void rnnTimeLoop(const NDArray* x, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* h0, const NDArray* maxTimeStep, NDArray* h, NDArray* hFinal) {
 
@@ -64,8 +90,9 @@ void rnnTimeLoop(const NDArray* x, const NDArray* Wx, const NDArray* Wh, const N
 	// maxTimeStep vector [bS] containing integer values within [0,time), each element of this vector set max time step per each input in batch, this means there are no calculations for time >= maxTimeStep
     
     const int time     = x->sizeAt(0);
-    const int bS       = x->sizeAt(1);        
-    
+    const int bS       = x->sizeAt(1);
+    const int numUnits = Wx->sizeAt(1);
+
     // at first time step
     if(h0)
         hFinal->assign(h0);
@@ -73,31 +100,53 @@ void rnnTimeLoop(const NDArray* x, const NDArray* Wx, const NDArray* Wh, const N
         *hFinal = 0.;   
 
     BlasHelper::getInstance();          // to avoid memory leak in pragma parallel loops
-    // loop through batch of inputs           
-    for (int e = 0; e < bS; ++e) {                  
-        // loop through time steps
-        for (int t = 0; t < time; ++t) {
-
-            int maxStep = maxTimeStep ? maxTimeStep->e<int>(e) : time;
-
-            auto xt   = (*x)({t,t+1, e,e+1, 0,0}, true);
-            auto ht   = (*h)({t,t+1, e,e+1, 0,0}, true);
-            auto ht_1 = (*hFinal)({e,e+1, 0,0}, true);                       // previous state
-            
-            if(t >= maxStep) {
-                ht = 0.;
-                if(maxStep != 0)                    
-                    ht_1.assign((*h)({maxStep-1,maxStep, e,e+1, 0,0}));
+
+    // input projection doesn't depend on previous state, so it's calculated for all time steps by single gemm, together with both biases
+    NDArray xProj('c', {time * bS, numUnits}, hFinal->dataType(), hFinal->getWorkspace());
+    rnnProjectInputs(x, Wx, &xProj);
+    xProj += (*b)({{0, numUnits}}) + (*b)({{numUnits, 2*numUnits}});
+
+    std::vector<int> maxSteps(bS, time);
+    int minStep = time;
+    for (int e = 0; e < bS; ++e) {
+        if(maxTimeStep)
+            maxSteps[e] = maxTimeStep->e<int>(e);
+        minStep = std::min<int>(minStep, maxSteps[e]);
+    }
+
+    NDArray ht('c', {bS, numUnits}, hFinal->dataType(), hFinal->getWorkspace());
+
+    // loop through time steps, whole batch is processed at once
+    for (int t = 0; t < time; ++t) {
+
+        auto xt = xProj({t*bS,(t+1)*bS, 0,0}, true);
+        auto hT = (*h)({t,t+1, 0,0, 0,0}, true);
+
+        ht.assign(xt);
+        MmulHelper::mmul(hFinal, Wh, &ht, 1.0, 1.0);                // ht = xt*Wx + bx + bh  +  ht_1*Wh
+        ht.applyTransform(transform::Tanh);
+
+        if(t < minStep) {
+            hT.assign(ht);
+            hFinal->assign(ht);
+            continue;
+        }
+
+        // some inputs in batch are already finished: their outputs are zeros, and final state is kept as is
+        for (int e = 0; e < bS; ++e) {
+            auto hTe = hT({0,0, e,e+1, 0,0}, true);
+
+            if(t >= maxSteps[e]) {
+                hTe = 0.;
             }
             else {
-                helpers::rnnCell(&xt, Wx, Wh, b, &ht_1, &ht);
-                ht_1.assign(ht);
+                auto hte = ht({e,e+1, 0,0}, true);
+                hTe.assign(hte);
+                (*hFinal)({e,e+1, 0,0}, true).assign(hte);
             }
         }
-    }    
+    }
 }
-
-
 }
 }
 }
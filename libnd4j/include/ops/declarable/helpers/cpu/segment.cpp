@@ -14,340 +14,458 @@
  * SPDX-License-Identifier: Apache-2.0
  ******************************************************************************/
 
+
 //
 //  @author GS <sgazeos@gmail.com>
 //
 
 #include <ops/declarable/helpers/segment.h>
+#include <helpers/OmpLaunchHelper.h>
+#include <Environment.h>
+#include <memory>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    // segment max
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Segment reduction engine
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Input is viewed as [rows, inner] matrix, and output as [classes, inner] matrix. Rows are grouped into segments,
+    // each segment is reduced into the row of its class with SIMD loops over inner dimension, segments are processed
+    // in parallel. Sorted and unsorted ops differ only in the way segments are built.
+
+    enum SegmentOp {
+        SegmentMaxOp = 0,
+        SegmentMinOp,
+        SegmentSumOp,
+        SegmentMeanOp,
+        SegmentProdOp,
+        SegmentSqrtNOp,
+    };
+
+    struct SegmentLayout {
+        // order of rows, grouped by segment. Empty means natural order
+        std::vector<Nd4jLong> rows;
+
+        // bounds of segments within rows, numberOfSegments + 1 elements
+        std::vector<Nd4jLong> starts;
+
+        // class of each segment
+        std::vector<Nd4jLong> classes;
+
+        FORCEINLINE Nd4jLong rowAt(const Nd4jLong e) const {
+            return rows.empty() ? e : rows[e];
+        }
+    };
+
     template <typename T>
-    static void segmentMaxFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        //int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
-
-            for (Nd4jLong e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<Nd4jLong>(e)) {
-                   // max
-                   val = nd4j::math::nd4j_max<T>(val, input->t<T>(e));
-                }
-                else {
-                    idx = indices->e<Nd4jLong>(e);
-                    val = input->t<T>(e);
-                }
-                output->t<T>(idx) = val;
-            }
+    struct SegmentMax {
+        static FORCEINLINE T empty() { return -DataTypeUtils::max<T>(); }
+        static FORCEINLINE T op(const T a, const T b) { return nd4j::math::nd4j_max<T>(a, b); }
+        static FORCEINLINE T finalize(const T v, const Nd4jLong count) { return v; }
+        static FORCEINLINE T bp(const T x, const T f, const T g, const Nd4jLong count) { return x == f ? g : static_cast<T>(0); }
+    };
+
+    template <typename T>
+    struct SegmentMin {
+        static FORCEINLINE T empty() { return DataTypeUtils::max<T>(); }
+        static FORCEINLINE T op(const T a, const T b) { return nd4j::math::nd4j_min<T>(a, b); }
+        static FORCEINLINE T finalize(const T v, const Nd4jLong count) { return v; }
+        static FORCEINLINE T bp(const T x, const T f, const T g, const Nd4jLong count) { return x == f ? g : static_cast<T>(0); }
+    };
+
+    template <typename T>
+    struct SegmentSum {
+        static FORCEINLINE T empty() { return static_cast<T>(0); }
+        static FORCEINLINE T op(const T a, const T b) { return static_cast<T>(a + b); }
+        static FORCEINLINE T finalize(const T v, const Nd4jLong count) { return v; }
+        static FORCEINLINE T bp(const T x, const T f, const T g, const Nd4jLong count) { return g; }
+    };
+
+    template <typename T>
+    struct SegmentMean {
+        static FORCEINLINE T empty() { return static_cast<T>(0); }
+        static FORCEINLINE T op(const T a, const T b) { return static_cast<T>(a + b); }
+        static FORCEINLINE T finalize(const T v, const Nd4jLong count) { return static_cast<T>(v / static_cast<T>(count)); }
+        static FORCEINLINE T bp(const T x, const T f, const T g, const Nd4jLong count) { return static_cast<T>(g / static_cast<T>(count)); }
+    };
+
+    template <typename T>
+    struct SegmentProd {
+        static FORCEINLINE T empty() { return static_cast<T>(1); }
+        static FORCEINLINE T op(const T a, const T b) { return static_cast<T>(a * b); }
+        static FORCEINLINE T finalize(const T v, const Nd4jLong count) { return v; }
+        static FORCEINLINE T bp(const T x, const T f, const T g, const Nd4jLong count) { return static_cast<T>(f * g / x); }
+    };
+
+    template <typename T>
+    struct SegmentSqrtN {
+        static FORCEINLINE T empty() { return static_cast<T>(0); }
+        static FORCEINLINE T op(const T a, const T b) { return static_cast<T>(a + b); }
+        static FORCEINLINE T finalize(const T v, const Nd4jLong count) { return static_cast<T>(static_cast<double>(v) / nd4j::math::nd4j_sqrt<Nd4jLong, double>(count)); }
+        static FORCEINLINE T bp(const T x, const T f, const T g, const Nd4jLong count) { return static_cast<T>(static_cast<double>(g) / nd4j::math::nd4j_sqrt<Nd4jLong, double>(count)); }
+    };
+
+    static void readIndices(NDArray* indices, std::vector<Nd4jLong>& ids) {
+        const Nd4jLong length = indices->lengthOf();
+        ids.resize(length);
+
+        if (indices->dataType() == nd4j::DataType::INT64 && indices->ews() == 1 && indices->ordering() == 'c') {
+            auto buffer = indices->bufferAsT<Nd4jLong>();
+            std::copy(buffer, buffer + length, ids.begin());
+            return;
         }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
+        PRAGMA_OMP_PARALLEL_FOR_IF(length > Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong e = 0; e < length; e++)
+            ids[e] = indices->e<Nd4jLong>(e);
+    }
 
-            auto numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto maxT = listOfOutTensors->at(idx);
+    // sorted indices: every run of equal indices is a segment. Boundaries are found with parallel scan
+    static void sortedLayout(const std::vector<Nd4jLong>& ids, SegmentLayout& layout) {
+        const Nd4jLong length = ids.size();
+        const int numChunks = OmpLaunchHelper::betterThreads(length);
+        const Nd4jLong span = length / numChunks + 1;
 
-            //int pos = 0;
-            maxT->assign(listOfTensors->at(0));
+        std::vector<Nd4jLong> counts(numChunks + 1, 0);
 
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(numChunks)
+        for (int c = 0; c < numChunks; c++) {
+            const Nd4jLong end = nd4j::math::nd4j_min<Nd4jLong>((c + 1) * span, length);
+            for (Nd4jLong e = c * span; e < end; e++)
+                if (e == 0 || ids[e] != ids[e - 1])
+                    counts[c + 1]++;
+        }
 
-                    for (Nd4jLong e = 0; e < maxT->lengthOf(); e++) {
-                       maxT->t<T>(e) = nd4j::math::nd4j_max(maxT->t<T>(e), listOfTensors->at(i)->t<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<Nd4jLong>(i);
-                    maxT = listOfOutTensors->at(idx);
-                    maxT->assign(listOfTensors->at(i));
+        for (int c = 0; c < numChunks; c++)
+            counts[c + 1] += counts[c];
+
+        layout.rows.clear();
+        layout.starts.resize(counts[numChunks] + 1);
+        layout.classes.resize(counts[numChunks]);
+
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(numChunks)
+        for (int c = 0; c < numChunks; c++) {
+            const Nd4jLong end = nd4j::math::nd4j_min<Nd4jLong>((c + 1) * span, length);
+            auto pos = counts[c];
+            for (Nd4jLong e = c * span; e < end; e++)
+                if (e == 0 || ids[e] != ids[e - 1]) {
+                    layout.starts[pos] = e;
+                    layout.classes[pos] = ids[e];
+                    pos++;
                 }
+        }
+
+        layout.starts[counts[numChunks]] = length;
+    }
+
+    // unsorted indices: rows are grouped by class with counting sort, so each class becomes single segment,
+    // and rows within the segment keep their original order
+    static void unsortedLayout(const std::vector<Nd4jLong>& ids, const Nd4jLong numOfClasses, SegmentLayout& layout) {
+        const Nd4jLong length = ids.size();
+        std::vector<Nd4jLong> offsets(numOfClasses + 1, 0);
 
+        for (Nd4jLong e = 0; e < length; e++)
+            offsets[ids[e] + 1]++;
+
+        layout.starts.clear();
+        layout.classes.clear();
+        for (Nd4jLong c = 0; c < numOfClasses; c++) {
+            if (offsets[c + 1] > 0) {
+                layout.starts.emplace_back(offsets[c]);
+                layout.classes.emplace_back(c);
             }
-            delete listOfTensors;
-            delete listOfOutTensors;
+
+            offsets[c + 1] += offsets[c];
         }
+        layout.starts.emplace_back(length);
+
+        layout.rows.resize(length);
+        for (Nd4jLong e = 0; e < length; e++)
+            layout.rows[offsets[ids[e]]++] = e;
     }
 
-    // segmen min 
-    template <typename T>
-    static void segmentMinFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        //int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
-
-            for (int e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<Nd4jLong>(e)) {
-                   // min 
-                   val = nd4j::math::nd4j_min<T>(val, input->t<T>(e));
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->t<T>(e);
-                }
-                output->t<T>(idx) = val;
+    static void countClasses(const std::vector<Nd4jLong>& ids, const Nd4jLong numOfClasses, std::vector<Nd4jLong>& counts) {
+        counts.assign(numOfClasses, 0);
+        for (auto id: ids)
+            counts[id]++;
+    }
+
+    // returns given array, if it's contiguous and has requested data type, or its contiguous copy otherwise
+    static NDArray* contiguousOf(NDArray* array, const nd4j::DataType dtype) {
+        if (array->dataType() == dtype && array->ordering() == 'c' && array->ews() == 1)
+            return array;
+
+        auto result = new NDArray('c', array->getShapeAsVector(), dtype, array->getWorkspace());
+        result->assign(array);
+        return result;
+    }
+
+    template <typename T, typename OpType>
+    static void segmentReduceLoop(const T* x, T* z, const Nd4jLong inner, const Nd4jLong numOfClasses, const SegmentLayout& layout, const bool fillEmpty) {
+        const Nd4jLong numSegments = layout.classes.size();
+
+        if (fillEmpty) {
+            std::vector<int8_t> present(numOfClasses, 0);
+            for (auto c: layout.classes)
+                present[c] = 1;
+
+            PRAGMA_OMP_PARALLEL_FOR_IF(numOfClasses * inner > Environment::getInstance()->elementwiseThreshold())
+            for (Nd4jLong c = 0; c < numOfClasses; c++) {
+                if (present[c])
+                    continue;
+
+                auto zRow = z + c * inner;
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = 0; e < inner; e++)
+                    zRow[e] = OpType::empty();
             }
         }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            auto loop_length = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int e = 1; e < loop_length; e++)
-                restDims[e - 1] = e;
 
-            std::unique_ptr<ResultSet> listOfTensors( input->allTensorsAlongDimension(restDims) );
-            std::unique_ptr<ResultSet> listOfOutTensors( output->allTensorsAlongDimension(restDims) );
+        // if there are few segments, inner dimension is split into blocks, so all threads have some work
+        const int maxThreads = omp_get_max_threads();
+        const Nd4jLong numBlocks = numSegments >= maxThreads ? 1 : nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(maxThreads, inner / 1024));
+        const Nd4jLong blockSize = (inner + numBlocks - 1) / numBlocks;
 
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto minT = listOfOutTensors->at(idx);
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(if(numSegments * numBlocks > 1 && layout.starts[numSegments] * inner > Environment::getInstance()->elementwiseThreshold()) collapse(2))
+        for (Nd4jLong s = 0; s < numSegments; s++) {
+            for (Nd4jLong b = 0; b < numBlocks; b++) {
+                const Nd4jLong start = b * blockSize;
+                const Nd4jLong end = nd4j::math::nd4j_min<Nd4jLong>(start + blockSize, inner);
+                const Nd4jLong first = layout.starts[s];
+                const Nd4jLong last = layout.starts[s + 1];
 
-            int pos = 0;
-            minT->assign(listOfTensors->at(0));
+                auto zRow = z + layout.classes[s] * inner;
+                auto xRow = x + layout.rowAt(first) * inner;
 
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<T>(i) == idx) {
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = start; e < end; e++)
+                    zRow[e] = xRow[e];
 
-                    for (int e = 0; e < minT->lengthOf(); e++) {
-                       minT->p(e, nd4j::math::nd4j_min(minT->e<T>(e), listOfTensors->at(i)->e<T>(e)));
-                    }
-                }
-                else {
-                    idx = indices->e<T>(i);
-                    minT = listOfOutTensors->at(idx);
-                    minT->assign(listOfTensors->at(i));
+                for (Nd4jLong r = first + 1; r < last; r++) {
+                    xRow = x + layout.rowAt(r) * inner;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = start; e < end; e++)
+                        zRow[e] = OpType::op(zRow[e], xRow[e]);
                 }
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong e = start; e < end; e++)
+                    zRow[e] = OpType::finalize(zRow[e], last - first);
             }
         }
     }
 
-    // segmen mean
     template <typename T>
-    static void segmentMeanFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        if (input->isVector()) {
-            T val = T(0.f);
-            int count = 0;
-
-            for (int e = 0; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // mean 
-                   val += input->e<T>(e);
-                   count++;
-                }
-                else {
-                   output->p<T>(idx, val / count);
-                    idx = indices->e<int>(e);
-                    val = input->e<T>(e);
-                    count = 1;
-                }
-                output->p<T>(idx, val / count);
-            }
+    static void segmentReduce_(NDArray* input, const SegmentLayout& layout, const int opNum, const bool fillEmpty, NDArray* output) {
+        if (input->lengthOf() == 0)
+            return;
+
+        auto x = contiguousOf(input, output->dataType());
+        auto z = contiguousOf(output, output->dataType());
+
+        auto xBuffer = x->bufferAsT<T>();
+        auto zBuffer = z->bufferAsT<T>();
+        const Nd4jLong inner = input->lengthOf() / input->sizeAt(0);
+        const Nd4jLong numOfClasses = output->sizeAt(0);
+
+        switch (opNum) {
+            case SegmentMaxOp:
+                segmentReduceLoop<T, SegmentMax<T>>(xBuffer, zBuffer, inner, numOfClasses, layout, fillEmpty);
+                break;
+            case SegmentMinOp:
+                segmentReduceLoop<T, SegmentMin<T>>(xBuffer, zBuffer, inner, numOfClasses, layout, fillEmpty);
+                break;
+            case SegmentSumOp:
+                segmentReduceLoop<T, SegmentSum<T>>(xBuffer, zBuffer, inner, numOfClasses, layout, fillEmpty);
+                break;
+            case SegmentMeanOp:
+                segmentReduceLoop<T, SegmentMean<T>>(xBuffer, zBuffer, inner, numOfClasses, layout, fillEmpty);
+                break;
+            case SegmentProdOp:
+                segmentReduceLoop<T, SegmentProd<T>>(xBuffer, zBuffer, inner, numOfClasses, layout, fillEmpty);
+                break;
+            case SegmentSqrtNOp:
+                segmentReduceLoop<T, SegmentSqrtN<T>>(xBuffer, zBuffer, inner, numOfClasses, layout, fillEmpty);
+                break;
+            default:
+                throw std::runtime_error("segmentReduce: unknown segment op");
         }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto meanT = listOfOutTensors->at(idx);
-            int count = 1;
-            auto meanV = meanT->dup();
-            meanV->assign(listOfTensors->at(0));
-
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < meanT->lengthOf(); e++) {
-                       meanV->p<T>(e, meanV->e<T>(e) + listOfTensors->at(i)->e<T>(e));
-                    }
-                    count++;
-                }
-                else {
-                    //meanT->assign(meanV);
-                    meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
-                    idx = indices->e<int>(i);
-                    meanT = listOfOutTensors->at(idx);
-                    meanV->assign(listOfTensors->at(i));
-                    count = 1;
-                }
-                meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
-            }
-            delete meanV;
-            delete listOfTensors;
-            delete listOfOutTensors;
+
+        if (x != input)
+            delete x;
+
+        if (z != output) {
+            output->assign(z);
+            delete z;
         }
     }
 
-    template <typename T>
-    static void segmentSumFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        if (input->isVector()) {
-            T val = T(0.f);
-            int count = 0;
-            for (int e = 0; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // sum 
-                   val += input->t<T>(e);
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->t<T>(e);
-                }
-                output->p(idx, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-	    int loop_size = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto sumT = listOfOutTensors->at(idx);
-
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) + listOfTensors->at(i)->e<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
-                }
-            }
-            delete listOfTensors;
-            delete listOfOutTensors;
+    static void segmentReduce(NDArray* input, const SegmentLayout& layout, const int opNum, const bool fillEmpty, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentReduce_, (input, layout, opNum, fillEmpty, output), LIBND4J_TYPES);
+    }
+
+    static void sortedSegmentReduce(NDArray* input, NDArray* indices, const int opNum, const bool fillEmpty, NDArray* output) {
+        std::vector<Nd4jLong> ids;
+        readIndices(indices, ids);
+
+        SegmentLayout layout;
+        sortedLayout(ids, layout);
+
+        segmentReduce(input, layout, opNum, fillEmpty, output);
+    }
+
+    static void unsortedSegmentReduce(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, const int opNum, const bool fillEmpty, NDArray* output) {
+        std::vector<Nd4jLong> ids;
+        readIndices(indices, ids);
+
+        SegmentLayout layout;
+        unsortedLayout(ids, numOfClasses, layout);
+
+        segmentReduce(input, layout, opNum, fillEmpty, output);
+    }
+
+    // every input row gets gradient of its class: grad = OpType::bp(input, forward result, gradOut, class size)
+    template <typename T, typename OpType>
+    static void segmentBPLoop(const T* x, const T* f, const T* g, T* z, const Nd4jLong inner, const std::vector<Nd4jLong>& ids, const std::vector<Nd4jLong>& counts) {
+        const Nd4jLong numRows = ids.size();
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numRows > 1 && numRows * inner > Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong r = 0; r < numRows; r++) {
+            const auto c = ids[r];
+            const auto count = counts[c];
+            auto xRow = x + r * inner;
+            auto fRow = f + c * inner;
+            auto gRow = g + c * inner;
+            auto zRow = z + r * inner;
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong e = 0; e < inner; e++)
+                zRow[e] = OpType::bp(xRow[e], fRow[e], gRow[e], count);
         }
     }
 
     template <typename T>
-    static void segmentProdFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        //int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        output->assign(1.f);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
-            int count = 0;
-
-            for (int e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // sum 
-                   val *= input->e<T>(e);
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->e<T>(e);
-                }
-                output->p(idx, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            PRAGMA_OMP_SIMD
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            auto sumT = listOfOutTensors->at(idx);
-            sumT->assign(listOfTensors->at(0));
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i)  == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) * listOfTensors->at(i)->e<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
-                }
-            }
-            delete listOfTensors;
-            delete listOfOutTensors;
+    static int segmentBP_(NDArray* input, NDArray* indices, NDArray* gradOut, const Nd4jLong numOfClasses, const bool sorted, const int opNum, NDArray* output) {
+        if (input->lengthOf() == 0)
+            return ND4J_STATUS_OK;
+
+        std::vector<Nd4jLong> ids;
+        readIndices(indices, ids);
+
+        std::vector<Nd4jLong> counts;
+        countClasses(ids, numOfClasses, counts);
+
+        auto x = contiguousOf(input, output->dataType());
+        auto g = contiguousOf(gradOut, output->dataType());
+        auto z = contiguousOf(output, output->dataType());
+
+        // max, min and prod gradients depend on the forward result
+        NDArray* f = g;
+        if (opNum == SegmentMaxOp || opNum == SegmentMinOp || opNum == SegmentProdOp) {
+            SegmentLayout layout;
+            if (sorted)
+                sortedLayout(ids, layout);
+            else
+                unsortedLayout(ids, numOfClasses, layout);
+
+            f = new NDArray('c', g->getShapeAsVector(), output->dataType(), output->getWorkspace());
+            segmentReduce_<T>(x, layout, opNum, false, f);
+        }
+
+        auto xBuffer = x->bufferAsT<T>();
+        auto fBuffer = f->bufferAsT<T>();
+        auto gBuffer = g->bufferAsT<T>();
+        auto zBuffer = z->bufferAsT<T>();
+        const Nd4jLong inner = input->lengthOf() / input->sizeAt(0);
+
+        switch (opNum) {
+            case SegmentMaxOp:
+                segmentBPLoop<T, SegmentMax<T>>(xBuffer, fBuffer, gBuffer, zBuffer, inner, ids, counts);
+                break;
+            case SegmentMinOp:
+                segmentBPLoop<T, SegmentMin<T>>(xBuffer, fBuffer, gBuffer, zBuffer, inner, ids, counts);
+                break;
+            case SegmentSumOp:
+                segmentBPLoop<T, SegmentSum<T>>(xBuffer, fBuffer, gBuffer, zBuffer, inner, ids, counts);
+                break;
+            case SegmentMeanOp:
+                segmentBPLoop<T, SegmentMean<T>>(xBuffer, fBuffer, gBuffer, zBuffer, inner, ids, counts);
+                break;
+            case SegmentProdOp:
+                segmentBPLoop<T, SegmentProd<T>>(xBuffer, fBuffer, gBuffer, zBuffer, inner, ids, counts);
+                break;
+            case SegmentSqrtNOp:
+                segmentBPLoop<T, SegmentSqrtN<T>>(xBuffer, fBuffer, gBuffer, zBuffer, inner, ids, counts);
+                break;
+            default:
+                throw std::runtime_error("segmentBP: unknown segment op");
+        }
+
+        if (f != g)
+            delete f;
+
+        if (x != input)
+            delete x;
+
+        if (g != gradOut)
+            delete g;
+
+        if (z != output) {
+            output->assign(z);
+            delete z;
         }
+
+        return ND4J_STATUS_OK;
+    }
+
+    static int segmentBP(NDArray* input, NDArray* indices, NDArray* gradOut, const Nd4jLong numOfClasses, const bool sorted, const int opNum, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentBP_, (input, indices, gradOut, numOfClasses, sorted, opNum, output), NUMERIC_TYPES);
     }
 
-//    template <typename T>
-//    static bool segmentIndicesValidate_(NDArray* indices, NDArray& aexpected, NDArray& anOutput) {
-//      }
+    BUILD_SINGLE_TEMPLATE(template void segmentReduce_, (NDArray* input, const SegmentLayout& layout, const int opNum, const bool fillEmpty, NDArray* output), LIBND4J_TYPES);
+    BUILD_SINGLE_TEMPLATE(template int segmentBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, const Nd4jLong numOfClasses, const bool sorted, const int opNum, NDArray* output), NUMERIC_TYPES);
+
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Sorted segment ops
+    // -------------------------------------------------------------------------------------------------------------- //
 
     void segmentMaxFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentMaxFunctor_, (input, indices, output), LIBND4J_TYPES);
+        sortedSegmentReduce(input, indices, SegmentMaxOp, false, output);
     }
 
     void segmentMinFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentMinFunctor_, (input, indices, output), LIBND4J_TYPES);
+        sortedSegmentReduce(input, indices, SegmentMinOp, false, output);
     }
 
     void segmentMeanFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentMeanFunctor_, (input, indices, output), LIBND4J_TYPES);
+        sortedSegmentReduce(input, indices, SegmentMeanOp, false, output);
     }
 
     void segmentSumFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentSumFunctor_, (input, indices, output), LIBND4J_TYPES);
+        sortedSegmentReduce(input, indices, SegmentSumOp, false, output);
     }
 
     void segmentProdFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentProdFunctor_, (input, indices, output), LIBND4J_TYPES);
+        sortedSegmentReduce(input, indices, SegmentProdOp, true, output);
     }
 
     bool segmentIndicesValidate(NDArray* indices, NDArray& expected, NDArray& output) {
-        auto val = indices->e(0);
-        for (int e = 1; e < indices->lengthOf(); e++) {
-            output = indices->e(e);
-            if (val.e<Nd4jLong>(0) > output.e<Nd4jLong>(0))
+        std::vector<Nd4jLong> ids;
+        readIndices(indices, ids);
+
+        for (Nd4jLong e = 1; e < (Nd4jLong) ids.size(); e++) {
+            if (ids[e - 1] > ids[e]) {
+                output = indices->e(e);
                 return false;
-            val = indices->e(e);
+            }
         }
 
         return true;
     }
 
-    //BUILD_SINGLE_TEMPLATE(template bool segmentIndicesValidate_, (NDArray*, NDArray&, NDArray&), LIBND4J_TYPES);
-    BUILD_SINGLE_TEMPLATE(template void segmentProdFunctor_, (NDArray* input, NDArray* indices, NDArray* output), LIBND4J_TYPES);
-    BUILD_SINGLE_TEMPLATE(template void segmentSumFunctor_, (NDArray* input, NDArray* indices, NDArray* output), LIBND4J_TYPES);
-    BUILD_SINGLE_TEMPLATE(template void segmentMeanFunctor_, (NDArray* input, NDArray* indices, NDArray* output), LIBND4J_TYPES);
-    BUILD_SINGLE_TEMPLATE(template void segmentMinFunctor_, (NDArray* input, NDArray* indices, NDArray* output), LIBND4J_TYPES);
-    BUILD_SINGLE_TEMPLATE(template void segmentMaxFunctor_, (NDArray* input, NDArray* indices, NDArray* output), LIBND4J_TYPES);
     // -------------------------------------------------------------------------------------------------------------- //
     // Unsorted segment ops
     // -------------------------------------------------------------------------------------------------------------- //
@@ -364,286 +482,28 @@ namespace helpers {
         return true;
     }
 
-    template <typename T>
-    static void unsortedSegmentMaxFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-
-        // if input is a vector: (as if in doc sample)
-        //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(-maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->e<T>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_max(val, input->e<T>(fi->second.at(idx)));
-                }
-                output->p(fi->first, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong idx = idxs[0][0];
-            int loop_size = input->rankOf();
-            PRAGMA_OMP_SIMD
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(-maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto maxT = listOfTensors->at(fi->second.at(idx));
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        T val = nd4j::math::nd4j_max(maxT->e<T>(e), outputT->e<T>(e));
-
-                        outputT->p(e, val);
-                    }
-                }
-                //outputT->assign(maxT);
-            }
-        }
-    }
     void unsortedSegmentMaxFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+        unsortedSegmentReduce(input, indices, numOfClasses, SegmentMaxOp, true, output);
     }
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMaxFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
-
-    template <typename T>
-    static void unsortedSegmentMinFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        // if input is a vector: (as if in doc sample)
-        //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
 
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->t<T>(fi->second.at(0));
-
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_min(val, input->t<T>(fi->second.at(idx)));
-                }
-                output->t<T>(fi->first) = val;
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong idx = idxs[0][0];
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto minT = listOfTensors->at(fi->second.at(idx));
-
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        outputT->t<T>(e) = nd4j::math::nd4j_min(minT->t<T>(e), outputT->t<T>(e));
-                    }
-                }
-                //outputT->assign(maxT);
-            }
-        }
-
-    }
     void unsortedSegmentMinFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output),
-                              NUMERIC_TYPES);
+        unsortedSegmentReduce(input, indices, numOfClasses, SegmentMinOp, true, output);
     }
 
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
-
     void unsortedSegmentMeanFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                int loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR_SIMD_REDUCTION(+:sumValue)
-                for (size_t idx = 1; idx < loop_size; ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-
-                output->p(fi->first, sumValue / fi->second.size());
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size= input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
-                }
-                (*outputT) /= double(fi->second.size());
-            }
-        }
+        unsortedSegmentReduce(input, indices, numOfClasses, SegmentMeanOp, false, output);
     }
 
     void unsortedSegmentSumFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        if (input->isVector()) { // 1D case
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                Nd4jLong loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR_REDUCTION(+:sumValue)
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-                output->p(fi->first, sumValue);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                Nd4jLong loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *(outputT) += *current;
-                }
-                //outputT->assign(maxT);
-            }
-        }
-    }
-
-    template <typename T>
-    void unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        output->assign(1.f);
-
-        if (input->isVector()) { // 1D case
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T prodValue = input->e<T>(fi->second.at(0));
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    prodValue *= input->e<T>(fi->second.at(idx));
-                }
-                output->p(fi->first, prodValue);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-
-                    *outputT *= *current;
-                }
-            }
-        }
+        unsortedSegmentReduce(input, indices, numOfClasses, SegmentSumOp, false, output);
     }
 
     void unsortedSegmentProdFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentProdFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+        unsortedSegmentReduce(input, indices, numOfClasses, SegmentProdOp, true, output);
     }
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentProdFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     void unsortedSegmentSqrtNFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-                output->p(fi->first, sumValue / nd4j::math::nd4j_sqrt<Nd4jLong, double>(fi->second.size()));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-
-            int loop_size =  input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
-                }
-                //outputT->assign(maxT);
-                (*outputT) /= nd4j::math::nd4j_sqrt<size_t, double>(fi->second.size());
-            }
-        }
+        unsortedSegmentReduce(input, indices, numOfClasses, SegmentSqrtNOp, false, output);
     }
 
     // -------------------------------------------------------------------------------------------------------------- //
@@ -652,474 +512,52 @@ namespace helpers {
     // Sorted backpropagate ops
     //
 
-    // segment max
-    template <typename T>
-    int segmentMaxFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        //int numOfClasses = gradOut->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        auto tempRes = gradOut->dup();
-        segmentMaxFunctor_<T>(input, indices, tempRes);
-        if (input->isVector()) {
-            Nd4jLong loop_size = input->lengthOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < loop_size; ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                if (nd4j::math::nd4j_abs(tempRes->e<T>(classNum) -input->e<T>(e) <= T(1.e-6)))
-                    output->p(e, gradOut->e<T>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            int pos = 0;
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                for (Nd4jLong e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->e<T>(e) - current->e<T>(e)) <= T(1.e-6))
-                        currentOut->p(e, currentGradOut->e<T>(e));
-                }
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
-    }
-
     int segmentMaxFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentMaxFunctorBP_, (input, indices, gradOut, output), NUMERIC_TYPES);
+        return segmentBP(input, indices, gradOut, gradOut->sizeAt(0), true, SegmentMaxOp, output);
     }
-    BUILD_SINGLE_TEMPLATE(template int segmentMaxFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output), NUMERIC_TYPES);
 
-    // segmen min
     int segmentMinFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        std::unique_ptr<NDArray> tempRes(gradOut->dup());
-        segmentMinFunctor(input, indices, tempRes.get());
-        if (input->isVector()) {
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                if (nd4j::math::nd4j_abs(tempRes->e<double>(classNum) - input->e<double>(e)) < 1.e-5)
-                    output->p(e, gradOut->e<double>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            output->assign(0.);
-            int pos = 0;
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->e<double>(e) - current->e<double>(e)) < 1.e-5)
-                        currentOut->p(e, currentGradOut->e<double>(e));
-                }
-            }
-        }
-        return ND4J_STATUS_OK;
+        return segmentBP(input, indices, gradOut, gradOut->sizeAt(0), true, SegmentMinOp, output);
     }
 
-    // segmen mean
     int segmentMeanFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        std::map<Nd4jLong, Nd4jLong> classCount;//(numClasses);
-
-        for (Nd4jLong count = 0; count < numClasses; ++count) {
-            classCount[count] = 0;
-        }
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-            classCount[indices->e<Nd4jLong>(e)] ++;
-        }
-
-        // if input is a vector: (as if in doc sample)
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum) / classCount[classNum]);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            int pos = 0;
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    currentOut->p(e, currentGradOut->e<double>(e) / classCount[classNum]);
-                }
-            }
-        }
-        return ND4J_STATUS_OK;
+        return segmentBP(input, indices, gradOut, gradOut->sizeAt(0), true, SegmentMeanOp, output);
     }
 
     int segmentSumFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-//        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                currentOut->assign(currentGradOut);
-            }
-        }
-        return ND4J_STATUS_OK;
+        return segmentBP(input, indices, gradOut, gradOut->sizeAt(0), true, SegmentSumOp, output);
     }
 
     int segmentProdFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        auto tempRes = gradOut->dup();
-        segmentProdFunctor(input, indices, tempRes);
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum) * tempRes->e<double>(classNum)/ input->e<double>(e));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                NDArray* currentFFOut = listOfBPTensors->at(classNum);
-
-                currentOut->assign((*currentFFOut) * (*currentGradOut) / (*current));
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
+        return segmentBP(input, indices, gradOut, gradOut->sizeAt(0), true, SegmentProdOp, output);
     }
 
     // -------------------------------------------------------------------------------------------------------------- //
     // Unsorted backpropagate segment ops
     // -------------------------------------------------------------------------------------------------------------- //
 
-    template <typename T>
-    static int unsortedSegmentMaxFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-//        int numOfClasses = gradOut->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        auto tempRes = gradOut->dup();
-        unsortedSegmentMaxFunctor(input, indices, numOfClasses, tempRes);
-        if (input->isVector()) {
-
-            for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                if (nd4j::math::nd4j_abs(tempRes->e<double>(classNum) - input->e<double>(e)) < 1.e-5)
-                    output->p(e, gradOut->e<T>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->e<double>(e) - current->e<double>(e)) < 1.e-5)
-                        currentOut->p(e, currentGradOut->e<T>(e));
-                }
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
-    }
-
     int unsortedSegmentMaxFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(output->dataType(), return unsortedSegmentMaxFunctorBP_, (input, indices, gradOut, numOfClasses, output), NUMERIC_TYPES);
-    }
-    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentMaxFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
-
-    template <typename T>
-    static int unsortedSegmentMinFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        auto tempRes = gradOut->dup();
-        unsortedSegmentMinFunctor(input, indices, numOfClasses, tempRes);
-        if (input->isVector()) {
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                if (nd4j::math::nd4j_abs(tempRes->t<T>(classNum) - input->t<T>(e)) < 1.e-6)
-                    output->t<T>(e) = gradOut->t<T>(classNum);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->t<T>(e) - current->t<T>(e)) < 1.e-6)
-                        currentOut->t<T>(e) = currentGradOut->t<T>(e);
-                }
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
+        return segmentBP(input, indices, gradOut, numOfClasses, false, SegmentMaxOp, output);
     }
 
     int unsortedSegmentMinFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(output->dataType(), return unsortedSegmentMinFunctorBP_, (input, indices, gradOut, numOfClasses, output), NUMERIC_TYPES);
+        return segmentBP(input, indices, gradOut, numOfClasses, false, SegmentMinOp, output);
     }
-    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentMinFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     int unsortedSegmentMeanFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-
-        std::map<Nd4jLong, Nd4jLong> classCount;//(numClasses);
-
-        for (Nd4jLong count = 0; count < numOfClasses; ++count) {
-            classCount[count] = 0;
-        }
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-            classCount[indices->e<Nd4jLong>(e)]++;
-        }
-
-        // if input is a vector: (as if in doc sample)
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum) / classCount[classNum]);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                currentOut->assign(*currentGradOut / double(classCount[classNum]));
-            }
-        }
-        return ND4J_STATUS_OK;
+        return segmentBP(input, indices, gradOut, numOfClasses, false, SegmentMeanOp, output);
     }
 
     int unsortedSegmentSumFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                //NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                currentOut->assign(currentGradOut);
-            }
-        }
-        return ND4J_STATUS_OK;
+        return segmentBP(input, indices, gradOut, numOfClasses, false, SegmentSumOp, output);
     }
 
     int unsortedSegmentProdFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        auto tempRes = gradOut->dup();
-
-        unsortedSegmentProdFunctor(input, indices, numOfClasses, tempRes);
-        if (input->isVector()) {
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p<double>(e, gradOut->e<double>(classNum) * tempRes->e<double>(classNum)/ input->e<double>(e));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                auto currentFFOut = listOfBPTensors->at(classNum);
-
-                currentOut->assign((*currentFFOut) * (*currentGradOut) / (*current));
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
+        return segmentBP(input, indices, gradOut, numOfClasses, false, SegmentProdOp, output);
     }
 
-//    template <typename T>
     int unsortedSegmentSqrtNFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, Nd4jLong> classCount;//(numClasses);
-
-        for (Nd4jLong count = 0; count < numOfClasses; ++count) {
-            classCount[count] = 0;
-        }
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-            classCount[indices->e<Nd4jLong>(e)]++;
-        }
-
-        // if input is a vector: (as if in doc sample)
-        if (input->isVector()) {
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum) / nd4j::math::nd4j_sqrt<double,double>(classCount[classNum]));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    currentOut->p(e, currentGradOut->e<double>(e) / nd4j::math::nd4j_sqrt<double,double>(classCount[classNum]));
-                }
-            }
-        }
-        return ND4J_STATUS_OK;
+        return segmentBP(input, indices, gradOut, numOfClasses, false, SegmentSqrtNOp, output);
     }
 
 }
@@ -22,6 +22,8 @@
 #include <AveragingArrayProxy.h>
 #include <helpers/AveragingArrayProxy.h>
 #include <specials.h>
+#include <vector>
+#include <algorithm>
 
 #define HS_MAX_EXP 6.0f
 
@@ -74,6 +76,29 @@ namespace nd4j {
                 }
             }
 
+            /**
+             * This method calculates negative sampling gradient for given dot product. Returns FALSE if row must be skipped
+             */
+            template <typename T>
+            static FORCEINLINE bool nsGradient_(const T dot, const int code, const double alpha, const T *expTable, const int expLength, T &g) {
+                if (dot > HS_MAX_EXP)
+                    g = (code - 1) * alpha;
+                else if (dot < (T) - HS_MAX_EXP)
+                    g = (code - 0) * alpha;
+                else {
+                    int idx = (int) ((dot + (T) HS_MAX_EXP) * ((T) expLength / HS_MAX_EXP / 2.0));
+                    if (idx >= expLength)
+                        return false;
+
+                    if (idx < 0)
+                        return false;
+
+                    g = ((T) code - expTable[idx]) * alpha;
+                }
+
+                return true;
+            }
+
             template <typename T>
             void nSampling_(void *vsyn0, void *vsyn1Neg, void *vexpTable, void *vneu1e, double alpha, int vectorLength, int code, int expLength, bool isInference) {
                 auto syn0 = reinterpret_cast<T*>(vsyn0);
@@ -88,20 +113,8 @@ namespace nd4j {
                     dot += syn0[e] * syn1Neg[e];
                 }
 
-                if (dot > HS_MAX_EXP)
-                    g = (code - 1) * alpha;
-                else if (dot < (T) - HS_MAX_EXP)
-                    g = (code - 0) * alpha;
-                else {
-                    int idx = (int) ((dot + (T) HS_MAX_EXP) * ((T) expLength / HS_MAX_EXP / 2.0));
-                    if (idx >= expLength)
-                        return;
-
-                    if (idx < 0)
-                        return;
-
-                    g = ((T) code - expTable[idx]) * alpha;
-                }
+                if (!nsGradient_<T>(dot, code, alpha, expTable, expLength, g))
+                    return;
 
                 // axpy1
                 PRAGMA_OMP_SIMD
@@ -351,87 +364,178 @@ namespace nd4j {
                 }
             }
 
+            template <typename T>
+            static FORCEINLINE void prefetchRow_(const T *row, const int vectorLength) {
+#if defined(__GNUC__)
+                // rows are going to be updated, so they're requested for write
+                const auto bytes = vectorLength * (int) sizeof(T);
+                for (int e = 0; e < bytes; e += 64)
+                    __builtin_prefetch(reinterpret_cast<const char*>(row) + e, 1, 1);
+#endif
+            }
+
+            /**
+             * This method draws rows for negative sampling round. First row is always nsStarter, i.e. positive one.
+             * Random sequence is the same as in single round nSampling
+             */
+            template <typename T>
+            static int drawNegatives_(const int nsStarter, unsigned long long randomValue, const T *negTable, const int nsRounds, const int vocabSize, const int negLength, int *rows) {
+                int numRows = 0;
+                rows[numRows++] = nsStarter;
+
+                for (int r = 1; r < nsRounds + 1; r++) {
+                    randomValue = randomValue * (unsigned long long) 25214903917 + 11;
+                    auto idx = nd4j::math::nd4j_abs<Nd4jLong >((randomValue >> 16) % negLength);
+                    int irow = idx >= negLength ? -1 : static_cast<int>(negTable[idx]);
+
+                    if (irow < 0 || irow >= vocabSize)
+                        irow = randomValue % (vocabSize - 1) + 1;
+
+                    if (irow == nsStarter)
+                        continue;
+
+                    rows[numRows++] = irow;
+                }
+
+                return numRows;
+            }
+
+            /**
+             * This method applies whole negative sampling round for one input vector. Dot products for all rows are
+             * computed first, as single small GEMV, and updates are applied after that. That's equal to sequential
+             * nSampling calls as long as rows are distinct, so sequential path is used for duplicates.
+             */
+            template <typename T>
+            static void negativeBlock_(T *input, T *syn1Neg, const T *expTable, const int *rows, const int numRows, T *grads, T *neu1e, const double alpha, const int vectorLength, const int expLength) {
+                for (int r = 0; r < numRows; r++)
+                    for (int p = r + 1; p < numRows; p++)
+                        if (rows[r] == rows[p]) {
+                            for (int e = 0; e < numRows; e++) {
+                                if (e + 1 < numRows)
+                                    prefetchRow_<T>(syn1Neg + (rows[e + 1] * vectorLength), vectorLength);
+
+                                nSampling_<T>(input, syn1Neg + (rows[e] * vectorLength), const_cast<T*>(expTable), neu1e, alpha, vectorLength, e == 0 ? 1 : 0, expLength, false);
+                            }
+                            return;
+                        }
+
+                // gradients
+                for (int r = 0; r < numRows; r++) {
+                    if (r + 1 < numRows)
+                        prefetchRow_<T>(syn1Neg + (rows[r + 1] * vectorLength), vectorLength);
+
+                    auto row = syn1Neg + (rows[r] * vectorLength);
+                    T dot = (T) 0.0f;
+                    for (int e = 0; e < vectorLength; e++)
+                        dot += input[e] * row[e];
+
+                    grads[r] = (T) 0.0f;
+                    nsGradient_<T>(dot, r == 0 ? 1 : 0, alpha, expTable, expLength, grads[r]);
+                }
+
+                // axpy1 goes first for all rows, since it needs rows before update
+                for (int r = 0; r < numRows; r++) {
+                    const T g = grads[r];
+                    auto row = syn1Neg + (rows[r] * vectorLength);
+
+                    PRAGMA_OMP_SIMD
+                    for (int e = 0; e < vectorLength; e++)
+                        neu1e[e] = g * row[e] + neu1e[e];
+                }
+
+                // axpy2
+                for (int r = 0; r < numRows; r++) {
+                    const T g = grads[r];
+                    auto row = syn1Neg + (rows[r] * vectorLength);
+
+                    PRAGMA_OMP_SIMD
+                    for (int e = 0; e < vectorLength; e++)
+                        row[e] = g * input[e] + row[e];
+                }
+            }
+
             template <typename T>
             void skipgramBatchExec_(NDArray &s0, NDArray &s1, NDArray &s1n, void *vexpTable, void *vnegTable, void *vinfVector, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, const int nsRounds, const int vocabSize, const int vectorLength, const int expLength, const int negLength, const bool preciseMode, const int numThreads) {
-                //auto syn0 = reinterpret_cast<T*>(vsyn0);
-                //auto syn1 = reinterpret_cast<T*>(vsyn1);
-                //auto syn1Neg = reinterpret_cast<T*>(vsyn1Neg);
+                const auto syn0 = s0.bufferAsT<T>();
+                const auto syn1 = s1.bufferAsT<T>();
+                const auto syn1Neg = s1n.bufferAsT<T>();
                 const auto expTable = reinterpret_cast<T*>(vexpTable);
                 const auto negTable = reinterpret_cast<T*>(vnegTable);
-                const auto infVector = reinterpret_cast<T*>(vinfVector);
 
-                T sneu1e[600];
-
-                //const auto numThreads = omp_get_max_threads();
                 const auto idxShift = indices.isEmpty() ? 0 : indices.sizeAt(1);
                 const auto hsRounds = codes.isEmpty() ? 0 : codes.sizeAt(1);
 
-                    // regular mode provides 0 guarantees for reproducibility
-                    auto numTargets = targets.lengthOf();
-                    auto bTarget = targets.bufferAsT<int>();
-                    auto bIndices = indices.bufferAsT<int>();
-                    auto bCodes = codes.bufferAsT<int8_t>();
+                // regular mode provides 0 guarantees for reproducibility
+                const int numTargets = targets.lengthOf();
+                const auto bTarget = targets.bufferAsT<int>();
+                const auto bIndices = indices.bufferAsT<int>();
+                const auto bCodes = codes.bufferAsT<int8_t>();
+                const auto bStarters = negStarters.isEmpty() ? nullptr : negStarters.bufferAsT<int>();
+
+                // targets are sharded by syn0 row, so every syn0 row is updated by single thread, in original order
+                const int numShards = numThreads > 1 ? numThreads * 4 : 1;
+                std::vector<int> shardStart(numShards + 1, 0);
+                std::vector<int> order(numTargets);
+
+                for (int t = 0; t < numTargets; t++)
+                    shardStart[bTarget[t] % numShards + 1]++;
 
-                    PRAGMA_OMP_PARALLEL_FOR_ARGS(num_threads(numThreads) private(sneu1e))
-                    for (int t = 0; t < numTargets; t++) {
-                        T* neu1e = vectorLength <= 600 ? sneu1e : new T[vectorLength];
-                        memset(neu1e, 0, vectorLength * sizeof(T));
+                for (int s = 0; s < numShards; s++)
+                    shardStart[s + 1] += shardStart[s];
+
+                {
+                    std::vector<int> position(shardStart.begin(), shardStart.end() - 1);
+                    for (int t = 0; t < numTargets; t++)
+                        order[position[bTarget[t] % numShards]++] = t;
+                }
+
+                PRAGMA_OMP_PARALLEL_FOR_ARGS(num_threads(numThreads > 0 ? numThreads : 1) schedule(dynamic))
+                for (int s = 0; s < numShards; s++) {
+                    if (shardStart[s] == shardStart[s + 1])
+                        continue;
+
+                    std::vector<T> neu1e(vectorLength);
+                    std::vector<T> grads(nsRounds + 1);
+                    std::vector<int> rows(nsRounds + 1);
+
+                    for (int p = shardStart[s]; p < shardStart[s + 1]; p++) {
+                        const auto t = order[p];
+                        std::fill(neu1e.begin(), neu1e.end(), (T) 0.0f);
+
+                        if (p + 1 < shardStart[s + 1])
+                            prefetchRow_<T>(syn0 + (bTarget[order[p + 1]] * vectorLength), vectorLength);
 
                         auto target = bTarget[t];
                         auto alpha = lr.e<double>(t);
                         unsigned long long randomValue = nextRandom.e<Nd4jLong>(t);
 
-                        auto syn0row = reinterpret_cast<T*>(s0.bufferWithOffset(target * vectorLength));
+                        auto syn0row = syn0 + (target * vectorLength);
 
                         if (hsRounds > 0) {
-                            int irow = 0;
                             auto cShift = t * idxShift;
 
                             for (int e = 0; e < hsRounds; e++) {
-                                irow = bIndices[e + cShift];
+                                const int irow = bIndices[e + cShift];
                                 if (irow < 0 || irow >= vocabSize)
                                     continue;
 
-                                auto syn1row = s1.bufferWithOffset(irow * vectorLength);
-                                auto code = bCodes[e + cShift];
+                                if (e + 1 < hsRounds && bIndices[e + 1 + cShift] >= 0 && bIndices[e + 1 + cShift] < vocabSize)
+                                    prefetchRow_<T>(syn1 + (bIndices[e + 1 + cShift] * vectorLength), vectorLength);
 
-                                    //nd4j_printf("syn0: [%i]; syn1: [%i]; code: [%i]\n", target, irow, code);
-                                hSoftmax_<T>(syn0row, syn1row, expTable, neu1e, alpha, vectorLength, code, expLength, false);
+                                hSoftmax_<T>(syn0row, syn1 + (irow * vectorLength), expTable, neu1e.data(), alpha, vectorLength, bCodes[e + cShift], expLength, false);
                             }
                         }
 
-
                         if (nsRounds > 0) {
-                            int irow = negStarters.e<int>(t);
-                            int nsStarter = irow;
-                            for (int r = 0; r < nsRounds + 1; r++) {
-                                if (r == 0) {
-                                    // target is known in advance
-                                } else {
-                                    randomValue = randomValue * (unsigned long long) 25214903917 + 11;
-                                    auto idx = nd4j::math::nd4j_abs<Nd4jLong >((randomValue >> 16) % negLength);
-                                    irow = idx >= negLength ? -1 : static_cast<int>(negTable[idx]);
-
-                                    if (irow < 0 || irow >= vocabSize)
-                                        irow = randomValue % (vocabSize - 1) + 1;
-
-                                    if (irow == nsStarter)
-                                        continue;
-                                }
-
-                                nSampling_<T>(syn0row, s1n.bufferWithOffset(irow * vectorLength), expTable, neu1e, alpha, vectorLength, r == 0 ? 1 : 0, expLength, infVector != nullptr);
-                            }
+                            auto numRows = drawNegatives_<T>(bStarters[t], randomValue, negTable, nsRounds, vocabSize, negLength, rows.data());
+                            negativeBlock_<T>(syn0row, syn1Neg, expTable, rows.data(), numRows, grads.data(), neu1e.data(), alpha, vectorLength, expLength);
                         }
 
-                                PRAGMA_OMP_SIMD
+                        PRAGMA_OMP_SIMD
                         for (int e = 0; e < vectorLength; e++)
                             syn0row[e] += neu1e[e];
-
-
-                        // optionally release temp arrays
-                        if (vectorLength > 600)
-                            delete[] neu1e;
                     }
+                }
             }
             BUILD_SINGLE_TEMPLATE(template void skipgramBatchExec_, (NDArray &s0, NDArray &s1, NDArray &s1n, void *vexpTable, void *vnegTable, void *vinfVector, NDArray &targets, NDArray &negStarters, NDArray &indices, NDArray &codes, NDArray &lr, NDArray &nextRandom, const int nsRounds, const int vocabSize, const int vectorLength, const int expLength, const int negLength, const bool preciseMode, const int numThreads), FLOAT_TYPES);
 
@@ -446,13 +550,6 @@ namespace nd4j {
                 const auto negTable = reinterpret_cast<T*>(vnegTable);
                 const auto infVector = reinterpret_cast<T*>(vinfVector);
 
-
-                T sneu1[600];
-                T sneu1e[600];
-
-                //const auto numThreads = omp_get_max_threads();
-                const auto idxShift = indices.isEmpty() ? 0 : indices.sizeAt(1);
-                const auto hsRounds = codes.isEmpty() ? 0 : codes.sizeAt(1);
                 const auto numTargets = context.sizeAt(0);
                 const int contextWidth = context.sizeAt(1);
                 const auto bContext = context.bufferAsT<int>();
@@ -463,116 +560,98 @@ namespace nd4j {
                 const auto bStarters = negStarters.bufferAsT<int>();
                 const auto numIndices = indices.isEmpty() ? 0 : indices.sizeAt(1);
 
-                PRAGMA_OMP_PARALLEL_FOR_ARGS(num_threads(numThreads) private(sneu1, sneu1e))
-                for (int e = 0; e < numTargets; e++){
-                    T* neu1 = vectorLength <= 600 ? sneu1 : new T[vectorLength];
-                    T* neu1e = vectorLength <= 600 ? sneu1e : new T[vectorLength];
+                const int numWorkers = numThreads > 0 ? numThreads : 1;
 
-                    // every threads rolls over own targets
+                PRAGMA_OMP_PARALLEL_FOR_ARGS(num_threads(numWorkers))
+                for (int t = 0; t < numWorkers; t++) {
+                    // every threads rolls over own targets, temp arrays are allocated once per thread
+                    std::vector<T> neu1(vectorLength);
+                    std::vector<T> neu1e(vectorLength);
+                    std::vector<T> grads(nsRounds + 1);
+                    std::vector<int> rows(nsRounds + 1);
 
-                    // optionally we nullify temp arrays after successful (and on first) cycle
-                    memset(neu1, 0, sizeof(T) * vectorLength);
-                    memset(neu1e, 0, sizeof(T) * vectorLength);
+                    for (Nd4jLong e = t; e < numTargets; e += numWorkers) {
+                        std::fill(neu1.begin(), neu1.end(), (T) 0.0f);
+                        std::fill(neu1e.begin(), neu1e.end(), (T) 0.0f);
 
-                    auto alpha = lr.e<double>(e);
-                    auto numLabels = nLabels.isEmpty() ? 0 : nLabels.e<int>(e);
+                        auto alpha = lr.e<double>(e);
+                        auto numLabels = nLabels.isEmpty() ? 0 : nLabels.e<int>(e);
 
-                    int actualContext = 0;
+                        int actualContext = 0;
 
-                    // building neu1 for current window
-                    for (int c = 0; c < contextWidth; c++) {
-                        // getting next context word
-                        auto cContext = bContext[c + (e * contextWidth)];
+                        // building neu1 for current window
+                        for (int c = 0; c < contextWidth; c++) {
+                            // getting next context word
+                            auto cContext = bContext[c + (e * contextWidth)];
 
-                        // skipping padded values
-                        if (cContext < 0)
-                            continue;
-
-                        T *syn0word = syn0 + (cContext * vectorLength);
-
-                        PRAGMA_OMP_SIMD
-                        for (int i = 0; i < vectorLength; i++)
-                            neu1[i] += syn0word[i];
+                            // skipping padded values
+                            if (cContext < 0)
+                                continue;
 
-                        actualContext++;
-                    }
+                            if (c + 1 < contextWidth && bContext[c + 1 + (e * contextWidth)] >= 0)
+                                prefetchRow_<T>(syn0 + (bContext[c + 1 + (e * contextWidth)] * vectorLength), vectorLength);
 
-                    if (infVector != nullptr)
-                        actualContext++;
+                            T *syn0word = syn0 + (cContext * vectorLength);
 
-                    if (actualContext > 1) {
-                        PRAGMA_OMP_SIMD
-                        for (int i = 0; i < vectorLength; i++)
-                            neu1[i] /= actualContext;
-                    }
+                            PRAGMA_OMP_SIMD
+                            for (int i = 0; i < vectorLength; i++)
+                                neu1[i] += syn0word[i];
 
-                    // hierarchic softmax step
-                    if (!indices.isEmpty()) {
-                        for (int i = 0; i < numIndices; i++) {
-                            const int cIndex = bIndices[(e * numIndices) + i];
-                            const int cCode = bCodes[(e * numIndices) + i];
+                            actualContext++;
+                        }
 
-                            // we're skipping padded values
-                            if (cIndex < 0)
-                                continue;
+                        if (infVector != nullptr)
+                            actualContext++;
 
-                            hSoftmax_<T>(neu1, syn1 + (cIndex * vectorLength), expTable, neu1e, alpha, vectorLength, cCode, expLength, false);
+                        if (actualContext > 1) {
+                            PRAGMA_OMP_SIMD
+                            for (int i = 0; i < vectorLength; i++)
+                                neu1[i] /= actualContext;
                         }
-                    }
 
-                    // negative sampling step
-                    if (!negStarters.isEmpty() && nsRounds > 0) {
-                        int irow = bStarters[e];
-                        const int nsStarter = irow;
-                        unsigned long long randomValue = nextRandom.e<Nd4jLong>(e);
-
-                        for (int r = 0; r < nsRounds + 1; r++) {
-                            // we're skipping rng on 0 step
-                            if (r != 0) {
-                                randomValue = randomValue * (unsigned long long) 25214903917 + 11;
-                                auto idx = nd4j::math::nd4j_abs<Nd4jLong>((randomValue >> 16) % negLength);
-                                irow = idx >= negLength ? -1 : static_cast<int>(negTable[idx]);
-
-                                if (irow < 0 || irow >= vocabSize) irow = randomValue % (vocabSize - 1) + 1;
-                                if (irow == nsStarter)
+                        // hierarchic softmax step
+                        if (!indices.isEmpty()) {
+                            for (int i = 0; i < numIndices; i++) {
+                                const int cIndex = bIndices[(e * numIndices) + i];
+                                const int cCode = bCodes[(e * numIndices) + i];
+
+                                // we're skipping padded values
+                                if (cIndex < 0)
                                     continue;
 
-                                nSampling_<T>(neu1, s1n.bufferWithOffset(irow * vectorLength), expTable, neu1e, alpha, vectorLength, r == 0 ? 1 : 0, expLength, infVector != nullptr);
-                            } else {
-                                nSampling_<T>(neu1, s1n.bufferWithOffset(irow * vectorLength), expTable, neu1e, alpha, vectorLength, r == 0 ? 1 : 0, expLength, infVector != nullptr);
-                            }
+                                if (i + 1 < numIndices && bIndices[(e * numIndices) + i + 1] >= 0)
+                                    prefetchRow_<T>(syn1 + (bIndices[(e * numIndices) + i + 1] * vectorLength), vectorLength);
 
-                            //nd4j_printf("Thread <%i>: syn0: [%i]; s1n: [%i];\n", omp_get_thread_num(), 0, irow);
+                                hSoftmax_<T>(neu1.data(), syn1 + (cIndex * vectorLength), expTable, neu1e.data(), alpha, vectorLength, cCode, expLength, false);
+                            }
                         }
-                    }
-
-                    // if we're skipping labels
-                    int starter = trainWords == 1 ? 0 : contextWidth - numLabels;
-
-                    // applying previously averaged results
-                    for (int c = starter; c < contextWidth; c++) {
-                        // getting context
-                        auto cContext = bContext[c + (e * contextWidth)];
-                        auto cLock = bLocker[c + (e * contextWidth)];
 
-                        // skipping padded values
-                        if (cContext < 0 || cLock == 1)
-                            continue;
+                        // negative sampling step
+                        if (!negStarters.isEmpty() && nsRounds > 0) {
+                            auto numRows = drawNegatives_<T>(bStarters[e], nextRandom.e<Nd4jLong>(e), negTable, nsRounds, vocabSize, negLength, rows.data());
+                            negativeBlock_<T>(neu1.data(), syn1Neg, expTable, rows.data(), numRows, grads.data(), neu1e.data(), alpha, vectorLength, expLength);
+                        }
 
-                        // one word from context
-                        T *syn0word = syn0 + (cContext * vectorLength);
+                        // if we're skipping labels
+                        int starter = trainWords == 1 ? 0 : contextWidth - numLabels;
 
+                        // applying previously averaged results
+                        for (int c = starter; c < contextWidth; c++) {
+                            // getting context
+                            auto cContext = bContext[c + (e * contextWidth)];
+                            auto cLock = bLocker[c + (e * contextWidth)];
 
-                        PRAGMA_OMP_SIMD
-                        for (int i = 0; i < vectorLength; i++)
-                            syn0word[i] += neu1e[i];
-                    }
+                            // skipping padded values
+                            if (cContext < 0 || cLock == 1)
+                                continue;
 
+                            // one word from context
+                            T *syn0word = syn0 + (cContext * vectorLength);
 
-                    // optionally release temp arrays
-                    if (vectorLength > 600) {
-                        delete[] neu1;
-                        delete[] neu1e;
+                            PRAGMA_OMP_SIMD
+                            for (int i = 0; i < vectorLength; i++)
+                                syn0word[i] += neu1e[i];
+                        }
                     }
                 }
             }
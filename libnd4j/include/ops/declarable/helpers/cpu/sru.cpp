@@ -21,7 +21,9 @@
 //
 
 #include<ops/declarable/helpers/sru.h>
+#include<ops/declarable/helpers/rnn.h>
 #include <NDArrayFactory.h>
+#include <MmulHelper.h>
 
 namespace nd4j    {
 namespace ops     {
@@ -43,6 +45,78 @@ static FORCEINLINE NDArray sigmoid(const NDArray& arr) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+// single pass over gates: z [bS x 3*inSize] = x*w, all other arrays are [bS x inSize], b is [2*inSize]
+template <typename T>
+static void fusedSruCell(const NDArray* z, const NDArray* b, const NDArray* x, const NDArray* c0, NDArray* h, NDArray* c) {
+
+    const Nd4jLong bS     = x->sizeAt(0);
+    const Nd4jLong inSize = x->sizeAt(1);
+
+    auto z_  = z->bufferAsT<T>();
+    auto b_  = b->bufferAsT<T>();
+    auto x_  = x->bufferAsT<T>();
+    auto c0_ = c0->bufferAsT<T>();
+    auto h_  = h->bufferAsT<T>();
+    auto c_  = c->bufferAsT<T>();
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(bS * inSize > Environment::getInstance()->elementwiseThreshold())
+    for (Nd4jLong r = 0; r < bS; r++) {
+        auto zr = z_ + r * 3 * inSize;
+
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong j = 0; j < inSize; j++) {
+            const auto e = r * inSize + j;
+            const T one = static_cast<T>(1.f);
+
+            // forget gate = sigmoid(x*Wf + bf), reset gate = sigmoid(x*Wr + br)
+            const T f = nd4j::math::nd4j_sigmoid<T,T>(zr[inSize + j] + b_[j]);
+            const T g = nd4j::math::nd4j_sigmoid<T,T>(zr[2 * inSize + j] + b_[inSize + j]);
+
+            const T cv = f * c0_[e] + (one - f) * zr[j];
+            c_[e] = cv;
+            h_[e] = g * nd4j::math::nd4j_tanh<T,T>(cv) + (one - g) * x_[e];
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// z is optional scratch buffer [bS x 3*inSize], c order
+static void sruCellStep(const NDArray* x, const NDArray* c0, const NDArray* w, const NDArray* b, NDArray* h, NDArray* c, NDArray* z) {
+
+    const int inSize = x->sizeAt(1);           // inSize - number of features
+    const auto dataType = c->dataType();
+
+    bool fusable = isFusable(x, dataType) && isFusable(c0, dataType) && isFusable(h, dataType) && isFusable(c, dataType) && b->ews() == 1 && b->dataType() == dataType;
+    if (!fusable) {
+        auto zx = mmul(*x, *w);               //  [bS x 3*inSize]
+
+        // forget gate = sigmoid(x*Wf + bf)
+        auto f = sigmoid(zx({0,0, inSize,   2*inSize}) + (*b)({0, inSize}));
+
+        // reset gate = sigmoid(x*Wr + br)
+        auto r = sigmoid(zx({0,0, 2*inSize, 3*inSize}) + (*b)({inSize, 2*inSize}));
+
+        // ◦ means element-wise product or so called Hadamard product
+        // current sell state = f◦c0 + (1 - f)◦(x*Wc)
+        c->assign( f*(*c0) + (1.f - f) * zx({0,0 ,0, inSize}) );
+        // *c = f*(*c0 - z({},{0, inSize})) + z({{},{0, inSize}});
+
+        // current cell output = r◦activation(c) + (1 - r)◦x
+        h->assign( r*activation(*c) + (1.f - r) * (*x) );
+        // *h = r * (activation<T>(c) - *x) + *x;
+        return;
+    }
+
+    NDArray* zt = z != nullptr ? z : new NDArray('c', {x->sizeAt(0), 3 * inSize}, dataType, x->getWorkspace());
+    MmulHelper::mmul(x, w, zt, 1.0, 0.0);        //  [bS x 3*inSize]
+
+    BUILD_SINGLE_SELECTOR(dataType, fusedSruCell, (zt, b, x, c0, h, c), FLOAT_TYPES);
+
+    if (zt != z)
+        delete zt;
+}
+
 //////////////////////////////////////////////////////////////////////////
 void sruCell(const NDArray* x, const NDArray* c0, const NDArray* w, const NDArray* b, NDArray* h, NDArray* c) {
 
@@ -54,24 +128,7 @@ void sruCell(const NDArray* x, const NDArray* c0, const NDArray* w, const NDArra
     // h   current cell output [bS x inSize], that is at current time step t
     // c   current cell state  [bS x inSize], that is at current time step t
 
-    const int inSize = x->sizeAt(1);           // inSize - number of features
-            
-    auto z = mmul(*x, *w);               //  [bS x 3*inSize]
-
-    // forget gate = sigmoid(x*Wf + bf)
-    auto f = sigmoid(z({0,0, inSize,   2*inSize}) + (*b)({0, inSize}));
-    
-    // reset gate = sigmoid(x*Wr + br)
-    auto r = sigmoid(z({0,0, 2*inSize, 3*inSize}) + (*b)({inSize, 2*inSize}));
-
-    // ◦ means element-wise product or so called Hadamard product
-    // current sell state = f◦c0 + (1 - f)◦(x*Wc)
-    c->assign( f*(*c0) + (1.f - f) * z({0,0 ,0, inSize}) );
-    // *c = f*(*c0 - z({},{0, inSize})) + z({{},{0, inSize}});
-
-    // current cell output = r◦activation(c) + (1 - r)◦x
-    h->assign( r*activation(*c) + (1.f - r) * (*x) );
-    // *h = r * (activation<T>(c) - *x) + *x;        
+    sruCellStep(x, c0, w, b, h, c, nullptr);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -159,9 +216,17 @@ void sruTimeLoop(const NDArray* x, const NDArray* c0, const NDArray* w, const ND
 
     w = w->transpose();                             // [3*inSize x inSize] -> [inSize x 3*inSize] 
 
-    const int time  = x->sizeAt(2);
+    const int time   = x->sizeAt(2);
+    const int bS     = x->sizeAt(0);
+    const int inSize = x->sizeAt(1);
 
-    NDArray ct_1(*c0);
+    // time is the last dimension, so per-step sub-arrays are strided: steps are computed in contiguous scratch buffers, allocated once per sequence
+    NDArray ct_1('c', {bS, inSize}, c0->dataType(), c0->getWorkspace());
+    NDArray xBuf('c', {bS, inSize}, x->dataType(), x->getWorkspace());
+    NDArray hBuf('c', {bS, inSize}, h->dataType(), h->getWorkspace());
+    NDArray cBuf('c', {bS, inSize}, c->dataType(), c->getWorkspace());
+    NDArray z('c', {bS, 3 * inSize}, c->dataType(), c->getWorkspace());
+    ct_1.assign(c0);
 
     // loop through time steps
     for (int t = 0; t < time; ++t) {
@@ -170,8 +235,12 @@ void sruTimeLoop(const NDArray* x, const NDArray* c0, const NDArray* w, const ND
         auto ht = (*h)({0,0, 0,0, t,t+1});
         auto ct = (*c)({0,0, 0,0, t,t+1});
 
-        helpers::sruCell(&xt, &ct_1, w, b,  &ht, &ct);
-        ct_1.assign(ct);
+        xBuf.assign(xt);
+        sruCellStep(&xBuf, &ct_1, w, b, &hBuf, &cBuf, &z);
+
+        ht.assign(hBuf);
+        ct.assign(cBuf);
+        ct_1.assign(cBuf);
     }    
 
     delete w;
@@ -21,120 +21,137 @@
 #include <ops/declarable/helpers/top_k.h>
 #include <ops/declarable/headers/parity_ops.h>
 #include <NDArrayFactory.h>
+#include <helpers/ConstantTadHelper.h>
+#include <algorithm>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    // candidates are ordered by value descending, equal values - by index ascending
     template <typename T>
-    static int topKFunctor_(NDArray* input, NDArray* values, NDArray* indeces, int k, bool needSort) {
-        Nd4jLong width = input->sizeAt(-1);
-//        Nd4jLong lastDim = input->rankOf() - 1;
-//      FIX ME: lastDim should be Nd4Long not int only?
-        int lastDim = input->rankOf() - 1;
-//        std::unique_ptr<ResultSet> lastDimList(input->allTensorsAlongDimension({lastDim}));
-// ----------------------------------------------------------------------------------------------- //
-// this assumption is right:
-//        if (values->lengthOf() != k * lastDimList->size()) {
-//            nd4j_printf("top_k: something is wrong. %i expected, but %i given.\n",
-//                values->lengthOf(), k * lastDimList->size());
-//        }
-// ----------------------------------------------------------------------------------------------- //
-        std::vector<int> dimsToExclude(input->rankOf() - 1);
-        for (int d = 0; d < dimsToExclude.size(); ++d)
-            dimsToExclude[d] = d;
-
-        const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(input->getShapeInfo(), dimsToExclude);
-
-            if (k == 1) {
-                for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
-                    //int maxPos = //lastDimList->at(e)->argMax();
-                    Nd4jLong maxPos = 0;
-                    //trial.printIndexedBuffer("TRIAL:");
-                    T maxVal = trial.e<T>(0);
-                    for (Nd4jLong pos = 1; pos < trial.lengthOf(); pos++)
-                        if (maxVal < trial.e<T>(pos)) {
-                            maxPos = pos;
-                            maxVal = trial.e<T>(pos);
-                        }
-                    if (indeces)
-                        indeces->p(e, maxPos); //topIndex;
-                    if (values)
-                        values->p(e, maxVal);
+    static FORCEINLINE bool isBetter(const std::pair<T, Nd4jLong>& a, const std::pair<T, Nd4jLong>& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    }
+
+    // scans elements [from, to) of the row, and keeps best k of them in the heap. Worst candidate is at heap front
+    template <typename T>
+    static void topKScan(const T* row, const Nd4jLong stride, Nd4jLong from, const Nd4jLong to, const int k, std::vector<std::pair<T, Nd4jLong>>& heap) {
+        // elements are checked against the worst candidate in blocks, and only blocks having better elements are inspected one by one
+        const Nd4jLong blockSize = 64;
+
+        for (; from < to && heap.size() < (size_t) k; from++)
+            heap.emplace_back(row[from * stride], from);
+        std::make_heap(heap.begin(), heap.end(), isBetter<T>);
+
+        for (Nd4jLong b = from; b < to; b += blockSize) {
+            const Nd4jLong end = nd4j::math::nd4j_min<Nd4jLong>(b + blockSize, to);
+            const T threshold = heap.front().first;
+
+            int found = 0;
+            PRAGMA_OMP_SIMD_ARGS(reduction(|:found))
+            for (Nd4jLong i = b; i < end; i++)
+                found |= row[i * stride] > threshold;
+
+            if (!found)
+                continue;
+
+            for (Nd4jLong i = b; i < end; i++) {
+                if (row[i * stride] > heap.front().first) {
+                    std::pop_heap(heap.begin(), heap.end(), isBetter<T>);
+                    heap.back() = std::make_pair(row[i * stride], i);
+                    std::push_heap(heap.begin(), heap.end(), isBetter<T>);
                 }
             }
-            else { 
-                int nextPos = 0;
-
-                for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
-
-                    // fill up the first k elements
-                    NDArray topValues = NDArrayFactory::create<T>('c', {k});
-                    NDArray sortedVals = NDArrayFactory::create<T>('c', {k});
-                    NDArray topIndices = NDArrayFactory::create<Nd4jLong>('c', {k});
-                    for (Nd4jLong pos = 0; pos < k; ++pos) {
-                        topIndices.t<Nd4jLong>(pos) = pos;
-                        topValues.t<T>(pos) = trial.t<T>(pos);
-                    }
-                    //std::vector<T> sortedVals(topValues);
-                    sortedVals.assign(topValues);// = NDArrayFactory::create<T>('c', {k});
-                    //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                    SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
-                    for (int i = k; i < width; ++i) {
-                        T val = trial.e<T>(i);
-                        T minTopVal = sortedVals.t<T>(0);
-                        if (minTopVal < val) { // value should be inserted to top k
-                            // only if it is not contained in
-                            T* begin = reinterpret_cast<T*>(sortedVals.buffer());
-                            T* end = begin + k;
-                            bool exists = std::binary_search(begin, end, val);
-                            if (!exists) {
-                                //exchangePos - a distance between begin and minimal existed to be suppressed by val
-                                T* topBegin = reinterpret_cast<T*>(topValues.buffer());
-                                T* topEnd = topBegin + k;
-                                auto exchangePos = std::distance(topBegin, std::find(topBegin, topEnd, sortedVals.t<T>(0)));
-                                topValues.t<T>(exchangePos) = val; //*exchangeIt = val;
-                                topIndices.t<Nd4jLong>(exchangePos) = i;
-                                sortedVals.t<T>(0) = val; // suppress in sorted
-                                //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                                SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
-                            }
-                        }
-                    }
-                    if (needSort) {
-                        SpecialMethods<T>::sortGeneric(topValues.buffer(), topValues.shapeInfo(), true);
+        }
+    }
 
-                        for (int j = 0; j < width; j++)
-                            for (int pos = 0; pos < k; ++pos)
-                                if (topValues.t<T>(pos) == trial.t<T>(j))
-                                    topIndices.t<Nd4jLong>(pos) = j;
-                    }
-                    else { // else sort by indices
-                        std::map<Nd4jLong, T> sortValsMap;
-                        //std::vector<std::pair<int, T>> data(topValues.lengthOf());
-                        for (size_t e = 0; e < topValues.lengthOf(); ++e) {
-                            sortValsMap[topIndices.t<Nd4jLong>(e)] = topValues.t<T>(e);
-                        }
+    template <typename T>
+    static int topKFunctor_(NDArray* input, NDArray* values, NDArray* indeces, int k, bool needSort) {
+        const int lastDim = input->rankOf() - 1;
+        const Nd4jLong width = input->sizeAt(-1);
+
+        auto inPack = ConstantTadHelper::getInstance()->tadForDimensions(input->getShapeInfo(), {lastDim});
+        const Nd4jLong numOfSubArrs = inPack.numberOfTads();
+        const Nd4jLong inStride = width > 1 ? shape::stride(inPack.primaryShapeInfo())[0] : 1;
+
+        TadPack vPack, iPack;
+        Nd4jLong vStride = 1, iStride = 1;
+        if (values) {
+            vPack = ConstantTadHelper::getInstance()->tadForDimensions(values->getShapeInfo(), {lastDim});
+            vStride = k > 1 ? shape::stride(vPack.primaryShapeInfo())[0] : 1;
+        }
 
-                        //std::sort(data.begin(), data.end(), [](std::pair<int, T> const& a, std::pair<int, T> const& b) {
-                        //    return a.first < b.first;
-                        //});
-                        Nd4jLong e = 0;
-                        for (auto it = sortValsMap.begin(); it != sortValsMap.end(); ++it, e++) {
-                            topIndices.t<Nd4jLong>(e) = it->first;
-                            topValues.t<T>(e) = it->second;
-                        }
+        // indices are INT64 by default, other types are written element-wise
+        const bool rawIndices = indeces != nullptr && indeces->dataType() == nd4j::DataType::INT64;
+        if (rawIndices) {
+            iPack = ConstantTadHelper::getInstance()->tadForDimensions(indeces->getShapeInfo(), {lastDim});
+            iStride = k > 1 ? shape::stride(iPack.primaryShapeInfo())[0] : 1;
+        }
+
+        auto x = input->bufferAsT<T>();
+
+        // rows are split between threads when there's not enough rows to keep all threads busy
+        int numChunks = 1;
+        if (numOfSubArrs < omp_get_max_threads() && width > Environment::getInstance()->elementwiseThreshold())
+            numChunks = nd4j::math::nd4j_max<int>(1, nd4j::math::nd4j_min<Nd4jLong>(omp_get_max_threads() / numOfSubArrs, width / (4 * k)));
+
+        // only one level is parallel: rows, or chunks within each row when rows are processed serially
+        PRAGMA_OMP_PARALLEL_FOR_IF(numChunks == 1 && numOfSubArrs > 1 && numOfSubArrs * width > Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
+            auto row = x + inPack.primaryOffsets()[e];
+
+            std::vector<std::pair<T, Nd4jLong>> heap;
+            heap.reserve(k);
+
+            if (numChunks > 1) {
+                std::vector<std::vector<std::pair<T, Nd4jLong>>> partial(numChunks);
+                const Nd4jLong chunk = width / numChunks + 1;
+
+                PRAGMA_OMP_PARALLEL_FOR
+                for (int c = 0; c < numChunks; c++)
+                    topKScan<T>(row, inStride, c * chunk, nd4j::math::nd4j_min<Nd4jLong>((c + 1) * chunk, width), k, partial[c]);
 
+                // merging partial results, they are few
+                for (auto &p: partial) {
+                    for (auto &candidate: p) {
+                        if (heap.size() < (size_t) k) {
+                            heap.emplace_back(candidate);
+                            std::push_heap(heap.begin(), heap.end(), isBetter<T>);
+                        }
+                        else if (isBetter<T>(candidate, heap.front())) {
+                            std::pop_heap(heap.begin(), heap.end(), isBetter<T>);
+                            heap.back() = candidate;
+                            std::push_heap(heap.begin(), heap.end(), isBetter<T>);
+                        }
                     }
-                    if (values)
-                    (*values)(e, dimsToExclude).assign(topValues);
-                    if (indeces)
-                    (*indeces)(e, dimsToExclude).assign(topIndices);
                 }
-                //indeces->printIndexedBuffer("Indices as is");
+            }
+            else
+                topKScan<T>(row, inStride, 0, width, k, heap);
+
+            if (needSort)
+                std::sort_heap(heap.begin(), heap.end(), isBetter<T>);
+            else // else sort by indices
+                std::sort(heap.begin(), heap.end(), [](const std::pair<T, Nd4jLong>& a, const std::pair<T, Nd4jLong>& b) { return a.second < b.second; });
+
+            if (values) {
+                auto v = values->bufferAsT<T>() + vPack.primaryOffsets()[e];
+                for (int j = 0; j < k; j++)
+                    v[j * vStride] = heap[j].first;
+            }
+
+            if (rawIndices) {
+                auto i = indeces->bufferAsT<Nd4jLong>() + iPack.primaryOffsets()[e];
+                for (int j = 0; j < k; j++)
+                    i[j * iStride] = heap[j].second;
+            }
+            else if (indeces) {
+                for (int j = 0; j < k; j++)
+                    indeces->p(e * k + j, heap[j].second);
+            }
         }
+
         return Status::OK();
     }
 // ----------------------------------------------------------------------------------------------- //
@@ -20,25 +20,40 @@
 
 #include <ops/declarable/helpers/unique.h>
 #include <Status.h>
+#include <helpers/UniqueTable.h>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    // elements are taken in logical order, so only c ordered inputs can be read directly
     template <typename T>
-    static Nd4jLong uniqueCount_(NDArray* input) {
-        Nd4jLong count = 0;
+    static void buildTable(NDArray* input, UniqueTable<T>& table, std::vector<Nd4jLong>* ids = nullptr) {
+        NDArray* source = input;
+        if (input->ordering() != 'c' || input->ews() < 1)
+            source = input->dup('c');
+
+        const Nd4jLong length = source->lengthOf();
+        const Nd4jLong stride = source->ews();
+        auto buffer = source->bufferAsT<T>();
 
-        std::vector<T> values;
+        table.build(buffer, length, stride);
 
-        for (int e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(values.begin(), values.end(), v) == values.end()) {
-                values.push_back(v);
-                count++;
-            }
+        if (ids != nullptr) {
+            ids->resize(length);
+            table.lookup(buffer, length, stride, ids->data());
         }
-        return count;
+
+        if (source != input)
+            delete source;
+    }
+
+    template <typename T>
+    static Nd4jLong uniqueCount_(NDArray* input) {
+        UniqueTable<T> table;
+        buildTable<T>(input, table);
+
+        return table.size();
     }
 
     Nd4jLong uniqueCount(NDArray* input) {
@@ -50,34 +65,26 @@ namespace helpers {
 
     template <typename T>
     static Nd4jStatus uniqueFunctor_(NDArray* input, NDArray* values, NDArray* indices, NDArray* counts) {
-    
-        std::vector<T> valuesVector;
-        std::map<T, int> indicesMap;
-        std::map<T, int> countsMap;
-
-        for (int e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(valuesVector.begin(), valuesVector.end(), v) == valuesVector.end()) {
-                valuesVector.push_back(v);
-                indicesMap[v] = e;
-                countsMap[v] = 1;
-            }
-            else {
-                countsMap[v]++;
-            }
-        }
+        UniqueTable<T> table(input->lengthOf() / 16);
+        std::vector<Nd4jLong> ids;
+        buildTable<T>(input, table, &ids);
+
+        auto &uniqueValues = table.values();
+        auto &uniqueCounts = table.counts();
 
         PRAGMA_OMP_PARALLEL_FOR_IF(values->lengthOf() > Environment::getInstance()->elementwiseThreshold())
-        for (int e = 0; e < values->lengthOf(); e++) {
-            values->p(e, static_cast<T>(valuesVector[e]));
-            if (counts != nullptr) 
-                counts->p(e, countsMap[valuesVector[e]]);
+        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
+            values->p(e, static_cast<T>(uniqueValues[e]));
+            if (counts != nullptr)
+                counts->p(e, uniqueCounts[e]);
         }
 
-        for (int e = 0; e < indices->lengthOf(); e++) {
-            auto posI = std::find(valuesVector.begin(), valuesVector.end(), input->e<T>(e));
-            auto dist = std::distance(valuesVector.begin(), posI);
-            indices->p(e, Nd4jLong(dist));//indicesMap[(*input)(e)];
+        if (indices->dataType() == nd4j::DataType::INT64 && indices->ews() == 1)
+            memcpy(indices->buffer(), ids.data(), ids.size() * sizeof(Nd4jLong));
+        else {
+            PRAGMA_OMP_PARALLEL_FOR_IF(indices->lengthOf() > Environment::getInstance()->elementwiseThreshold())
+            for (Nd4jLong e = 0; e < indices->lengthOf(); e++)
+                indices->p(e, ids[e]);
         }
 
         return Status::OK();
@@ -28,6 +28,19 @@ namespace helpers {
 
     void nonMaxSuppressionV2(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output);
 
+    /**
+     * Greedy non-max suppression over single set of boxes
+     *
+     * @param boxes - [N, 4] boxes as (y1, x1, y2, x2)
+     * @param scales - [N] scores
+     * @param maxSize - max number of boxes selected
+     * @param threshold - boxes with IoU above this threshold are suppressed
+     * @param scoreThreshold - boxes with scores not above this threshold are ignored
+     * @param sigma - soft-NMS parameter: scores of overlapping boxes are decayed by exp(-IoU^2 / (2 * sigma)). 0 means hard NMS
+     * @param output - indices of selected boxes
+     */
+    void nonMaxSuppression(NDArray* boxes, NDArray* scales, int maxSize, double threshold, double scoreThreshold, double sigma, NDArray* output);
+
 }
 }
 }
@@ -30,8 +30,16 @@ namespace helpers {
 
 	void rnnCell(const NDArray* xt, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* ht_1, NDArray* ht);
 
+	// projects inputs of all time steps at once: x [time x bS x inSize] * Wx [inSize x N] -> xProj [time*bS x N], c order
+	void rnnProjectInputs(const NDArray* x, const NDArray* Wx, NDArray* xProj);
+
 	void rnnTimeLoop(const NDArray* x, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* h0, const NDArray* maxTimeStep, NDArray* h, NDArray* hFinal);
 
+	// true if arr can be processed by fused rnn cell kernels: c order, contiguous and of given data type
+	FORCEINLINE bool isFusable(const NDArray* arr, const nd4j::DataType dataType) {
+		return arr->ordering() == 'c' && arr->ews() == 1 && arr->dataType() == dataType;
+	}
+
 }
 }
 }
@@ -25,6 +25,7 @@
 #include <NDArrayFactory.h>
 #include <graph/exceptions/graph_exception.h>
 #include <graph/exceptions/unresolved_input_exception.h>
+#include <graph/MemoryArena.h>
 
 namespace nd4j {
     namespace ops {
@@ -77,6 +78,10 @@ namespace nd4j {
             return _descriptor;
         }
 
+        ShapeCache* DeclarableOp::getShapeCache() {
+            return &_shapeCache;
+        }
+
         std::string *DeclarableOp::getOpName() {
             return _descriptor->getOpName();
         }
@@ -146,6 +151,7 @@ namespace nd4j {
                 // if op is not inplace - we should pre-allocate arrays
 
                 ShapeList inSha;
+                std::vector<NDArray*> inArrs;
                 int results = 0;
 
                 if (Environment::getInstance()->isProfiling() && node != nullptr)
@@ -156,6 +162,7 @@ namespace nd4j {
                 if (ctx.isFastPath()) {
                     for (const auto p:ctx.fastpath_in()) {
                         inSha.push_back(p->getShapeInfo());
+                        inArrs.emplace_back(p);
                     }
                 } else {
                     for (auto p: *ctx.inputs()) {
@@ -166,7 +173,10 @@ namespace nd4j {
                                 throw unresolved_input_exception::build("Variable wasn't resolved prior shape calculation", p);
 
                             inSha.push_back(array->getShapeInfo());
-                        }
+                            inArrs.emplace_back(array);
+                        } else
+                            inArrs.emplace_back(nullptr);
+
                         cntIn++;
                     }
                 }
@@ -180,8 +190,34 @@ namespace nd4j {
                     shapeStart = std::chrono::system_clock::now();
                 }
 
-                auto outSha = this->calculateOutputShape(&inSha, ctx);
-                results = outSha->size();
+                // shape function is skipped if this op was already executed with the same inputs and arguments. key buffer is reused between executions
+                static thread_local std::vector<Nd4jLong> key;
+                bool cacheable = _descriptor->isCacheableShape() && Environment::getInstance()->isUseShapeCache() && ShapeCache::buildKey(ctx, inArrs, key);
+                ShapeCache::Entry* cached = cacheable ? _shapeCache.get(key) : nullptr;
+
+                ShapeList *outSha = nullptr;
+                if (cached == nullptr) {
+                    // shape function might execute other ops, so key is taken out of shared buffer
+                    std::vector<Nd4jLong> missKey;
+                    if (cacheable)
+                        missKey.swap(key);
+
+                    outSha = this->calculateOutputShape(&inSha, ctx);
+
+                    if (cacheable) {
+                        cached = _shapeCache.put(missKey, outSha);
+                        key.swap(missKey);
+                    }
+                }
+
+                std::vector<Nd4jLong*> outShapes;
+                if (outSha != nullptr)
+                    outShapes = *outSha->asVector();
+                else
+                    for (auto &v: *cached)
+                        outShapes.emplace_back(v.data());
+
+                results = outShapes.size();
 
                 // optionally saving shapeTime
                 if (Environment::getInstance()->isProfiling() && node != nullptr) {
@@ -192,8 +228,13 @@ namespace nd4j {
                     arrayStart = std::chrono::system_clock::now();
                 }
 
+                // if graph run has memory arena attached - outputs are placed according to the memory plan
+                MemoryArena* arena = nullptr;
+                if (!ctx.isFastPath() && ctx.getVariableSpace() != nullptr && ctx.getVariableSpace()->flowPath() != nullptr)
+                    arena = ctx.getVariableSpace()->flowPath()->memoryArena();
+
                 int cnt = 0;
-                for (auto out: *outSha->asVector()) {
+                for (auto out: outShapes) {
                     if (!ctx.isFastPath()) {
                         // we need to check, if Z is really needed
                         std::pair<int, int> pair(ctx.nodeId(), cnt++);
@@ -202,7 +243,7 @@ namespace nd4j {
                             if (Environment::getInstance()->isDebugAndVerbose())
                                 shape::printShapeInfoLinear("Going to create variable with shape", out);
 
-                            auto outArr = new NDArray(out, true, workspace);
+                            auto outArr = arena != nullptr ? arena->allocate(pair.first, pair.second, out, workspace) : new NDArray(out, true, workspace);
 
                             ctx.pushNDArrayToVariableSpace(pair, outArr);
                         } else {
@@ -214,8 +255,10 @@ namespace nd4j {
                                 auto eShape = ShapeUtils::shapeAsString(out);
                                 auto aShape = ShapeUtils::shapeAsString(shape);
 
-                                outSha->destroy();
-                                delete outSha;
+                                if (outSha != nullptr) {
+                                    outSha->destroy();
+                                    delete outSha;
+                                }
 
                                 nd4j_printf("Expected vs provided shapes mismatch: %s vs %s\n", eShape.c_str(), aShape.c_str());
                                 throw std::runtime_error("Expected vs provided shapes mismatch");
@@ -234,8 +277,10 @@ namespace nd4j {
                                 auto eShape = ShapeUtils::shapeAsString(out);
                                 auto aShape = ShapeUtils::shapeAsString(array->shapeInfo());
 
-                                outSha->destroy();
-                                delete outSha;
+                                if (outSha != nullptr) {
+                                    outSha->destroy();
+                                    delete outSha;
+                                }
 
                                 nd4j_printf("Expected vs provided shapes mismatch: %s vs %s\n", eShape.c_str(), aShape.c_str());
                                 throw std::runtime_error("Expected vs provided shapes mismatch");
@@ -244,8 +289,10 @@ namespace nd4j {
                     }
                 }
 
-                outSha->destroy();
-                delete outSha;
+                if (outSha != nullptr) {
+                    outSha->destroy();
+                    delete outSha;
+                }
 
                 // saving arrayTime
                 if (Environment::getInstance()->isProfiling() && node != nullptr) {
@@ -270,6 +270,15 @@ namespace nd4j {
             return _sameMode;
         }
 
+        OpDescriptor* OpDescriptor::setCacheableShape(bool reallyCacheable) {
+            _cacheableShape = reallyCacheable;
+            return this;
+        }
+
+        bool OpDescriptor::isCacheableShape() {
+            return _cacheableShape;
+        }
+
         bool OpDescriptor::isInherit(int index) {
             if (std::find(_allowedOuts.begin(), _allowedOuts.end(), nd4j::DataType::INHERIT) != _allowedOuts.end())
                 return true;
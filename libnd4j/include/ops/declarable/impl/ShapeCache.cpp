@@ -0,0 +1,255 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// @author raver119@gmail.com
+//
+
+#include <ops/declarable/ShapeCache.h>
+#include <helpers/shape.h>
+#include <cstring>
+#include <algorithm>
+
+namespace nd4j {
+    namespace ops {
+        static FORCEINLINE Nd4jLong asKeyValue(double value) {
+            Nd4jLong result = 0;
+            memcpy(&result, &value, sizeof(double));
+            return result;
+        }
+
+        bool ShapeCache::buildKey(nd4j::graph::Context &ctx, const std::vector<NDArray*> &inputs, std::vector<Nd4jLong> &key) {
+            key.clear();
+            key.emplace_back(ctx.opNum());
+            key.emplace_back((Nd4jLong) ctx.dataType());
+            key.emplace_back((Nd4jLong) inputs.size());
+
+            for (auto array: inputs) {
+                if (array == nullptr || array->isS())
+                    return false;
+
+                auto shapeInfo = array->shapeInfo();
+                key.insert(key.end(), shapeInfo, shapeInfo + shape::shapeInfoLength(shapeInfo));
+
+                // scalars and short integer arrays are arguments more often than data: axis, shape, begin/end etc
+                auto length = array->lengthOf();
+                bool content = !array->isEmpty() && (length == 1 || (!array->isR() && length <= MAX_CONTENT_LENGTH));
+                key.emplace_back(content ? length : -1);
+
+                if (!content)
+                    continue;
+
+                for (Nd4jLong e = 0; e < length; e++)
+                    key.emplace_back(array->isR() ? asKeyValue(array->e<double>(e)) : array->e<Nd4jLong>(e));
+            }
+
+            auto iArgs = ctx.getIArguments();
+            key.emplace_back((Nd4jLong) iArgs->size());
+            for (auto v: *iArgs)
+                key.emplace_back(v);
+
+            auto tArgs = ctx.getTArguments();
+            key.emplace_back((Nd4jLong) tArgs->size());
+            for (auto v: *tArgs)
+                key.emplace_back(asKeyValue(v));
+
+            auto bArgs = ctx.getBArguments();
+            key.emplace_back((Nd4jLong) bArgs->size());
+            for (auto v: *bArgs)
+                key.emplace_back(v ? 1L : 0L);
+
+            auto axis = ctx.getAxis();
+            key.emplace_back((Nd4jLong) axis->size());
+            for (auto v: *axis)
+                key.emplace_back(v);
+
+            return true;
+        }
+
+        // recently used entries of this thread, shared by all caches. slot is valid only if its generation matches the cache
+        class FrontSlot {
+        public:
+            Nd4jLong generation = -1;
+            std::vector<Nd4jLong> key;
+            std::shared_ptr<ShapeCache::Entry> entry;
+        };
+
+        static thread_local FrontSlot frontCache[ShapeCache::FRONT_SIZE];
+
+        static FORCEINLINE FrontSlot& frontSlot(size_t hash, Nd4jLong generation) {
+            // different ops with the same key shouldn't compete for the same slot
+            return frontCache[(hash ^ (static_cast<uint64_t>(generation) * 0x9E3779B97F4A7C15ULL)) % ShapeCache::FRONT_SIZE];
+        }
+
+        size_t ShapeCache::KeyHash::operator()(const std::vector<Nd4jLong> &key) const {
+            uint64_t hash = 14695981039346656037ULL;
+            for (auto v: key) {
+                hash ^= static_cast<uint64_t>(v);
+                hash *= 1099511628211ULL;
+            }
+
+            return static_cast<size_t>(hash ^ (hash >> 32));
+        }
+
+        ShapeCache::ShapeCache() {
+            _generation = nextGeneration();
+        }
+
+        Nd4jLong ShapeCache::nextGeneration() {
+            static std::atomic<Nd4jLong> generations{0};
+            return generations.fetch_add(1);
+        }
+
+        int ShapeCache::counterIndex() {
+            static std::atomic<int> threads{0};
+            static thread_local int index = threads.fetch_add(1) % NUM_SHARDS;
+            return index;
+        }
+
+        ShapeCache::Shard& ShapeCache::shardFor(size_t hash) {
+            return _shards[(hash >> 8) % NUM_SHARDS];
+        }
+
+        void ShapeCache::evict(Shard &shard, int shardCapacity) {
+            while (!shard.order.empty() && (int) shard.entries.size() > shardCapacity) {
+                shard.entries.erase(shard.order.front());
+                shard.order.pop_front();
+            }
+        }
+
+        ShapeCache::Entry* ShapeCache::get(const std::vector<Nd4jLong> &key) {
+            if (_capacity.load(std::memory_order_relaxed) <= 0)
+                return nullptr;
+
+            auto hash = KeyHash()(key);
+            auto generation = _generation.load(std::memory_order_acquire);
+            auto &slot = frontSlot(hash, generation);
+            auto counter = counterIndex();
+
+            // fast path: this thread has used this entry recently
+            if (slot.generation == generation && slot.key == key) {
+                _hits[counter].value.fetch_add(1, std::memory_order_relaxed);
+                return slot.entry.get();
+            }
+
+            std::shared_ptr<Entry> entry;
+            {
+                auto &shard = shardFor(hash);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+
+                auto it = shard.entries.find(key);
+                if (it != shard.entries.end())
+                    entry = it->second;
+            }
+
+            if (entry == nullptr) {
+                _misses[counter].value.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            _hits[counter].value.fetch_add(1, std::memory_order_relaxed);
+
+            slot.generation = generation;
+            slot.key = key;
+            slot.entry = std::move(entry);
+
+            return slot.entry.get();
+        }
+
+        ShapeCache::Entry* ShapeCache::put(const std::vector<Nd4jLong> &key, ShapeList *shapes) {
+            auto entry = std::make_shared<Entry>();
+            for (auto s: *shapes->asVector())
+                entry->emplace_back(s, s + shape::shapeInfoLength(s));
+
+            auto hash = KeyHash()(key);
+            auto generation = _generation.load(std::memory_order_acquire);
+            auto capacity = _capacity.load(std::memory_order_relaxed);
+
+            if (capacity > 0) {
+                auto &shard = shardFor(hash);
+                auto shardCapacity = std::max<int>(1, (capacity + NUM_SHARDS - 1) / NUM_SHARDS);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+
+                // another thread could get here first
+                auto it = shard.entries.find(key);
+                if (it != shard.entries.end()) {
+                    entry = it->second;
+                } else {
+                    evict(shard, shardCapacity - 1);
+
+                    shard.entries[key] = entry;
+                    shard.order.emplace_back(key);
+                }
+            }
+
+            // front slot also keeps entry alive for the caller
+            auto &slot = frontSlot(hash, generation);
+            slot.generation = generation;
+            slot.key = key;
+            slot.entry = std::move(entry);
+
+            return slot.entry.get();
+        }
+
+        void ShapeCache::setCapacity(int capacity) {
+            _capacity = capacity;
+
+            auto shardCapacity = capacity > 0 ? std::max<int>(1, (capacity + NUM_SHARDS - 1) / NUM_SHARDS) : 0;
+            for (auto &shard: _shards) {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                evict(shard, shardCapacity);
+            }
+
+            _generation = nextGeneration();
+        }
+
+        int ShapeCache::size() {
+            int result = 0;
+            for (auto &shard: _shards) {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                result += (int) shard.entries.size();
+            }
+
+            return result;
+        }
+
+        void ShapeCache::clear() {
+            for (auto &shard: _shards) {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.entries.clear();
+                shard.order.clear();
+            }
+
+            _generation = nextGeneration();
+        }
+
+        Nd4jLong ShapeCache::hits() {
+            Nd4jLong result = 0;
+            for (auto &counter: _hits)
+                result += counter.value.load();
+
+            return result;
+        }
+
+        Nd4jLong ShapeCache::misses() {
+            Nd4jLong result = 0;
+            for (auto &counter: _misses)
+                result += counter.value.load();
+
+            return result;
+        }
+    }
+}
@@ -28,12 +28,13 @@
 
 namespace nd4j {
      namespace blas {
-         template <typename T>
-         static void * transpose(int orderSource, int orderTarget, int rows, int cols, void *source);
-
          static inline int linearIndexC(int rows, int cols, int r, int c);
          static inline int linearIndexF(int rows, int cols, int r, int c);
 
+         /**
+          * Generic GEMM, used when no BLAS is available or for types BLAS doesn't support.
+          * Follows cblas_?gemm semantics: C = alpha * op(A) * op(B) + beta * C
+          */
          template <typename X, typename Y, typename Z>
          class GEMM {
          protected:
@@ -41,6 +42,9 @@ namespace nd4j {
              static void op(int Order, int TransA, int TransB, int M, int N, int K, double alpha, void *A, int lda, void *B, int ldb, double beta, void *C, int ldc);
          };
 
+         /**
+          * Generic GEMV for column-major M x N matrix A: y = alpha * op(A) * x + beta * y
+          */
          template <typename X, typename Y, typename Z>
          class GEMV : public nd4j::blas::GEMM<X, Y, Z>{
          public:
@@ -26,80 +26,193 @@
 namespace nd4j {
     namespace blas {
 
-        template <typename T>
-        void* transpose(int orderSource, int orderTarget, int rows, int cols, void *vsource) {
-            auto ret = new T[rows * cols];
-            auto source = reinterpret_cast<T *>(vsource);
-
-            // handle transpose in parallel
-            PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
-            for (int r = 0; r < rows; r++) {
-                for (int c = 0; c < cols; c++) {
-                    int zIdx = orderTarget == CblasRowMajor ? linearIndexC(rows, cols, r, c) : linearIndexF(rows, cols, r, c);
-                    int xIdx = orderSource == CblasColMajor ? linearIndexF(rows, cols, r, c) : linearIndexC(rows, cols, r, c);
-
-                    ret[zIdx] = source[xIdx];
+        // register tile of micro-kernel, and cache blocking of packed panels
+        // MC x KC panel of A is supposed to stay in L2, KC x NR micro-panel of B - in L1
+        static const int GEMM_MR = 4;
+        static const int GEMM_NR = 8;
+        static const int GEMM_MC = 128;
+        static const int GEMM_KC = 256;
+        static const int GEMM_NC = 4096;
+
+        /**
+         * This method packs mc x kc block of op(A) into MR-row micro-panels: for each p, MR consecutive values of the column.
+         * Alpha is applied here, so it's multiplied once per element of A instead of once per FMA
+         */
+        template <typename X, typename Z>
+        static void packA(const bool trans, const X *A, const int lda, const int ic, const int pc, const int mc, const int kc, const Z alpha, Z *packed) {
+            for (int ir = 0; ir < mc; ir += GEMM_MR) {
+                const int mr = nd4j::math::nd4j_min<int>(GEMM_MR, mc - ir);
+                auto panel = packed + ir * kc;
+
+                for (int p = 0; p < kc; p++) {
+                    auto dst = panel + p * GEMM_MR;
+                    for (int i = 0; i < mr; i++) {
+                        const Nd4jLong row = ic + ir + i;
+                        const Nd4jLong col = pc + p;
+                        dst[i] = alpha * static_cast<Z>(trans ? A[col + row * lda] : A[row + col * lda]);
+                    }
+
+                    for (int i = mr; i < GEMM_MR; i++)
+                        dst[i] = static_cast<Z>(0.f);
                 }
             }
+        }
 
-            return ret;
+        /**
+         * This method packs kc x nc block of op(B) into NR-column micro-panels: for each p, NR consecutive values of the row
+         */
+        template <typename Y, typename Z>
+        static void packB(const bool trans, const Y *B, const int ldb, const int pc, const int jc, const int kc, const int nc, Z *packed) {
+            const int numPanels = (nc + GEMM_NR - 1) / GEMM_NR;
+
+            PRAGMA_OMP_PARALLEL_FOR_IF(numPanels > 1 && (Nd4jLong) kc * nc > Environment::getInstance()->elementwiseThreshold())
+            for (int jp = 0; jp < numPanels; jp++) {
+                const int jr = jp * GEMM_NR;
+                const int nr = nd4j::math::nd4j_min<int>(GEMM_NR, nc - jr);
+                auto panel = packed + jr * kc;
+
+                for (int p = 0; p < kc; p++) {
+                    auto dst = panel + p * GEMM_NR;
+                    for (int j = 0; j < nr; j++) {
+                        const Nd4jLong row = pc + p;
+                        const Nd4jLong col = jc + jr + j;
+                        dst[j] = static_cast<Z>(trans ? B[col + row * ldb] : B[row + col * ldb]);
+                    }
+
+                    for (int j = nr; j < GEMM_NR; j++)
+                        dst[j] = static_cast<Z>(0.f);
+                }
+            }
         }
 
-        template <typename X, typename Y, typename Z>
-        void GEMM<X, Y, Z>::op(int Order, int TransA, int TransB,
-                       int M, int N, int K,
-                       double alpha,
-                       void *vA, int lda,
-                       void *vB, int ldb,
-                       double beta,
-                       void *vC, int ldc) {
+        /**
+         * Micro-kernel: MR x NR tile of C += packed A micro-panel * packed B micro-panel.
+         * Only mr x nr part of the tile is written back, to handle edges of C
+         */
+        template <typename Z>
+        static FORCEINLINE void microKernel(const int kc, const Z *a, const Z *b, Z *C, const int ldc, const int mr, const int nr) {
+            Z acc[GEMM_MR * GEMM_NR];
 
-            auto A = reinterpret_cast<X *>(vA);
-            auto B = reinterpret_cast<Y *>(vB);
-            auto C = reinterpret_cast<Z *>(vC);
+            PRAGMA_OMP_SIMD
+            for (int e = 0; e < GEMM_MR * GEMM_NR; e++)
+                acc[e] = static_cast<Z>(0.f);
 
-            bool transAFlag = TransA == CblasTrans;
-            bool transBFlag = TransB == CblasTrans;
+            for (int p = 0; p < kc; p++) {
+                auto ap = a + p * GEMM_MR;
+                auto bp = b + p * GEMM_NR;
+
+                for (int i = 0; i < GEMM_MR; i++) {
+                    const Z ai = ap[i];
 
-            if (beta == 0.0) {
-                int length = M*N;
-                if (length <= Environment::getInstance()->elementwiseThreshold()) {
                     PRAGMA_OMP_SIMD
-                    for (int r = 0; r < length; r++)
-                        C[r] = static_cast<Z>(0.0f);
-                } else {
-                    PRAGMA_OMP_PARALLEL_FOR_SIMD
-                    for (int r = 0; r < length; r++)
-                        C[r] = static_cast<Z>(0.0f);
+                    for (int j = 0; j < GEMM_NR; j++)
+                        acc[i * GEMM_NR + j] += ai * bp[j];
                 }
             }
 
+            for (int j = 0; j < nr; j++)
+                for (int i = 0; i < mr; i++)
+                    C[i + (Nd4jLong) j * ldc] += acc[i * GEMM_NR + j];
+        }
+
+        /**
+         * Column-major C = alpha * op(A) * op(B) + beta * C, GotoBLAS-style: jc -> pc -> ic blocking,
+         * packed panels and register-tiled micro-kernel
+         */
+        template <typename X, typename Y, typename Z>
+        static void gemmColMajor(const bool transA, const bool transB, const int M, const int N, const int K, const double alpha, const X *A, const int lda, const Y *B, const int ldb, const double beta, Z *C, const int ldc) {
+            if (M <= 0 || N <= 0)
+                return;
 
-            PRAGMA_OMP_PARALLEL_FOR_SIMD_COLLAPSE(2)
-            for (int r = 0; r < M; r++) {
+            // beta is applied once, before accumulation
+            if (beta != 1.0) {
+                const Z betaZ = static_cast<Z>(beta);
+
+                PRAGMA_OMP_PARALLEL_FOR_IF((Nd4jLong) M * N > Environment::getInstance()->elementwiseThreshold())
                 for (int c = 0; c < N; c++) {
-                    int zIdx = linearIndexF(M, N, r, c);
+                    auto column = C + (Nd4jLong) c * ldc;
+                    if (beta == 0.0) {
+                        PRAGMA_OMP_SIMD
+                        for (int r = 0; r < M; r++)
+                            column[r] = static_cast<Z>(0.f);
+                    } else {
+                        PRAGMA_OMP_SIMD
+                        for (int r = 0; r < M; r++)
+                            column[r] = betaZ * column[r];
+                    }
+                }
+            }
 
-                    Z dot = static_cast<Z>(0.0f);
+            if (alpha == 0.0 || K <= 0)
+                return;
 
-                    if (alpha != 0.0) {
-                        int bIdx; // = linearIndexF(K, N, 0, c);
-                        int aIdx;
+            const Z alphaZ = static_cast<Z>(alpha);
 
-                        for (int k = 0; k < K; k++) {
-                            aIdx = (transAFlag ? linearIndexC(M, K, r, k) : linearIndexF(M, K, r, k));
-                            bIdx = (transBFlag ? linearIndexC(K, N, k, c) : linearIndexF(K,N, k, c));
-                            dot += static_cast<Z>(alpha) * static_cast<Z>(A[aIdx]) * static_cast<Z>(B[bIdx]);//A[aIdx]nd4j::math::nd4j_dot<T>(aX, bX, K) * alpha;
-                        }
-                    }
+            const int kcMax = nd4j::math::nd4j_min<int>(K, GEMM_KC);
+            const int ncMax = nd4j::math::nd4j_min<int>(N, GEMM_NC);
+            const int numBlocksM = (M + GEMM_MC - 1) / GEMM_MC;
+            const int mPadded = ((M + GEMM_MR - 1) / GEMM_MR) * GEMM_MR;
+            const int nPadded = ((ncMax + GEMM_NR - 1) / GEMM_NR) * GEMM_NR;
 
-                    if (beta != 0.0) {
-                        C[zIdx] = static_cast<Z>(dot + beta * C[zIdx]);
-                    } else {
-                        C[zIdx] = static_cast<Z>(dot);
+            // every block of A has its own packing buffer, so blocks can be processed in parallel
+            auto packedA = new Z[(Nd4jLong) mPadded * kcMax];
+            auto packedB = new Z[(Nd4jLong) nPadded * kcMax];
+
+            for (int jc = 0; jc < N; jc += GEMM_NC) {
+                const int nc = nd4j::math::nd4j_min<int>(GEMM_NC, N - jc);
+
+                for (int pc = 0; pc < K; pc += GEMM_KC) {
+                    const int kc = nd4j::math::nd4j_min<int>(GEMM_KC, K - pc);
+
+                    packB<Y, Z>(transB, B, ldb, pc, jc, kc, nc, packedB);
+
+                    PRAGMA_OMP_PARALLEL_FOR_ARGS(if(numBlocksM > 1 && (Nd4jLong) M * nc * kc > Environment::getInstance()->elementwiseThreshold()) schedule(dynamic, 1))
+                    for (int b = 0; b < numBlocksM; b++) {
+                        const int ic = b * GEMM_MC;
+                        const int mc = nd4j::math::nd4j_min<int>(GEMM_MC, M - ic);
+                        auto blockA = packedA + (Nd4jLong) ic * kc;
+
+                        packA<X, Z>(transA, A, lda, ic, pc, mc, kc, alphaZ, blockA);
+
+                        for (int jr = 0; jr < nc; jr += GEMM_NR) {
+                            const int nr = nd4j::math::nd4j_min<int>(GEMM_NR, nc - jr);
+
+                            for (int ir = 0; ir < mc; ir += GEMM_MR) {
+                                const int mr = nd4j::math::nd4j_min<int>(GEMM_MR, mc - ir);
+                                auto tile = C + (ic + ir) + (Nd4jLong) (jc + jr) * ldc;
+
+                                microKernel<Z>(kc, blockA + ir * kc, packedB + jr * kc, tile, ldc, mr, nr);
+                            }
+                        }
                     }
                 }
             }
+
+            delete[] packedA;
+            delete[] packedB;
+        }
+
+        template <typename X, typename Y, typename Z>
+        void GEMM<X, Y, Z>::op(int Order, int TransA, int TransB,
+                       int M, int N, int K,
+                       double alpha,
+                       void *vA, int lda,
+                       void *vB, int ldb,
+                       double beta,
+                       void *vC, int ldc) {
+
+            auto A = reinterpret_cast<X *>(vA);
+            auto B = reinterpret_cast<Y *>(vB);
+            auto C = reinterpret_cast<Z *>(vC);
+
+            bool transAFlag = TransA == CblasTrans;
+            bool transBFlag = TransB == CblasTrans;
+
+            // row-major C is column-major C^T = op(B)^T * op(A)^T, so we just swap operands
+            if (Order == CblasRowMajor)
+                gemmColMajor<Y, X, Z>(transBFlag, transAFlag, N, M, K, alpha, B, ldb, A, lda, beta, C, ldc);
+            else
+                gemmColMajor<X, Y, Z>(transAFlag, transBFlag, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
         }
 
 
@@ -114,23 +227,57 @@ namespace nd4j {
                                void* vZ,
                                int incy ) {
 
-            auto x = reinterpret_cast<X *>(vX);
-            auto y = reinterpret_cast<Y *>(vY);
+            // column-major M x N matrix A, z = alpha * op(A) * y + beta * z
+            auto A = reinterpret_cast<X *>(vX);
+            auto x = reinterpret_cast<Y *>(vY);
             auto z = reinterpret_cast<Z *>(vZ);
 
-            auto aT = TRANS == CblasTrans ? reinterpret_cast<X *>(nd4j::blas::transpose<X>(CblasColMajor, CblasRowMajor, M, N, reinterpret_cast<void *>(x))) : x;
+            const Z alphaZ = static_cast<Z>(alpha);
+            const Z betaZ = static_cast<Z>(beta);
 
-            PRAGMA_OMP_PARALLEL_FOR_SIMD
-            for (int r = 0; r < M; r++) {
-                int aIdx = linearIndexC(M, N, r, 0);
-                auto aX = aT + aIdx;
+            if (TRANS == CblasTrans) {
+                // every output element is a dot product with contiguous column of A
+                PRAGMA_OMP_PARALLEL_FOR_IF(N > Environment::getInstance()->tadThreshold())
+                for (int c = 0; c < N; c++) {
+                    auto column = A + (Nd4jLong) c * lda;
+                    Z dot = static_cast<Z>(0.f);
 
-                auto dot = nd4j::math::nd4j_dot<X, Y, Z>(aX, y, lda) * alpha;
-                z[r] =  beta == 0.0f ? dot : dot + beta * z[r];
-            }
+                    for (int r = 0; r < M; r++)
+                        dot += static_cast<Z>(column[r]) * static_cast<Z>(x[(Nd4jLong) r * incx]);
+
+                    auto zc = z + (Nd4jLong) c * incy;
+                    *zc = beta == 0.0 ? alphaZ * dot : alphaZ * dot + betaZ * *zc;
+                }
+            } else {
+                // output is accumulated column by column, every thread owns its own slice of rows, so A is read contiguously
+                const int numBlocks = (M + GEMM_MC - 1) / GEMM_MC;
+
+                PRAGMA_OMP_PARALLEL_FOR_IF(numBlocks > 1 && M > Environment::getInstance()->tadThreshold())
+                for (int b = 0; b < numBlocks; b++) {
+                    const int rStart = b * GEMM_MC;
+                    const int rows = nd4j::math::nd4j_min<int>(GEMM_MC, M - rStart);
 
-            if (TRANS == CblasTrans)
-                delete[] aT;
+                    Z acc[GEMM_MC];
+
+                    PRAGMA_OMP_SIMD
+                    for (int r = 0; r < rows; r++)
+                        acc[r] = static_cast<Z>(0.f);
+
+                    for (int c = 0; c < N; c++) {
+                        auto column = A + rStart + (Nd4jLong) c * lda;
+                        const Z xc = alphaZ * static_cast<Z>(x[(Nd4jLong) c * incx]);
+
+                        PRAGMA_OMP_SIMD
+                        for (int r = 0; r < rows; r++)
+                            acc[r] += static_cast<Z>(column[r]) * xc;
+                    }
+
+                    for (int r = 0; r < rows; r++) {
+                        auto zr = z + (Nd4jLong) (rStart + r) * incy;
+                        *zr = beta == 0.0 ? acc[r] : acc[r] + betaZ * *zr;
+                    }
+                }
+            }
         }
 
         BUILD_TRIPLE_TEMPLATE(template class  GEMV, , LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
@@ -272,23 +272,10 @@ namespace randomOps {
 
             int tid = blockIdx.x * blockDim.x + threadIdx.x;
 
-            int middle = zLength % 2 == 0 ? zLength / 2 : zLength / 2 + 1;
-
-            for (int e = tid; e < middle; e += step) {
-                auto epm = e + middle;
-
-                // we need to get random values
-                T r0 = rng->relativeT<T>(e, epsilon, static_cast<T>(1.0f));
-                T r1 = rng->relativeT<T>(epm, epsilon, static_cast<T>(1.0f));
-
-                T realMean0 = y == z ? mean : y[e * yEWS];
-
-                z[e * zEWS] =  (nd4j::math::nd4j_sqrt<T,T>(static_cast<T>(-2.0f) * nd4j::math::nd4j_log<T,T>(r0)) * nd4j::math::nd4j_cos<T,T>(two_pi * r1)) * stddev + realMean0;
-
-                if (epm < zLength) {
-                    T realMean1 = y == z ? mean : y[epm * yEWS];
-                    z[epm * zEWS] =  (nd4j::math::nd4j_sqrt<T,T>(static_cast<T>(-2.0f) * nd4j::math::nd4j_log<T,T>(r0)) * nd4j::math::nd4j_sin<T,T>(two_pi * r1)) * stddev + realMean1;
-                }
+            // same values as produced by normalBlock() on host
+            for (Nd4jLong e = tid; e < zLength; e += step) {
+                T realMean = y == z ? mean : y[e * yEWS];
+                z[e * zEWS] = rng->relativeNormal<T>(e) * stddev + realMean;
             }
 
             __syncthreads();
@@ -299,51 +286,44 @@ namespace randomOps {
 #endif
 
 
-        static inline void
-        specialOp(Nd4jPointer state, T *x, Nd4jLong *xShapeBuffer, T *y, Nd4jLong *yShapeBuffer, T *z, Nd4jLong *zShapeBuffer, T *extraArguments) {
-            const T two_pi = static_cast<T>(2.0f) * static_cast<T>(3.14159265358979323846);
-
-            auto zLength = shape::length(zShapeBuffer);
-            auto yEWS = shape::elementWiseStride(yShapeBuffer);
-            auto zEWS = shape::elementWiseStride(zShapeBuffer);
-
-            auto middle = zLength % 2  + zLength / 2;
+        /**
+         * This method fills z with normal values produced by RandomGenerator::normalBlock(), optionally followed by exp
+         */
+        template <bool exponent>
+        static inline void fill(nd4j::graph::RandomGenerator* rng, T *y, Nd4jLong yEWS, T *z, Nd4jLong zEWS, Nd4jLong zLength, T mean, T stddev, bool scalarMean) {
+            const int blockSize = nd4j::graph::RandomGenerator::PHILOX_BLOCK;
+            Nd4jLong numBlocks = (zLength + blockSize - 1) / blockSize;
 
-            int elementsPerThread = middle / TAD_THRESHOLD;
+            int elementsPerThread = numBlocks / TAD_THRESHOLD;
             int _threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
             _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
 
-            int span = (middle / _threads) + 8;
-
-            // we're enforcing even chunks, since it's mandatory for this algorithm
-            span -= span % 2;
-
-            //nd4j::random::RandomBuffer *buffer = reinterpret_cast<nd4j::random::RandomBuffer *> (state);
-            nd4j::graph::RandomGenerator* rng = reinterpret_cast<nd4j::graph::RandomGenerator*>(state);
-            const T mean = extraArguments[0];
-            const T stddev = extraArguments[1];
-
-            const T epsilon = static_cast<T>(1e-5);
-
             PRAGMA_OMP_PARALLEL_FOR_THREADS(_threads)
-            for (Nd4jLong e = 0; e < middle; e++) {
-                auto epm = e + middle;
-
-                // we need to get random values
-                T r0 = rng->relativeT<T>(e, epsilon, static_cast<T>(1.0f));
-                T r1 = rng->relativeT<T>(epm, epsilon, static_cast<T>(1.0f));
+            for (Nd4jLong b = 0; b < numBlocks; b++) {
+                T values[nd4j::graph::RandomGenerator::PHILOX_BLOCK];
+                rng->normalBlock<T>(b, values);
+
+                auto start = b * blockSize;
+                auto length = nd4j::math::nd4j_min<Nd4jLong>(blockSize, zLength - start);
+                for (int e = 0; e < length; e++) {
+                    auto i = start + e;
+                    T realMean = scalarMean ? mean : y[i * yEWS];
+                    T value = values[e] * stddev + realMean;
+
+                    z[i * zEWS] = exponent ? nd4j::math::nd4j_exp<T,T>(value) : value;
+                }
+            }
+        }
 
-                T realMean0 = y == z ? mean : y[e * yEWS];
+        static inline void
+        specialOp(Nd4jPointer state, T *x, Nd4jLong *xShapeBuffer, T *y, Nd4jLong *yShapeBuffer, T *z, Nd4jLong *zShapeBuffer, T *extraArguments) {
+            auto zLength = shape::length(zShapeBuffer);
+            auto yEWS = shape::elementWiseStride(yShapeBuffer);
+            auto zEWS = shape::elementWiseStride(zShapeBuffer);
 
-                auto z0 =  (nd4j::math::nd4j_sqrt<T,T>(static_cast<T>(-2.0f) * nd4j::math::nd4j_log<T,T>(r0)) * nd4j::math::nd4j_cos<T,T>(two_pi * r1)) * stddev + realMean0;
-                z[e * zEWS] = z0;
+            nd4j::graph::RandomGenerator* rng = reinterpret_cast<nd4j::graph::RandomGenerator*>(state);
 
-                if (epm < zLength) {
-                    T realMean1 = y == z ? mean : y[epm * yEWS];
-                    auto z1 = (nd4j::math::nd4j_sqrt<T,T>(static_cast<T>(-2.0f) * nd4j::math::nd4j_log<T,T>(r0)) * nd4j::math::nd4j_sin<T,T>(two_pi * r1)) * stddev + realMean1;
-                    z[epm * zEWS] = z1;
-                }
-            }
+            fill<false>(rng, y, yEWS, z, zEWS, zLength, extraArguments[0], extraArguments[1], y == z);
 
             // update rng state
             rng->rewindH(zLength);
@@ -598,27 +578,6 @@ namespace randomOps {
     // This Op produces random Gaussian values within [mean-2*stddev,mean+2*stddev]
     template<typename T>
     class TruncatedNormalDistribution {
-    private:
-        static T step(nd4j::graph::RandomGenerator* rng, T mean, T stddev, Nd4jLong e, Nd4jLong middle, T& z) {
-            auto epm = e + middle;
-            const T two_pi = static_cast<T>(2.0f) * static_cast<T>(3.14159265358979323846);
-            const T epsilon = static_cast<T>(1.e-5f);
-            // we need to get random values
-            T r0 = rng->relativeT<T>(e, epsilon, static_cast<T>(1.0f));
-            T r1 = rng->relativeT<T>(epm, epsilon, static_cast<T>(1.0f));
-
-            T realMean0 = mean;
-
-            auto z0 =  (nd4j::math::nd4j_sqrt<T,T>(static_cast<T>(-2.0f) * nd4j::math::nd4j_log<T,T>(r0)) * nd4j::math::nd4j_cos<T,T>(two_pi * r1)) * stddev + realMean0;
-            z = z0;
-            if (epm < middle) {
-                T realMean1 = mean;
-                auto z1 = (nd4j::math::nd4j_sqrt<T, T>(static_cast<T>(-2.0f) * nd4j::math::nd4j_log<T, T>(r0)) *
-                           nd4j::math::nd4j_sin<T, T>(two_pi * r1)) * stddev + realMean1;
-                z = z1;
-            }
-            return z;
-        }
     public:
 
         method_XY
@@ -721,29 +680,36 @@ namespace randomOps {
         static inline void
         specialOp(Nd4jPointer state, T *x, Nd4jLong *xShapeBuffer, T *y, Nd4jLong *yShapeBuffer, T *z, Nd4jLong *zShapeBuffer, T *extraArguments) {
             GaussianDistribution<T>::specialOp(state, x, xShapeBuffer, y, yShapeBuffer, z, zShapeBuffer, extraArguments);
+
             Nd4jLong zLength = shape::length(zShapeBuffer);
-            //auto yEWS = shape::elementWiseStride(yShapeBuffer);
-            //auto zEWS = shape::elementWiseStride(zShapeBuffer);
+            auto yEWS = shape::elementWiseStride(yShapeBuffer);
+            auto zEWS = shape::elementWiseStride(zShapeBuffer);
+
             nd4j::graph::RandomGenerator* rng = reinterpret_cast<nd4j::graph::RandomGenerator*>(state);
-            T mean = extraArguments[0];
-            T stddev = extraArguments[1];
-            T ds = nd4j::math::nd4j_abs<T>(stddev) * (T) 2.0f;
-            Nd4jLong middle = zLength / 2 + (zLength % 2);
-            int elementsPerThread = middle / TAD_THRESHOLD;
+            const T mean = extraArguments[0];
+            const T stddev = extraArguments[1];
+            const T ds = nd4j::math::nd4j_abs<T>(stddev) * static_cast<T>(2.0f);
+
+            // ~4.5% of values need resampling, so even 2 generations are rarely needed
+            const int maxGenerations = 32;
+
+            int elementsPerThread = zLength / TAD_THRESHOLD;
             int _threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
             _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
 
-            const T epsilon = static_cast<T>(1e-5);
-
             PRAGMA_OMP_PARALLEL_FOR_THREADS(_threads)
-            for (Nd4jLong e = 0; e < zLength; ++e) {
-                if (z[e] > mean + ds || z[e] < mean - ds) {
-                    z[e] = step(rng, mean, stddev, e, middle, z[e]);// = e > 0 ? z[e - 1] : mean; // + stddev;
+            for (Nd4jLong e = 0; e < zLength; e++) {
+                T realMean = y == z ? mean : y[e * yEWS];
+                T value = z[e * zEWS];
 
-                //else if (z[e] < mean - ds)
-                    if (z[e] > mean + ds || z[e] < mean - ds)
-                        z[e] = mean + nd4j::DataTypeUtils::min<T>();
-                }
+                // every generation uses its own range of indices
+                for (int generation = 1; generation <= maxGenerations && nd4j::math::nd4j_abs<T>(value - realMean) > ds; generation++)
+                    value = rng->relativeNormal<T>(e + generation * zLength) * stddev + realMean;
+
+                if (nd4j::math::nd4j_abs<T>(value - realMean) > ds)
+                    value = realMean;
+
+                z[e * zEWS] = value;
             }
 
             // update rng state
@@ -816,23 +782,10 @@ namespace randomOps {
 
             int tid = blockIdx.x * blockDim.x + threadIdx.x;
 
-            int middle = zLength % 2 == 0 ? zLength / 2 : zLength / 2 + 1;
-
-            for (Nd4jLong e = tid; e < middle; e += step) {
-                auto epm = e + middle;
-
-                // we need to get random values
-                T r0 = rng->relativeT<T>(e, epsilon, static_cast<T>(1.0f));
-                T r1 = rng->relativeT<T>(epm, epsilon, static_cast<T>(1.0f));
-
+            // same values as produced by normalBlock() on host
+            for (Nd4jLong e = tid; e < zLength; e += step) {
                 T realMean = y == z ? mean : y[e * yEWS];
-
-                z[e *zEWS] =  nd4j::math::nd4j_exp<T,T>((nd4j::math::nd4j_sqrt<T,T>(static_cast<T>(-2.0f) * nd4j::math::nd4j_log<T,T>(r0)) * nd4j::math::nd4j_cos<T,T>(two_pi * r1)) * stddev + realMean);
-
-                if (epm < zLength) {
-                    realMean = y == z ? mean : y[epm * yEWS];
-                    z[epm *zEWS] =  nd4j::math::nd4j_exp<T,T>((nd4j::math::nd4j_sqrt<T,T>(static_cast<T>(-2.0f) * nd4j::math::nd4j_log<T,T>(r0)) * nd4j::math::nd4j_sin<T,T>(two_pi * r1)) * stddev + realMean);
-                }
+                z[e * zEWS] = nd4j::math::nd4j_exp<T,T>(rng->relativeNormal<T>(e) * stddev + realMean);
             }
 
             __syncthreads();
@@ -843,60 +796,16 @@ namespace randomOps {
 
         static inline void
         specialOp(Nd4jPointer state, T *x, Nd4jLong *xShapeBuffer, T *y, Nd4jLong *yShapeBuffer, T *z, Nd4jLong *zShapeBuffer, T *extraArguments) {
-            const T two_pi = static_cast<T>(2.0f) * static_cast<T>(3.14159265358979323846);
-
             Nd4jLong zLength = shape::length(zShapeBuffer);
             auto yEWS = shape::elementWiseStride(yShapeBuffer);
             auto zEWS = shape::elementWiseStride(zShapeBuffer);
 
-            auto middle = zLength % 2 == 0 ? zLength / 2 : zLength / 2 + 1;
-
-            int elementsPerThread = middle / TAD_THRESHOLD;
-            int _threads = nd4j::math::nd4j_max<int>(1, elementsPerThread);
-            _threads = nd4j::math::nd4j_min<int>(_threads, omp_get_max_threads());
-
-            int span = (zLength / _threads) + 8;
-
-            // we're enforcing even chunks, since it's mandatory for this algorithm
-            span -= span % 2;
-
-//            auto buffer = reinterpret_cast<nd4j::random::RandomBuffer *> (state);
             nd4j::graph::RandomGenerator* rng = reinterpret_cast<nd4j::graph::RandomGenerator*>(state);
 
-            const T mean = extraArguments[0];
-            const T stddev = extraArguments[1];
-            const T epsilon = static_cast<T>(1e-5);
-
-            PRAGMA_OMP_PARALLEL_THREADS(_threads)
-            {
-                int tid = omp_get_thread_num();
-                Nd4jLong start = span * tid;
-                Nd4jLong end = span * (tid + 1);
-                if (end > middle)
-                    end = middle;
-
-                PRAGMA_OMP_SIMD
-                for (Nd4jLong e = start; e < end; e++) {
-                    auto epm = e + middle;
-
-                    // we need to get random values
-                    T r0 = rng->relativeT<T>(e, epsilon, static_cast<T>(1.0f));
-                    T r1 = rng->relativeT<T>(epm, epsilon, static_cast<T>(1.0f));
-
-                    T realMean = y == z ? mean : y[e * yEWS];
-
-                    z[e * zEWS] =  nd4j::math::nd4j_exp<T,T>((nd4j::math::nd4j_sqrt<T,T>(static_cast<T>(-2.0f) * nd4j::math::nd4j_log<T,T>(r0)) * nd4j::math::nd4j_cos<T,T>(two_pi * r1)) * stddev + realMean);
-
-                    if (epm < zLength) {
-                        realMean = y == z ? mean : y[epm * yEWS];
-                        z[epm * zEWS] =  nd4j::math::nd4j_exp<T,T>((nd4j::math::nd4j_sqrt<T,T>(static_cast<T>(-2.0f) * nd4j::math::nd4j_log<T,T>(r0)) * nd4j::math::nd4j_sin<T,T>(two_pi * r1)) * stddev + realMean);
-                    }
-                }
-            }
+            GaussianDistribution<T>::template fill<true>(rng, y, yEWS, z, zEWS, zLength, extraArguments[0], extraArguments[1], y == z);
 
             // update rng state
             rng->rewindH(zLength);
-
         }
     };
 
@@ -35,15 +35,46 @@
 
 namespace nd4j {
     namespace graph {
+            GraphInferenceServerImpl::GraphInferenceServerImpl(int maxBatchSize, Nd4jLong batchWindow) {
+                _maxBatchSize = maxBatchSize;
+                _batchWindow = batchWindow;
+            }
+
+            GraphInferenceServerImpl::~GraphInferenceServerImpl() {
+                for (auto v: _batchers)
+                    delete v.second;
+            }
+
+            void GraphInferenceServerImpl::setBatching(Nd4jLong graphId, bool enabled) {
+                std::lock_guard<std::mutex> lock(_batchersLock);
+                if (enabled)
+                    _batchedGraphs.insert(graphId);
+                else
+                    _batchedGraphs.erase(graphId);
+            }
+
+            bool GraphInferenceServerImpl::isBatching(Nd4jLong graphId) {
+                std::lock_guard<std::mutex> lock(_batchersLock);
+                return _maxBatchSize > 1 && _batchedGraphs.count(graphId) > 0;
+            }
+
+            InferenceBatcher* GraphInferenceServerImpl::batcher(Nd4jLong graphId) {
+                std::lock_guard<std::mutex> lock(_batchersLock);
+                if (_batchers.count(graphId) == 0)
+                    _batchers[graphId] = new InferenceBatcher(graphId, _maxBatchSize, _batchWindow);
+
+                return _batchers[graphId];
+            }
+
             grpc::Status GraphInferenceServerImpl::RegisterGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatGraph> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg) {
                 auto flat_graph = request_msg->GetRoot();
 
                 try {
                     // building our graph
-                    auto graph = new Graph<float>(flat_graph);
+                    auto graph = new Graph(flat_graph);
 
                     // single data type for now
-                    GraphHolder::getInstance()->registerGraph<float>(flat_graph->id(), graph);
+                    GraphHolder::getInstance()->registerGraph(flat_graph->id(), graph);
 
                     // sending out OK response
                     auto response_offset = CreateFlatResponse(mb_, 0);
@@ -63,7 +94,7 @@ namespace nd4j {
 
                 try {
                     // building our graph
-                    auto graph = new Graph<float>(flat_graph);
+                    auto graph = new Graph(flat_graph);
 
                     // single data type for now
                     GraphHolder::getInstance()->replaceGraph(flat_graph->id(), graph);
@@ -109,12 +140,27 @@ namespace nd4j {
             grpc::Status GraphInferenceServerImpl::InferenceRequest( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatInferenceRequest> *request_msg, flatbuffers::grpc::Message<FlatResult> *response_msg) {
                 auto request = request_msg->GetRoot();
 
-                try {
-                    // GraphHolder
-                    auto response_offset = GraphHolder::getInstance()->execute(request->id(), mb_, request);
+                // inference requests are served concurrently, so each one gets its own builder
+                flatbuffers::grpc::MessageBuilder mb;
 
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResult>();
+                try {
+                    flatbuffers::Offset<FlatResult> response_offset;
+                    // only graphs explicitly opted in are batched: merged rows must not affect each other
+                    if (isBatching(request->id())) {
+                        if (!GraphHolder::getInstance()->hasGraph(request->id()))
+                            throw nd4j::graph::unknown_graph_exception(request->id());
+
+                        // requests are merged along dimension 0 with other requests to the same graph
+                        auto b = batcher(request->id());
+                        response_offset = b->execute(mb, request);
+
+                        nd4j_debug("Graph [%lld] batching: queue depth: %i; avg batch size: %f; avg wait time: %f us\n", request->id(), b->queueDepth(), b->averageBatchSize(), b->averageWaitTime());
+                    } else {
+                        response_offset = GraphHolder::getInstance()->execute(request->id(), mb, request);
+                    }
+
+                    mb.Finish(response_offset);
+                    *response_msg = mb.ReleaseMessage<FlatResult>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
@@ -134,57 +180,3 @@ namespace nd4j {
             }
     }
 }
-
-void RunServer(int port) {
-  assert(port > 0 && port < 65535);
-
-  std::string server_address("0.0.0.0:");
-  server_address += nd4j::StringUtils::valueToString<int>(port);
-
-  nd4j::graph::GraphInferenceServerImpl service;
-  auto registrator = nd4j::ops::OpRegistrator::getInstance();
-
-  grpc::ServerBuilder builder;
-  builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());
-  builder.RegisterService(&service);
-  std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
-  std::cerr << "Server listening on: [" << server_address << "]; Number of operations: [" <<  registrator->numberOfOperations()  << "]"<< std::endl;
-
-  server->Wait();
-}
-
-char* getCmdOption(char **begin, char **end, const std::string & option) {
-    auto itr = std::find(begin, end, option);
-    if (itr != end && ++itr != end)
-        return *itr;
-
-    return 0;
-}
-
-bool cmdOptionExists(char** begin, char** end, const std::string& option) {
-    return std::find(begin, end, option) != end;
-}
-
-int main(int argc, char *argv[]) {
-    /**
-     * basically we only care about few things here:
-     * 1) port number
-     * 2) if we should use gprc, json, or both
-     * 3) if there's any graph(s) provided at startup
-     */
-     int port = 40123;
-     if(cmdOptionExists(argv, argv+argc, "-p")) {
-        auto sPort = getCmdOption(argv, argv + argc, "-p");
-        port = atoi(sPort);
-     }
-
-    if(cmdOptionExists(argv, argv+argc, "-f")) {
-        auto file = getCmdOption(argv, argv + argc, "-f");
-        auto graph = GraphExecutioner<float>::importFromFlatBuffers(file);
-        nd4j::graph::GraphHolder::getInstance()->registerGraph<float>(0L, graph);
-    }
-
-    RunServer(port);
-
-    return 0;
-}
\ No newline at end of file
@@ -23,6 +23,10 @@
 #include <NDArray.h>
 #include <graph/Graph.h>
 #include <ops/declarable/CustomOperations.h>
+#include <graph/InferenceBatcher.h>
+#include <map>
+#include <set>
+#include <mutex>
 
 #include <graph/generated/graph.grpc.fb.h>
 
@@ -31,7 +35,44 @@ namespace nd4j {
         class GraphInferenceServerImpl final : public GraphInferenceServer::Service {
         private:
             flatbuffers::grpc::MessageBuilder mb_;
+
+            // batching is disabled if _maxBatchSize <= 1
+            int _maxBatchSize = 0;
+            Nd4jLong _batchWindow = 0;
+
+            std::mutex _batchersLock;
+            std::map<Nd4jLong, InferenceBatcher*> _batchers;
+
+            // graphs opted in for batching
+            std::set<Nd4jLong> _batchedGraphs;
         public:
+            GraphInferenceServerImpl() = default;
+
+            /**
+             * @param maxBatchSize - max number of inference requests merged into single graph execution, for graphs enabled via setBatching()
+             * @param batchWindow - max time (in microseconds) request waits for other requests to be batched with
+             */
+            GraphInferenceServerImpl(int maxBatchSize, Nd4jLong batchWindow);
+            ~GraphInferenceServerImpl();
+
+            /**
+             * This method enables or disables batching of requests to given graph, disabled by default.
+             * Batched requests are concatenated along dimension 0, so it must be enabled only for graphs
+             * that process rows independently: any op mixing rows (i.e. softmax or cumsum along dimension 0,
+             * batch statistics) would make results depend on requests of other clients
+             */
+            void setBatching(Nd4jLong graphId, bool enabled);
+
+            /**
+             * This method returns TRUE if requests to given graph are batched
+             */
+            bool isBatching(Nd4jLong graphId);
+
+            /**
+             * This method returns batcher of given graph, it's created on first call
+             */
+            InferenceBatcher* batcher(Nd4jLong graphId);
+
             virtual grpc::Status RegisterGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatGraph> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg);
 
             virtual grpc::Status ForgetGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatDropRequest> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg);
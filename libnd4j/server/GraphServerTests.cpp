@@ -0,0 +1,126 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// @author raver119@gmail.com
+//
+
+#include <gtest/gtest.h>
+#include "GraphServer.h"
+#include <graph/GraphHolder.h>
+#include <graph/InferenceRequest.h>
+#include <graph/ExecutionResult.h>
+#include <ops/declarable/OpRegistrator.h>
+#include <NDArrayFactory.h>
+#include <thread>
+
+using namespace nd4j;
+using namespace nd4j::graph;
+
+class GraphServerTests : public testing::Test {
+public:
+
+};
+
+// rows are reduced independently, so this graph can be batched
+static Graph* buildReductionGraph(int dimension) {
+    auto graph = new Graph();
+    graph->getVariableSpace()->putVariable(-1, new Variable());
+
+    auto op = nd4j::ops::OpRegistrator::getInstance()->getOperation("reduce_sum");
+    graph->addNode(new Node(op, 1, {-1}, {}, {}, 0.0f, {}, {dimension}));
+
+    return graph;
+}
+
+// sends requests to given graph from numThreads concurrent clients via in-process channel, and checks results
+static void sendConcurrentRequests(GraphInferenceServer::Stub *stub, Nd4jLong graphId, int numThreads) {
+    std::vector<std::thread> threads;
+    std::vector<int> results(numThreads, 0);
+
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back(std::thread([stub, graphId, &results, t] {
+            auto input = NDArrayFactory::create<float>('c', {2, 3});
+            input.linspace(t + 1);
+
+            // sums of rows: [3t + 6, 3t + 15]
+            auto exp = NDArrayFactory::create<float>('c', {2}, {3.f * t + 6.f, 3.f * t + 15.f});
+
+            InferenceRequest ir(graphId);
+            ir.appendVariable(-1, 0, &input);
+
+            flatbuffers::grpc::MessageBuilder mb;
+            mb.Finish(ir.asFlatInferenceRequest(mb));
+            auto request = mb.ReleaseMessage<FlatInferenceRequest>();
+
+            grpc::ClientContext context;
+            flatbuffers::grpc::Message<FlatResult> response;
+            auto status = stub->InferenceRequest(&context, request, &response);
+            if (!status.ok())
+                return;
+
+            ExecutionResult restored(response.GetRoot());
+            results[t] = restored.size() == 1 && exp.equalsTo(restored.at(0)->getNDArray()) ? 1 : 0;
+        }));
+    }
+
+    for (auto &t: threads)
+        t.join();
+
+    for (int t = 0; t < numThreads; t++)
+        ASSERT_EQ(1, results[t]);
+}
+
+TEST_F(GraphServerTests, BatchedInference_1) {
+    const int numThreads = 4;
+    const Nd4jLong batchedId = 12001L;
+    const Nd4jLong plainId = 12002L;
+
+    GraphHolder::getInstance()->registerGraph(batchedId, buildReductionGraph(1));
+    GraphHolder::getInstance()->registerGraph(plainId, buildReductionGraph(1));
+
+    // batch leader waits until all requests are queued, window is only a safety net here
+    GraphInferenceServerImpl service(numThreads, 30000000L);
+    service.setBatching(batchedId, true);
+
+    ASSERT_TRUE(service.isBatching(batchedId));
+    ASSERT_FALSE(service.isBatching(plainId));
+
+    grpc::ServerBuilder builder;
+    builder.RegisterService(&service);
+    auto server = builder.BuildAndStart();
+    ASSERT_TRUE(server != nullptr);
+
+    grpc::ChannelArguments args;
+    auto stub = GraphInferenceServer::NewStub(server->InProcessChannel(args));
+
+    sendConcurrentRequests(stub.get(), batchedId, numThreads);
+
+    // all requests were coalesced into single graph execution
+    auto batcher = service.batcher(batchedId);
+    ASSERT_EQ(numThreads, batcher->numberOfRequests());
+    ASSERT_EQ(1, batcher->numberOfBatches());
+
+    // graph that isn't opted in serves each request separately, and never reaches its batcher
+    sendConcurrentRequests(stub.get(), plainId, numThreads);
+    ASSERT_EQ(0, service.batcher(plainId)->numberOfRequests());
+
+    server->Shutdown();
+
+    GraphHolder::getInstance()->dropGraphAny(batchedId);
+    GraphHolder::getInstance()->dropGraphAny(plainId);
+}
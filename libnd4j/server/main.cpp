@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// @author raver119@gmail.com
+//
+
+#include "GraphServer.h"
+#include <GraphExecutioner.h>
+#include <graph/GraphHolder.h>
+#include <helpers/StringUtils.h>
+#include <algorithm>
+#include <sstream>
+
+void RunServer(int port, int maxBatchSize, Nd4jLong batchWindow, const std::vector<Nd4jLong> &batchedGraphs) {
+  assert(port > 0 && port < 65535);
+
+  std::string server_address("0.0.0.0:");
+  server_address += nd4j::StringUtils::valueToString<int>(port);
+
+  nd4j::graph::GraphInferenceServerImpl service(maxBatchSize, batchWindow);
+  for (auto graphId: batchedGraphs)
+      service.setBatching(graphId, true);
+  auto registrator = nd4j::ops::OpRegistrator::getInstance();
+
+  grpc::ServerBuilder builder;
+  builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());
+  builder.RegisterService(&service);
+  std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
+  std::cerr << "Server listening on: [" << server_address << "]; Number of operations: [" <<  registrator->numberOfOperations()  << "]"<< std::endl;
+
+  server->Wait();
+}
+
+char* getCmdOption(char **begin, char **end, const std::string & option) {
+    auto itr = std::find(begin, end, option);
+    if (itr != end && ++itr != end)
+        return *itr;
+
+    return 0;
+}
+
+bool cmdOptionExists(char** begin, char** end, const std::string& option) {
+    return std::find(begin, end, option) != end;
+}
+
+int main(int argc, char *argv[]) {
+    /**
+     * basically we only care about few things here:
+     * 1) port number
+     * 2) if we should use gprc, json, or both
+     * 3) if there's any graph(s) provided at startup
+     * 4) if inference requests should be batched, and for which graphs
+     * 5) how many versions of each graph are kept for A/B routing
+     */
+     int port = 40123;
+     if(cmdOptionExists(argv, argv+argc, "-p")) {
+        auto sPort = getCmdOption(argv, argv + argc, "-p");
+        port = atoi(sPort);
+     }
+
+    if(cmdOptionExists(argv, argv+argc, "-f")) {
+        auto file = getCmdOption(argv, argv + argc, "-f");
+        auto graph = GraphExecutioner::importFromFlatBuffers(file);
+        nd4j::graph::GraphHolder::getInstance()->registerGraph(0L, graph);
+    }
+
+    int maxBatchSize = 0;
+    if(cmdOptionExists(argv, argv+argc, "-b")) {
+        auto sBatch = getCmdOption(argv, argv + argc, "-b");
+        maxBatchSize = atoi(sBatch);
+    }
+
+    Nd4jLong batchWindow = 1000;
+    if(cmdOptionExists(argv, argv+argc, "-w")) {
+        auto sWindow = getCmdOption(argv, argv + argc, "-w");
+        batchWindow = atol(sWindow);
+    }
+
+    // batching is opt-in per graph: comma-separated ids of graphs which process rows along dimension 0 independently
+    std::vector<Nd4jLong> batchedGraphs;
+    if(cmdOptionExists(argv, argv+argc, "-g")) {
+        std::stringstream ids(getCmdOption(argv, argv + argc, "-g"));
+        std::string id;
+        while (std::getline(ids, id, ','))
+            if (!id.empty())
+                batchedGraphs.emplace_back(atol(id.c_str()));
+    }
+
+    // number of graph versions kept after ReplaceGraph, and share of requests (in percents) routed to the newest one
+    if(cmdOptionExists(argv, argv+argc, "-k")) {
+        auto sVersions = getCmdOption(argv, argv + argc, "-k");
+        nd4j::graph::GraphHolder::getInstance()->setRetainedVersions(atoi(sVersions));
+    }
+
+    if(cmdOptionExists(argv, argv+argc, "-s")) {
+        auto sShare = getCmdOption(argv, argv + argc, "-s");
+        nd4j::graph::GraphHolder::getInstance()->setNewestShare(atoi(sShare));
+    }
+
+    RunServer(port, maxBatchSize, batchWindow, batchedGraphs);
+
+    return 0;
+}
\ No newline at end of file
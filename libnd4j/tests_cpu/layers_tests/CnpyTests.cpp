@@ -19,6 +19,7 @@
 //
 
 #include "testinclude.h"
+#include <config.h>
 
 class FileTest : public testing::Test {
 
@@ -57,4 +58,76 @@ TEST_F(LoadFromStringTest,PathTest) {
     delete[] loaded;
 }
 
-*/
\ No newline at end of file
+*/
+TEST_F(FileTest, MappedNpy_1) {
+    auto arr = cnpy::npyLoad("./resources/npy_float_10x100.npy");
+    ASSERT_TRUE(arr.owner != nullptr);
+    ASSERT_FALSE(arr.fortranOrder);
+    ASSERT_EQ(2, arr.shape.size());
+    ASSERT_EQ(10, arr.shape[0]);
+    ASSERT_EQ(100, arr.shape[1]);
+    ASSERT_EQ(4, arr.wordSize);
+
+    auto data = reinterpret_cast<float *>(arr.data);
+    for (int e = 0; e < 1000; e++)
+        ASSERT_EQ((float) e, data[e]);
+
+    arr.destruct();
+}
+
+TEST_F(FileTest, NpzIndex_1) {
+    cnpy::NpzIndex index("./resources/npz_stored.npz");
+    ASSERT_EQ(3, index.entries().size());
+    ASSERT_TRUE(index.hasEntry("bb"));
+    ASSERT_FALSE(index.hasEntry("bb.npy"));
+    ASSERT_EQ(0, index.entry("bb").method);
+
+    auto arrays = index.loadAll();
+    ASSERT_EQ(3, arrays.size());
+    ASSERT_EQ(256, arrays["bb"].shape[0]);
+    ASSERT_EQ(8, arrays["bb"].wordSize);
+
+    auto data = reinterpret_cast<double *>(arrays["bb"].data);
+    for (int e = 0; e < 256; e++)
+        ASSERT_EQ(e * 0.5, data[e]);
+
+    auto single = index.load("c");
+    ASSERT_EQ(3.0f, reinterpret_cast<float *>(single.data)[2]);
+
+    ASSERT_ANY_THROW(index.load("zz"));
+
+    single.destruct();
+    arrays.destruct();
+}
+
+#ifdef HAVE_ZLIB
+TEST_F(FileTest, NpzIndex_2) {
+    auto arrays = cnpy::npzLoad(std::string("./resources/npz_deflated.npz"));
+    ASSERT_EQ(3, arrays.size());
+
+    auto data = reinterpret_cast<float *>(arrays["a"].data);
+    for (int e = 0; e < 1000; e++)
+        ASSERT_EQ((float) e, data[e]);
+
+    arrays.destruct();
+}
+#endif
+
+TEST_F(FileTest, NpyStream_1) {
+    cnpy::NpyStream stream("./resources/npz_stored.npz", "bb");
+    ASSERT_EQ(256, stream.lengthOf());
+    ASSERT_EQ(8, stream.wordSize());
+
+    double buffer[100];
+    Nd4jLong total = 0;
+    Nd4jLong cnt;
+    while ((cnt = stream.read(buffer, 100)) > 0) {
+        for (Nd4jLong e = 0; e < cnt; e++)
+            ASSERT_EQ((total + e) * 0.5, buffer[e]);
+
+        total += cnt;
+    }
+
+    ASSERT_EQ(256, total);
+    ASSERT_EQ(256, stream.position());
+}
@@ -1096,6 +1096,34 @@ TEST_F(DeclarableOpsTests10, NTH_Element_Test_6) {
     delete results;
 }
 
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, NTH_Element_Test_7) {
+
+    NDArray x = NDArrayFactory::create<float>('c', {3,4}, {3.f, 1.f, 4.f, 2.f, 8.f, 6.f, 7.f, 5.f, 9.f, 12.f, 10.f, 11.f});
+    NDArray n = NDArrayFactory::create<int>(1);
+    NDArray expR = NDArrayFactory::create<float>({3.f, 7.f, 11.f});
+    NDArray expF = NDArrayFactory::create<float>({2.f, 6.f, 10.f});
+
+    // f order, so rows aren't contiguous
+    auto input = x.dup('f');
+
+    nd4j::ops::nth_element op;
+    auto results = op.execute({input, &n}, {}, {1});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+    ASSERT_TRUE(expR.equalsTo(results->at(0)));
+    delete results;
+
+    // n must stay intact after reverse call
+    ASSERT_EQ(1, n.e<int>(0));
+
+    results = op.execute({input, &n}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+    ASSERT_TRUE(expF.equalsTo(results->at(0)));
+    delete results;
+
+    delete input;
+}
+
 ///////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests10, broadcast_to_test1) {
 
@@ -2464,6 +2492,28 @@ TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressing_2) {
     delete results;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressing_3) {
+
+    NDArray boxes    = NDArrayFactory::create<float>('c', {6,4}, {0, 0, 1, 1, 0, 0.1f, 1, 1.1f, 0, -0.1f, 1.f, 0.9f,
+                                         0, 10, 1, 11, 0, 10.1f, 1.f, 11.1f, 0, 100, 1, 101});
+    NDArray scales = NDArrayFactory::create<float>('c', {6}, {0.9f, .75f, .6f, .95f, .5f, .3f});
+    NDArray expected = NDArrayFactory::create<float>('c', {5}, {3., 0., 1., 5., 4.});
+
+    // soft-NMS: iou threshold 1.0, score threshold 0.2, sigma 0.5
+    nd4j::ops::non_max_suppression op;
+    auto results = op.execute({&boxes, &scales}, {1.0, 0.2, 0.5}, {5});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    NDArray* result = results->at(0);
+
+    ASSERT_TRUE(expected.isSameShapeStrict(result));
+    ASSERT_TRUE(expected.equalsTo(result));
+
+    delete results;
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests10, Image_CropAndResize_1) {
 
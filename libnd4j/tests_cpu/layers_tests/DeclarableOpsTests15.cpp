@@ -134,4 +134,74 @@ TEST_F(DeclarableOpsTests15, test_avgpooling_edge_1) {
     ASSERT_EQ(m, *z);
 
     delete result;
-}
\ No newline at end of file
+}
+
+TEST_F(DeclarableOpsTests15, Test_ShapeCache_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 4});
+    auto y = NDArrayFactory::create<float>('c', {4});
+    auto z = NDArrayFactory::create<float>('c', {5, 4});
+
+    nd4j::ops::add op;
+    auto cache = op.getShapeCache();
+
+    for (int e = 0; e < 3; e++) {
+        auto result = op.execute({&x, &y}, {}, {});
+        ASSERT_EQ(Status::OK(), result->status());
+        ASSERT_TRUE(result->at(0)->isSameShape(x));
+        delete result;
+    }
+
+    ASSERT_EQ(1, cache->size());
+    ASSERT_EQ(1, cache->misses());
+    ASSERT_EQ(2, cache->hits());
+
+    // different input shape means different key
+    auto result = op.execute({&z, &y}, {}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_TRUE(result->at(0)->isSameShape(z));
+    delete result;
+
+    ASSERT_EQ(2, cache->size());
+}
+
+TEST_F(DeclarableOpsTests15, Test_ShapeCache_2) {
+    // unique isn't marked as cacheable, since its output shape depends on content of input
+    auto x = NDArrayFactory::create<float>('c', {5}, {1.f, 1.f, 2.f, 2.f, 3.f});
+    auto y = NDArrayFactory::create<float>('c', {5}, {1.f, 2.f, 3.f, 4.f, 5.f});
+
+    nd4j::ops::unique op;
+
+    auto resultX = op.execute({&x}, {}, {});
+    ASSERT_EQ(Status::OK(), resultX->status());
+    ASSERT_EQ(3, resultX->at(0)->lengthOf());
+
+    auto resultY = op.execute({&y}, {}, {});
+    ASSERT_EQ(Status::OK(), resultY->status());
+    ASSERT_EQ(5, resultY->at(0)->lengthOf());
+
+    ASSERT_EQ(0, op.getShapeCache()->size());
+
+    delete resultX;
+    delete resultY;
+}
+
+TEST_F(DeclarableOpsTests15, Test_ShapeCache_3) {
+    // shape given as float array: same input shapes, but different output shapes
+    auto x = NDArrayFactory::create<float>('c', {2}, {2.f, 3.f});
+    auto y = NDArrayFactory::create<float>('c', {2}, {4.f, 5.f});
+
+    nd4j::ops::fill op;
+
+    auto resultX = op.execute({&x}, {1.0}, {});
+    ASSERT_EQ(Status::OK(), resultX->status());
+    ASSERT_EQ(std::vector<Nd4jLong>({2, 3}), resultX->at(0)->getShapeAsVector());
+
+    auto resultY = op.execute({&y}, {1.0}, {});
+    ASSERT_EQ(Status::OK(), resultY->status());
+    ASSERT_EQ(std::vector<Nd4jLong>({4, 5}), resultY->at(0)->getShapeAsVector());
+
+    ASSERT_EQ(0, op.getShapeCache()->size());
+
+    delete resultX;
+    delete resultY;
+}
@@ -4275,3 +4275,110 @@ TEST_F(DeclarableOpsTests2, lstmCell_test12) {
 
     delete results;
 }
+
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests2, lstmCell_test13) {
+
+    // same cell evaluated with c ordered contiguous inputs (fused gates) and with strided/'f' ordered inputs (fallback)
+    const int batchSize = 3;
+    const int inSize    = 5;
+    const int numProj   = 3;
+    const int numUnits  = 4;
+
+    auto xt   = NDArrayFactory::create<double>('c', {batchSize, inSize});
+    auto ht_1 = NDArrayFactory::create<double>('c', {batchSize, numProj});
+    auto ct_1 = NDArrayFactory::create<double>('c', {batchSize, numUnits});
+    auto Wx   = NDArrayFactory::create<double>('c', {inSize, 4*numUnits});
+    auto Wh   = NDArrayFactory::create<double>('c', {numProj, 4*numUnits});
+    auto Wc   = NDArrayFactory::create<double>('c', {3*numUnits});
+    auto Wp   = NDArrayFactory::create<double>('c', {numUnits, numProj});
+    auto b    = NDArrayFactory::create<double>('c', {4*numUnits});
+
+    xt.linspace(-1., 0.1);
+    ht_1.linspace(-0.5, 0.1);
+    ct_1.linspace(0.5, -0.1);
+    Wx.linspace(-0.3, 0.01);
+    Wh.linspace(0.2, -0.02);
+    Wc.linspace(-0.1, 0.05);
+    Wp.linspace(0.4, -0.05);
+    b.linspace(-0.2, 0.03);
+
+    auto xtBig = NDArrayFactory::create<double>('c', {batchSize, 2*inSize});
+    auto xtView = xtBig({0,0, inSize,2*inSize});
+    xtView.assign(xt);
+    auto ht_1F = NDArrayFactory::create<double>('f', {batchSize, numProj});
+    ht_1F.assign(ht_1);
+    auto ct_1F = NDArrayFactory::create<double>('f', {batchSize, numUnits});
+    ct_1F.assign(ct_1);
+
+    ASSERT_NE(1, xtView.ews());
+    ASSERT_EQ('f', ct_1F.ordering());
+
+    nd4j::ops::lstmCell op;
+    auto fused   = op.execute({&xt, &ht_1, &ct_1, &Wx, &Wh, &Wc, &Wp, &b}, {0.8, 0.6, 0.5}, {1, 1});
+    auto unfused = op.execute({&xtView, &ht_1F, &ct_1F, &Wx, &Wh, &Wc, &Wp, &b}, {0.8, 0.6, 0.5}, {1, 1});
+
+    ASSERT_EQ(ND4J_STATUS_OK, fused->status());
+    ASSERT_EQ(ND4J_STATUS_OK, unfused->status());
+
+    for (int e = 0; e < 2; e++) {
+        ASSERT_TRUE(fused->at(e)->isSameShape(unfused->at(e)));
+        ASSERT_TRUE(fused->at(e)->equalsTo(unfused->at(e)));
+    }
+
+    delete fused;
+    delete unfused;
+}
+
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests2, lstmBlockCell_test1) {
+
+    // same cell evaluated with c ordered contiguous inputs (fused gates) and with strided/'f' ordered inputs (fallback)
+    const int batchSize = 3;
+    const int inSize    = 5;
+    const int numUnits  = 4;
+
+    auto xt    = NDArrayFactory::create<double>('c', {batchSize, inSize});
+    auto cLast = NDArrayFactory::create<double>('c', {batchSize, numUnits});
+    auto yLast = NDArrayFactory::create<double>('c', {batchSize, numUnits});
+    auto W     = NDArrayFactory::create<double>('c', {inSize + numUnits, 4*numUnits});
+    auto Wci   = NDArrayFactory::create<double>('c', {numUnits});
+    auto Wcf   = NDArrayFactory::create<double>('c', {numUnits});
+    auto Wco   = NDArrayFactory::create<double>('c', {numUnits});
+    auto b     = NDArrayFactory::create<double>('c', {4*numUnits});
+
+    xt.linspace(-1., 0.1);
+    cLast.linspace(0.5, -0.1);
+    yLast.linspace(-0.5, 0.1);
+    W.linspace(-0.3, 0.005);
+    Wci.linspace(-0.1, 0.05);
+    Wcf.linspace(0.1, 0.05);
+    Wco.linspace(0.2, -0.05);
+    b.linspace(-0.2, 0.03);
+
+    auto xtBig = NDArrayFactory::create<double>('c', {batchSize, 2*inSize});
+    auto xtView = xtBig({0,0, inSize,2*inSize});
+    xtView.assign(xt);
+    auto cLastF = NDArrayFactory::create<double>('f', {batchSize, numUnits});
+    cLastF.assign(cLast);
+    auto yLastF = NDArrayFactory::create<double>('f', {batchSize, numUnits});
+    yLastF.assign(yLast);
+
+    ASSERT_NE(1, xtView.ews());
+    ASSERT_EQ('f', cLastF.ordering());
+
+    nd4j::ops::lstmBlockCell op;
+    auto fused   = op.execute({&xt, &cLast, &yLast, &W, &Wci, &Wcf, &Wco, &b}, {1.0, 0.9}, {1});
+    auto unfused = op.execute({&xtView, &cLastF, &yLastF, &W, &Wci, &Wcf, &Wco, &b}, {1.0, 0.9}, {1});
+
+    ASSERT_EQ(ND4J_STATUS_OK, fused->status());
+    ASSERT_EQ(ND4J_STATUS_OK, unfused->status());
+
+    for (int e = 0; e < 7; e++) {
+        ASSERT_TRUE(fused->at(e)->isSameShape(unfused->at(e)));
+        ASSERT_TRUE(fused->at(e)->equalsTo(unfused->at(e)));
+    }
+
+    delete fused;
+    delete unfused;
+}
@@ -163,6 +163,37 @@ TEST_F(DeclarableOpsTests3, Test_Unique_2) {
     delete result;
 }
 
+TEST_F(DeclarableOpsTests3, Test_Unique_3) {
+    // large enough for partitioned build, values are appearing in descending order
+    const Nd4jLong length = 200000;
+    const Nd4jLong numUnique = 1000;
+    auto x = NDArrayFactory::create<Nd4jLong>('c', {length});
+    for (Nd4jLong e = 0; e < length; e++)
+        x.p(e, numUnique - 1 - (e % numUnique));
+
+    nd4j::ops::unique_with_counts op;
+    auto result = op.execute({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto v = result->at(0);
+    auto i = result->at(1);
+    auto c = result->at(2);
+
+    ASSERT_EQ(numUnique, v->lengthOf());
+    ASSERT_EQ(length, i->lengthOf());
+
+    for (Nd4jLong e = 0; e < numUnique; e++) {
+        ASSERT_EQ(numUnique - 1 - e, v->e<Nd4jLong>(e));
+        ASSERT_EQ(length / numUnique, c->e<Nd4jLong>(e));
+    }
+
+    for (Nd4jLong e = 0; e < length; e++)
+        ASSERT_EQ(e % numUnique, i->e<Nd4jLong>(e));
+
+    delete result;
+}
+
 TEST_F(DeclarableOpsTests3, Test_Rint_1) {
     auto x= NDArrayFactory::create<float>('c', {1, 7}, {-1.7, -1.5, -0.2, 0.2, 1.5, 1.7, 2.0});
     auto exp= NDArrayFactory::create<float>('c', {1, 7}, {-2., -2., -0., 0., 2., 2., 2.});
@@ -1150,6 +1181,95 @@ TEST_F(DeclarableOpsTests3, gruCell_test3) {
     delete results;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests3, sruCell_test4) {
+
+    // same cell evaluated with c ordered contiguous inputs (fused gates) and with strided/'f' ordered inputs (fallback)
+    const int batchSize = 3;
+    const int inSize    = 5;
+
+    auto xt  = NDArrayFactory::create<float>('c', {batchSize, inSize});
+    auto ct_1= NDArrayFactory::create<float>('c', {batchSize, inSize});
+    auto w   = NDArrayFactory::create<float>('c', {inSize, 3*inSize});
+    auto b   = NDArrayFactory::create<float>('c', {2*inSize});
+
+    xt.linspace(-1., 0.1);
+    ct_1.linspace(0.5, -0.1);
+    w.linspace(-0.3, 0.01);
+    b.linspace(-0.2, 0.03);
+
+    auto xtBig = NDArrayFactory::create<float>('c', {batchSize, 2*inSize});
+    auto xtView = xtBig({0,0, inSize,2*inSize});
+    xtView.assign(xt);
+    auto ct_1F = NDArrayFactory::create<float>('f', {batchSize, inSize});
+    ct_1F.assign(ct_1);
+
+    ASSERT_NE(1, xtView.ews());
+    ASSERT_EQ('f', ct_1F.ordering());
+
+    nd4j::ops::sruCell op;
+    auto fused   = op.execute({&xt, &ct_1, &w, &b}, {}, {});
+    auto unfused = op.execute({&xtView, &ct_1F, &w, &b}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, fused->status());
+    ASSERT_EQ(ND4J_STATUS_OK, unfused->status());
+
+    for (int e = 0; e < 2; e++) {
+        ASSERT_TRUE(fused->at(e)->isSameShape(unfused->at(e)));
+        ASSERT_TRUE(fused->at(e)->equalsTo(unfused->at(e)));
+    }
+
+    delete fused;
+    delete unfused;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests3, gruCell_test4) {
+
+    // same cell evaluated with c ordered contiguous inputs (fused gates) and with strided/'f' ordered inputs (fallback)
+    const int batchSize = 3;
+    const int inSize    = 5;
+    const int numUnits  = 4;
+
+    auto xt    = NDArrayFactory::create<float>('c', {batchSize, inSize});
+    auto ht_1  = NDArrayFactory::create<float>('c', {batchSize, numUnits});
+    auto Wru   = NDArrayFactory::create<float>('c', {(inSize+numUnits), 2*numUnits});
+    auto Wc    = NDArrayFactory::create<float>('c', {(inSize+numUnits), numUnits});
+    auto bru   = NDArrayFactory::create<float>('c', {2*numUnits});
+    auto bc    = NDArrayFactory::create<float>('c', {numUnits});
+
+    xt.linspace(-1., 0.1);
+    ht_1.linspace(0.5, -0.1);
+    Wru.linspace(-0.3, 0.01);
+    Wc.linspace(0.2, -0.01);
+    bru.linspace(-0.2, 0.03);
+    bc.linspace(0.1, -0.03);
+
+    auto xtBig = NDArrayFactory::create<float>('c', {batchSize, 2*inSize});
+    auto xtView = xtBig({0,0, inSize,2*inSize});
+    xtView.assign(xt);
+    auto ht_1F = NDArrayFactory::create<float>('f', {batchSize, numUnits});
+    ht_1F.assign(ht_1);
+
+    ASSERT_NE(1, xtView.ews());
+    ASSERT_EQ('f', ht_1F.ordering());
+
+    nd4j::ops::gruCell op;
+    auto fused   = op.execute({&xt, &ht_1, &Wru, &Wc, &bru, &bc}, {}, {});
+    auto unfused = op.execute({&xtView, &ht_1F, &Wru, &Wc, &bru, &bc}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, fused->status());
+    ASSERT_EQ(ND4J_STATUS_OK, unfused->status());
+
+    for (int e = 0; e < 4; e++) {
+        ASSERT_TRUE(fused->at(e)->isSameShape(unfused->at(e)));
+        ASSERT_TRUE(fused->at(e)->equalsTo(unfused->at(e)));
+    }
+
+    delete fused;
+    delete unfused;
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests3, invertPermutation_test1) {
 
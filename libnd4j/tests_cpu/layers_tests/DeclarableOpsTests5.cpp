@@ -1136,6 +1136,62 @@ TEST_F(DeclarableOpsTests5, Test_TopK_5) {
     delete result;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_TopK_6) {
+    auto x = NDArrayFactory::create<double>('c', {2, 5}, {1.0, 5.0, 3.0, 5.0, 2.0, 7.0, 7.0, 7.0, 1.0, 7.0});
+    auto expV = NDArrayFactory::create<double>('c', {2, 3}, {5.0, 5.0, 3.0, 7.0, 7.0, 7.0});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {2, 3}, {1, 3, 2, 0, 1, 2});
+    auto expUV = NDArrayFactory::create<double>('c', {2, 3}, {5.0, 3.0, 5.0, 7.0, 7.0, 7.0});
+    auto expUI = NDArrayFactory::create<Nd4jLong>('c', {2, 3}, {1, 2, 3, 0, 1, 2});
+
+    nd4j::ops::top_k op;
+    auto result = op.execute({&x}, {}, {3}, {true});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    // equal values are ordered by index
+    ASSERT_TRUE(expV.equalsTo(result->at(0)));
+    ASSERT_TRUE(expI.equalsTo(result->at(1)));
+
+    auto unsorted = op.execute({&x}, {}, {3}, {false});
+    ASSERT_EQ(ND4J_STATUS_OK, unsorted->status());
+
+    ASSERT_TRUE(expUV.equalsTo(unsorted->at(0)));
+    ASSERT_TRUE(expUI.equalsTo(unsorted->at(1)));
+
+    delete result;
+    delete unsorted;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_TopK_7) {
+    const int width = 100000;
+    auto x = NDArrayFactory::create<float>('c', {3, width});
+    x.linspace(1.0);
+
+    // max values are placed in the middle of each row
+    for (int r = 0; r < 3; r++)
+        x.p(r * width + width / 2, 1e7f + r);
+
+    nd4j::ops::top_k op;
+    auto result = op.execute({&x}, {}, {4}, {true});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto v = result->at(0);
+    auto i = result->at(1);
+
+    for (int r = 0; r < 3; r++) {
+        ASSERT_NEAR(1e7f + r, v->e<float>(r, 0), 1e-1);
+        ASSERT_EQ(width / 2, i->e<Nd4jLong>(r, 0));
+
+        for (int j = 1; j < 4; j++) {
+            ASSERT_EQ(width - j, i->e<Nd4jLong>(r, j));
+            ASSERT_NEAR((float) (r * width + width - j + 1), v->e<float>(r, j), 1e-1);
+        }
+    }
+
+    delete result;
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests5, Test_InTopK_1) {
     auto x = NDArrayFactory::create<double>('c', {2, 3}, {1.0, 11.0, 3.0, 14.0, 5.0, 6.0});
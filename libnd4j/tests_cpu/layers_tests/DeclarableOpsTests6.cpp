@@ -2187,3 +2187,61 @@ TEST_F(DeclarableOpsTests6, concat_test14) {
     delete result;
 }
 
+
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, gru_test1) {
+
+    const int bS     = 3;
+    const int inSize = 5;
+    const int nU     = 4;
+    const int time   = 6;
+
+    auto x  = NDArrayFactory::create<double>('c', {time, bS, inSize});
+    auto h0 = NDArrayFactory::create<double>('c', {bS, nU});
+    auto Wx = NDArrayFactory::create<double>('c', {inSize, 3*nU});
+    auto Wh = NDArrayFactory::create<double>('c', {nU, 3*nU});
+    auto b  = NDArrayFactory::create<double>('c', {3*nU});
+
+    x.linspace(-0.5, 0.01);
+    h0.linspace(0.1, 0.05);
+    Wx.linspace(-0.3, 0.01);
+    Wh.linspace(0.2, -0.01);
+    b.linspace(0.1, 0.02);
+
+    nd4j::ops::gru op;
+    auto results = op.execute({&x, &h0, &Wx, &Wh, &b}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    auto h = results->at(0);
+
+    // reference: gruCell applied step by step, with weights concatenated as [x, h_1]
+    auto Wru = NDArrayFactory::create<double>('c', {inSize + nU, 2*nU});
+    auto Wc  = NDArrayFactory::create<double>('c', {inSize + nU, nU});
+    Wru({0,inSize, 0,0}, true).assign(Wx({0,0, 0,2*nU}, true));
+    Wru({inSize,inSize+nU, 0,0}, true).assign(Wh({0,0, 0,2*nU}, true));
+    Wc({0,inSize, 0,0}, true).assign(Wx({0,0, 2*nU,3*nU}, true));
+    Wc({inSize,inSize+nU, 0,0}, true).assign(Wh({0,0, 2*nU,3*nU}, true));
+    auto bru = b({0,2*nU}, true).dup('c');
+    auto bc  = b({2*nU,3*nU}, true).dup('c');
+
+    auto ht_1 = h0.dup('c');
+    nd4j::ops::gruCell cell;
+    for (int t = 0; t < time; t++) {
+        auto xt = x({t,t+1, 0,0, 0,0}).dup('c');
+        auto cellResults = cell.execute({xt, ht_1, &Wru, &Wc, bru, bc}, {}, {});
+        ASSERT_EQ(ND4J_STATUS_OK, cellResults->status());
+
+        auto ht = (*h)({t,t+1, 0,0, 0,0});
+        ASSERT_TRUE(cellResults->at(3)->equalsTo(&ht, 1e-5));
+
+        ht_1->assign(cellResults->at(3));
+
+        delete cellResults;
+        delete xt;
+    }
+
+    delete ht_1;
+    delete bru;
+    delete bc;
+    delete results;
+}
@@ -24,6 +24,9 @@
 #include <helpers/helper_hash.h>
 #include <NDArray.h>
 #include <array/NDArrayList.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 using namespace nd4j;
@@ -2052,6 +2055,320 @@ TEST_F(DeclarableOpsTests7, TestUnsortedSegmentProdBP_4) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestUnsortedSegmentMax_Large) {
+    const int numRows = 1000;
+    const int numCols = 64;
+    const int numClasses = 7;
+
+    auto x = NDArrayFactory::create<float>('c', {numRows, numCols});
+    auto idx = NDArrayFactory::create<int>('c', {numRows});
+    auto exp = NDArrayFactory::create<float>('c', {numClasses, numCols});
+
+    x.linspace(1);
+    for (int r = 0; r < numRows; r++)
+        idx.p(r, (r * 3) % numClasses);
+
+    exp.assign(-1.f);
+    for (int r = 0; r < numRows; r++)
+        for (int c = 0; c < numCols; c++) {
+            auto cls = idx.e<int>(r);
+            exp.p(cls, c, nd4j::math::nd4j_max<float>(exp.e<float>(cls, c), x.e<float>(r, c)));
+        }
+
+    nd4j::ops::unsorted_segment_max op;
+
+    auto result = op.execute({&x, &idx}, {}, {numClasses});
+    ASSERT_EQ(result->status(), Status::OK());
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// naive segment reduction over rows of x in their original order, op is one of "max", "min", "sum", "prod", "sqrt_n"
+template <typename T>
+static void segmentReference(NDArray& x, const std::vector<Nd4jLong>& ids, const std::string& op, const T emptyValue, NDArray& z) {
+    const Nd4jLong inner = x.lengthOf() / x.sizeAt(0);
+    const Nd4jLong numClasses = z.sizeAt(0);
+    auto xBuffer = x.bufferAsT<T>();
+    auto zBuffer = z.bufferAsT<T>();
+
+    std::vector<Nd4jLong> counts(numClasses, 0);
+    for (Nd4jLong e = 0; e < numClasses * inner; e++)
+        zBuffer[e] = emptyValue;
+
+    for (Nd4jLong r = 0; r < (Nd4jLong) ids.size(); r++) {
+        const auto c = ids[r];
+        for (Nd4jLong e = 0; e < inner; e++) {
+            const T v = xBuffer[r * inner + e];
+            T& acc = zBuffer[c * inner + e];
+
+            if (counts[c] == 0)
+                acc = v;
+            else if (op == "max")
+                acc = v > acc ? v : acc;
+            else if (op == "min")
+                acc = v < acc ? v : acc;
+            else if (op == "prod")
+                acc = static_cast<T>(acc * v);
+            else
+                acc = static_cast<T>(acc + v);
+        }
+        counts[c]++;
+    }
+
+    if (op == "sqrt_n")
+        for (Nd4jLong c = 0; c < numClasses; c++)
+            for (Nd4jLong e = 0; e < inner && counts[c] > 0; e++)
+                zBuffer[c * inner + e] = static_cast<T>(static_cast<double>(zBuffer[c * inner + e]) / std::sqrt(static_cast<double>(counts[c])));
+}
+
+// naive gradient of segment reduction wrt x, f is forward result and g is gradient wrt it
+template <typename T>
+static void segmentBPReference(NDArray& x, const std::vector<Nd4jLong>& ids, const std::string& op, NDArray& f, NDArray& g, NDArray& z) {
+    const Nd4jLong inner = x.lengthOf() / x.sizeAt(0);
+
+    std::vector<Nd4jLong> counts(g.sizeAt(0), 0);
+    for (auto c: ids)
+        counts[c]++;
+
+    for (Nd4jLong r = 0; r < (Nd4jLong) ids.size(); r++) {
+        const auto c = ids[r];
+        for (Nd4jLong e = 0; e < inner; e++) {
+            const T xv = x.bufferAsT<T>()[r * inner + e];
+            const T fv = f.bufferAsT<T>()[c * inner + e];
+            const T gv = g.bufferAsT<T>()[c * inner + e];
+            T& zv = z.bufferAsT<T>()[r * inner + e];
+
+            if (op == "max" || op == "min")
+                zv = xv == fv ? gv : static_cast<T>(0);
+            else if (op == "prod")
+                zv = static_cast<T>(fv * gv / xv);
+            else
+                zv = static_cast<T>(static_cast<double>(gv) / std::sqrt(static_cast<double>(counts[c])));
+        }
+    }
+}
+
+// fills array with non-monotonic pattern, values are in [offset - 504, offset + 504] * scale
+template <typename T>
+static void segmentPattern(NDArray& x, const double scale, const double offset) {
+    auto buffer = x.bufferAsT<T>();
+    for (Nd4jLong e = 0; e < x.lengthOf(); e++)
+        buffer[e] = static_cast<T>((offset + static_cast<double>((e * 7919) % 1009) - 504.) * scale);
+}
+
+static NDArray segmentIndices(const std::vector<Nd4jLong>& ids) {
+    auto idx = NDArrayFactory::create<Nd4jLong>('c', {(Nd4jLong) ids.size()});
+    for (Nd4jLong e = 0; e < (Nd4jLong) ids.size(); e++)
+        idx.p(e, ids[e]);
+
+    return idx;
+}
+
+static void checkSegmentOp(nd4j::ops::DeclarableOp& op, const std::vector<NDArray*>& inputs, const std::vector<Nd4jLong>& iArgs, NDArray& exp) {
+    auto result = op.execute(inputs, {}, iArgs);
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_TRUE(exp.isSameShape(result->at(0)));
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete result;
+}
+
+// sets number of OpenMP threads for the scope, so parallel branches of segment helpers are taken regardless of machine
+class SegmentThreadsScope {
+private:
+    int _threads;
+public:
+    explicit SegmentThreadsScope(int threads) {
+#ifdef _OPENMP
+        _threads = omp_get_max_threads();
+        omp_set_num_threads(threads);
+#endif
+    }
+
+    ~SegmentThreadsScope() {
+#ifdef _OPENMP
+        omp_set_num_threads(_threads);
+#endif
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestSegmentOps_InnerBlocks_1) {
+    // 3 segments for 4 threads and 4100 elements per row: inner dimension is split into blocks of uneven tail
+    SegmentThreadsScope threads(4);
+
+    auto x = NDArrayFactory::create<float>('c', {6, 2, 2050});
+    segmentPattern<float>(x, 0.125, 0.);
+
+    std::vector<Nd4jLong> sortedIds = {0, 0, 1, 1, 1, 2};
+    std::vector<Nd4jLong> unsortedIds = {2, 0, 2, 1, 0, 2};
+    auto sorted = segmentIndices(sortedIds);
+    auto unsorted = segmentIndices(unsortedIds);
+
+    auto exp = NDArrayFactory::create<float>('c', {3, 2, 2050});
+    nd4j::ops::segment_max opMax;
+    segmentReference<float>(x, sortedIds, "max", 0.f, exp);
+    checkSegmentOp(opMax, {&x, &sorted}, {}, exp);
+
+    nd4j::ops::segment_sum opSum;
+    segmentReference<float>(x, sortedIds, "sum", 0.f, exp);
+    checkSegmentOp(opSum, {&x, &sorted}, {}, exp);
+
+    nd4j::ops::unsorted_segment_sqrt_n opSqrtN;
+    segmentReference<float>(x, unsortedIds, "sqrt_n", 0.f, exp);
+    checkSegmentOp(opSqrtN, {&x, &unsorted}, {3}, exp);
+
+    // class 3 has no rows and gets lowest value
+    auto expEmpty = NDArrayFactory::create<float>('c', {4, 2, 2050});
+    nd4j::ops::unsorted_segment_max opUnsortedMax;
+    segmentReference<float>(x, unsortedIds, "max", -DataTypeUtils::max<float>(), expEmpty);
+    checkSegmentOp(opUnsortedMax, {&x, &unsorted}, {4}, expEmpty);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestSegmentOps_InnerBlocks_2) {
+    SegmentThreadsScope threads(4);
+
+    auto x = NDArrayFactory::create<int>('c', {5, 4096});
+    segmentPattern<int>(x, 1., 0.);
+
+    std::vector<Nd4jLong> sortedIds = {0, 1, 1, 1, 1};
+    std::vector<Nd4jLong> unsortedIds = {1, 0, 0, 1, 0};
+    auto sorted = segmentIndices(sortedIds);
+    auto unsorted = segmentIndices(unsortedIds);
+
+    auto exp = NDArrayFactory::create<int>('c', {2, 4096});
+    nd4j::ops::segment_min opMin;
+    segmentReference<int>(x, sortedIds, "min", 0, exp);
+    checkSegmentOp(opMin, {&x, &sorted}, {}, exp);
+
+    nd4j::ops::unsorted_segment_sum opSum;
+    segmentReference<int>(x, unsortedIds, "sum", 0, exp);
+    checkSegmentOp(opSum, {&x, &unsorted}, {2}, exp);
+
+    nd4j::ops::unsorted_segment_prod opProd;
+    segmentReference<int>(x, unsortedIds, "prod", 1, exp);
+    checkSegmentOp(opProd, {&x, &unsorted}, {2}, exp);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestSegmentOps_LongSorted_1) {
+    // sorted layout is built with 4 chunks of span rows each
+    SegmentThreadsScope threads(4);
+
+    const Nd4jLong numRows = 100003;
+    const Nd4jLong inner = 3;
+    const Nd4jLong span = numRows / 4 + 1;
+
+    auto x = NDArrayFactory::create<float>('c', {numRows, inner});
+    auto xi = NDArrayFactory::create<int>('c', {numRows, inner});
+    segmentPattern<float>(x, 0.5, 0.);
+    segmentPattern<int>(xi, 1., 0.);
+
+    // first variant starts new segment exactly at every chunk edge, second one has segments spanning over chunk edges
+    for (int variant = 0; variant < 2; variant++) {
+        std::vector<Nd4jLong> ids(numRows, 0);
+        Nd4jLong runLength = 0;
+        for (Nd4jLong r = 1; r < numRows; r++) {
+            bool boundary = ++runLength >= (r * 37) % 11 + 1;
+            if (r % span == 0)
+                boundary = variant == 0;
+            else if (variant == 1 && (r % span < 25 || span - r % span < 25))
+                boundary = false;
+
+            if (boundary)
+                runLength = 0;
+
+            ids[r] = ids[r - 1] + (boundary ? 1 : 0);
+        }
+
+        const Nd4jLong numClasses = ids[numRows - 1] + 1;
+        ASSERT_LT(20000, numClasses);
+
+        auto idx = segmentIndices(ids);
+        auto exp = NDArrayFactory::create<float>('c', {numClasses, inner});
+        auto expi = NDArrayFactory::create<int>('c', {numClasses, inner});
+
+        nd4j::ops::segment_sum opSum;
+        segmentReference<float>(x, ids, "sum", 0.f, exp);
+        checkSegmentOp(opSum, {&x, &idx}, {}, exp);
+
+        nd4j::ops::segment_min opMin;
+        segmentReference<float>(x, ids, "min", 0.f, exp);
+        checkSegmentOp(opMin, {&x, &idx}, {}, exp);
+
+        nd4j::ops::segment_max opMax;
+        segmentReference<int>(xi, ids, "max", 0, expi);
+        checkSegmentOp(opMax, {&xi, &idx}, {}, expi);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void checkSegmentBP(nd4j::DataType dtype) {
+    SegmentThreadsScope threads(4);
+
+    const Nd4jLong numRows = 300;
+    const Nd4jLong inner = 40;
+    const Nd4jLong numClasses = 13;
+
+    NDArray x('c', {numRows, inner}, dtype);
+    NDArray xProd('c', {numRows, inner}, dtype);
+    NDArray gradO('c', {numClasses, inner}, dtype);
+    NDArray f('c', {numClasses, inner}, dtype);
+    NDArray exp('c', {numRows, inner}, dtype);
+
+    segmentPattern<T>(x, 0.01, 0.);
+    // values close to 1, so products don't overflow or vanish
+    segmentPattern<T>(xProd, 0.0005, 2000.);
+    segmentPattern<T>(gradO, 0.1, 100.);
+
+    std::vector<Nd4jLong> sortedIds(numRows), unsortedIds(numRows);
+    for (Nd4jLong r = 0; r < numRows; r++) {
+        sortedIds[r] = r * numClasses / numRows;
+        unsortedIds[r] = (r * 7) % numClasses;
+    }
+    auto sorted = segmentIndices(sortedIds);
+    auto unsorted = segmentIndices(unsortedIds);
+
+    const std::vector<std::string> ops = {"max", "min", "prod"};
+    nd4j::ops::segment_max_bp opMax;
+    nd4j::ops::segment_min_bp opMin;
+    nd4j::ops::segment_prod_bp opProd;
+    nd4j::ops::unsorted_segment_max_bp opUnsortedMax;
+    nd4j::ops::unsorted_segment_min_bp opUnsortedMin;
+    nd4j::ops::unsorted_segment_prod_bp opUnsortedProd;
+    std::vector<nd4j::ops::DeclarableOp*> sortedOps = {&opMax, &opMin, &opProd};
+    std::vector<nd4j::ops::DeclarableOp*> unsortedOps = {&opUnsortedMax, &opUnsortedMin, &opUnsortedProd};
+
+    for (int e = 0; e < (int) ops.size(); e++) {
+        auto input = ops[e] == "prod" ? &xProd : &x;
+
+        segmentReference<T>(*input, sortedIds, ops[e], static_cast<T>(0), f);
+        segmentBPReference<T>(*input, sortedIds, ops[e], f, gradO, exp);
+        checkSegmentOp(*sortedOps[e], {input, &sorted, &gradO}, {}, exp);
+
+        segmentReference<T>(*input, unsortedIds, ops[e], static_cast<T>(0), f);
+        segmentBPReference<T>(*input, unsortedIds, ops[e], f, gradO, exp);
+        checkSegmentOp(*unsortedOps[e], {input, &unsorted, &gradO}, {numClasses}, exp);
+    }
+
+    nd4j::ops::unsorted_segment_sqrt_n_bp opSqrtN;
+    segmentBPReference<T>(x, unsortedIds, "sqrt_n", f, gradO, exp);
+    checkSegmentOp(opSqrtN, {&x, &unsorted, &gradO}, {numClasses}, exp);
+}
+
+TEST_F(DeclarableOpsTests7, TestSegmentOps_BP_1) {
+    checkSegmentBP<float>(nd4j::DataType::FLOAT32);
+}
+
+TEST_F(DeclarableOpsTests7, TestSegmentOps_BP_2) {
+    checkSegmentBP<double>(nd4j::DataType::DOUBLE);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests7, TestExtractImagePatches_1) {
     auto x = NDArrayFactory::create<double>('c', {2,4, 4, 4}, {
@@ -3519,6 +3836,48 @@ TEST_F(DeclarableOpsTests7, percentile_test12) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, percentile_test13) {
+
+    const int rows = 3, cols = 37;
+
+    auto input = NDArrayFactory::create<double>('c', {rows, cols});
+    for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < cols; ++j)
+            input.p(i * cols + j, static_cast<double>((j * 29 + i * 17) % 23) * (i + 1));
+
+    nd4j::ops::percentile op;
+
+    // (cols - 1) * q / 100 isn't integer for these q, so lower, higher and nearest differ
+    for (double q : {0., 10., 33., 50., 66., 90., 100.}) {
+        for (int interpolation = 0; interpolation < 3; ++interpolation) {
+            auto result = op.execute({&input}, {q, (double) interpolation, 0.}, {1});
+            ASSERT_EQ(ND4J_STATUS_OK, result->status());
+            auto output = result->at(0);
+            ASSERT_EQ(rows, output->lengthOf());
+
+            const double position = (cols - 1) * q / 100.;
+            int index = 0;
+            switch (interpolation) {
+                case 0: index = static_cast<int>(std::floor(position)); break;
+                case 1: index = static_cast<int>(std::ceil(position)); break;
+                case 2: index = static_cast<int>(std::round(position)); break;
+            }
+
+            for (int i = 0; i < rows; ++i) {
+                std::vector<double> row(cols);
+                for (int j = 0; j < cols; ++j)
+                    row[j] = input.e<double>(i * cols + j);
+                std::sort(row.begin(), row.end());
+
+                ASSERT_NEAR(row[index], output->e<double>(i), 1e-8);
+            }
+
+            delete result;
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests7, transpose_test3) {
 
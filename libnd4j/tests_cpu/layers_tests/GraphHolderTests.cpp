@@ -83,4 +83,53 @@ TEST_F(GraphHolderTests, SimpleTests_3) {
 
 
     delete graph2;
-}
\ No newline at end of file
+}
+TEST_F(GraphHolderTests, Versions_1) {
+    auto holder = GraphHolder::getInstance();
+    auto graphA = new Graph;
+    auto graphB = new Graph;
+    Nd4jLong graphId = 121;
+
+    holder->registerGraph(graphId, graphA);
+    auto pinned = holder->pinGraph(graphId);
+
+    holder->replaceGraph(graphId, graphB);
+
+    // in-flight request keeps using previous version, while new requests get the new one
+    ASSERT_EQ(graphA, pinned.get());
+    ASSERT_EQ(graphB, holder->pinGraph(graphId).get());
+    ASSERT_EQ(std::vector<Nd4jLong>({2L}), holder->versions(graphId));
+
+    // previous version is released here
+    pinned.reset();
+
+    holder->dropGraph(graphId);
+    ASSERT_FALSE(holder->hasGraph(graphId));
+}
+
+TEST_F(GraphHolderTests, Versions_2) {
+    auto holder = GraphHolder::getInstance();
+    auto graphA = new Graph;
+    auto graphB = new Graph;
+    Nd4jLong graphId = 123;
+
+    holder->setRetainedVersions(2);
+    holder->setNewestShare(25);
+
+    holder->registerGraph(graphId, graphA);
+    holder->replaceGraph(graphId, graphB);
+
+    ASSERT_EQ(std::vector<Nd4jLong>({2L, 1L}), holder->versions(graphId));
+    ASSERT_EQ(graphA, holder->pinGraph(graphId, 1L).get());
+
+    int newest = 0;
+    for (int e = 0; e < 100; e++)
+        if (holder->routeGraph(graphId).get() == graphB)
+            newest++;
+
+    ASSERT_EQ(25, newest);
+
+    holder->setRetainedVersions(1);
+    holder->setNewestShare(100);
+    holder->dropGraph(graphId);
+}
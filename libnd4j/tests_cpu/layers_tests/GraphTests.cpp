@@ -25,6 +25,9 @@
 #include <graph/Node.h>
 #include <graph/Graph.h>
 #include <graph/GraphUtils.h>
+#include <graph/VariableProxy.h>
+#include <graph/MemoryPlanner.h>
+#include <graph/execution/LogicNextIteration.h>
 #include <NDArray.h>
 #include <ops/declarable/DeclarableOp.h>
 #include <ops/declarable/generic/parity_ops.cpp>
@@ -332,6 +335,93 @@ TEST_F(GraphTests, QuadInput1) {
     delete graph;
 }
 
+TEST_F(GraphTests, QuadInput2) {
+    auto graph = new Graph();
+    graph->getExecutorConfiguration()->_executionMode = ExecutionMode_AUTO;
+
+    auto x0 = NDArrayFactory::create_<float>('c', {5, 5});
+    x0->assign(0.0);
+
+    auto x1 = NDArrayFactory::create_<float>('c', {5, 5});
+    x1->assign(-1.0);
+
+    auto x2 = NDArrayFactory::create_<float>('c', {5, 5});
+    x2->assign(-2.0);
+
+    auto x3 = NDArrayFactory::create_<float>('c', {5, 5});
+    x3->assign(-3.0);
+
+    auto z = NDArrayFactory::create_<float>('c', {5, 5});
+    z->assign(119.0);
+
+    graph->getVariableSpace()->putVariable(-1, x0);
+    graph->getVariableSpace()->putVariable(-2, x1);
+    graph->getVariableSpace()->putVariable(-3, x2);
+    graph->getVariableSpace()->putVariable(-4, x3);
+    graph->getVariableSpace()->putVariable(-5, z);
+
+    // first two layers are executed concurrently in AUTO mode
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {11});
+    auto nodeB = new Node(OpType_TRANSFORM_SAME, transform::Abs, 2, {-2}, {11});
+    auto nodeC = new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {-3}, {21});
+    auto nodeD = new Node(OpType_TRANSFORM_SAME, transform::Abs, 4, {-4}, {21});
+
+    auto nodeP1 = new Node(OpType_PAIRWISE, pairwise::Add, 11, {1, 2}, {31});
+    auto nodeP2 = new Node(OpType_PAIRWISE, pairwise::Add, 21, {3, 4}, {31});
+
+    auto nodeZ = new Node(OpType_PAIRWISE, pairwise::Add, 31, {11, 21}, {-5});
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+    graph->addNode(nodeC);
+    graph->addNode(nodeD);
+    graph->addNode(nodeP1);
+    graph->addNode(nodeP2);
+    graph->addNode(nodeZ);
+
+    ASSERT_EQ(4, graph->rootNodes());
+    ASSERT_EQ(7, graph->totalNodes());
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+
+    ASSERT_NEAR(3.0, graph->getVariableSpace()->getVariable(21)->getNDArray()->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+    ASSERT_NEAR(6.0, z->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+
+    delete graph;
+}
+
+TEST_F(GraphTests, QuadInput3) {
+    auto graph = new Graph();
+    graph->getExecutorConfiguration()->_executionMode = ExecutionMode_AUTO;
+
+    // first layer alone has 4 nodes, so limit is exceeded before it's executed
+    graph->getExecutorConfiguration()->_maxSteps = 3;
+
+    auto z = NDArrayFactory::create_<float>('c', {5, 5});
+    z->assign(119.0);
+
+    for (int e = 1; e <= 4; e++) {
+        auto x = NDArrayFactory::create_<float>('c', {5, 5});
+        x->assign(-e);
+        graph->getVariableSpace()->putVariable(-e, x);
+    }
+    graph->getVariableSpace()->putVariable(-5, z);
+
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {11}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 2, {-2}, {11}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {-3}, {21}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 4, {-4}, {21}));
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 11, {1, 2}, {31}));
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 21, {3, 4}, {31}));
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 31, {11, 21}, {-5}));
+
+    ASSERT_THROW(GraphExecutioner::execute(graph), std::runtime_error);
+
+    ASSERT_NEAR(119.0, z->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+
+    delete graph;
+}
+
 TEST_F(GraphTests, InternalBranching1) {
     auto graph = new Graph();
 
@@ -1602,6 +1692,240 @@ TEST_F(GraphTests, Test_Inplace_Outputs_2) {
 #endif
 }
 
+TEST_F(GraphTests, MemoryPlanner_1) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {5, 5});
+    x->assign(-2.0f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // plain chain: each output is used by the next node only, so 2 buffers are enough for the whole graph
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2}));
+    graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 2, {1}, {3}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {2}, {4}));
+    graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 4, {3}, {5}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 5, {4}, {6}));
+    graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 6, {5}, {}));
+
+    MemoryPlanner::getInstance()->clear();
+    Environment::getInstance()->setUseMemoryPlanner(true);
+
+    NDArray* exp = nullptr;
+    for (int e = 0; e < 3; e++) {
+        VariableProxy proxy(graph->getVariableSpace());
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph, &proxy));
+        ASSERT_TRUE(proxy.hasVariable(6));
+
+        auto z = proxy.getVariable(6)->getNDArray();
+        if (e == 0)
+            exp = z->dup();
+        else
+            ASSERT_EQ(*exp, *z);
+    }
+
+    auto plan = MemoryPlanner::getInstance()->getPlan(graph->hashCode(), MemoryPlanner::signature(graph, graph->getVariableSpace()));
+    ASSERT_TRUE(plan != nullptr);
+
+    // 5x5 floats take 100 bytes, aligned to 128
+    ASSERT_EQ(6, plan->numberOfSlots());
+    ASSERT_EQ(6 * 128, plan->totalBytes());
+    ASSERT_EQ(2 * 128, plan->arenaSize());
+
+    MemoryPlanner::getInstance()->clear();
+    Environment::getInstance()->setUseMemoryPlanner(false);
+
+    delete exp;
+    delete graph;
+}
+
+TEST_F(GraphTests, MemoryPlanner_2) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {5, 5});
+    x->assign(-2.0f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // output of node 1 stays alive till the last node, so its memory can't be reused
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2, 5}));
+    graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 2, {1}, {3}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {2}, {4}));
+    graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 4, {3}, {5}));
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 5, {1, 4}, {}));
+
+    MemoryPlanner::getInstance()->clear();
+    Environment::getInstance()->setUseMemoryPlanner(true);
+
+    NDArray* exp = nullptr;
+    for (int e = 0; e < 2; e++) {
+        VariableProxy proxy(graph->getVariableSpace());
+
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph, &proxy));
+
+        auto z = proxy.getVariable(5)->getNDArray();
+        if (e == 0)
+            exp = z->dup();
+        else
+            ASSERT_EQ(*exp, *z);
+    }
+
+    auto plan = MemoryPlanner::getInstance()->getPlan(graph->hashCode(), MemoryPlanner::signature(graph, graph->getVariableSpace()));
+    ASSERT_TRUE(plan != nullptr);
+    ASSERT_EQ(5, plan->numberOfSlots());
+
+    auto first = plan->slot(1, 0);
+    for (int e = 2; e <= 5; e++)
+        ASSERT_NE(first->offset, plan->slot(e, 0)->offset);
+
+    ASSERT_EQ(3 * 128, plan->arenaSize());
+
+    MemoryPlanner::getInstance()->clear();
+    Environment::getInstance()->setUseMemoryPlanner(false);
+
+    delete exp;
+    delete graph;
+}
+
+TEST_F(GraphTests, MemoryPlanner_3) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {5, 5});
+    x->assign(-2.0f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2}));
+    graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 2, {1}, {}));
+
+    MemoryPlanner::getInstance()->clear();
+
+    // planner is disabled by default, so nothing gets recorded
+    ASSERT_FALSE(Environment::getInstance()->isUseMemoryPlanner());
+    for (int e = 0; e < 2; e++) {
+        VariableProxy proxy(graph->getVariableSpace());
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph, &proxy));
+    }
+
+    ASSERT_TRUE(MemoryPlanner::getInstance()->getPlan(graph->hashCode(), MemoryPlanner::signature(graph, graph->getVariableSpace())) == nullptr);
+
+    delete graph;
+}
+
+static Graph* buildCounterLoop(float limit) {
+    // while (x < limit) x += 1; expressed with Enter/Merge/LoopCond/Switch/NextIteration/Exit nodes
+    auto graph = new Graph();
+    auto variableSpace = graph->getVariableSpace();
+
+    variableSpace->putVariable(-1, NDArrayFactory::create_<float>(0.f));
+    variableSpace->putVariable(-2, NDArrayFactory::create_<float>(limit));
+    variableSpace->putVariable(-3, NDArrayFactory::create_<float>(1.f));
+
+    auto enterX = new Node(OpType_LOGIC, logic::Enter, 1, {-1});
+    auto enterLimit = new Node(OpType_LOGIC, logic::Enter, 2, {-2});
+    auto enterStep = new Node(OpType_LOGIC, logic::Enter, 3, {-3});
+    enterX->setFrameId(119);
+    enterLimit->setFrameId(119);
+    enterStep->setFrameId(119);
+
+    auto merge = new Node(OpType_LOGIC, logic::Merge, 4, {1, 9});
+
+    static nd4j::ops::less lessOp;
+    auto cond = new Node(&lessOp, 5, {4, 2});
+
+    auto loopCond = new Node(OpType_LOGIC, logic::LoopCond, 6, {5});
+    auto nodeSwitch = new Node(OpType_LOGIC, logic::Switch, 7, {4, 6});
+
+    static nd4j::ops::add addOp;
+    auto body = new Node(&addOp, 8, {});
+    body->pickInput(7, 1);
+    body->pickInput(3, 0);
+
+    auto nextIteration = new Node(OpType_LOGIC, logic::NextIteration, 9, {8});
+
+    auto exit = new Node(OpType_LOGIC, logic::Exit, 10, {});
+    exit->pickInput(7, 0);
+
+    graph->addNode(enterX);
+    graph->addNode(enterLimit);
+    graph->addNode(enterStep);
+    graph->addNode(merge);
+    graph->addNode(cond);
+    graph->addNode(loopCond);
+    graph->addNode(nodeSwitch);
+    graph->addNode(body);
+    graph->addNode(nextIteration);
+    graph->addNode(exit);
+
+    return graph;
+}
+
+TEST_F(GraphTests, Loop_Unbounded_1) {
+    // way more steps than old hardcoded limit of 10000 steps
+    auto graph = buildCounterLoop(20000.f);
+
+    FlowPath flowPath;
+    graph->getVariableSpace()->setFlowPath(&flowPath);
+
+    auto status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    auto z = graph->getVariableSpace()->getVariable(10)->getNDArray();
+    ASSERT_NEAR(20000.f, z->e<float>(0), 1e-5);
+
+    // loop body is everything between Merge and NextIteration, with Exit node
+    auto schedule = flowPath.frameSchedule(119);
+    ASSERT_TRUE(schedule != nullptr);
+    ASSERT_EQ(graph->nodeById(4)->getLayer(), schedule->firstLayer());
+    ASSERT_EQ(graph->nodeById(9)->getLayer(), schedule->lastLayer());
+
+    delete graph;
+}
+
+TEST_F(GraphTests, Loop_Limit_1) {
+    auto graph = buildCounterLoop(1000.f);
+    graph->getExecutorConfiguration()->_maxIterations = 100;
+
+    FlowPath flowPath;
+    graph->getVariableSpace()->setFlowPath(&flowPath);
+
+    ASSERT_ANY_THROW(GraphExecutioner::execute(graph));
+
+    delete graph;
+}
+
+TEST_F(GraphTests, NextIteration_Empty_1) {
+    auto graph = new Graph();
+    auto variableSpace = graph->getVariableSpace();
+    auto x = NDArrayFactory::create_<float>('c', {3}, {1.f, 2.f, 3.f});
+    auto empty = NDArrayFactory::empty_<float>();
+
+    variableSpace->putVariable(-1, x);
+    variableSpace->putVariable(-2, empty);
+
+    auto node = new Node(OpType_LOGIC, logic::NextIteration, 1, {-1});
+    graph->addNode(node);
+
+    // first pass copies value into buffer owned by the node, second one fills the spare buffer
+    ASSERT_EQ(Status::OK(), LogicNextIeration::processNode(graph, node, variableSpace));
+    ASSERT_EQ(Status::OK(), LogicNextIeration::processNode(graph, node, variableSpace));
+
+    auto value = variableSpace->getVariable(1, 0);
+    ASSERT_NE(x, value->getNDArray());
+    ASSERT_EQ(*x, *value->getNDArray());
+    ASSERT_TRUE(variableSpace->getVariable(1, 1)->hasNDArray());
+
+    // empty input releases both owned buffers and is just passed through
+    node->input()->at(0) = std::pair<int, int>(-2, 0);
+    ASSERT_EQ(Status::OK(), LogicNextIeration::processNode(graph, node, variableSpace));
+
+    ASSERT_EQ(empty, value->getNDArray());
+    ASSERT_TRUE(value->isReadOnly());
+    ASSERT_FALSE(variableSpace->getVariable(1, 1)->hasNDArray());
+
+    delete graph;
+}
+
 TEST_F(GraphTests, Test_Minifier_1) {
     // run preprocessor to produce single header
     // if all ok - return value is 0, if error - non-zero value will be returned
@@ -25,7 +25,9 @@
 #include <ops/declarable/helpers/activations.h>
 #include <ops/declarable/helpers/rnn.h>
 #include <ops/declarable/helpers/sg_cb.h>
+#include <helpers/Selection.h>
 #include <MmulHelper.h>
+#include <ops/gemm.h>
 #include <GradCheck.h>
 #include <ops/declarable/CustomOperations.h>
 
@@ -2055,4 +2057,241 @@ TEST_F(HelpersTests1, mmulMxV_7) {
 
     nd4j::MmulHelper::mmul(&a, &x, &y, 1., 0.);    
     ASSERT_TRUE(y.equalsTo(&exp));    
-}
\ No newline at end of file
+}
+////////////////////////////////////////////////////////////////////
+// element (i, j) of op(A), where A is stored with leading dimension ld
+template <typename T>
+static double gemmElement(const std::vector<T>& a, const bool colMajor, const bool trans, const int ld, const int i, const int j) {
+    const int r = trans ? j : i;
+    const int c = trans ? i : j;
+    return static_cast<double>(colMajor ? a[r + (Nd4jLong) c * ld] : a[(Nd4jLong) r * ld + c]);
+}
+
+// small integers, so sums stay exact even in half precision
+template <typename T>
+static std::vector<T> gemmPattern(const Nd4jLong length, const int seed) {
+    std::vector<T> result(length);
+    for (Nd4jLong e = 0; e < length; e++)
+        result[e] = static_cast<T>(static_cast<int>((e * 7919 + seed * 104729) % 5) - 2);
+
+    return result;
+}
+
+// compares generic GEMM against naive triple loop, with leading dimensions larger than matrices, so padding has to stay untouched
+template <typename T>
+static void checkGemm(const int M, const int N, const int K) {
+    const double alpha = 1.5;
+    const double beta = -0.5;
+
+    for (int colMajor = 0; colMajor < 2; colMajor++)
+        for (int transA = 0; transA < 2; transA++)
+            for (int transB = 0; transB < 2; transB++) {
+                // stored A is aRows x aCols, B is bRows x bCols
+                const int aRows = transA ? K : M, aCols = transA ? M : K;
+                const int bRows = transB ? N : K, bCols = transB ? K : N;
+
+                const int lda = (colMajor ? aRows : aCols) + 3;
+                const int ldb = (colMajor ? bRows : bCols) + 5;
+                const int ldc = (colMajor ? M : N) + 2;
+
+                auto a = gemmPattern<T>((Nd4jLong) lda * (colMajor ? aCols : aRows), 1);
+                auto b = gemmPattern<T>((Nd4jLong) ldb * (colMajor ? bCols : bRows), 2);
+                auto c = gemmPattern<T>((Nd4jLong) ldc * (colMajor ? N : M), 3);
+                auto c0 = c;
+
+                nd4j::blas::GEMM<T, T, T>::op(colMajor ? CblasColMajor : CblasRowMajor, transA ? CblasTrans : CblasNoTrans, transB ? CblasTrans : CblasNoTrans,
+                                              M, N, K, alpha, a.data(), lda, b.data(), ldb, beta, c.data(), ldc);
+
+                for (int i = 0; i < M; i++)
+                    for (int j = 0; j < N; j++) {
+                        double sum = 0.;
+                        for (int p = 0; p < K; p++)
+                            sum += gemmElement(a, colMajor, transA, lda, i, p) * gemmElement(b, colMajor, transB, ldb, p, j);
+
+                        const double exp = alpha * sum + beta * gemmElement(c0, colMajor, false, ldc, i, j);
+                        ASSERT_NEAR(exp, gemmElement(c, colMajor, false, ldc, i, j), 1e-4 * (1. + std::abs(exp))) << "order " << colMajor << ", transA " << transA << ", transB " << transB << ", at " << i << ":" << j;
+                    }
+
+                // padding between rows/columns of C
+                for (Nd4jLong e = 0; e < (Nd4jLong) c.size(); e++)
+                    if (e % ldc >= (colMajor ? M : N))
+                        ASSERT_EQ(c0[e], c[e]);
+            }
+}
+
+// compares generic GEMV against naive loop, with lda larger than M and strided x and y
+template <typename T>
+static void checkGemv(const int M, const int N) {
+    const double alpha = 2.;
+    const double beta = 0.5;
+    const int lda = M + 7;
+    const int incx = 2;
+    const int incy = 3;
+
+    for (int trans = 0; trans < 2; trans++) {
+        const int xLength = trans ? M : N;
+        const int yLength = trans ? N : M;
+
+        auto a = gemmPattern<T>((Nd4jLong) lda * N, 4);
+        auto x = gemmPattern<T>((Nd4jLong) xLength * incx, 5);
+        auto y = gemmPattern<T>((Nd4jLong) yLength * incy, 6);
+        auto y0 = y;
+
+        nd4j::blas::GEMV<T, T, T>::op(trans ? CblasTrans : CblasNoTrans, M, N, alpha, a.data(), lda, x.data(), incx, beta, y.data(), incy);
+
+        for (int i = 0; i < yLength; i++) {
+            double sum = 0.;
+            for (int p = 0; p < xLength; p++)
+                sum += gemmElement(a, true, trans, lda, i, p) * static_cast<double>(x[p * incx]);
+
+            const double exp = alpha * sum + beta * static_cast<double>(y0[i * incy]);
+            ASSERT_NEAR(exp, static_cast<double>(y[i * incy]), 1e-4 * (1. + std::abs(exp))) << "trans " << trans << ", at " << i;
+        }
+
+        for (int e = 0; e < (int) y.size(); e++)
+            if (e % incy != 0)
+                ASSERT_EQ(y0[e], y[e]);
+    }
+}
+
+// naive reference for MmulHelper, computed through e<double>() so any order and type of arrays is supported
+static void mmulReference(const NDArray& x, const NDArray& y, NDArray& z, const double alpha, const double beta) {
+    const Nd4jLong M = x.sizeAt(0), K = x.sizeAt(1), N = y.sizeAt(1);
+    for (Nd4jLong i = 0; i < M; i++)
+        for (Nd4jLong j = 0; j < N; j++) {
+            double sum = 0.;
+            for (Nd4jLong p = 0; p < K; p++)
+                sum += x.e<double>(i, p) * y.e<double>(p, j);
+
+            z.p(i, j, alpha * sum + beta * z.e<double>(i, j));
+        }
+}
+
+static void fillPattern(NDArray& arr, const int seed) {
+    for (Nd4jLong e = 0; e < arr.lengthOf(); e++)
+        arr.p(e, static_cast<int>((e * 7919 + seed * 104729) % 5) - 2);
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulHelper_test_8) {
+
+    // larger than single cache block in both M and K, and not multiple of micro-kernel tile
+    NDArray x('c', {131, 300}, nd4j::DataType::HALF);
+    NDArray y('f', {300, 13}, nd4j::DataType::HALF);
+    NDArray z('c', {131, 13}, nd4j::DataType::HALF);
+    fillPattern(x, 1);
+    fillPattern(y, 2);
+    fillPattern(z, 3);
+
+    auto exp = z.dup();
+    mmulReference(x, y, *exp, 2., 0.5);
+
+    MmulHelper::mmul(&x, &y, &z, 2., 0.5);
+    ASSERT_TRUE(exp->equalsTo(&z));
+
+    // transposed views as operands
+    auto xT = x.transp();
+    auto yT = y.transp();
+    NDArray zT('f', {13, 131}, nd4j::DataType::HALF);
+    fillPattern(zT, 4);
+
+    auto expT = zT.dup();
+    mmulReference(yT, xT, *expT, 1., -1.);
+
+    MmulHelper::mmul(&yT, &xT, &zT, 1., -1.);
+    ASSERT_TRUE(expT->equalsTo(&zT));
+
+    delete exp;
+    delete expT;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulHelper_test_9) {
+
+    // mixed types go through generic gemm
+    NDArray x('c', {3, 4}, nd4j::DataType::INT32);
+    NDArray y('c', {4, 5}, nd4j::DataType::FLOAT32);
+    NDArray z('f', {3, 5}, nd4j::DataType::FLOAT32);
+    x.linspace(1);
+    y.linspace(1);
+    z.assign(1.);
+
+    NDArray exp('c', {3, 5}, {110.,120.,130.,140.,150.,246.,272.,298.,324.,350.,382.,424.,466.,508.,550.}, nd4j::DataType::FLOAT32);
+    exp *= 2.;
+    exp += 0.5;
+
+    MmulHelper::mmul(&x, &y, &z, 2., 0.5);
+    ASSERT_TRUE(exp.equalsTo(&z));
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulMxV_8) {
+
+    // more rows than single block of generic gemv
+    const Nd4jLong M = 300;
+    const Nd4jLong N = 7;
+
+    NDArray a('c', {M,N}, nd4j::DataType::HALF);
+    NDArray x('c', {N}, nd4j::DataType::HALF);
+    NDArray y('c', {M}, nd4j::DataType::HALF);
+    fillPattern(a, 1);
+    fillPattern(x, 2);
+    fillPattern(y, 3);
+
+    auto af = a.dup('f');
+    NDArray exp('c', {M}, nd4j::DataType::HALF);
+
+    // both orders of matrix, with and without beta
+    for (int e = 0; e < 2; e++) {
+        const double alpha = e == 0 ? 1. : 2.;
+        const double beta = e == 0 ? 0. : -1.;
+
+        for (Nd4jLong i = 0; i < M; i++) {
+            double sum = 0.;
+            for (Nd4jLong p = 0; p < N; p++)
+                sum += a.e<double>(i, p) * x.e<double>(p);
+
+            exp.p(i, alpha * sum + beta * y.e<double>(i));
+        }
+
+        nd4j::MmulHelper::mmul(e == 0 ? &a : af, &x, &y, alpha, beta);
+        ASSERT_TRUE(exp.equalsTo(&y));
+    }
+
+    delete af;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, gemm_generic_1) {
+    // M crosses MC, K crosses KC, edges of MR x NR tile in both dimensions
+    checkGemm<double>(131, 13, 300);
+    checkGemm<double>(9, 133, 513);
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, gemm_generic_2) {
+    checkGemm<float>(257, 17, 260);
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, gemv_generic_1) {
+    checkGemv<double>(300, 7);
+    checkGemv<float>(131, 260);
+}
+
+///////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, selection_select_1) {
+
+    const Nd4jLong len = 1001;
+    std::vector<float> x(len);
+    for (Nd4jLong e = 0; e < len; e++)
+        x[e] = static_cast<float>((e * 389) % 97) - 40.f;        // with duplicates
+
+    auto sorted = x;
+    std::sort(sorted.begin(), sorted.end());
+
+    for (Nd4jLong position : {0, 1, 100, 250, 500, 501, 750, 999, 1000}) {
+        auto buffer = x;
+        ASSERT_EQ(sorted[position], nd4j::Selection<float>::select(buffer.data(), len, position));
+    }
+}
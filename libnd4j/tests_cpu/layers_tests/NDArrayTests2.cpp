@@ -22,6 +22,7 @@
 #include <memory>
 #include <NDArray.h>
 #include <DebugHelper.h>
+#include <helpers/ElementwiseChain.h>
 #include <ops/declarable/headers/parity_ops.h>
 
 using namespace nd4j;
@@ -1203,3 +1204,164 @@ TEST_F(NDArrayTest2, test_long_sum_1) {
     z.printIndexedBuffer("z long");
 }
 
+
+TEST_F(NDArrayTest2, test_temporary_operands_1) {
+    auto a = NDArrayFactory::create<float>('c', {2, 3}, {1, 2, 3, 4, 5, 6});
+    auto b = NDArrayFactory::create<float>('c', {2, 3}, {2, 2, 2, 2, 2, 2});
+    auto c = NDArrayFactory::create<float>('c', {2, 3}, {1, 0, 1, 0, 1, 0});
+    auto e = NDArrayFactory::create<float>('c', {2, 3}, {-2.f, 0.f, -2.f, 0.f, -2.f, 0.f});
+
+    // every intermediate here is temporary, so its buffer is reused
+    auto t = a * b;
+    auto buffer = t.getBuffer();
+    auto z = -(std::move(t) - c * b) / 2.f + (a - b * c * 2.f + c);
+
+    ASSERT_EQ(buffer, z.getBuffer());
+    ASSERT_EQ(e, z);
+
+    // views must never be overwritten
+    auto row = a({0,1, 0,0}, true);
+    auto r = a({1,2, 0,0}, true) * 2.f;
+
+    ASSERT_EQ(NDArrayFactory::create<float>('c', {1, 3}, {8, 10, 12}), r);
+    ASSERT_EQ(NDArrayFactory::create<float>('c', {1, 3}, {1, 2, 3}), row);
+    ASSERT_EQ(NDArrayFactory::create<float>('c', {2, 3}, {1, 2, 3, 4, 5, 6}), a);
+}
+
+TEST_F(NDArrayTest2, test_temporary_operands_2) {
+    auto a = NDArrayFactory::create<float>('c', {2, 3}, {1, 2, 3, 4, 5, 6});
+    auto x = NDArrayFactory::create<bool>('c', {2, 3}, {true, true, true, true, true, true});
+    auto y = NDArrayFactory::create<bool>('c', {2, 3}, {true, false, true, false, true, false});
+
+    // division by bool array is never allowed, even if temporary could be reused
+    ASSERT_ANY_THROW(a * 2.f / y);
+    ASSERT_ANY_THROW(NDArray(x) / y);
+    ASSERT_ANY_THROW(y / NDArray(x));
+    ASSERT_ANY_THROW(NDArray(x) / NDArray(x));
+}
+
+TEST_F(NDArrayTest2, test_temporary_operands_3) {
+    auto a = NDArrayFactory::create<float>('c', {2, 3}, {1, 2, 3, 4, 5, 6});
+    auto row = NDArrayFactory::create<float>('c', {1, 3}, {1, 2, 3});
+    auto e = NDArrayFactory::create<float>('c', {2, 3}, {3, 6, 9, 9, 12, 15});
+
+    // broadcastable temporaries can't hold result, so new array is allocated
+    auto t = row * 2.f;
+    auto buffer = t.getBuffer();
+    auto z = std::move(t) + a;
+
+    ASSERT_NE(buffer, z.getBuffer());
+    ASSERT_EQ(e, z);
+    ASSERT_EQ(e, a + row * 2.f);
+    ASSERT_EQ(e, a * 1.f + row * 2.f);
+    ASSERT_EQ(NDArrayFactory::create<float>('c', {2, 3}, {1, 1, 1, 4, 2.5, 2}), a / (row * 1.f));
+}
+
+// fills rows of x with values of different magnitude, and compares reductions along last dimension with double precision reference, using relative tolerance eps
+static void checkLongTadReductions(NDArray &x, double eps) {
+    const Nd4jLong rows = x.sizeAt(0);
+    const Nd4jLong cols = x.sizeAt(1);
+    auto buffer = x.bufferAsT<float>();
+
+    for (Nd4jLong i = 0; i < rows; i++) {
+        for (Nd4jLong j = 0; j < cols; j++)
+            buffer[i * cols + j] = (1.f + (float) ((j * 7919 + i * 13) % 1000) / 1000.f) * (i % 2 == 0 ? 1.f : -1.5f);
+
+        // single max element per row
+        buffer[i * cols + (cols * 3) / 4 + i] = 10.f;
+    }
+
+    auto sum = x.reduceAlongDims(reduce::Sum, {1});
+    auto mean = x.reduceAlongDims(reduce::Mean, {1});
+    auto max = x.reduceAlongDims(reduce::Max, {1});
+    auto norm2 = x.reduceAlongDims(reduce::Norm2, {1});
+    auto imax = x.applyIndexReduce(indexreduce::IndexMax, {1});
+
+    ASSERT_EQ(rows, sum.lengthOf());
+    ASSERT_EQ(rows, imax->lengthOf());
+
+    for (Nd4jLong i = 0; i < rows; i++) {
+        double eSum = 0., eSquares = 0., eMax = -1e10;
+        Nd4jLong eIndex = 0;
+        for (Nd4jLong j = 0; j < cols; j++) {
+            double v = buffer[i * cols + j];
+            eSum += v;
+            eSquares += v * v;
+            if (v > eMax) {
+                eMax = v;
+                eIndex = j;
+            }
+        }
+
+        ASSERT_NEAR(eSum, sum.e<double>(i), eps * std::abs(eSum));
+        ASSERT_NEAR(eSum / cols, mean.e<double>(i), eps * std::abs(eSum / cols));
+        ASSERT_NEAR(eMax, max.e<double>(i), 1e-6);
+        ASSERT_NEAR(std::sqrt(eSquares), norm2.e<double>(i), eps * std::sqrt(eSquares));
+        ASSERT_EQ(eIndex, imax->e<Nd4jLong>(i));
+    }
+
+    delete imax;
+}
+
+TEST_F(NDArrayTest2, test_long_tad_reduce_1) {
+    // few long TADs, so each of them is split between threads
+    auto x = NDArrayFactory::create<float>('c', {2, 100000});
+    checkLongTadReductions(x, 1e-5);
+}
+
+TEST_F(NDArrayTest2, test_long_tad_reduce_2) {
+    // single output goes through scalar reduction, which accumulates sequentially within each thread
+    auto x = NDArrayFactory::create<float>('c', {1, 1 << 20});
+    checkLongTadReductions(x, 1e-4);
+}
+
+TEST_F(NDArrayTest2, test_elementwise_chain_1) {
+    // length isn't multiple of block size, so the last block is partial
+    auto x = NDArrayFactory::create<float>('c', {3, 1000});
+    auto y = NDArrayFactory::create<float>('c', {3, 1000});
+    auto w = NDArrayFactory::create<float>('c', {3, 1000});
+    x.linspace(-1.f, 0.0007f);
+    y.linspace(0.5f, 0.0003f);
+    w.linspace(2.f, -0.0001f);
+
+    ElementwiseChain chain(x);
+    chain.apply(pairwise::Multiply, y).apply(scalar::ReverseSubtract, 1.).apply(transform::Tanh).apply(pairwise::Add, w).apply(transform::Square).apply(pairwise::Divide, w);
+
+    auto z = NDArrayFactory::create<float>('c', {3, 1000});
+    ASSERT_TRUE(chain.isFused(z));
+
+    chain.execute(z);
+
+    auto exp = ((1.f - x * y).transform(transform::Tanh) + w).transform(transform::Square) / w;
+    ASSERT_TRUE(exp.equalsTo(z));
+    ASSERT_TRUE(exp.equalsTo(chain.evaluate()));
+
+    // output may be one of operands
+    chain.execute(w);
+    ASSERT_TRUE(exp.equalsTo(w));
+}
+
+TEST_F(NDArrayTest2, test_elementwise_chain_2) {
+    auto x = NDArrayFactory::create<double>('c', {4, 6});
+    auto y = NDArrayFactory::create<double>('c', {6, 4});
+    x.linspace(1.);
+    y.linspace(3., 0.5);
+
+    // operand with different order and int arrays aren't fused, ops are executed one by one
+    auto yT = y.transp();
+    auto z = NDArrayFactory::create<double>('c', {4, 6});
+    ElementwiseChain chain(x);
+    chain.apply(pairwise::Subtract, yT).apply(transform::Abs).apply(transform::Sqrt).apply(scalar::Multiply, 2.);
+    ASSERT_FALSE(chain.isFused(z));
+
+    chain.execute(z);
+    auto exp = (x - yT).transform(transform::Abs).transform(transform::Sqrt) * 2.;
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    auto i = NDArrayFactory::create<int>('c', {2, 3}, {1, 2, 3, 4, 5, 6});
+    auto iExp = NDArrayFactory::create<int>('c', {2, 3}, {-3, -5, -7, -9, -11, -13});
+    ElementwiseChain intChain(i);
+    intChain.apply(pairwise::Add, i).apply(scalar::Add, 1.).apply(transform::Neg);
+    ASSERT_FALSE(intChain.isFused(i));
+    ASSERT_TRUE(iExp.equalsTo(intChain.evaluate()));
+}
@@ -425,6 +425,55 @@ TEST_F(NlpTests, test_sg_ns_batch_1) {
     delete result;
 }
 
+TEST_F(NlpTests, test_sg_ns_batch_2) {
+    auto targets = NDArrayFactory::create<int>('c', {3}, {1, 2, 3});
+    auto ngStarters = NDArrayFactory::create<int>('c', {3}, {4, 5, 6});
+    auto indices = NDArrayFactory::empty<int>();
+    auto codes = NDArrayFactory::empty<int8_t>();
+    auto syn00 = NDArrayFactory::create<float>('c', {100, 10});
+    auto syn01 = NDArrayFactory::create<float>('c', {100, 10});
+    auto syn1Neg0 = NDArrayFactory::create<float>('c', {100, 10});
+    auto syn1Neg1 = NDArrayFactory::create<float>('c', {100, 10});
+    auto syn1 = NDArrayFactory::empty<float>();
+    auto expTable = NDArrayFactory::create<float>('c', {10000});
+    auto negTable = NDArrayFactory::create<float>('c', {100000});
+
+    auto alphas = NDArrayFactory::create<double>('c', {3}, {0.01, 0.02, 0.03});
+    auto randomValues = NDArrayFactory::create<Nd4jLong>('c', {3}, {1L, 2L, 3L});
+    auto inferenceVector = NDArrayFactory::empty<float>();
+    auto neu1e = NDArrayFactory::create<float>('c', {10});
+
+    RandomGenerator rng(119L, 198L);
+    RandomLauncher::fillUniform(rng, &syn00, 0.0, 1.0);
+    RandomLauncher::fillUniform(rng, &syn1Neg0, 0.0, 0.1);
+
+    syn01.assign(syn00);
+    syn1Neg1.assign(syn1Neg0);
+    expTable.assign(0.5);
+    negTable.linspace(0.0);
+
+    nd4j::ops::skipgram op;
+
+    // batched execution must be equal to sequence of single rounds
+    auto result = op.execute({&targets, &ngStarters, &indices, &codes, &syn00, &syn1, &syn1Neg0, &expTable, &negTable, &alphas, &randomValues, &inferenceVector, &neu1e}, {}, {1, 3}, {false}, true);
+    ASSERT_EQ(Status::OK(), result->status());
+    delete result;
+
+    for (int e = 0; e < 3; e++) {
+        auto target = NDArrayFactory::create<int>(targets.e<int>(e));
+        auto ngStarter = NDArrayFactory::create<int>(ngStarters.e<int>(e));
+        auto alpha = NDArrayFactory::create<double>(alphas.e<double>(e));
+        auto randomValue = NDArrayFactory::create<Nd4jLong>(randomValues.e<Nd4jLong>(e));
+
+        auto single = op.execute({&target, &ngStarter, &indices, &codes, &syn01, &syn1, &syn1Neg1, &expTable, &negTable, &alpha, &randomValue, &inferenceVector, &neu1e}, {}, {1, 3}, {false}, true);
+        ASSERT_EQ(Status::OK(), single->status());
+        delete single;
+    }
+
+    ASSERT_TRUE(syn01.equalsTo(syn00, 1e-6));
+    ASSERT_TRUE(syn1Neg1.equalsTo(syn1Neg0, 1e-6));
+}
+
 TEST_F(NlpTests, test_cbow_hs_batch_1) {
     auto target = NDArrayFactory::create<int>(0);
     auto ngStarter = NDArrayFactory::empty<int>();
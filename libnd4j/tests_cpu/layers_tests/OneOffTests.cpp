@@ -27,6 +27,9 @@
 #include <memory/MemoryReport.h>
 #include <memory/MemoryUtils.h>
 #include <MmulHelper.h>
+#include <graph/generated/graph_generated.h>
+#include <helpers/BitwiseUtils.h>
+#include <cstdio>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -370,4 +373,92 @@ TEST_F(OneOffTests, test_reduce_all_1) {
 
 
     delete graph;
-}
\ No newline at end of file
+}
+
+TEST_F(OneOffTests, test_mapped_import_1) {
+    auto mapped = GraphExecutioner::importFromFlatBuffers("./resources/channels_last_b1_k2_s1_d1_SAME_crelu.fb");
+    ASSERT_TRUE(mapped != nullptr);
+
+    // this model is stored big-endian, so on little-endian hosts its weights are converted instead of being used in place
+    auto data = nd4j::graph::readFlatBuffers("./resources/channels_last_b1_k2_s1_d1_SAME_crelu.fb");
+    auto copied = GraphExecutioner::importFromFlatPointer(reinterpret_cast<Nd4jPointer>(data));
+    delete[] data;
+
+    // weights restored from mapped file must be equal to copied ones
+    auto variables = copied->getVariableSpace()->getVariables();
+    ASSERT_FALSE(variables.empty());
+
+    for (auto v: variables) {
+        if (!v->hasNDArray())
+            continue;
+
+        auto m = mapped->getVariableSpace()->getVariable(v->id(), v->index());
+        ASSERT_TRUE(m->hasNDArray());
+        ASSERT_TRUE(v->getNDArray()->equalsTo(m->getNDArray()));
+    }
+
+    Nd4jStatus status = GraphExecutioner::execute(mapped);
+    ASSERT_EQ(Status::OK(), status);
+
+    delete mapped;
+    delete copied;
+}
+
+TEST_F(OneOffTests, test_mapped_import_2) {
+    const char *filename = "./mapped_import_2.fb";
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {-1.f, 2.f, -3.f, 4.f, -5.f, 6.f});
+
+    // model with weights stored in host byte order: variable -1 and abs(-1) as node 1
+    flatbuffers::FlatBufferBuilder builder(1024);
+    auto fShape = builder.CreateVector(x.getShapeInfoAsFlatVector());
+    auto fBuffer = builder.CreateVector(x.asByteVector());
+    auto fArray = nd4j::graph::CreateFlatArray(builder, fShape, fBuffer, nd4j::graph::DataType_FLOAT, BitwiseUtils::isBE() ? nd4j::graph::ByteOrder_BE : nd4j::graph::ByteOrder_LE);
+    auto fVar = nd4j::graph::CreateFlatVariable(builder, nd4j::graph::CreateIntPair(builder, -1), 0, nd4j::graph::DataType_FLOAT, 0, fArray);
+
+    std::vector<int> inputs = {-1};
+    auto node = nd4j::graph::CreateFlatNode(builder, 1, builder.CreateString("abs"), nd4j::graph::OpType_TRANSFORM_SAME, transform::Abs, 0, builder.CreateVector(inputs));
+
+    std::vector<flatbuffers::Offset<nd4j::graph::FlatVariable>> variables = {fVar};
+    std::vector<flatbuffers::Offset<nd4j::graph::FlatNode>> nodes = {node};
+    nd4j::graph::FlatGraphBuilder graphBuilder(builder);
+    graphBuilder.add_id(1);
+    graphBuilder.add_variables(builder.CreateVector(variables));
+    graphBuilder.add_nodes(builder.CreateVector(nodes));
+    builder.Finish(graphBuilder.Finish());
+
+    auto out = fopen(filename, "wb");
+    ASSERT_TRUE(out != nullptr);
+    ASSERT_EQ(builder.GetSize(), fwrite(builder.GetBufferPointer(), 1, builder.GetSize(), out));
+    fclose(out);
+
+    auto graph = GraphExecutioner::importFromFlatBuffers(filename);
+    ASSERT_TRUE(graph != nullptr);
+
+    auto storage = graph->getStorage();
+    ASSERT_TRUE(storage != nullptr);
+    ASSERT_TRUE(storage->isMapped());
+
+    // weights weren't copied: array buffer lies inside of the mapping
+    auto w = graph->getVariableSpace()->getVariable(-1)->getNDArray();
+    auto wBuffer = reinterpret_cast<uint8_t *>(w->getBuffer());
+    ASSERT_TRUE(wBuffer >= storage->data());
+    ASSERT_TRUE(wBuffer + w->lengthOf() * sizeof(float) <= storage->data() + storage->size());
+    ASSERT_EQ(x, *w);
+
+    // writes into zero-copy weights stay private to this process, file is intact
+    w->assign(-7.f);
+    auto data = nd4j::graph::readFlatBuffers(filename);
+    auto stored = nd4j::graph::GetFlatGraph(data)->variables()->Get(0)->ndarray()->buffer();
+    ASSERT_EQ(0, memcmp(stored->data(), x.getBuffer(), x.lengthOf() * sizeof(float)));
+    delete[] data;
+
+    Nd4jStatus status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    auto z = graph->getVariableSpace()->getVariable(1)->getNDArray();
+    ASSERT_TRUE(z != nullptr);
+    ASSERT_EQ(7.f, z->reduceNumber(reduce::Mean).e<float>(0));
+
+    delete graph;
+    std::remove(filename);
+}
@@ -94,6 +94,88 @@ TEST_F(RNGTests, TestSeeds_2) {
 }
 
 
+TEST_F(RNGTests, Test_Philox_1) {
+    RandomGenerator generatorA(119, 5);
+    RandomGenerator generatorB(119, 5);
+    RandomGenerator generatorC(119, 6);
+
+    uint32_t block[RandomGenerator::PHILOX_BLOCK];
+    uint32_t single[4];
+    float normals[RandomGenerator::PHILOX_BLOCK];
+
+    bool differs = false;
+    for (int b = 0; b < 64; b++) {
+        generatorA.philoxBlock(b, block);
+        generatorA.normalBlock<float>(b, normals);
+
+        for (int j = 0; j < 4; j++) {
+            generatorB.philox(4 * b + j, single);
+            for (int e = 0; e < 4; e++)
+                ASSERT_EQ(block[4 * j + e], single[e]);
+
+            generatorC.philox(4 * b + j, single);
+            differs |= single[0] != block[4 * j];
+        }
+
+        for (int e = 0; e < RandomGenerator::PHILOX_BLOCK; e++)
+            ASSERT_NEAR(generatorB.relativeNormal<float>(RandomGenerator::PHILOX_BLOCK * b + e), normals[e], 1e-5f);
+    }
+
+    ASSERT_TRUE(differs);
+}
+
+TEST_F(RNGTests, Test_Philox_2) {
+    // Random123 known-answer vectors for Philox4x32-10: counter is (counter, node state), key is root state
+    uint32_t result[4];
+
+    RandomGenerator generatorA(0x299f31d0a4093822LL, 0x0370734413198a2eLL);
+    generatorA.philox(static_cast<Nd4jLong>(0x85a308d3243f6a88ULL), result);
+    ASSERT_EQ(0xd16cfe09U, result[0]);
+    ASSERT_EQ(0x94fdccebU, result[1]);
+    ASSERT_EQ(0x5001e420U, result[2]);
+    ASSERT_EQ(0x24126ea1U, result[3]);
+
+    RandomGenerator generatorB(-1LL, -1LL);
+    generatorB.philox(-1LL, result);
+    ASSERT_EQ(0x408f276dU, result[0]);
+    ASSERT_EQ(0x41c83b0eU, result[1]);
+    ASSERT_EQ(0xa20bc7c6U, result[2]);
+    ASSERT_EQ(0x6d5451fdU, result[3]);
+}
+
+TEST_F(RNGTests, Test_Philox_3) {
+    // moments of single precision normals, which use polynomial log/sincos
+    RandomGenerator generator(119, 5);
+    const int numBlocks = 1 << 16;
+    float normals[RandomGenerator::PHILOX_BLOCK];
+
+    double sum = 0., squares = 0.;
+    Nd4jLong tail2 = 0, tail3 = 0, length = 0;
+    for (int b = 0; b < numBlocks; b++) {
+        generator.normalBlock<float>(b, normals);
+
+        for (int e = 0; e < RandomGenerator::PHILOX_BLOCK; e++) {
+            double v = normals[e];
+            ASSERT_TRUE(std::isfinite(v));
+
+            sum += v;
+            squares += v * v;
+            tail2 += std::abs(v) > 2.;
+            tail3 += std::abs(v) > 3.;
+            length++;
+        }
+    }
+
+    auto mean = sum / length;
+    auto variance = squares / length - mean * mean;
+
+    // bounds are ~5 standard errors for 2^20 samples
+    ASSERT_NEAR(0., mean, 5e-3);
+    ASSERT_NEAR(1., variance, 7e-3);
+    ASSERT_NEAR(0.0455003, (double) tail2 / length, 1e-3);
+    ASSERT_NEAR(0.0026998, (double) tail3 / length, 2.5e-4);
+}
+
 TEST_F(RNGTests, Test_Dropout_1) {
     auto x0 = NDArrayFactory::create<float>('c', {10, 10});
     auto x1 = NDArrayFactory::create<float>('c', {10, 10});
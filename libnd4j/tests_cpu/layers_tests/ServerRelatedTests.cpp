@@ -22,6 +22,10 @@
 #include <GraphExecutioner.h>
 #include <graph/GraphHolder.h>
 #include <graph/InferenceRequest.h>
+#include <graph/InferenceBatcher.h>
+#include <graph/VariableProxy.h>
+#include <ops/declarable/OpRegistrator.h>
+#include <thread>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -80,6 +84,19 @@ TEST_F(ServerRelatedTests, Basic_Output_Test_1) {
     ASSERT_EQ(*array2, *restored.byId("second")->getNDArray());
     ASSERT_EQ(*array3, *restored.byId("second indexed")->getNDArray());
 }
+/**
+ * This method builds graph with single placeholder and reduce_sum along given dimension, so {3, 3} input gives {3} output
+ */
+static Graph* buildReductionGraph(int dimension = 0) {
+    auto graph = new Graph();
+    graph->getVariableSpace()->putVariable(-1, new Variable());
+
+    auto op = nd4j::ops::OpRegistrator::getInstance()->getOperation("reduce_sum");
+    graph->addNode(new Node(op, 1, {-1}, {}, {}, 0.0f, {}, {dimension}));
+
+    return graph;
+}
+
 #if GRAPH_FILES_OK
 TEST_F(ServerRelatedTests, Basic_Execution_Test_1) {
     flatbuffers::FlatBufferBuilder builder(4096);
@@ -184,4 +201,203 @@ TEST_F(ServerRelatedTests, BasicExecutionTests_3) {
 
     GraphHolder::getInstance()->dropGraphAny(11903L);
 }
+
 #endif
+
+TEST_F(ServerRelatedTests, BasicExecutionTests_4) {
+    auto oGraph = buildReductionGraph();
+
+    auto input0 = NDArrayFactory::create<float>('c', {3, 3}, {2.f,2.f,2.f, 2.f,2.f,2.f, 2.f,2.f,2.f});
+    auto input1 = NDArrayFactory::create<float>('c', {3, 3}, {3.f,3.f,3.f, 3.f,3.f,3.f, 3.f,3.f,3.f});
+    auto exp0 = NDArrayFactory::create<float>('c', {3}, {6.f, 6.f, 6.f});
+    auto exp1 = NDArrayFactory::create<float>('c', {3}, {9.f, 9.f, 9.f});
+
+    GraphHolder::getInstance()->registerGraph(11904L, oGraph);
+    auto entries = oGraph->getVariableSpace()->totalEntries();
+
+    // same registered graph serves both requests, without being modified
+    for (auto p: std::vector<std::pair<NDArray*, NDArray*>>({{&input0, &exp0}, {&input1, &exp1}})) {
+        flatbuffers::FlatBufferBuilder builder(4096);
+        flatbuffers::FlatBufferBuilder otherBuilder(4096);
+
+        InferenceRequest ir(11904L);
+        ir.appendVariable(-1, 0, p.first);
+
+        auto af = ir.asFlatInferenceRequest(otherBuilder);
+        otherBuilder.Finish(af);
+        auto fir = GetFlatInferenceRequest(otherBuilder.GetBufferPointer());
+
+        auto flatResult = GraphHolder::getInstance()->execute(fir->id(), builder, fir);
+        builder.Finish(flatResult);
+
+        ExecutionResult restored(GetFlatResult(builder.GetBufferPointer()));
+        ASSERT_EQ(1, restored.size());
+        ASSERT_EQ(*p.second, *restored.at(0)->getNDArray());
+
+        ASSERT_EQ(entries, oGraph->getVariableSpace()->totalEntries());
+    }
+
+    GraphHolder::getInstance()->dropGraphAny(11904L);
+}
+
+TEST_F(ServerRelatedTests, BasicExecutionTests_5) {
+    auto oGraph = buildReductionGraph();
+    GraphHolder::getInstance()->registerGraph(11906L, oGraph);
+    auto entries = oGraph->getVariableSpace()->totalEntries();
+
+    const int numThreads = 4;
+    const int numRequests = 16;
+
+    // all threads are served by the same registered graph at the same time
+    std::vector<std::thread> threads;
+    std::vector<int> results(numThreads, 0);
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back(std::thread([&results, t] {
+            for (int r = 0; r < numRequests; r++) {
+                auto input = NDArrayFactory::create<float>('c', {3, 3});
+                input.assign(t * numRequests + r);
+
+                auto exp = NDArrayFactory::create<float>('c', {3});
+                exp.assign(3 * (t * numRequests + r));
+
+                flatbuffers::FlatBufferBuilder builder(4096);
+                flatbuffers::FlatBufferBuilder otherBuilder(4096);
+
+                InferenceRequest ir(11906L);
+                ir.appendVariable(-1, 0, &input);
+
+                auto af = ir.asFlatInferenceRequest(otherBuilder);
+                otherBuilder.Finish(af);
+                auto fir = GetFlatInferenceRequest(otherBuilder.GetBufferPointer());
+
+                auto flatResult = GraphHolder::getInstance()->execute(fir->id(), builder, fir);
+                builder.Finish(flatResult);
+
+                ExecutionResult restored(GetFlatResult(builder.GetBufferPointer()));
+                if (restored.size() == 1 && exp.equalsTo(restored.at(0)->getNDArray()))
+                    results[t]++;
+            }
+        }));
+    }
+
+    for (auto &t: threads)
+        t.join();
+
+    for (int t = 0; t < numThreads; t++)
+        ASSERT_EQ(numRequests, results[t]);
+
+    ASSERT_EQ(entries, oGraph->getVariableSpace()->totalEntries());
+
+    GraphHolder::getInstance()->dropGraphAny(11906L);
+}
+
+TEST_F(ServerRelatedTests, BatchedExecutionTests_1) {
+    // rows are reduced independently, so merged batch can be split back
+    auto oGraph = buildReductionGraph(1);
+    GraphHolder::getInstance()->registerGraph(11905L, oGraph);
+
+    const int numThreads = 4;
+
+    // batch leader waits until all requests are queued, window is only a safety net here
+    InferenceBatcher batcher(11905L, numThreads, 30000000L);
+
+    std::vector<std::thread> threads;
+    std::vector<int> results(numThreads, 0);
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back(std::thread([&batcher, &results, t] {
+            auto input = NDArrayFactory::create<float>('c', {3, 3});
+            input.assign(t + 1);
+
+            auto exp = NDArrayFactory::create<float>('c', {3});
+            exp.assign(3 * (t + 1));
+
+            flatbuffers::FlatBufferBuilder builder(4096);
+            flatbuffers::FlatBufferBuilder otherBuilder(4096);
+
+            InferenceRequest ir(11905L);
+            ir.appendVariable(-1, 0, &input);
+
+            auto af = ir.asFlatInferenceRequest(otherBuilder);
+            otherBuilder.Finish(af);
+            auto fir = GetFlatInferenceRequest(otherBuilder.GetBufferPointer());
+
+            auto flatResult = batcher.execute(builder, fir);
+            builder.Finish(flatResult);
+
+            ExecutionResult restored(GetFlatResult(builder.GetBufferPointer()));
+            results[t] = restored.size() == 1 && exp.equalsTo(restored.at(0)->getNDArray()) ? 1 : 0;
+        }));
+    }
+
+    for (auto &t: threads)
+        t.join();
+
+    for (int t = 0; t < numThreads; t++)
+        ASSERT_EQ(1, results[t]);
+
+    ASSERT_EQ(numThreads, batcher.numberOfRequests());
+    ASSERT_EQ(0, batcher.queueDepth());
+
+    // all requests were coalesced into single graph execution
+    ASSERT_EQ(1, batcher.numberOfBatches());
+    ASSERT_NEAR((double) numThreads, batcher.averageBatchSize(), 1e-5);
+
+    GraphHolder::getInstance()->dropGraphAny(11905L);
+}
+
+TEST_F(ServerRelatedTests, BasicExecutionTests_6) {
+    // reduce_sum(placeholder + weights) along dimension 0
+    auto oGraph = new Graph();
+    auto weights = NDArrayFactory::create_<float>('c', {3, 3});
+    weights->assign(1.f);
+    oGraph->getVariableSpace()->putVariable(-1, new Variable());
+    oGraph->getVariableSpace()->putVariable(-2, weights);
+
+    auto opAdd = nd4j::ops::OpRegistrator::getInstance()->getOperation("add");
+    auto opSum = nd4j::ops::OpRegistrator::getInstance()->getOperation("reduce_sum");
+    oGraph->addNode(new Node(opAdd, 1, {-1, -2}));
+    oGraph->addNode(new Node(opSum, 2, {1}, {}, {}, 0.0f, {}, {0}));
+
+    // graph is executed before registration, so slots of op outputs hold arrays already
+    auto input0 = NDArrayFactory::create_<float>('c', {3, 3});
+    input0->assign(2.f);
+    oGraph->getVariableSpace()->getVariable(-1)->setNDArray(input0);
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(oGraph));
+
+    auto exp0 = NDArrayFactory::create<float>('c', {3}, {9.f, 9.f, 9.f});
+    auto exp1 = NDArrayFactory::create<float>('c', {3}, {12.f, 12.f, 12.f});
+    auto previous = oGraph->getVariableSpace()->getVariable(2)->getNDArray();
+    ASSERT_EQ(exp0, *previous);
+
+    GraphHolder::getInstance()->registerGraph(11907L, oGraph);
+
+    // weights are read in place by every session, op outputs get replicated as empty slots
+    VariableProxy proxy(oGraph->getVariableSpace());
+    ASSERT_TRUE(oGraph->getVariableSpace()->getVariable(-2) == proxy.getVariable(-2));
+    ASSERT_FALSE(oGraph->getVariableSpace()->getVariable(2) == proxy.getVariable(2));
+    ASSERT_FALSE(proxy.getVariable(2)->hasNDArray());
+
+    flatbuffers::FlatBufferBuilder builder(4096);
+    flatbuffers::FlatBufferBuilder otherBuilder(4096);
+    auto input1 = NDArrayFactory::create<float>('c', {3, 3});
+    input1.assign(3.f);
+
+    InferenceRequest ir(11907L);
+    ir.appendVariable(-1, 0, &input1);
+
+    auto af = ir.asFlatInferenceRequest(otherBuilder);
+    otherBuilder.Finish(af);
+    auto fir = GetFlatInferenceRequest(otherBuilder.GetBufferPointer());
+
+    auto flatResult = GraphHolder::getInstance()->execute(fir->id(), builder, fir);
+    builder.Finish(flatResult);
+
+    ExecutionResult restored(GetFlatResult(builder.GetBufferPointer()));
+    ASSERT_EQ(exp1, *restored.byId(2)->getNDArray());
+
+    // result of execution before registration wasn't touched by the request
+    ASSERT_TRUE(previous == oGraph->getVariableSpace()->getVariable(2)->getNDArray());
+    ASSERT_EQ(exp0, *previous);
+
+    GraphHolder::getInstance()->dropGraphAny(11907L);
+}
@@ -24,6 +24,7 @@
 #include "testlayers.h"
 #include <NDArray.h>
 #include <helpers/TAD.h>
+#include <helpers/ConstantTadHelper.h>
 #include <array>
 
 using namespace nd4j;
@@ -279,6 +280,70 @@ TEST_F(TadTests, Tad_1D_1) {
 */
 
 ///////////////////////////////////////////////////////////////////
+TEST_F(TadTests, TadCache_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 17, 5});
+    auto helper = ConstantTadHelper::getInstance();
+
+    auto misses = helper->cacheMisses();
+    auto hits = helper->cacheHits();
+
+    auto pack0 = helper->tadForDimensions(x.shapeInfo(), {0, 2});
+    auto pack1 = helper->tadForDimensions(x.shapeInfo(), {2, 0});
+
+    // axis order doesn't matter, so that's the same pack
+    ASSERT_EQ(pack0.primaryShapeInfo(), pack1.primaryShapeInfo());
+    ASSERT_EQ(17, pack0.numberOfTads());
+    ASSERT_EQ(misses + 1, helper->cacheMisses());
+    ASSERT_EQ(hits + 1, helper->cacheHits());
+}
+
+TEST_F(TadTests, TadCache_2) {
+    auto helper = ConstantTadHelper::getInstance();
+    auto evictions = helper->cacheEvictions();
+
+    helper->setCapacity(16);
+
+    for (int e = 1; e < 100; e++) {
+        auto x = NDArrayFactory::create<float>('c', {e, 7, 3});
+        auto pack = helper->tadForDimensions(x.shapeInfo(), {1, 2});
+        ASSERT_EQ(e, pack.numberOfTads());
+    }
+
+    ASSERT_TRUE(helper->cacheEvictions() > evictions);
+
+    // evicted pack is just built again
+    auto x = NDArrayFactory::create<float>('c', {1, 7, 3});
+    ASSERT_EQ(1, helper->tadForDimensions(x.shapeInfo(), {1, 2}).numberOfTads());
+
+    helper->setCapacity(0);
+}
+
+TEST_F(TadTests, TadCache_3) {
+    auto helper = ConstantTadHelper::getInstance();
+    auto x = NDArrayFactory::create<float>('c', {5, 11, 3});
+    auto y = NDArrayFactory::create<float>('c', {6, 11, 3});
+
+    // this one is handed out while cache isn't bounded
+    auto unbounded = helper->tadForDimensions(x.shapeInfo(), {1, 2});
+
+    helper->setCapacity(16);
+    auto bounded = helper->tadForDimensions(y.shapeInfo(), {1, 2});
+
+    for (int e = 100; e < 200; e++) {
+        auto z = NDArrayFactory::create<float>('c', {e, 11, 3});
+        helper->tadForDimensions(z.shapeInfo(), {1, 2});
+    }
+
+    helper->setCapacity(0);
+
+    // both packs are still valid after their entries were evicted
+    ASSERT_EQ(5, unbounded.numberOfTads());
+    ASSERT_EQ(33, unbounded.primaryOffsets()[1]);
+    ASSERT_EQ(6, bounded.numberOfTads());
+    ASSERT_EQ(5 * 33, bounded.primaryOffsets()[5]);
+    ASSERT_EQ(2, shape::rank(bounded.primaryShapeInfo()));
+}
+
 /*
 TEST_F(TadTests, TestShapeTad_2) {
         
@@ -170,4 +170,41 @@ TEST_F(VariableProxyTests, Test_Clone_1) {
     ASSERT_TRUE(clone->hasVariable(119));
 
     delete clone;
-}
\ No newline at end of file
+}
+
+TEST_F(VariableProxyTests, Test_Shadow_1) {
+    auto x = NDArrayFactory::create_<float>('c', {2, 2}, {1, 2, 3, 4});
+    VariableSpace ref;
+
+    std::pair<int, int> pair(119, 0);
+    ref.putVariable(pair, new Variable(nullptr, nullptr, 119, 0));
+
+    VariableProxy proxy(&ref);
+
+    ASSERT_TRUE(proxy.hasVariable(pair));
+
+    // empty Variable from backing space shouldn't be modified via proxy
+    proxy.getVariable(pair)->setNDArray(x);
+
+    ASSERT_FALSE(ref.getVariable(pair)->hasNDArray());
+    ASSERT_TRUE(proxy.getVariable(pair)->hasNDArray());
+    ASSERT_TRUE(x == proxy.getVariable(pair)->getNDArray());
+}
+
+TEST_F(VariableProxyTests, Test_Shadow_2) {
+    auto w = NDArrayFactory::create_<float>('c', {2, 2}, {1, 2, 3, 4});
+    auto o = NDArrayFactory::create_<float>('c', {2, 2}, {4, 3, 2, 1});
+    VariableSpace ref;
+
+    // weights are marked as shared at registration, op output is left from previous execution
+    ref.putVariable(-1, w);
+    ref.getVariable(-1)->markShared(true);
+    ref.putVariable(1, o);
+
+    VariableProxy proxy(&ref);
+
+    ASSERT_TRUE(ref.getVariable(-1) == proxy.getVariable(-1));
+    ASSERT_FALSE(ref.getVariable(1) == proxy.getVariable(1));
+    ASSERT_FALSE(proxy.getVariable(1)->hasNDArray());
+    ASSERT_TRUE(o == ref.getVariable(1)->getNDArray());
+}
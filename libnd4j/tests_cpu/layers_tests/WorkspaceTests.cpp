@@ -196,6 +196,77 @@ TEST_F(WorkspaceTests, CloneTest1) {
     delete clone;
 }
 
+TEST_F(WorkspaceTests, SpillsRecycleTest1) {
+    Workspace ws(1024);
+
+    auto ptr1 = ws.allocateBytes(4096);
+    ASSERT_EQ(4096, ws.getSpilledSize());
+
+    ws.scopeOut();
+    ASSERT_EQ(0, ws.getSpilledSize());
+
+    // spill of the same size class is taken from the pool
+    auto ptr2 = ws.allocateBytes(3000);
+    ASSERT_TRUE(ptr1 == ptr2);
+    ASSERT_EQ(3000, ws.getSpilledSize());
+    ASSERT_EQ(0, reinterpret_cast<Nd4jLong>(ptr2) % Workspace::ALIGNMENT);
+}
+
+TEST_F(WorkspaceTests, AlignedTest1) {
+    Workspace ws(65536);
+    ws.setAligned(true);
+
+    const int numAllocations = 256;
+    std::vector<char*> pointers(numAllocations);
+
+    PRAGMA_OMP_PARALLEL_FOR
+    for (int e = 0; e < numAllocations; e++) {
+        auto ptr = reinterpret_cast<char*>(ws.allocateBytes(100));
+        memset(ptr, e, 100);
+        pointers[e] = ptr;
+    }
+
+    ASSERT_EQ(0, ws.getSpilledSize());
+    ASSERT_EQ((numAllocations - 1) * 128 + 100, ws.getCurrentOffset());
+
+    for (int e = 0; e < numAllocations; e++) {
+        ASSERT_EQ(0, reinterpret_cast<Nd4jLong>(pointers[e]) % Workspace::ALIGNMENT);
+
+        for (int i = 0; i < 100; i++)
+            ASSERT_EQ((char) e, pointers[e][i]);
+    }
+}
+
+TEST_F(WorkspaceTests, HugePagesTest1) {
+    auto env = Environment::getInstance();
+    auto hugePages = env->hugePagesMode();
+    auto numaPolicy = env->numaPolicy();
+    auto threshold = env->largeAllocationThreshold();
+
+    env->setHugePagesMode(nd4j::memory::HUGE_PAGES_TRANSPARENT);
+    env->setNumaPolicy(nd4j::memory::NUMA_INTERLEAVE);
+    env->setLargeAllocationThreshold(1024 * 1024);
+
+    {
+        Workspace ws(4 * 1024 * 1024);
+        ws.setAligned(true);
+
+        auto x = NDArrayFactory::create<float>('c', {512, 512}, &ws);
+        auto y = NDArrayFactory::create<float>('c', {512, 512});
+
+        ASSERT_EQ(0, reinterpret_cast<Nd4jLong>(x.getBuffer()) % Workspace::ALIGNMENT);
+
+        x.assign(2.0f);
+        y.assign(3.0f);
+
+        ASSERT_NEAR(5.0f, (x + y).meanNumber().e<float>(0), 1e-5);
+    }
+
+    env->setHugePagesMode(hugePages);
+    env->setNumaPolicy(numaPolicy);
+    env->setLargeAllocationThreshold(threshold);
+}
+
 TEST_F(WorkspaceTests, Test_Arrays_1) {
     Workspace ws(65536);
     auto x = NDArrayFactory::create<float>('c', {3, 3}, {1, 2, 3, 4, 5, 6, 7, 8, 9}, &ws);